@@ -0,0 +1,265 @@
+// Copyright (c) 2025
+//
+// A/B benchmark harness.  See ab_benchmark.h.
+
+#include "ab_benchmark.h"
+#include <windows.h>
+#include <intrin.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "MinHook.h"
+
+namespace {
+    const int    kInputs = 4096;    // argument sets per run
+    const int    kRuns   = 30;      // timed runs per side
+    const double kT95    = 2.045;   // two-sided 95% t value, kRuns - 1 d.o.f.
+
+    using Fn0 = uint32_t(__cdecl*)();
+    using Fn1 = uint32_t(__cdecl*)(uint32_t);
+    using Fn2 = uint32_t(__cdecl*)(uint32_t, uint32_t);
+    using Fn3 = uint32_t(__cdecl*)(uint32_t, uint32_t, uint32_t);
+    using Fn4 = uint32_t(__cdecl*)(uint32_t, uint32_t, uint32_t, uint32_t);
+
+    // One call with `Arity` arguments taken from `a`.
+    template <int Arity> struct Caller;
+    template <> struct Caller<0> {
+        static uint32_t Call(void* f, const uint32_t*) { return reinterpret_cast<Fn0>(f)(); }
+    };
+    template <> struct Caller<1> {
+        static uint32_t Call(void* f, const uint32_t* a) { return reinterpret_cast<Fn1>(f)(a[0]); }
+    };
+    template <> struct Caller<2> {
+        static uint32_t Call(void* f, const uint32_t* a) { return reinterpret_cast<Fn2>(f)(a[0], a[1]); }
+    };
+    template <> struct Caller<3> {
+        static uint32_t Call(void* f, const uint32_t* a) { return reinterpret_cast<Fn3>(f)(a[0], a[1], a[2]); }
+    };
+    template <> struct Caller<4> {
+        static uint32_t Call(void* f, const uint32_t* a) { return reinterpret_cast<Fn4>(f)(a[0], a[1], a[2], a[3]); }
+    };
+
+    uint32_t Invoke(void* fn, int arity, const uint32_t* args) {
+        switch (arity) {
+        case 0:  return Caller<0>::Call(fn, args);
+        case 1:  return Caller<1>::Call(fn, args);
+        case 2:  return Caller<2>::Call(fn, args);
+        case 3:  return Caller<3>::Call(fn, args);
+        default: return Caller<4>::Call(fn, args);
+        }
+    }
+
+    volatile uint32_t g_sink;
+
+    // Cycles for one pass over every argument set.  The arity switch
+    // sits outside the loop so it costs both sides nothing per call.
+    template <int Arity>
+    uint64_t TimePass(void* fn, const std::vector<uint32_t>& args) {
+        void* volatile target = fn;
+        uint32_t sink = 0;
+        const uint32_t* a = args.data();
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < kInputs; ++i, a += Arity) {
+            sink += Caller<Arity>::Call(target, a);
+        }
+        uint64_t cycles = __rdtsc() - start;
+        g_sink = sink;
+        return cycles;
+    }
+
+    uint64_t TimePass(void* fn, int arity, const std::vector<uint32_t>& args) {
+        switch (arity) {
+        case 0:  return TimePass<0>(fn, args);
+        case 1:  return TimePass<1>(fn, args);
+        case 2:  return TimePass<2>(fn, args);
+        case 3:  return TimePass<3>(fn, args);
+        default: return TimePass<4>(fn, args);
+        }
+    }
+
+    // Fixed-seed argument sets: the range's end points, 0 and -1 where
+    // they are in range, then xorshift32 values spread over the range.
+    std::vector<uint32_t> GenerateArgs(const AbBenchCase& c) {
+        std::vector<uint32_t> args(static_cast<size_t>(kInputs) * c.arity);
+        const int32_t edges[] = { c.minArg, c.maxArg, 0, -1 };
+        uint32_t state = 0x9E3779B9u;
+        uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(c.maxArg) - c.minArg) + 1;
+        for (size_t i = 0; i < args.size(); ++i) {
+            size_t set = i / (c.arity ? c.arity : 1);
+            if (set < 4 && edges[set] >= c.minArg && edges[set] <= c.maxArg) {
+                args[i] = static_cast<uint32_t>(edges[set]);
+                continue;
+            }
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            args[i] = static_cast<uint32_t>(c.minArg + static_cast<int64_t>(state % span));
+        }
+        return args;
+    }
+
+    struct Stats {
+        double mean;
+        double ci;      // half-width of the 95% interval
+    };
+
+    Stats Summarise(const std::vector<double>& samples) {
+        double sum = 0.0;
+        for (double s : samples) {
+            sum += s;
+        }
+        double mean = sum / samples.size();
+        double var = 0.0;
+        for (double s : samples) {
+            var += (s - mean) * (s - mean);
+        }
+        var /= samples.size() - 1;
+        return Stats{ mean, kT95 * std::sqrt(var / samples.size()) };
+    }
+
+    struct Result {
+        const AbBenchCase* c;
+        int         mismatches;
+        uint32_t    badArgs[4];
+        uint32_t    badOriginal;
+        uint32_t    badReconstruction;
+        Stats       original;
+        Stats       reconstruction;
+        const char* verdict;
+    };
+
+    // Disable or re-enable the hooks on a row's callees.  Returns false
+    // if any could not be changed; those already changed are put back.
+    bool SetCalleeHooks(const AbBenchCase& c, bool enable) {
+        const size_t kCallees = sizeof(c.callees) / sizeof(c.callees[0]);
+        for (size_t i = 0; i < kCallees && c.callees[i]; ++i) {
+            LPVOID target = reinterpret_cast<LPVOID>(c.callees[i]);
+            MH_STATUS status = enable ? MH_EnableHook(target) : MH_DisableHook(target);
+            if (status != MH_OK) {
+                while (i-- > 0) {
+                    target = reinterpret_cast<LPVOID>(c.callees[i]);
+                    enable ? MH_DisableHook(target) : MH_EnableHook(target);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Result RunCase(const AbBenchCase& c) {
+        Result r = {};
+        r.c = &c;
+        void* original = c.original ? *c.original : nullptr;
+        if (!original || !c.reconstruction || c.arity < 0 || c.arity > 4) {
+            r.verdict = "unavailable";
+            return r;
+        }
+        // With a callee still hooked the original side would partly be
+        // the reconstruction, so the row is not run at all.
+        if (!SetCalleeHooks(c, false)) {
+            r.verdict = "unavailable";
+            return r;
+        }
+        std::vector<uint32_t> args = GenerateArgs(c);
+
+        // Correctness first, on every argument set.
+        for (int i = 0; i < kInputs; ++i) {
+            const uint32_t* a = args.data() + static_cast<size_t>(i) * c.arity;
+            uint32_t want = Invoke(original, c.arity, a) & c.resultMask;
+            uint32_t got  = Invoke(c.reconstruction, c.arity, a) & c.resultMask;
+            if (want != got && r.mismatches++ == 0) {
+                for (int k = 0; k < c.arity; ++k) {
+                    r.badArgs[k] = a[k];
+                }
+                r.badOriginal = want;
+                r.badReconstruction = got;
+            }
+        }
+
+        // Warm both up, then alternate the timed runs.
+        TimePass(original, c.arity, args);
+        TimePass(c.reconstruction, c.arity, args);
+        std::vector<double> a, b;
+        for (int run = 0; run < kRuns; ++run) {
+            a.push_back(static_cast<double>(TimePass(original, c.arity, args)) / kInputs);
+            b.push_back(static_cast<double>(TimePass(c.reconstruction, c.arity, args)) / kInputs);
+        }
+        SetCalleeHooks(c, true);
+        r.original = Summarise(a);
+        r.reconstruction = Summarise(b);
+        if (r.mismatches) {
+            r.verdict = "mismatch";
+        } else if (r.reconstruction.mean - r.reconstruction.ci > r.original.mean + r.original.ci) {
+            r.verdict = "slower";
+        } else if (r.reconstruction.mean + r.reconstruction.ci < r.original.mean - r.original.ci) {
+            r.verdict = "faster";
+        } else {
+            r.verdict = "same";
+        }
+        return r;
+    }
+
+    void WriteJson(const char* path, const std::vector<Result>& results) {
+        FILE* f = std::fopen(path, "w");
+        if (!f) {
+            OutputDebugStringA("[AB] cannot open JSON output\n");
+            return;
+        }
+        std::fprintf(f, "{\n  \"runs\": %d,\n  \"inputs\": %d,\n  \"unit\": \"cycles_per_call\",\n  \"cases\": [\n",
+                     kRuns, kInputs);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(f, "    {\n      \"name\": \"");
+            for (const char* p = r.c->name; *p; ++p) {
+                if (*p == '"' || *p == '\\') {
+                    std::fputc('\\', f);
+                }
+                std::fputc(*p, f);
+            }
+            std::fprintf(f, "\",\n      \"address\": \"0x%08X\",\n      \"verdict\": \"%s\",\n",
+                         static_cast<unsigned>(r.c->address), r.verdict);
+            std::fprintf(f, "      \"mismatches\": %d,\n", r.mismatches);
+            if (r.mismatches) {
+                std::fprintf(f, "      \"first_mismatch\": { \"args\": [");
+                for (int k = 0; k < r.c->arity; ++k) {
+                    std::fprintf(f, "%s%d", k ? ", " : "", static_cast<int32_t>(r.badArgs[k]));
+                }
+                std::fprintf(f, "], \"original\": %u, \"reconstruction\": %u },\n",
+                             r.badOriginal, r.badReconstruction);
+            }
+            std::fprintf(f, "      \"original\": { \"mean\": %.3f, \"ci95\": %.3f },\n",
+                         r.original.mean, r.original.ci);
+            std::fprintf(f, "      \"reconstruction\": { \"mean\": %.3f, \"ci95\": %.3f },\n",
+                         r.reconstruction.mean, r.reconstruction.ci);
+            std::fprintf(f, "      \"speedup\": %.3f\n    }%s\n",
+                         r.reconstruction.mean > 0.0 ? r.original.mean / r.reconstruction.mean : 0.0,
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        std::fclose(f);
+    }
+}
+
+int RunAbBenchmarks(const char* jsonPath, const AbBenchCase* table, size_t count) {
+    std::vector<Result> results;
+    int flagged = 0;
+    char buf[256];
+    for (size_t i = 0; i < count; ++i) {
+        Result r = RunCase(table[i]);
+        results.push_back(r);
+        bool bad = r.mismatches || std::strcmp(r.verdict, "slower") == 0;
+        flagged += bad ? 1 : 0;
+        std::snprintf(buf, sizeof(buf),
+                      "[AB] %s%s (%08X): original %.2f +/- %.2f, reconstruction %.2f +/- %.2f cycles/call, "
+                      "%d/%d mismatches, %s\n",
+                      bad ? "REGRESSION " : "", r.c->name, static_cast<unsigned>(r.c->address),
+                      r.original.mean, r.original.ci, r.reconstruction.mean, r.reconstruction.ci,
+                      r.mismatches, kInputs, r.verdict);
+        OutputDebugStringA(buf);
+    }
+    if (jsonPath && *jsonPath) {
+        WriteJson(jsonPath, results);
+    }
+    return flagged;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025
+//
+// A/B benchmark of reconstructed functions against the game's own
+// code.  Every hook keeps the MinHook trampoline to the original in
+// an s_orig* pointer; a row of an A/B table pairs that trampoline with
+// the reconstruction and says how to generate arguments for it.
+//
+// Both sides are fed the same generated argument sets (a fixed-seed
+// random sweep of the row's range plus its end points, 0 and -1) and
+// their results are compared call by call before anything is timed, so
+// a fast but wrong reconstruction is reported as a mismatch rather
+// than a win.  Timing interleaves original and reconstruction runs so
+// clock and thermal drift hit both equally; each side's cycles per
+// call are reported as a mean with a 95% confidence interval over the
+// runs.  A reconstruction whose interval lies entirely above the
+// original's is flagged as a regression.
+//
+// An original that calls other hooked functions would reach their
+// detours, and so the reconstructions, from inside its trampoline; a
+// row lists such callees and their hooks are disabled while it runs.
+//
+// Results are logged and written as JSON.  Enabled by setting
+// DIGI_AB_BENCH to the JSON path; the table is run from
+// RunDeferredHookWork, outside the loader lock.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct AbBenchCase {
+    // Name used in reports, and the original's address.
+    const char* name;
+    uintptr_t   address;
+    // Where MinHook stored the trampoline to the original, and the
+    // reconstruction.  Both are called as
+    // `uint32_t __cdecl f(uint32_t...)` with `arity` arguments (0-4).
+    void**      original;
+    void*       reconstruction;
+    int         arity;
+    // Generated arguments are uniform in [minArg, maxArg].
+    int32_t     minArg;
+    int32_t     maxArg;
+    // Bits of EAX that make up the result (0xFFFF for a 16-bit
+    // return, whose upper half is undefined).
+    uint32_t    resultMask;
+    // Hooked functions the original calls, 0 for none.  Their hooks
+    // are disabled for the row so the original runs the game's code
+    // all the way down.
+    uintptr_t   callees[2];
+};
+
+// Run every row and write the JSON report to `jsonPath`.  Returns the
+// number of rows that mismatched or regressed.
+int RunAbBenchmarks(const char* jsonPath, const AbBenchCase* table, size_t count);
+
+template <size_t N>
+int RunAbBenchmarks(const char* jsonPath, const AbBenchCase (&table)[N]) {
+    return RunAbBenchmarks(jsonPath, table, N);
+}
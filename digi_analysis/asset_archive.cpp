@@ -0,0 +1,170 @@
+// Copyright (c) 2025
+//
+// Asset archive reader.  See asset_archive.h.
+
+#include "asset_archive.h"
+#include "lz4_block.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    bool IsSeparator(char c) {
+        return c == '\\' || c == '/';
+    }
+
+    // Byte order, shorter first on a common prefix.
+    int ComparePaths(const char* a, size_t aLength, const char* b, size_t bLength) {
+        int c = std::memcmp(a, b, aLength < bLength ? aLength : bLength);
+        if (c != 0) {
+            return c;
+        }
+        return aLength < bLength ? -1 : aLength > bLength ? 1 : 0;
+    }
+
+    bool Within(uint64_t offset, uint64_t length, size_t size) {
+        return offset <= size && length <= size - offset;
+    }
+}
+
+size_t NormaliseAssetPath(const char* path, size_t length, char* out) {
+    size_t n = 0;
+    size_t i = 0;
+    if (length >= 2 && path[0] == '.' && IsSeparator(path[1])) {
+        i = 2;
+    }
+    while (i < length) {
+        unsigned char c = static_cast<unsigned char>(path[i++]);
+        if (c >= 0x81 && c <= 0xFE && i < length) {
+            out[n++] = static_cast<char>(c);
+            out[n++] = path[i++];
+        } else if (IsSeparator(static_cast<char>(c))) {
+            if (n == 0 || out[n - 1] != '\\') {
+                out[n++] = '\\';
+            }
+        } else {
+            out[n++] = static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        }
+    }
+    return n;
+}
+
+bool AssetArchive::Open(const uint8_t* data, size_t size) {
+    m_header = nullptr;
+    if (size < sizeof(AssetArchiveHeader)) {
+        return false;
+    }
+    const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(data);
+    if (std::memcmp(header->magic, kAssetArchiveMagic, sizeof(kAssetArchiveMagic)) != 0 ||
+        header->version != kAssetArchiveVersion || header->blockSize == 0) {
+        return false;
+    }
+    uint64_t entriesOffset = sizeof(AssetArchiveHeader);
+    uint64_t blocksOffset = entriesOffset + uint64_t(header->entryCount) * sizeof(AssetEntry);
+    uint64_t blocksEnd = blocksOffset + uint64_t(header->blockCount) * sizeof(AssetBlock);
+    if (!Within(0, blocksEnd, size) || !Within(header->namesOffset, header->namesSize, size)) {
+        return false;
+    }
+    const AssetEntry* entries = reinterpret_cast<const AssetEntry*>(data + entriesOffset);
+    const AssetBlock* blocks = reinterpret_cast<const AssetBlock*>(data + blocksOffset);
+    const uint8_t* names = data + header->namesOffset;
+
+    // Check everything Read will touch once here, so reads need not.
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        const AssetEntry& e = entries[i];
+        if (!Within(e.nameOffset, e.nameLength, header->namesSize)) {
+            return false;
+        }
+        if (i > 0) {
+            const AssetEntry& p = entries[i - 1];
+            if (ComparePaths(reinterpret_cast<const char*>(names + p.nameOffset), p.nameLength,
+                             reinterpret_cast<const char*>(names + e.nameOffset), e.nameLength) >= 0) {
+                return false;
+            }
+        }
+        if (!(e.flags & kAssetCompressed)) {
+            if (!Within(e.dataOffset, e.size, size)) {
+                return false;
+            }
+            continue;
+        }
+        uint64_t count = (uint64_t(e.size) + header->blockSize - 1) / header->blockSize;
+        if (!Within(e.firstBlock, count, header->blockCount)) {
+            return false;
+        }
+        for (uint64_t b = 0; b < count; ++b) {
+            const AssetBlock& block = blocks[e.firstBlock + b];
+            if (!Within(block.offset, block.storedSize, size)) {
+                return false;
+            }
+        }
+    }
+
+    m_data    = data;
+    m_header  = header;
+    m_entries = entries;
+    m_blocks  = blocks;
+    m_names   = names;
+    return true;
+}
+
+const AssetEntry* AssetArchive::Find(const char* path, size_t length) const {
+    if (!m_header) {
+        return nullptr;
+    }
+    const AssetEntry* begin = m_entries;
+    const AssetEntry* end = m_entries + m_header->entryCount;
+    const AssetEntry* it = std::lower_bound(begin, end, 0, [&](const AssetEntry& e, int) {
+        return ComparePaths(Name(e), e.nameLength, path, length) < 0;
+    });
+    if (it == end || ComparePaths(Name(*it), it->nameLength, path, length) != 0) {
+        return nullptr;
+    }
+    return it;
+}
+
+size_t AssetArchive::Read(const AssetEntry& entry, uint64_t offset, void* dst, size_t count,
+                          AssetReadCache* cache) const {
+    if (offset >= entry.size) {
+        return 0;
+    }
+    size_t n = static_cast<size_t>(std::min<uint64_t>(count, entry.size - offset));
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    if (!(entry.flags & kAssetCompressed)) {
+        std::memcpy(out, m_data + entry.dataOffset + offset, n);
+        return n;
+    }
+
+    const uint32_t blockSize = m_header->blockSize;
+    uint32_t position = static_cast<uint32_t>(offset);
+    size_t done = 0;
+    while (done < n) {
+        uint32_t index = entry.firstBlock + position / blockSize;
+        uint32_t start = position % blockSize;
+        uint32_t blockStart = position - start;
+        uint32_t length = std::min(blockSize, entry.size - blockStart);
+        size_t take = std::min<size_t>(length - start, n - done);
+        const AssetBlock& block = m_blocks[index];
+        if (block.storedSize == length) {
+            // Kept raw: copy the part wanted straight out of the map.
+            std::memcpy(out + done, m_data + block.offset + start, take);
+        } else if (start == 0 && take == length) {
+            if (!Lz4Decompress(m_data + block.offset, block.storedSize, out + done, length)) {
+                return 0;
+            }
+        } else {
+            if (cache->block != index) {
+                cache->data.resize(blockSize);
+                cache->block = kAssetNoBlock;
+                if (!Lz4Decompress(m_data + block.offset, block.storedSize, cache->data.data(), length)) {
+                    return 0;
+                }
+                cache->block = index;
+            }
+            std::memcpy(out + done, cache->data.data() + start, take);
+        }
+        done += take;
+        position += static_cast<uint32_t>(take);
+    }
+    return n;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2025
+//
+// The asset archive: every loose file the game reads (ETCDAT, STDDAT,
+// CHDAT, ETCNA, CARD\CARD.ALL, the sound folders and the rest) packed
+// into one file by tools/digi_pack, so file_hooks.cpp can serve the
+// game's reads out of a single mapping instead of an open, a seek and a
+// read per asset.
+//
+// Layout, all little-endian:
+//
+//     AssetArchiveHeader
+//     AssetEntry[entryCount]       sorted by path, byte order
+//     AssetBlock[blockCount]       compressed entries only
+//     path bytes                   entries point into them
+//     data                         each entry's bytes or blocks, 16-byte aligned
+//
+// Paths are relative to the game directory and normalised by
+// NormaliseAssetPath, so a lookup is one binary search over the entry
+// table.  An entry is either stored, its bytes contiguous in the file,
+// or split into blockSize-byte blocks that are LZ4-compressed one by
+// one; a block LZ4 cannot shrink is kept raw, which its table entry
+// shows by a stored size equal to its length.  Reads of a stored entry
+// are a copy out of the mapping; reads of a compressed one decompress
+// whole blocks straight into the caller's buffer and go through a
+// one-block cache per open file only for the partial blocks at either
+// end.
+//
+// Nothing here depends on <windows.h>: the archive is parsed from bytes
+// the caller has mapped, so the packer shares this code on Linux.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+const char     kAssetArchiveMagic[8] = { 'D', 'I', 'G', 'I', 'P', 'A', 'K', 0 };
+const uint32_t kAssetArchiveVersion  = 1;
+const uint32_t kAssetDataAlignment   = 16;
+const uint32_t kAssetCompressed      = 1;       // AssetEntry::flags
+const uint32_t kAssetNoBlock         = 0xFFFFFFFFu;
+
+struct AssetArchiveHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t blockCount;
+    uint32_t blockSize;         // uncompressed bytes per block
+    uint32_t namesOffset;
+    uint32_t namesSize;
+};
+
+struct AssetEntry {
+    uint32_t nameOffset;        // into the path bytes
+    uint32_t nameLength;
+    uint32_t size;              // uncompressed
+    uint32_t flags;
+    uint32_t dataOffset;        // stored entries: the bytes
+    uint32_t firstBlock;        // compressed entries: index into the block table
+};
+
+struct AssetBlock {
+    uint32_t offset;
+    uint32_t storedSize;        // equal to the block's length when kept raw
+};
+
+// The decoded block a partial read of a compressed entry last needed.
+struct AssetReadCache {
+    std::vector<uint8_t> data;
+    uint32_t             block = kAssetNoBlock;
+};
+
+// Normalise `length` bytes of `path` into `out` (room for `length`
+// bytes) and return the normalised length: ASCII upper-cased, '/' read
+// as '\', runs of separators collapsed and a leading ".\" dropped.  The
+// second byte of a CP949 pair is copied as is, since it may fall in
+// the ASCII letter range.
+size_t NormaliseAssetPath(const char* path, size_t length, char* out);
+
+class AssetArchive {
+public:
+    // Parse an archive held in `data` (normally a read-only mapping of
+    // the file, which must outlive the object).  Returns false unless
+    // the header, the tables and every entry's data lie within `size`
+    // bytes and the entries are sorted.
+    bool Open(const uint8_t* data, size_t size);
+
+    uint32_t EntryCount() const { return m_header ? m_header->entryCount : 0; }
+    const AssetEntry& Entry(uint32_t index) const { return m_entries[index]; }
+    const char* Name(const AssetEntry& entry) const {
+        return reinterpret_cast<const char*>(m_names + entry.nameOffset);
+    }
+
+    // The entry for the normalised relative `path`, or nullptr.
+    const AssetEntry* Find(const char* path, size_t length) const;
+
+    // Copy up to `count` bytes of `entry` from `offset` into `dst` and
+    // return how many were copied: fewer at the end of the entry, and
+    // zero past it or if a block fails to decompress.
+    size_t Read(const AssetEntry& entry, uint64_t offset, void* dst, size_t count, AssetReadCache* cache) const;
+
+private:
+    const uint8_t*            m_data = nullptr;
+    const AssetArchiveHeader* m_header = nullptr;
+    const AssetEntry*         m_entries = nullptr;
+    const AssetBlock*         m_blocks = nullptr;
+    const uint8_t*            m_names = nullptr;
+};
@@ -0,0 +1,144 @@
+// Copyright (c) 2025
+//
+// Call-site patching.  See call_site_patcher.h.
+
+#include "call_site_patcher.h"
+#include <windows.h>
+#include <intrin.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../third_party/minhook/src/hde/hde32.h"
+
+namespace {
+    const int kBenchCalls = 1 << 20;
+    const int kBenchRuns  = 5;          // best of
+
+    bool FindText(uintptr_t* begin, uintptr_t* end) {
+        const BYTE* base = reinterpret_cast<const BYTE*>(GetModuleHandleA(nullptr));
+        PIMAGE_NT_HEADERS nt = reinterpret_cast<PIMAGE_NT_HEADERS>(
+            const_cast<BYTE*>(base) + reinterpret_cast<const IMAGE_DOS_HEADER*>(base)->e_lfanew);
+        PIMAGE_SECTION_HEADER sec = IMAGE_FIRST_SECTION(nt);
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++sec) {
+            if (sec->Characteristics & IMAGE_SCN_MEM_EXECUTE) {
+                *begin = reinterpret_cast<uintptr_t>(base) + sec->VirtualAddress;
+                *end   = *begin + sec->Misc.VirtualSize;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct Site {
+        uintptr_t address;      // of the E8 opcode
+        size_t    row;
+    };
+
+    // Linear sweep of [begin, end).  MSVC pads between functions with
+    // NOP/INT3 and the sweep resynchronises within a few bytes after
+    // the jump tables it places in .text, so every call the game makes
+    // directly is found.  Undecodable bytes are stepped over one at a
+    // time.
+    void CollectSites(uintptr_t begin, uintptr_t end, const CallSiteRedirect* table, size_t count,
+                      std::vector<Site>* sites, std::vector<size_t>* inside) {
+        uintptr_t pc = begin;
+        while (pc + 5 <= end) {
+            hde32s hs;
+            unsigned int len = hde32_disasm(reinterpret_cast<const void*>(pc), &hs);
+            if (hs.flags & F_ERROR || len == 0) {
+                ++pc;
+                continue;
+            }
+            if (hs.opcode == 0xE8 && len == 5) {
+                uintptr_t target = pc + 5 + static_cast<int32_t>(hs.imm.imm32);
+                for (size_t i = 0; i < count; ++i) {
+                    if (table[i].target != target) {
+                        continue;
+                    }
+                    bool inBody = false;
+                    for (size_t j = 0; j < count; ++j) {
+                        if (pc >= table[j].target && pc < table[j].target + table[j].length) {
+                            inBody = true;
+                        }
+                    }
+                    if (inBody) {
+                        ++(*inside)[i];
+                    } else {
+                        sites->push_back(Site{ pc, i });
+                    }
+                    break;
+                }
+            }
+            pc += len;
+        }
+    }
+
+    using LookupFn = int16_t(__cdecl*)(int32_t);
+
+    // Best-of-kBenchRuns cycles per call of `fn`.  The pointer is
+    // volatile so the compiler cannot inline or hoist the call.
+    double CyclesPerCall(LookupFn fn) {
+        LookupFn volatile call = fn;
+        uint64_t best = ~0ULL;
+        int sink = 0;
+        for (int run = 0; run < kBenchRuns; ++run) {
+            uint64_t start = __rdtsc();
+            for (int i = 0; i < kBenchCalls; ++i) {
+                sink += call(i);
+            }
+            uint64_t cycles = __rdtsc() - start;
+            if (cycles < best) {
+                best = cycles;
+            }
+        }
+        static volatile int s_sink;
+        s_sink = sink;
+        return static_cast<double>(best) / kBenchCalls;
+    }
+}
+
+size_t RedirectCallSites(const CallSiteRedirect* table, size_t count) {
+    uintptr_t begin, end;
+    if (!FindText(&begin, &end)) {
+        OutputDebugStringA("[CallSites] no executable section\n");
+        return 0;
+    }
+    std::vector<Site>   sites;
+    std::vector<size_t> inside(count, 0);
+    CollectSites(begin, end, table, count, &sites, &inside);
+
+    std::vector<size_t> patched(count, 0);
+    DWORD old;
+    if (!VirtualProtect(reinterpret_cast<void*>(begin), end - begin, PAGE_EXECUTE_READWRITE, &old)) {
+        OutputDebugStringA("[CallSites] cannot unprotect .text\n");
+        return 0;
+    }
+    for (const Site& site : sites) {
+        int32_t rel = static_cast<int32_t>(reinterpret_cast<uintptr_t>(table[site.row].replacement) -
+                                           (site.address + 5));
+        std::memcpy(reinterpret_cast<void*>(site.address + 1), &rel, sizeof(rel));
+        ++patched[site.row];
+    }
+    VirtualProtect(reinterpret_cast<void*>(begin), end - begin, old, &old);
+    FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<void*>(begin), end - begin);
+
+    char buf[160];
+    for (size_t i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "[CallSites] %s (%08X): %u call sites redirected, %u left in redirected bodies\n",
+                      table[i].name, static_cast<unsigned>(table[i].target),
+                      static_cast<unsigned>(patched[i]), static_cast<unsigned>(inside[i]));
+        OutputDebugStringA(buf);
+    }
+    return sites.size();
+}
+
+void BenchmarkCallSites(const CallSiteRedirect* table, size_t count) {
+    char buf[160];
+    for (size_t i = 0; i < count; ++i) {
+        double hooked = CyclesPerCall(reinterpret_cast<LookupFn>(table[i].target));
+        double direct = CyclesPerCall(reinterpret_cast<LookupFn>(table[i].replacement));
+        std::snprintf(buf, sizeof(buf), "[CallSites] %s: %.1f cycles/call via detour, %.1f direct (%.1fx)\n",
+                      table[i].name, hooked, direct, direct > 0.0 ? hooked / direct : 0.0);
+        OutputDebugStringA(buf);
+    }
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2025
+//
+// Call-site patching for tiny hot functions.  A MinHook detour costs
+// every call a jump into the detour, the detour's own frame and a call
+// into the replacement: for the four-instruction sine lookups at
+// 0x401000-0x401050, which the game calls in tight loops, that is
+// several times the work of the lookup itself.
+//
+// RedirectCallSites decodes digi.exe's .text from start to end (with
+// MinHook's instruction length decoder, so bytes inside other
+// instructions are not mistaken for calls) and rewrites the rel32 of
+// every `call target` in a row to call the replacement directly.  The
+// MinHook detours stay installed as the fallback for anything that
+// still reaches the original entry: calls through a pointer, calls
+// from code that was not decoded, and the trampolines themselves.
+// Call sites inside a redirected function's own body are left alone so
+// the trampolines keep running the original code.
+//
+// Patching writes four bytes per site without suspending anything, so
+// it must run before the game executes any code, i.e. from
+// InstallHooks.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct CallSiteRedirect {
+    // Name used in reports; matches the row in kGameHooks.
+    const char* name;
+    // Original function and the size of its body in bytes.
+    uintptr_t   target;
+    uint32_t    length;
+    // Function the call sites are pointed at.  It must accept the
+    // same arguments in the same convention as the original.
+    void*       replacement;
+};
+
+// Patch every direct call site of every row.  Returns the number of
+// sites patched and logs per-row counts.
+size_t RedirectCallSites(const CallSiteRedirect* table, size_t count);
+
+template <size_t N>
+size_t RedirectCallSites(const CallSiteRedirect (&table)[N]) {
+    return RedirectCallSites(table, N);
+}
+
+// Time each row through its original entry (the MinHook detour path an
+// unpatched call takes) against a direct call to the replacement, and
+// log cycles per call for both.  Rows are called as
+// `int16_t __cdecl f(int32_t)`, the shape of the sine lookups; run
+// only after the hooks have been applied.
+void BenchmarkCallSites(const CallSiteRedirect* table, size_t count);
+
+template <size_t N>
+void BenchmarkCallSites(const CallSiteRedirect (&table)[N]) {
+    BenchmarkCallSites(table, N);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2025
+//
+// CP949 decoder.  See cp949.h.
+
+#include "cp949.h"
+#include <emmintrin.h>
+
+// The SSE2 path stores 16-bit lanes straight into the output.
+static_assert(sizeof(wchar_t) == 2, "DecodeCp949 writes UTF-16 code units");
+
+namespace {
+    const wchar_t kReplacement = L'?';
+
+    inline bool IsLead(unsigned char c) {
+        return c >= 0x81 && c <= 0xFE;
+    }
+
+    inline bool IsTrail(unsigned char c) {
+        return c >= kCp949TrailFirst && c <= 0xFE;
+    }
+
+    // Index of the lowest set bit; `mask` is non-zero.
+    inline int LowestBit(unsigned mask) {
+        int n = 0;
+        while (!(mask & 1u)) {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    }
+
+    // Decode the non-ASCII character at src[*i].
+    inline wchar_t DecodeHigh(const unsigned char* src, int count, int* i) {
+        unsigned char lead = src[*i];
+        if (IsLead(lead) && *i + 1 < count && IsTrail(src[*i + 1])) {
+            uint16_t u = g_cp949Table[(lead - kCp949LeadFirst) * kCp949TrailCount +
+                                      (src[*i + 1] - kCp949TrailFirst)];
+            *i += 2;
+            return u ? static_cast<wchar_t>(u) : kReplacement;
+        }
+        *i += 1;
+        return kReplacement;
+    }
+}
+
+int DecodeCp949(const char* text, int count, wchar_t* dst) {
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(text);
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    int out = 0;
+    while (i < count) {
+        if (i + 16 <= count) {
+            // Widen sixteen bytes at once.  If some of them are not
+            // ASCII, only the ASCII prefix is kept (out never passes i,
+            // so the full 16-unit store stays inside `dst`).
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + out),     _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + out + 8), _mm_unpackhi_epi8(v, zero));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(v));
+            if (mask == 0) {
+                i += 16;
+                out += 16;
+                continue;
+            }
+            int ascii = LowestBit(mask);
+            i += ascii;
+            out += ascii;
+            dst[out++] = DecodeHigh(src, count, &i);
+            continue;
+        }
+        unsigned char c = src[i];
+        if (c < 0x80) {
+            dst[out++] = static_cast<wchar_t>(c);
+            ++i;
+        } else {
+            dst[out++] = DecodeHigh(src, count, &i);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,29 @@
+// Copyright (c) 2025
+//
+// Table-driven CP949 (Unified Hangul Code, a superset of EUC-KR) to
+// UTF-16 decoder.  The game's ANSI text is CP949; decoding it here
+// rather than through MultiByteToWideChar keeps the text path free of
+// kernel32 calls and lets ANSI strings share the wide glyph cache.
+//
+// Bytes 0x00-0x7F map to themselves.  A lead byte 0x81-0xFE followed
+// by a trail byte 0x41-0xFE is looked up in g_cp949Table.  Anything
+// CP949 does not define decodes to '?', as MultiByteToWideChar does.
+
+#pragma once
+
+#include <cstdint>
+
+const int kCp949LeadFirst  = 0x81;
+const int kCp949LeadCount  = 0xFE - 0x81 + 1;
+const int kCp949TrailFirst = 0x41;
+const int kCp949TrailCount = 0xFE - 0x41 + 1;
+
+// Generated by tools/gen_cp949_table.py.  Index with
+// (lead - kCp949LeadFirst) * kCp949TrailCount + (trail - kCp949TrailFirst);
+// zero marks an undefined pair.
+extern const uint16_t g_cp949Table[kCp949LeadCount * kCp949TrailCount];
+
+// Decode `count` bytes into `dst` and return the number of UTF-16
+// units written.  The output is never longer than the input, so `dst`
+// must have room for `count` units.
+int DecodeCp949(const char* src, int count, wchar_t* dst);
@@ -0,0 +1,69 @@
+// Copyright (c) 2025
+//
+// Run-time instruction set checks for the vectorised paths in
+// sin_table.cpp and tim_image.cpp.  Those paths are compiled with
+// per-function target attributes on GCC and Clang (DIGI_TARGET_*, which
+// expand to nothing on MSVC, where intrinsics need no flags), so the
+// files build without special options and a path must only be entered
+// once the matching CpuHas* check has passed.
+//
+// DIGI_X86 is defined to 1 on 32- and 64-bit x86; the checks and
+// target macros exist only there.
+
+#pragma once
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define DIGI_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DIGI_TARGET_SSE2
+#define DIGI_TARGET_SSSE3
+#define DIGI_TARGET_AVX2
+#else
+#define DIGI_TARGET_SSE2  __attribute__((target("sse2")))
+#define DIGI_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define DIGI_TARGET_AVX2  __attribute__((target("avx2")))
+#endif
+
+inline bool CpuHasSse2() {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    return (regs[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+inline bool CpuHasSsse3() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    return (regs[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+inline bool CpuHasAvx2() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) {
+        return false;
+    }
+    // The OS must save the YMM registers (OSXSAVE and XCR0 bits 1-2).
+    __cpuid(regs, 1);
+    if ((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
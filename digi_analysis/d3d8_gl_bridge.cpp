@@ -1,5 +1,6 @@
 #include "d3d8_gl_bridge.h"
 #include "opengl_utils.h"
+#include "text_renderer.h"
 #include <cstring>
 
 // Helper functions for primitive conversion
@@ -32,7 +33,7 @@ static size_t IndexCountFromPrim(UINT primType, UINT primCount) {
 // ---------------------------------------------------------------------------
 IDirect3DTexture8::IDirect3DTexture8(UINT width, UINT height)
     : m_refCount(1), m_width(width), m_height(height), m_pixels(width* height * 4, 0),
-    m_glTex(0), m_uploaded(false) {
+    m_glTex(0), m_uploaded(false), m_linear(false) {
 }
 
 IDirect3DTexture8::~IDirect3DTexture8() {
@@ -69,8 +70,9 @@ void IDirect3DTexture8::Upload() {
     }
     glBindTexture(GL_TEXTURE_2D, m_glTex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_pixels.data());
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    GLint filter = m_linear ? GL_LINEAR : GL_NEAREST;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
     m_uploaded = true;
 }
 
@@ -225,6 +227,10 @@ HRESULT IDirect3DDevice8::Present(const RECT* pSourceRect, const RECT* pDestRect
         OutputDebugStringA("Present called - PresentFrame crashed\n");
     }
 
+    // Give the text renderer a fresh glyph rasterisation budget for
+    // the next frame.
+    TextRenderer::BeginFrame();
+
     OutputDebugStringA("Present called - returning S_OK\n");
     return S_OK;
 }
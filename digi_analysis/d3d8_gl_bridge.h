@@ -38,6 +38,10 @@ public:
     // RGBA data.
     void UpdateData(const void* src, unsigned int size);
 
+    // Sample with bilinear filtering instead of the default nearest.
+    // Distance field glyphs need this to stay smooth when scaled.
+    void SetLinearFilter(bool linear) { m_linear = linear; m_uploaded = false; }
+
     // Called on the render thread to create the GL texture if needed.
     void Upload();
     GLuint GetGLTexture() const { return m_glTex; }
@@ -49,6 +53,7 @@ private:
     std::vector<unsigned char> m_pixels;
     GLuint             m_glTex;
     bool               m_uploaded;
+    bool               m_linear;
 };
 
 // ---------------------------------------------------------------------------
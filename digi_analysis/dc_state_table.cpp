@@ -0,0 +1,148 @@
+// Copyright (c) 2025
+//
+// Implementation of the concurrent DC state table.  See
+// dc_state_table.h.
+
+#include "dc_state_table.h"
+#include <cstdint>
+
+namespace {
+    // Key markers.  Real HDCs are never this small.  A slot whose key is
+    // kEmpty ends every probe chain; kDeleted keeps the chain intact
+    // after a removal; kBusy is held while an insert fills in the fields.
+    const HDC kEmpty   = reinterpret_cast<HDC>(0);
+    const HDC kDeleted = reinterpret_cast<HDC>(1);
+    const HDC kBusy    = reinterpret_cast<HDC>(2);
+}
+
+DCStateTable::DCStateTable() {
+    for (Slot& s : m_slots) {
+        s.key.store(kEmpty, std::memory_order_relaxed);
+        s.font.store(nullptr, std::memory_order_relaxed);
+        s.textColor.store(0, std::memory_order_relaxed);
+        s.bkColor.store(0, std::memory_order_relaxed);
+        s.bkMode.store(0, std::memory_order_relaxed);
+    }
+}
+
+// GDI handles carry a type tag in the high bits and are spaced by
+// small multiples; a multiplicative hash spreads them over the table.
+size_t DCStateTable::Home(HDC hdc) {
+    uint32_t h = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(hdc));
+    h *= 0x9E3779B1u;
+    return static_cast<size_t>(h >> (32 - kCapacityBits));
+}
+
+DCStateTable::Slot* DCStateTable::Find(HDC hdc) const {
+    if (hdc == kEmpty || hdc == kDeleted || hdc == kBusy) {
+        return nullptr;
+    }
+    size_t i = Home(hdc);
+    for (size_t n = 0; n < kCapacity; ++n) {
+        HDC key = m_slots[i].key.load(std::memory_order_acquire);
+        if (key == hdc) {
+            return &m_slots[i];
+        }
+        if (key == kEmpty) {
+            return nullptr;
+        }
+        i = (i + 1) & (kCapacity - 1);
+    }
+    return nullptr;
+}
+
+bool DCStateTable::Insert(const DCState& state) {
+    Slot* existing = Find(state.hdc);
+    if (existing) {
+        // A handle recycled without going through our DeleteDC.
+        existing->font.store(state.font, std::memory_order_relaxed);
+        existing->textColor.store(state.textColor, std::memory_order_relaxed);
+        existing->bkColor.store(state.bkColor, std::memory_order_relaxed);
+        existing->bkMode.store(state.bkMode, std::memory_order_relaxed);
+        return true;
+    }
+    size_t i = Home(state.hdc);
+    for (size_t n = 0; n < kCapacity; ++n) {
+        Slot& s = m_slots[i];
+        HDC key = s.key.load(std::memory_order_relaxed);
+        if ((key == kEmpty || key == kDeleted) &&
+            s.key.compare_exchange_strong(key, kBusy, std::memory_order_acquire)) {
+            s.font.store(state.font, std::memory_order_relaxed);
+            s.textColor.store(state.textColor, std::memory_order_relaxed);
+            s.bkColor.store(state.bkColor, std::memory_order_relaxed);
+            s.bkMode.store(state.bkMode, std::memory_order_relaxed);
+            // Publish: readers that see the key also see the fields.
+            s.key.store(state.hdc, std::memory_order_release);
+            return true;
+        }
+        i = (i + 1) & (kCapacity - 1);
+    }
+    return false;
+}
+
+bool DCStateTable::Remove(HDC hdc) {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    HDC expected = hdc;
+    return s->key.compare_exchange_strong(expected, kDeleted, std::memory_order_release);
+}
+
+bool DCStateTable::Get(HDC hdc, DCState* out) const {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    out->hdc       = hdc;
+    out->font      = s->font.load(std::memory_order_relaxed);
+    out->textColor = s->textColor.load(std::memory_order_relaxed);
+    out->bkColor   = s->bkColor.load(std::memory_order_relaxed);
+    out->bkMode    = s->bkMode.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool DCStateTable::GetFont(HDC hdc, HFONT* font) const {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    *font = s->font.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool DCStateTable::ExchangeFont(HDC hdc, HFONT font, HFONT* prev) {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    *prev = s->font.exchange(font, std::memory_order_relaxed);
+    return true;
+}
+
+bool DCStateTable::ExchangeTextColor(HDC hdc, COLORREF color, COLORREF* prev) {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    *prev = s->textColor.exchange(color, std::memory_order_relaxed);
+    return true;
+}
+
+bool DCStateTable::ExchangeBkColor(HDC hdc, COLORREF color, COLORREF* prev) {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    *prev = s->bkColor.exchange(color, std::memory_order_relaxed);
+    return true;
+}
+
+bool DCStateTable::ExchangeBkMode(HDC hdc, int mode, int* prev) {
+    Slot* s = Find(hdc);
+    if (!s) {
+        return false;
+    }
+    *prev = s->bkMode.exchange(mode, std::memory_order_relaxed);
+    return true;
+}
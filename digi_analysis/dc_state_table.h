@@ -0,0 +1,70 @@
+// Copyright (c) 2025
+//
+// Concurrent table of the GDI state we track per memory DC.  The GDI
+// detours consult it on every SelectObject/SetTextColor/SetBkColor/
+// SetBkMode/TextOutA call, from whichever thread the game or a driver
+// makes them on, so lookups must be cheap and must not corrupt state
+// under concurrency.
+//
+// The table is a fixed array of slots with open addressing (linear
+// probing).  Each slot's key and fields are individual atomics: reads
+// never lock, inserts claim a slot with a compare-and-swap, and field
+// updates are atomic exchanges so the previous value returned to the
+// caller is always the one actually replaced.  The game keeps only a
+// handful of DCs alive, so the capacity is fixed; DCs that do not fit
+// are simply left untracked and handled by GDI as before.
+
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include <cstddef>
+
+// Snapshot of a tracked DC.
+struct DCState {
+    HDC      hdc;
+    HFONT    font;
+    COLORREF textColor;
+    COLORREF bkColor;
+    int      bkMode;
+};
+
+class DCStateTable {
+public:
+    DCStateTable();
+
+    // Start tracking `state.hdc`, replacing any stale entry for the same
+    // handle.  Returns false if the table is full.
+    bool Insert(const DCState& state);
+
+    // Stop tracking `hdc`.  Returns false if it was not tracked.
+    bool Remove(HDC hdc);
+
+    bool Contains(HDC hdc) const { return Find(hdc) != nullptr; }
+    bool Get(HDC hdc, DCState* out) const;
+    bool GetFont(HDC hdc, HFONT* font) const;
+
+    // Replace one field and return the previous value through `prev`.
+    // All return false, leaving `prev` untouched, for untracked DCs.
+    bool ExchangeFont(HDC hdc, HFONT font, HFONT* prev);
+    bool ExchangeTextColor(HDC hdc, COLORREF color, COLORREF* prev);
+    bool ExchangeBkColor(HDC hdc, COLORREF color, COLORREF* prev);
+    bool ExchangeBkMode(HDC hdc, int mode, int* prev);
+
+private:
+    static const unsigned kCapacityBits = 6;
+    static const size_t   kCapacity     = size_t(1) << kCapacityBits;
+
+    struct Slot {
+        std::atomic<HDC>      key;
+        std::atomic<HFONT>    font;
+        std::atomic<COLORREF> textColor;
+        std::atomic<COLORREF> bkColor;
+        std::atomic<int>      bkMode;
+    };
+
+    static size_t Home(HDC hdc);
+    Slot* Find(HDC hdc) const;
+
+    mutable Slot m_slots[kCapacity];
+};
@@ -1,16 +1,20 @@
 // Copyright (c) 2025
 //
-// Declaration of the 4 KiB lookup table extracted from the original
-// digi.exe.  The definitions live in digi_table.cpp and contain
-// 4096 16‑bit signed integers.
+// The 4096-entry sine table extracted from the original digi.exe
+// (0x4B0200).  Entry i is 4096 * sin(2 * pi * i / 4096); a quarter
+// turn is 0x400 entries, which is why 0x401020 adds 0x400 to get a
+// cosine.  The values are generated into digi_table.inc by
+// tools/gen_sin_table.py.
 
 #pragma once
 
 #include <cstdint>
 
-// A 4096‑element table of 16‑bit values.  Each entry corresponds to
-// precomputed sine values used by several routines early in the
-// Digimon World PC port.  In this sample project the table is
-// initialised to zeros to keep the repository lightweight.  Replace
-// this definition with the full dataset for accurate behaviour.
-extern const int16_t g_table[4096];
\ No newline at end of file
+// Compile-time copy for the portable lookups in sin_table.h.
+constexpr int16_t kSinTable[4096] = {
+#include "digi_table.inc"
+};
+
+// Single addressable copy, referenced by symbol from the inline
+// assembly in functions.cpp.  Defined in digi_table.cpp.
+extern const int16_t g_table[4096];
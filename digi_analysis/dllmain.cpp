@@ -10,6 +10,11 @@
 #include <cstring>
 #include "opengl_utils.h"
 #include "d3d8_gl_bridge.h"
+#include "function_tracer.h"
+#include "import_profiler.h"
+#include "sampling_profiler.h"
+#include "glyph_cache.h"
+#include "glyph_rasterizer.h"
 
 // Apply an in‑memory patch to bypass the CD check.  The patch data
 // and offsets were extracted from the original project.  On success
@@ -45,10 +50,12 @@ void InstallHooks();
 
 // Exported Direct3DCreate8 replacement.  This function is exported from
 // our DLL under both the decorated and undecorated names via the linker
-// directive above.  It simply allocates the bridge object and returns it
-// to the caller.
+// directive above.  It allocates the bridge object and returns it to
+// the caller.  The first call is also the earliest point outside the
+// loader lock, so the deferred hook work runs here.
 extern "C" __declspec(dllexport) IDirect3D8* WINAPI Direct3DCreate8(UINT /*sdkVersion*/) {
     OutputDebugStringA("Direct3DCreate8 called - OpenGL backend active\n");
+    RunDeferredHookWork();
     return new IDirect3D8();
 }
 
@@ -74,6 +81,11 @@ BOOL APIENTRY DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpReserved) {
     case DLL_PROCESS_DETACH:
         MH_DisableHook(MH_ALL_HOOKS);
         MH_Uninitialize();
+        StopSamplingProfiler();
+        StopImportProfiler();
+        StopFunctionTracer();
+        ShutdownGlyphRasterizer();
+        ShutdownGlyphCache();
         ShutdownOpenGL();
         break;
     }
@@ -0,0 +1,429 @@
+// Copyright (c) 2025
+//
+// Hook implementations for the Win32 file functions, serving the
+// game's asset reads out of the asset archive (see asset_archive.h and
+// tools/digi_pack).  digi.exe imports none of these itself: its assets
+// are read through MSVCRT fopen/fseek/fread and MFC42's CFile, both of
+// which end in CreateFileA, SetFilePointer and ReadFile.  Hooking the
+// exports rather than the game's import table therefore catches every
+// path into the file system, including the runtime's own.
+//
+// On Windows 7 and later the functions live in KernelBase.dll.  The
+// KERNEL32 exports are stubs that jump there, and the system MSVCRT
+// imports them through the api-ms-win-core-file API sets, which bind
+// to KernelBase directly and would never pass a detour on KERNEL32.
+// The hooks therefore go on KernelBase when it is loaded, which
+// catches both routes, and on KERNEL32 only on systems without it.
+//
+// The archive is mapped once when the hooks are installed.  An open of
+// a file the archive holds, for reading only, returns a pseudo-handle
+// from a small table instead of a kernel handle; reads on it are a copy
+// out of the mapping, or an LZ4 decompress into the caller's buffer,
+// and seeks only move the table's position.  No asset costs an open, a
+// seek or a read call into the kernel.  Everything else (writes, saves,
+// files the archive lacks, handles that are not ours) passes through to
+// the original functions.
+//
+// The archive is digi.pak next to digi.exe, or the file DIGI_ARCHIVE
+// names.  Without one no hooks are installed.  Only the calls the
+// runtime makes on a read-only file are served: GetFileTime,
+// GetFileInformationByHandle and the like fail on a pseudo-handle.
+// The archive speeds up reads and does not replace the loose files:
+// attribute queries, FindFirstFile and _stat still go to the file
+// system, so the files must stay where they are.
+
+#include <windows.h>
+#include <cstdio>
+#include <cstring>
+
+#include "asset_archive.h"
+#include "hook_registry.h"
+
+typedef HANDLE (WINAPI* PFN_CreateFileA)(LPCSTR, DWORD, DWORD, LPSECURITY_ATTRIBUTES, DWORD, DWORD, HANDLE);
+typedef HANDLE (WINAPI* PFN_CreateFileW)(LPCWSTR, DWORD, DWORD, LPSECURITY_ATTRIBUTES, DWORD, DWORD, HANDLE);
+typedef BOOL   (WINAPI* PFN_ReadFile)(HANDLE, LPVOID, DWORD, LPDWORD, LPOVERLAPPED);
+typedef DWORD  (WINAPI* PFN_SetFilePointer)(HANDLE, LONG, PLONG, DWORD);
+typedef BOOL   (WINAPI* PFN_SetFilePointerEx)(HANDLE, LARGE_INTEGER, PLARGE_INTEGER, DWORD);
+typedef DWORD  (WINAPI* PFN_GetFileSize)(HANDLE, LPDWORD);
+typedef BOOL   (WINAPI* PFN_GetFileSizeEx)(HANDLE, PLARGE_INTEGER);
+typedef DWORD  (WINAPI* PFN_GetFileType)(HANDLE);
+typedef BOOL   (WINAPI* PFN_CloseHandle)(HANDLE);
+
+// Static storage for the original function pointers.  These are
+// initialised in InstallFileHooks().
+static PFN_CreateFileA        orig_CreateFileA        = nullptr;
+static PFN_CreateFileW        orig_CreateFileW        = nullptr;
+static PFN_ReadFile           orig_ReadFile           = nullptr;
+static PFN_SetFilePointer     orig_SetFilePointer     = nullptr;
+static PFN_SetFilePointerEx   orig_SetFilePointerEx   = nullptr;
+static PFN_GetFileSize        orig_GetFileSize        = nullptr;
+static PFN_GetFileSizeEx      orig_GetFileSizeEx      = nullptr;
+static PFN_GetFileType        orig_GetFileType        = nullptr;
+static PFN_CloseHandle        orig_CloseHandle        = nullptr;
+
+// Pseudo-handles are kAssetHandleBase + slot * 4: multiples of four,
+// like kernel handles, in a range far above any the process will see
+// and well clear of INVALID_HANDLE_VALUE and the pseudo-handles
+// GetCurrentProcess and GetCurrentThread return.
+static const uintptr_t kAssetHandleBase = 0x7FF00000;
+static const size_t    kMaxOpenAssets   = 256;
+
+// One open asset.  `lock` serialises reads and seeks on the handle,
+// as the kernel does for a synchronous file object.
+struct OpenAsset {
+    const AssetEntry* entry;
+    uint64_t          position;
+    AssetReadCache    cache;
+    CRITICAL_SECTION  lock;
+};
+
+static AssetArchive     g_archive;
+static OpenAsset        g_assets[kMaxOpenAssets];
+static CRITICAL_SECTION g_assetsLock;          // guards `entry` across open and close
+static char             g_root[MAX_PATH];      // normalised game directory, with a trailing '\'
+static size_t           g_rootLength = 0;
+
+static OpenAsset* AssetFromHandle(HANDLE h) {
+    uintptr_t value = reinterpret_cast<uintptr_t>(h);
+    if (value < kAssetHandleBase || (value & 3) != 0) {
+        return nullptr;
+    }
+    size_t slot = (value - kAssetHandleBase) / 4;
+    if (slot >= kMaxOpenAssets || !g_assets[slot].entry) {
+        return nullptr;
+    }
+    return &g_assets[slot];
+}
+
+// The archive entry for `path`, or nullptr if it lies outside the game
+// directory or the archive lacks it.
+static const AssetEntry* FindAsset(LPCSTR path) {
+    if (!path) {
+        return nullptr;
+    }
+    char full[MAX_PATH];
+    DWORD length = GetFullPathNameA(path, MAX_PATH, full, nullptr);
+    if (length == 0 || length >= MAX_PATH) {
+        return nullptr;
+    }
+    char normalised[MAX_PATH];
+    size_t n = NormaliseAssetPath(full, length, normalised);
+    if (n <= g_rootLength || std::memcmp(normalised, g_root, g_rootLength) != 0) {
+        return nullptr;
+    }
+    return g_archive.Find(normalised + g_rootLength, n - g_rootLength);
+}
+
+// Reading, not writing, and not creating a file that may be missing.
+static bool IsReadOnlyOpen(DWORD access, DWORD disposition, DWORD flags) {
+    const DWORD writeAccess = GENERIC_WRITE | GENERIC_ALL | FILE_WRITE_DATA | FILE_APPEND_DATA |
+                              FILE_WRITE_ATTRIBUTES | FILE_WRITE_EA | DELETE | WRITE_DAC | WRITE_OWNER;
+    if (access & writeAccess) {
+        return false;
+    }
+    if (flags & FILE_FLAG_DELETE_ON_CLOSE) {
+        return false;
+    }
+    return disposition == OPEN_EXISTING || disposition == OPEN_ALWAYS;
+}
+
+// A pseudo-handle for `entry`, or INVALID_HANDLE_VALUE if every slot
+// is taken.
+static HANDLE OpenAssetHandle(const AssetEntry* entry) {
+    EnterCriticalSection(&g_assetsLock);
+    for (size_t slot = 0; slot < kMaxOpenAssets; ++slot) {
+        OpenAsset& asset = g_assets[slot];
+        if (!asset.entry) {
+            asset.position    = 0;
+            asset.cache.block = kAssetNoBlock;
+            asset.entry       = entry;
+            LeaveCriticalSection(&g_assetsLock);
+            SetLastError(ERROR_SUCCESS);
+            return reinterpret_cast<HANDLE>(kAssetHandleBase + slot * 4);
+        }
+    }
+    LeaveCriticalSection(&g_assetsLock);
+    return INVALID_HANDLE_VALUE;
+}
+
+static HANDLE WINAPI Detour_CreateFileA(LPCSTR path, DWORD access, DWORD share, LPSECURITY_ATTRIBUTES sa,
+                                        DWORD disposition, DWORD flags, HANDLE templateFile) {
+    if (IsReadOnlyOpen(access, disposition, flags)) {
+        if (const AssetEntry* entry = FindAsset(path)) {
+            HANDLE h = OpenAssetHandle(entry);
+            if (h != INVALID_HANDLE_VALUE) {
+                return h;
+            }
+            OutputDebugStringA("[file hooks] open asset table full; opening the loose file\n");
+        }
+    }
+    return orig_CreateFileA(path, access, share, sa, disposition, flags, templateFile);
+}
+
+static HANDLE WINAPI Detour_CreateFileW(LPCWSTR path, DWORD access, DWORD share, LPSECURITY_ATTRIBUTES sa,
+                                        DWORD disposition, DWORD flags, HANDLE templateFile) {
+    if (path && IsReadOnlyOpen(access, disposition, flags)) {
+        // Archive paths are stored in the ANSI code page the game uses.
+        char narrow[MAX_PATH];
+        if (WideCharToMultiByte(CP_ACP, 0, path, -1, narrow, MAX_PATH, nullptr, nullptr) > 0) {
+            if (const AssetEntry* entry = FindAsset(narrow)) {
+                HANDLE h = OpenAssetHandle(entry);
+                if (h != INVALID_HANDLE_VALUE) {
+                    return h;
+                }
+            }
+        }
+    }
+    return orig_CreateFileW(path, access, share, sa, disposition, flags, templateFile);
+}
+
+static BOOL WINAPI Detour_ReadFile(HANDLE h, LPVOID buffer, DWORD count, LPDWORD read, LPOVERLAPPED overlapped) {
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_ReadFile(h, buffer, count, read, overlapped);
+    }
+    if (!buffer && count > 0) {
+        SetLastError(ERROR_INVALID_USER_BUFFER);
+        return FALSE;
+    }
+    EnterCriticalSection(&asset->lock);
+    // An OVERLAPPED read names its own offset and completes at once;
+    // it leaves the file position alone, as it would on a file opened
+    // for overlapped I/O.
+    uint64_t offset = overlapped ? (uint64_t(overlapped->OffsetHigh) << 32) | overlapped->Offset
+                                 : asset->position;
+    size_t n = g_archive.Read(*asset->entry, offset, buffer, count, &asset->cache);
+    if (!overlapped) {
+        asset->position += n;
+    }
+    bool failed = n == 0 && count > 0 && offset < asset->entry->size;
+    LeaveCriticalSection(&asset->lock);
+
+    if (failed) {
+        // Only a damaged archive gets here.
+        OutputDebugStringA("[file hooks] asset block failed to decompress\n");
+        SetLastError(ERROR_FILE_CORRUPT);
+        return FALSE;
+    }
+    if (read) {
+        *read = static_cast<DWORD>(n);
+    }
+    if (overlapped) {
+        overlapped->Internal     = 0;
+        overlapped->InternalHigh = n;
+        if (overlapped->hEvent) {
+            SetEvent(overlapped->hEvent);
+        }
+        if (n == 0 && count > 0) {
+            SetLastError(ERROR_HANDLE_EOF);
+            return FALSE;
+        }
+    }
+    // A synchronous read at the end of the file succeeds with nothing
+    // read, which is how the runtime detects the end.
+    return TRUE;
+}
+
+// Move `asset`'s position by `move` from `method`'s origin.  Returns
+// false, with the last error set, for a bad origin or a position
+// before the start.
+static bool SeekAsset(OpenAsset* asset, int64_t move, DWORD method, uint64_t* position) {
+    EnterCriticalSection(&asset->lock);
+    int64_t base = method == FILE_BEGIN   ? 0
+                 : method == FILE_CURRENT ? int64_t(asset->position)
+                 : method == FILE_END     ? int64_t(asset->entry->size)
+                 : -1;
+    if (base < 0) {
+        LeaveCriticalSection(&asset->lock);
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return false;
+    }
+    int64_t target = base + move;
+    if (target < 0) {
+        LeaveCriticalSection(&asset->lock);
+        SetLastError(ERROR_NEGATIVE_SEEK);
+        return false;
+    }
+    // Seeking past the end is allowed, as on a real file; reads there
+    // return nothing.
+    asset->position = uint64_t(target);
+    LeaveCriticalSection(&asset->lock);
+    *position = uint64_t(target);
+    return true;
+}
+
+static DWORD WINAPI Detour_SetFilePointer(HANDLE h, LONG distance, PLONG distanceHigh, DWORD method) {
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_SetFilePointer(h, distance, distanceHigh, method);
+    }
+    int64_t move = distanceHigh ? (int64_t(*distanceHigh) << 32) | uint32_t(distance) : int64_t(distance);
+    uint64_t target = 0;
+    if (!SeekAsset(asset, move, method, &target)) {
+        return INVALID_SET_FILE_POINTER;
+    }
+    if (distanceHigh) {
+        *distanceHigh = static_cast<LONG>(target >> 32);
+    }
+    SetLastError(ERROR_SUCCESS);
+    return static_cast<DWORD>(target);
+}
+
+static BOOL WINAPI Detour_SetFilePointerEx(HANDLE h, LARGE_INTEGER distance, PLARGE_INTEGER newPosition,
+                                           DWORD method) {
+    // The 64-bit seek of the newer runtimes' _lseeki64.
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_SetFilePointerEx(h, distance, newPosition, method);
+    }
+    uint64_t target = 0;
+    if (!SeekAsset(asset, distance.QuadPart, method, &target)) {
+        return FALSE;
+    }
+    if (newPosition) {
+        newPosition->QuadPart = static_cast<LONGLONG>(target);
+    }
+    return TRUE;
+}
+
+static DWORD WINAPI Detour_GetFileSize(HANDLE h, LPDWORD sizeHigh) {
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_GetFileSize(h, sizeHigh);
+    }
+    if (sizeHigh) {
+        *sizeHigh = 0;
+    }
+    SetLastError(ERROR_SUCCESS);
+    return asset->entry->size;
+}
+
+static BOOL WINAPI Detour_GetFileSizeEx(HANDLE h, PLARGE_INTEGER size) {
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_GetFileSizeEx(h, size);
+    }
+    size->QuadPart = asset->entry->size;
+    return TRUE;
+}
+
+static DWORD WINAPI Detour_GetFileType(HANDLE h) {
+    // MSVCRT's _open asks, to tell disk files from devices and pipes.
+    if (AssetFromHandle(h)) {
+        return FILE_TYPE_DISK;
+    }
+    return orig_GetFileType(h);
+}
+
+static BOOL WINAPI Detour_CloseHandle(HANDLE h) {
+    OpenAsset* asset = AssetFromHandle(h);
+    if (!asset) {
+        return orig_CloseHandle(h);
+    }
+    // Wait out any read still running on another thread before the
+    // slot is handed to the next open.
+    EnterCriticalSection(&asset->lock);
+    EnterCriticalSection(&g_assetsLock);
+    asset->entry = nullptr;
+    LeaveCriticalSection(&g_assetsLock);
+    LeaveCriticalSection(&asset->lock);
+    return TRUE;
+}
+
+// Rows name KERNEL32; InstallFileHooks points them at KernelBase where
+// it is loaded.
+static const HookSpec kFileHooks[] = {
+    { "CreateFileA", "KERNEL32.dll", "CreateFileA", 0,
+      reinterpret_cast<void*>(&Detour_CreateFileA), reinterpret_cast<void**>(&orig_CreateFileA) },
+    { "CreateFileW", "KERNEL32.dll", "CreateFileW", 0,
+      reinterpret_cast<void*>(&Detour_CreateFileW), reinterpret_cast<void**>(&orig_CreateFileW) },
+    { "ReadFile", "KERNEL32.dll", "ReadFile", 0,
+      reinterpret_cast<void*>(&Detour_ReadFile), reinterpret_cast<void**>(&orig_ReadFile) },
+    { "SetFilePointer", "KERNEL32.dll", "SetFilePointer", 0,
+      reinterpret_cast<void*>(&Detour_SetFilePointer), reinterpret_cast<void**>(&orig_SetFilePointer) },
+    { "SetFilePointerEx", "KERNEL32.dll", "SetFilePointerEx", 0,
+      reinterpret_cast<void*>(&Detour_SetFilePointerEx), reinterpret_cast<void**>(&orig_SetFilePointerEx) },
+    { "GetFileSize", "KERNEL32.dll", "GetFileSize", 0,
+      reinterpret_cast<void*>(&Detour_GetFileSize), reinterpret_cast<void**>(&orig_GetFileSize) },
+    { "GetFileSizeEx", "KERNEL32.dll", "GetFileSizeEx", 0,
+      reinterpret_cast<void*>(&Detour_GetFileSizeEx), reinterpret_cast<void**>(&orig_GetFileSizeEx) },
+    { "GetFileType", "KERNEL32.dll", "GetFileType", 0,
+      reinterpret_cast<void*>(&Detour_GetFileType), reinterpret_cast<void**>(&orig_GetFileType) },
+    { "CloseHandle", "KERNEL32.dll", "CloseHandle", 0,
+      reinterpret_cast<void*>(&Detour_CloseHandle), reinterpret_cast<void**>(&orig_CloseHandle) },
+};
+
+// Map the archive and remember the game directory.  Runs before the
+// hooks exist, so these calls go straight to the kernel.
+static bool MapArchive() {
+    char exe[MAX_PATH];
+    DWORD exeLength = GetModuleFileNameA(nullptr, exe, MAX_PATH);
+    if (exeLength == 0 || exeLength >= MAX_PATH) {
+        return false;
+    }
+    char* slash = std::strrchr(exe, '\\');
+    if (!slash) {
+        return false;
+    }
+    slash[1] = '\0';
+
+    char path[MAX_PATH];
+    DWORD pathLength = GetEnvironmentVariableA("DIGI_ARCHIVE", path, sizeof(path));
+    if (pathLength == 0 || pathLength >= sizeof(path)) {
+        std::snprintf(path, sizeof(path), "%sdigi.pak", exe);
+    }
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= 0xFFFFFFFF) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    // The mapping keeps the file open; the handles are not needed.
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        return false;
+    }
+    char message[MAX_PATH + 64];
+    if (!g_archive.Open(static_cast<const uint8_t*>(view), static_cast<size_t>(size.QuadPart))) {
+        std::snprintf(message, sizeof(message), "[file hooks] %s is not a valid asset archive\n", path);
+        OutputDebugStringA(message);
+        UnmapViewOfFile(view);
+        return false;
+    }
+    g_rootLength = NormaliseAssetPath(exe, std::strlen(exe), g_root);
+    std::snprintf(message, sizeof(message), "[file hooks] serving %u assets from %s\n",
+                  g_archive.EntryCount(), path);
+    OutputDebugStringA(message);
+    return true;
+}
+
+void InstallFileHooks() {
+    if (!MapArchive()) {
+        return;
+    }
+    InitializeCriticalSection(&g_assetsLock);
+    for (size_t slot = 0; slot < kMaxOpenAssets; ++slot) {
+        InitializeCriticalSection(&g_assets[slot].lock);
+    }
+
+    const bool kernelBase = GetModuleHandleA("KernelBase.dll") != nullptr;
+    const size_t count = sizeof(kFileHooks) / sizeof(kFileHooks[0]);
+    HookSpec table[count];
+    for (size_t i = 0; i < count; ++i) {
+        table[i] = kFileHooks[i];
+        if (kernelBase) {
+            table[i].module = "KernelBase.dll";
+        }
+    }
+    InstallHookTable(kernelBase ? "KernelBase" : "KERNEL32", table);
+}
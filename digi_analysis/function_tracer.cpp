@@ -0,0 +1,456 @@
+// Copyright (c) 2025
+//
+// Function-entry tracer.  See function_tracer.h.
+
+#include "function_tracer.h"
+#include <windows.h>
+#include <intrin.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace {
+    const uint32_t kMaxSites   = 1024;
+    const uint32_t kThunkSize  = 16;
+    const int      kMaxDepth   = 64;
+    const uint32_t kRingSize   = 1u << 14;      // events per thread
+    const int      kBuckets    = 40;            // log2(cycles)
+    const DWORD    kDrainEvery = 20;            // milliseconds
+    const int      kProbeCalls = 10000;         // < kRingSize
+
+    struct TraceSite {
+        const char* name;       // nullptr for the overhead probe
+        uintptr_t   address;
+        void*       detour;
+    };
+
+    struct SiteStats {
+        uint64_t calls;
+        uint64_t cycles;
+        uint64_t maxCycles;
+        uint64_t histogram[kBuckets];
+    };
+
+    struct Frame {
+        void**   slot;          // where the caller's return address lives
+        void*    returnAddress;
+        uint32_t site;
+        uint64_t start;
+    };
+
+    struct TraceEvent {
+        uint32_t site;
+        uint32_t pad;
+        uint64_t cycles;
+    };
+
+    // Per-thread state.  The owning thread writes frames and the ring
+    // head; the drain thread only reads the ring and writes the tail.
+    struct ThreadTrace {
+        Frame                 frames[kMaxDepth];
+        int                   depth;
+        std::atomic<uint32_t> head;
+        std::atomic<uint32_t> tail;
+        std::atomic<uint32_t> dropped;
+        TraceEvent            ring[kRingSize];
+    };
+
+    TraceSite             g_sites[kMaxSites];
+    std::atomic<uint32_t> g_siteCount{0};
+    unsigned char*        g_thunks = nullptr;
+    bool                  g_running = false;
+    char                  g_dumpPath[MAX_PATH];
+
+    std::mutex                g_threadsLock;
+    std::vector<ThreadTrace*> g_threads;
+
+    // Written by the drain thread (and by the final drain), read by the
+    // dump, all under g_statsLock.
+    std::mutex g_statsLock;
+    SiteStats  g_stats[kMaxSites];
+    uint64_t   g_droppedTotal = 0;
+
+    HANDLE            g_drainThread = nullptr;
+    std::atomic<bool> g_drainStop{false};
+
+    // Counter/clock pairs taken at start and stop to convert cycles.
+    uint64_t      g_startTsc = 0;
+    LARGE_INTEGER g_startQpc;
+    double        g_probeOverheadNs = 0.0;
+
+    thread_local ThreadTrace* t_trace = nullptr;
+
+    ThreadTrace* AttachThread() {
+        ThreadTrace* t = static_cast<ThreadTrace*>(
+            VirtualAlloc(nullptr, sizeof(ThreadTrace), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (!t) {
+            return nullptr;
+        }
+        // VirtualAlloc hands back zeroed pages, which is a valid initial
+        // state for every field including the atomics.
+        {
+            std::lock_guard<std::mutex> lock(g_threadsLock);
+            g_threads.push_back(t);
+        }
+        t_trace = t;
+        return t;
+    }
+
+    int Bucket(uint64_t cycles) {
+        int b = 0;
+        while (cycles > 1 && b < kBuckets - 1) {
+            cycles >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+    // Move every completed event into g_stats.  Caller holds g_statsLock.
+    void DrainLocked() {
+        std::lock_guard<std::mutex> lock(g_threadsLock);
+        for (ThreadTrace* t : g_threads) {
+            uint32_t tail = t->tail.load(std::memory_order_relaxed);
+            uint32_t head = t->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                const TraceEvent& e = t->ring[tail & (kRingSize - 1)];
+                SiteStats& s = g_stats[e.site];
+                ++s.calls;
+                s.cycles += e.cycles;
+                s.maxCycles = e.cycles > s.maxCycles ? e.cycles : s.maxCycles;
+                ++s.histogram[Bucket(e.cycles)];
+            }
+            t->tail.store(tail, std::memory_order_release);
+            g_droppedTotal += t->dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+
+    DWORD WINAPI DrainThread(LPVOID) {
+        while (!g_drainStop.load(std::memory_order_relaxed)) {
+            Sleep(kDrainEvery);
+            std::lock_guard<std::mutex> lock(g_statsLock);
+            DrainLocked();
+        }
+        return 0;
+    }
+
+    double CyclesPerNs() {
+        LARGE_INTEGER now, freq;
+        uint64_t tsc = __rdtsc();
+        QueryPerformanceCounter(&now);
+        QueryPerformanceFrequency(&freq);
+        double ns = static_cast<double>(now.QuadPart - g_startQpc.QuadPart) * 1e9 /
+                    static_cast<double>(freq.QuadPart);
+        return ns > 0.0 ? static_cast<double>(tsc - g_startTsc) / ns : 1.0;
+    }
+
+    // Upper bound, in cycles, of the bucket holding the given fraction
+    // of calls.
+    uint64_t Percentile(const SiteStats& s, double fraction) {
+        uint64_t want = static_cast<uint64_t>(static_cast<double>(s.calls) * fraction);
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += s.histogram[b];
+            if (seen > want) {
+                return uint64_t(2) << b;
+            }
+        }
+        return s.maxCycles;
+    }
+
+    void WriteDump() {
+        if (!g_dumpPath[0]) {
+            return;
+        }
+        FILE* f = std::fopen(g_dumpPath, "w");
+        if (!f) {
+            OutputDebugStringA("[Trace] cannot open dump file\n");
+            return;
+        }
+        double cpn = CyclesPerNs();
+        // At process exit the drain thread may have been killed while
+        // holding the lock; in that case dump what was drained so far.
+        std::unique_lock<std::mutex> lock(g_statsLock, std::try_to_lock);
+        if (lock.owns_lock()) {
+            DrainLocked();
+        }
+        std::fprintf(f, "# function entry trace\n");
+        std::fprintf(f, "# %.3f cycles/ns, probe overhead %.1f ns/call, %llu events dropped\n",
+                     cpn, g_probeOverheadNs, static_cast<unsigned long long>(g_droppedTotal));
+        std::fprintf(f, "# address  name  calls  total_ms  mean_ns  p50_ns  p99_ns  max_ns\n");
+        std::fprintf(f, "#   hist: log2(cycles):calls ...\n");
+        uint32_t count = g_siteCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i) {
+            const TraceSite& site = g_sites[i];
+            const SiteStats& s = g_stats[i];
+            if (!site.name || s.calls == 0) {
+                continue;
+            }
+            double mean = static_cast<double>(s.cycles) / static_cast<double>(s.calls);
+            std::fprintf(f, "%08X  %s  %llu  %.3f  %.1f  %.1f  %.1f  %.1f\n",
+                         static_cast<unsigned>(site.address), site.name,
+                         static_cast<unsigned long long>(s.calls),
+                         static_cast<double>(s.cycles) / cpn / 1e6,
+                         mean / cpn,
+                         static_cast<double>(Percentile(s, 0.50)) / cpn,
+                         static_cast<double>(Percentile(s, 0.99)) / cpn,
+                         static_cast<double>(s.maxCycles) / cpn);
+            std::fprintf(f, "  hist:");
+            for (int b = 0; b < kBuckets; ++b) {
+                if (s.histogram[b]) {
+                    std::fprintf(f, " %d:%llu", b, static_cast<unsigned long long>(s.histogram[b]));
+                }
+            }
+            std::fprintf(f, "\n");
+        }
+        std::fclose(f);
+    }
+}
+
+// Entry and exit halves of the thunk, called from the assembly below.
+// Both are __stdcall so the assembly does not have to clean up.
+
+static void* __stdcall TraceExit(uint32_t lo, uint32_t hi);
+extern "C" void TraceExitThunk();
+
+static void* __stdcall TraceEnter(uint32_t site, void** slot, uint32_t lo, uint32_t hi) {
+    void* detour = g_sites[site].detour;
+    // A detour that tail-jumps into another traced function hands it a
+    // return slot that already holds the exit thunk.  Wrapping it again
+    // would save the thunk as the real return address; leave it alone,
+    // so the outer frame's time includes the inner call.
+    if (*slot == reinterpret_cast<void*>(&TraceExitThunk)) {
+        return detour;
+    }
+    ThreadTrace* t = t_trace ? t_trace : AttachThread();
+    if (!t) {
+        return detour;
+    }
+    // Frames whose return slot is below ours were unwound by an
+    // exception or longjmp without returning through the exit thunk.
+    // A frame at our own slot is live: only a tail jump (handled above)
+    // reuses a slot while its frame is still on the shadow stack.
+    while (t->depth > 0 && t->frames[t->depth - 1].slot < slot) {
+        --t->depth;
+    }
+    if (t->depth >= kMaxDepth) {
+        return detour;
+    }
+    Frame& f = t->frames[t->depth++];
+    f.slot          = slot;
+    f.returnAddress = *slot;
+    f.site          = site;
+    f.start         = (static_cast<uint64_t>(hi) << 32) | lo;
+    *slot = reinterpret_cast<void*>(&TraceExitThunk);
+    return detour;
+}
+
+static void* __stdcall TraceExit(uint32_t lo, uint32_t hi) {
+    uint64_t now = (static_cast<uint64_t>(hi) << 32) | lo;
+    ThreadTrace* t = t_trace;
+    if (!t || t->depth == 0) {
+        // Nothing to return to.  Should be unreachable now that tail
+        // jumps are not wrapped; fail loudly instead of jumping through
+        // a frame that does not exist.
+        OutputDebugStringA("[Trace] exit thunk reached with an empty shadow stack\n");
+        __fastfail(FAST_FAIL_FATAL_APP_EXIT);
+    }
+    const Frame& f = t->frames[--t->depth];
+    uint32_t head = t->head.load(std::memory_order_relaxed);
+    if (head - t->tail.load(std::memory_order_acquire) < kRingSize) {
+        TraceEvent& e = t->ring[head & (kRingSize - 1)];
+        e.site   = f.site;
+        e.cycles = now - f.start;
+        t->head.store(head + 1, std::memory_order_release);
+    } else {
+        t->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return f.returnAddress;
+}
+
+// Common entry code.  Each site's thunk is `push <site>; jmp
+// TraceEntryThunk`, so on arrival [esp] is the site and [esp+4] the
+// caller's return address.  The site slot is overwritten with the
+// detour address and consumed by the final ret.
+extern "C" __declspec(naked) void TraceEntryThunk() {
+    __asm {
+        push eax
+        push ecx
+        push edx
+        rdtsc
+        push edx                    // hi
+        push eax                    // lo
+        lea  eax, [esp + 24]        // &return address
+        push eax
+        push dword ptr [esp + 24]   // site
+        call TraceEnter
+        mov  [esp + 12], eax
+        pop  edx
+        pop  ecx
+        pop  eax
+        ret
+    }
+}
+
+// Common exit code.  The detour has returned here instead of to its
+// caller; the return value in EAX:EDX is preserved while the original
+// return address is fetched from the shadow stack.
+extern "C" __declspec(naked) void TraceExitThunk() {
+    __asm {
+        push eax                    // becomes the return address
+        push eax
+        push ecx
+        push edx
+        rdtsc
+        push edx                    // hi
+        push eax                    // lo
+        call TraceExit
+        mov  [esp + 12], eax
+        pop  edx
+        pop  ecx
+        pop  eax
+        ret
+    }
+}
+
+static int __cdecl TraceProbeTarget(int value) {
+    return value + 1;
+}
+
+void MeasureFunctionTracerOverhead() {
+    if (!g_running) {
+        return;
+    }
+    typedef int (__cdecl* ProbeFn)(int);
+    ProbeFn direct = &TraceProbeTarget;
+    ProbeFn traced = reinterpret_cast<ProbeFn>(WrapWithTracer(nullptr, 0, reinterpret_cast<void*>(direct)));
+    if (reinterpret_cast<void*>(traced) == reinterpret_cast<void*>(direct)) {
+        return;
+    }
+    volatile int sink = 0;
+    LARGE_INTEGER freq, t0, t1, t2;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t0);
+    for (int i = 0; i < kProbeCalls; ++i) {
+        sink += direct(i);
+    }
+    QueryPerformanceCounter(&t1);
+    for (int i = 0; i < kProbeCalls; ++i) {
+        sink += traced(i);
+    }
+    QueryPerformanceCounter(&t2);
+    double directNs = static_cast<double>(t1.QuadPart - t0.QuadPart) * 1e9 / static_cast<double>(freq.QuadPart);
+    double tracedNs = static_cast<double>(t2.QuadPart - t1.QuadPart) * 1e9 / static_cast<double>(freq.QuadPart);
+    g_probeOverheadNs = (tracedNs - directNs) / kProbeCalls;
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "[Trace] overhead %.1f ns per traced call\n", g_probeOverheadNs);
+    OutputDebugStringA(buf);
+}
+
+bool StartFunctionTracer(const char* dumpPath) {
+    if (g_running) {
+        return true;
+    }
+    g_thunks = static_cast<unsigned char*>(
+        VirtualAlloc(nullptr, kMaxSites * kThunkSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    if (!g_thunks) {
+        return false;
+    }
+    g_dumpPath[0] = '\0';
+    if (dumpPath) {
+        lstrcpynA(g_dumpPath, dumpPath, MAX_PATH);
+    }
+    g_startTsc = __rdtsc();
+    QueryPerformanceCounter(&g_startQpc);
+    g_running = true;
+    g_drainStop.store(false);
+    g_drainThread = CreateThread(nullptr, 0, DrainThread, nullptr, 0, nullptr);
+    return true;
+}
+
+bool IsFunctionTracerRunning() {
+    return g_running;
+}
+
+void* WrapWithTracer(const char* name, uintptr_t address, void* detour) {
+    if (!g_running) {
+        return detour;
+    }
+    uint32_t site = g_siteCount.load(std::memory_order_relaxed);
+    if (site >= kMaxSites) {
+        OutputDebugStringA("[Trace] out of trace sites; hook left untraced\n");
+        return detour;
+    }
+    g_sites[site].name    = name;
+    g_sites[site].address = address;
+    g_sites[site].detour  = detour;
+
+    // push imm32 ; jmp rel32 TraceEntryThunk ; int3 padding
+    unsigned char* thunk = g_thunks + site * kThunkSize;
+    std::memset(thunk, 0xCC, kThunkSize);
+    thunk[0] = 0x68;
+    std::memcpy(thunk + 1, &site, 4);
+    thunk[5] = 0xE9;
+    int32_t rel = static_cast<int32_t>(reinterpret_cast<intptr_t>(&TraceEntryThunk) -
+                                       reinterpret_cast<intptr_t>(thunk + 10));
+    std::memcpy(thunk + 6, &rel, 4);
+    FlushInstructionCache(GetCurrentProcess(), thunk, kThunkSize);
+
+    g_siteCount.store(site + 1, std::memory_order_release);
+    return thunk;
+}
+
+namespace {
+    // Body of the snapshots.  Caller holds g_statsLock.
+    void SnapshotLocked(std::vector<TraceSnapshot>* out) {
+        DrainLocked();
+        uint32_t count = g_siteCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!g_sites[i].name) {
+                continue;
+            }
+            TraceSnapshot snap;
+            snap.name    = g_sites[i].name;
+            snap.address = g_sites[i].address;
+            snap.calls   = g_stats[i].calls;
+            snap.cycles  = g_stats[i].cycles;
+            out->push_back(snap);
+        }
+    }
+}
+
+double SnapshotFunctionTracer(std::vector<TraceSnapshot>* out) {
+    out->clear();
+    double cpn = CyclesPerNs();
+    std::lock_guard<std::mutex> lock(g_statsLock);
+    SnapshotLocked(out);
+    return cpn;
+}
+
+bool TrySnapshotFunctionTracer(std::vector<TraceSnapshot>* out, double* cyclesPerNs) {
+    out->clear();
+    *cyclesPerNs = CyclesPerNs();
+    std::unique_lock<std::mutex> lock(g_statsLock, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    SnapshotLocked(out);
+    return true;
+}
+
+void StopFunctionTracer() {
+    if (!g_running) {
+        return;
+    }
+    g_drainStop.store(true);
+    if (g_drainThread) {
+        // Bounded: this runs from DllMain, where a thread that is still
+        // alive cannot finish exiting until the loader lock is released.
+        WaitForSingleObject(g_drainThread, kDrainEvery * 5);
+        CloseHandle(g_drainThread);
+        g_drainThread = nullptr;
+    }
+    WriteDump();
+    g_running = false;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2025
+//
+// Function-entry tracer for hooked routines.  When tracing is on,
+// every row of the hook tables (see hook_registry.h) is installed
+// through a small generated thunk instead of pointing MinHook straight
+// at the detour.  The thunk reads the time stamp counter, swaps the
+// caller's return address for an exit thunk and jumps to the detour;
+// the exit thunk reads the counter again and returns to the real
+// caller.  Calling conventions do not matter: arguments, ECX/EDX and
+// the return value in EAX:EDX pass through untouched.
+//
+// Each thread has its own shadow stack and ring buffer of (site,
+// cycles) events, so the hot path never takes a lock or shares a cache
+// line.  A background thread drains the rings into per-site call
+// counts and log2 histograms of inclusive cycles.  The dump lists each
+// site by its address in the same eight-digit form digi_disasm.asm
+// uses, so a row can be found in the listing directly.
+//
+// Tracing is enabled by setting DIGI_TRACE to the dump path before
+// launching the game; InstallHooks picks it up.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Start the tracer.  The dump is written to `dumpPath` by
+// StopFunctionTracer; pass nullptr to collect without a dump (other
+// reports can still read SnapshotFunctionTracer).  Must run before the
+// hook tables are installed.
+bool StartFunctionTracer(const char* dumpPath);
+
+bool IsFunctionTracerRunning();
+
+// Time calls through a traced thunk against direct calls and record the
+// difference as the per-call overhead in the dump header.  Takes a few
+// milliseconds of busy work, so it is run from RunDeferredHookWork
+// rather than under the loader lock.  Does nothing unless the tracer is
+// running.
+void MeasureFunctionTracerOverhead();
+
+// Return a thunk that times calls to `detour` and then enters it, or
+// `detour` itself if the tracer is not running or out of sites.
+// `name` and `address` label the site in the dump.
+void* WrapWithTracer(const char* name, uintptr_t address, void* detour);
+
+// Totals for one site as of the last drain.
+struct TraceSnapshot {
+    const char* name;
+    uintptr_t   address;
+    uint64_t    calls;
+    uint64_t    cycles;
+};
+
+// Copy the current totals of every named site into `out`, in site
+// order (so consecutive snapshots line up index by index), and return
+// the time stamp counter rate in cycles per nanosecond.
+double SnapshotFunctionTracer(std::vector<TraceSnapshot>* out);
+
+// As SnapshotFunctionTracer, for process exit: returns false, leaving
+// `out` empty, instead of waiting when the statistics lock is held,
+// since the thread holding it may have been killed.  `cyclesPerNs` is
+// set either way.
+bool TrySnapshotFunctionTracer(std::vector<TraceSnapshot>* out, double* cyclesPerNs);
+
+// Drain outstanding events, write the dump and stop the drain thread.
+// The thunks stay valid, so hooks may still be called afterwards;
+// their events are simply no longer collected.
+void StopFunctionTracer();
@@ -8,12 +8,14 @@
 // In this updated version the functions at 0x401000 and 0x401020 are
 // implemented using inline x86 assembly.  This more closely mirrors
 // the original instructions and demonstrates how to write naked
-// functions in MSVC to perform low‑level operations.  If you prefer
-// portable C++ you can replace these implementations with
-// straightforward C code as shown in the original project.
+// functions in MSVC to perform low‑level operations.  Other compilers
+// and targets get the portable lookups from sin_table.h instead.
 
 #include <cstdint>
 #include "digi_table.h"
+#include "sin_table.h"
+
+#if defined(_MSC_VER) && defined(_M_IX86)
 
 // Corresponds to the function at address 0x401000.  The original
 // game masks the argument to 12 bits, uses that as an index into
@@ -57,6 +59,18 @@ extern "C" __declspec(naked) int16_t func_401020(int32_t value) {
     }
 }
 
+#else
+
+extern "C" int16_t func_401000(int32_t value) {
+    return SinLookup(value);
+}
+
+extern "C" int16_t func_401020(int32_t value) {
+    return CosLookup(value);
+}
+
+#endif
+
 // Corresponds to the wrapper at 0x401040 which simply calls 0x401020.
 extern "C" int16_t func_401040(int32_t value) {
     return func_401020(value);
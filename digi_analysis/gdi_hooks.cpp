@@ -8,11 +8,13 @@
 // using OpenGL, bypassing GDI entirely.
 
 #include <windows.h>
-#include "MinHook.h"
 #include <cstdio>
 #include <vector>
-#include <unordered_map>
 
+#include "dc_state_table.h"
+#include "glyph_cache.h"
+#include "hook_registry.h"
+#include "text_metrics.h"
 #include "text_renderer.h"
 
 // Forward declarations of the original functions.  We store these in
@@ -60,17 +62,21 @@ static void LogCall(const char* funcName) {
     OutputDebugStringA(buf);
 }
 
-struct DCState {
-    HDC      hdc;
-    HFONT    font;
-    COLORREF textColor;
-    COLORREF bkColor;
-    int      bkMode;
-};
-
-static std::unordered_map<HDC, DCState> g_dcState;
+// Per-DC state for the memory DCs created through our
+// CreateCompatibleDC detour.  Lock-free; see dc_state_table.h.
+static DCStateTable g_dcState;
 static bool g_enableFallback = false;
 
+// Font currently selected into `hdc`.  DCs created through our
+// CreateCompatibleDC detour are tracked; anything else is asked.
+static HFONT SelectedFont(HDC hdc) {
+    HFONT font;
+    if (g_dcState.GetFont(hdc, &font)) {
+        return font;
+    }
+    return (HFONT)GetCurrentObject(hdc, OBJ_FONT);
+}
+
 // Detour implementations.  Each detour logs its invocation and then
 // calls the original function.  Replace the call to the original
 // function with your own implementation once the OpenGL renderer is
@@ -90,7 +96,9 @@ static HDC WINAPI Detour_CreateCompatibleDC(HDC hdc) {
         state.textColor = RGB(255, 255, 255);
         state.bkColor   = RGB(0, 0, 0);
         state.bkMode    = TRANSPARENT;
-        g_dcState[real] = state;
+        if (!g_dcState.Insert(state)) {
+            OutputDebugStringA("[GDI hook] DC state table full; DC left untracked\n");
+        }
     }
     return real;
 }
@@ -106,30 +114,82 @@ static HFONT WINAPI Detour_CreateFontA(int cHeight, int cWidth, int cEscapement,
                                        DWORD iCharSet, DWORD iOutPrecision, DWORD iClipPrecision,
                                        DWORD iQuality, DWORD iPitchAndFamily, LPCSTR pszFaceName) {
     LogCall("CreateFontA");
-    return orig_CreateFontA ? orig_CreateFontA(cHeight, cWidth, cEscapement, cOrientation,
-                                              cWeight, bItalic, bUnderline, bStrikeOut,
-                                              iCharSet, iOutPrecision, iClipPrecision,
-                                              iQuality, iPitchAndFamily, pszFaceName) : nullptr;
+    if (!orig_CreateFontA) {
+        return nullptr;
+    }
+    HFONT font = orig_CreateFontA(cHeight, cWidth, cEscapement, cOrientation,
+                                  cWeight, bItalic, bUnderline, bStrikeOut,
+                                  iCharSet, iOutPrecision, iClipPrecision,
+                                  iQuality, iPitchAndFamily, pszFaceName);
+    if (font) {
+        // Start (or load) the persistent glyph cache for this font.
+        LOGFONTA lf{};
+        lf.lfHeight         = cHeight;
+        lf.lfWidth          = cWidth;
+        lf.lfEscapement     = cEscapement;
+        lf.lfOrientation    = cOrientation;
+        lf.lfWeight         = cWeight;
+        lf.lfItalic         = static_cast<BYTE>(bItalic);
+        lf.lfUnderline      = static_cast<BYTE>(bUnderline);
+        lf.lfStrikeOut      = static_cast<BYTE>(bStrikeOut);
+        lf.lfCharSet        = static_cast<BYTE>(iCharSet);
+        lf.lfOutPrecision   = static_cast<BYTE>(iOutPrecision);
+        lf.lfClipPrecision  = static_cast<BYTE>(iClipPrecision);
+        lf.lfQuality        = static_cast<BYTE>(iQuality);
+        lf.lfPitchAndFamily = static_cast<BYTE>(iPitchAndFamily);
+        if (pszFaceName) {
+            lstrcpynA(lf.lfFaceName, pszFaceName, LF_FACESIZE);
+        }
+        RegisterGlyphCacheFont(font, lf);
+        RegisterFontLogFont(font, lf);
+    }
+    return font;
+}
+
+// Handles are recycled, so nothing cached for a font may outlive it:
+// a later font handed the same handle would draw with the old glyphs,
+// runs and metrics.  Only fonts the game created through the hooked
+// entry points are cached; the glyph cache workers delete their own
+// private fonts constantly, and those are left alone.
+static void ForgetFont(HFONT font) {
+    LOGFONTA lf;
+    if (!GetCachedLogFont(font, &lf)) {
+        return;
+    }
+    ForgetFontMetrics(font);
+    ForgetGlyphCacheFont(font);
+    TextRenderer::ForgetFont(font);
 }
 
 static BOOL WINAPI Detour_DeleteObject(HGDIOBJ obj) {
     LogCall("DeleteObject");
+    if (GetObjectType(obj) == OBJ_FONT) {
+        ForgetFont((HFONT)obj);
+    }
     return orig_DeleteObject ? orig_DeleteObject(obj) : FALSE;
 }
 
 static HFONT WINAPI Detour_CreateFontIndirectA(const LOGFONTA* plf) {
     LogCall("CreateFontIndirectA");
-    return orig_CreateFontIndirectA ? orig_CreateFontIndirectA(plf) : nullptr;
+    if (!orig_CreateFontIndirectA) {
+        return nullptr;
+    }
+    HFONT font = orig_CreateFontIndirectA(plf);
+    if (font && plf) {
+        RegisterGlyphCacheFont(font, *plf);
+        RegisterFontLogFont(font, *plf);
+    }
+    return font;
 }
 
 static BOOL WINAPI Detour_DeleteDC(HDC hdc) {
     LogCall("DeleteDC");
-    auto it = g_dcState.find(hdc);
-    if (it != g_dcState.end()) {
+    // Stop tracking first so no other thread picks up the state of a
+    // DC that is about to disappear.
+    if (g_dcState.Remove(hdc)) {
         if (orig_DeleteDC) {
-            orig_DeleteDC(it->second.hdc);
+            orig_DeleteDC(hdc);
         }
-        g_dcState.erase(it);
         return TRUE;
     }
     return orig_DeleteDC ? orig_DeleteDC(hdc) : FALSE;
@@ -137,10 +197,9 @@ static BOOL WINAPI Detour_DeleteDC(HDC hdc) {
 
 static HGDIOBJ WINAPI Detour_SelectObject(HDC hdc, HGDIOBJ hgdiobj) {
     LogCall("SelectObject");
-    auto it = g_dcState.find(hdc);
-    if (it != g_dcState.end() && GetObjectType(hgdiobj) == OBJ_FONT) {
-        HFONT prev = it->second.font;
-        it->second.font = (HFONT)hgdiobj;
+    HFONT prev;
+    if (g_dcState.Contains(hdc) && GetObjectType(hgdiobj) == OBJ_FONT &&
+        g_dcState.ExchangeFont(hdc, (HFONT)hgdiobj, &prev)) {
         if (orig_SelectObject) {
             orig_SelectObject(hdc, hgdiobj);
         }
@@ -151,10 +210,8 @@ static HGDIOBJ WINAPI Detour_SelectObject(HDC hdc, HGDIOBJ hgdiobj) {
 
 static COLORREF WINAPI Detour_SetBkColor(HDC hdc, COLORREF color) {
     LogCall("SetBkColor");
-    auto it = g_dcState.find(hdc);
-    if (it != g_dcState.end()) {
-        COLORREF prev = it->second.bkColor;
-        it->second.bkColor = color;
+    COLORREF prev;
+    if (g_dcState.ExchangeBkColor(hdc, color, &prev)) {
         if (orig_SetBkColor) {
             orig_SetBkColor(hdc, color);
         }
@@ -165,10 +222,8 @@ static COLORREF WINAPI Detour_SetBkColor(HDC hdc, COLORREF color) {
 
 static int WINAPI Detour_SetBkMode(HDC hdc, int mode) {
     LogCall("SetBkMode");
-    auto it = g_dcState.find(hdc);
-    if (it != g_dcState.end()) {
-        int prev = it->second.bkMode;
-        it->second.bkMode = mode;
+    int prev;
+    if (g_dcState.ExchangeBkMode(hdc, mode, &prev)) {
         if (orig_SetBkMode) {
             orig_SetBkMode(hdc, mode);
         }
@@ -179,25 +234,38 @@ static int WINAPI Detour_SetBkMode(HDC hdc, int mode) {
 
 static int WINAPI Detour_GetObjectA(HGDIOBJ obj, int cbBuffer, LPVOID pvBuffer) {
     LogCall("GetObjectA");
+    // Fonts created through our detours answer from the LOGFONT they
+    // were created with.  This is what D3DXCreateFont (0x00486730) asks
+    // for every time the game builds a text renderer.
+    if (pvBuffer && cbBuffer >= static_cast<int>(sizeof(LOGFONTA)) &&
+        GetCachedLogFont((HFONT)obj, static_cast<LOGFONTA*>(pvBuffer))) {
+        return sizeof(LOGFONTA);
+    }
     return orig_GetObjectA ? orig_GetObjectA(obj, cbBuffer, pvBuffer) : 0;
 }
 
 static BOOL WINAPI Detour_GetTextExtentPoint32A(HDC hdc, LPCSTR lpString, int cbString, LPSIZE lpSize) {
     LogCall("GetTextExtentPoint32A");
+    // GDI is only consulted the first time a font is measured; see
+    // text_metrics.h.
+    if (GetCachedTextExtent(hdc, SelectedFont(hdc), lpString, cbString, lpSize, false)) {
+        return TRUE;
+    }
     return orig_GetTextExtentPoint32A ? orig_GetTextExtentPoint32A(hdc, lpString, cbString, lpSize) : FALSE;
 }
 
 static BOOL WINAPI Detour_GetTextMetricsA(HDC hdc, LPTEXTMETRICA lptm) {
     LogCall("GetTextMetricsA");
+    if (GetCachedTextMetrics(hdc, SelectedFont(hdc), lptm)) {
+        return TRUE;
+    }
     return orig_GetTextMetricsA ? orig_GetTextMetricsA(hdc, lptm) : FALSE;
 }
 
 static COLORREF WINAPI Detour_SetTextColor(HDC hdc, COLORREF color) {
     LogCall("SetTextColor");
-    auto it = g_dcState.find(hdc);
-    if (it != g_dcState.end()) {
-        COLORREF prev = it->second.textColor;
-        it->second.textColor = color;
+    COLORREF prev;
+    if (g_dcState.ExchangeTextColor(hdc, color, &prev)) {
         if (orig_SetTextColor) {
             orig_SetTextColor(hdc, color);
         }
@@ -211,70 +279,64 @@ static BOOL WINAPI Detour_TextOutA(HDC hdc, int x, int y, LPCSTR lpString, int c
     if (!lpString || c <= 0) {
         return TRUE;
     }
-    auto it = g_dcState.find(hdc);
+    DCState state;
     COLORREF color = RGB(255, 255, 255);
     HFONT font = nullptr;
-    if (it != g_dcState.end()) {
-        color = it->second.textColor;
-        font  = it->second.font;
+    if (g_dcState.Get(hdc, &state)) {
+        color = state.textColor;
+        font  = state.font;
     }
+    // The game's ANSI text is CP949; DrawTextA decodes it so Korean
+    // double-byte characters are drawn as single glyphs.
     TextRenderer::DrawTextA(hdc, font, x, y, lpString, c, color);
     return TRUE;
 }
 
-// Install hooks for all the GDI functions listed above.  This routine
-// retrieves the address of each target from GDI32.dll and uses
-// MinHook to create a detour.  Hooks are enabled after creation via
-// MH_EnableHook(MH_ALL_HOOKS) in InstallHooks().
+// GDI32 exports we detour, one row per function.
+static const HookSpec kGdiHooks[] = {
+    { "CreateCompatibleDC", "GDI32.dll", "CreateCompatibleDC", 0,
+      reinterpret_cast<void*>(&Detour_CreateCompatibleDC), reinterpret_cast<void**>(&orig_CreateCompatibleDC) },
+    { "CreateDIBSection", "GDI32.dll", "CreateDIBSection", 0,
+      reinterpret_cast<void*>(&Detour_CreateDIBSection), reinterpret_cast<void**>(&orig_CreateDIBSection) },
+    { "CreateFontA", "GDI32.dll", "CreateFontA", 0,
+      reinterpret_cast<void*>(&Detour_CreateFontA), reinterpret_cast<void**>(&orig_CreateFontA) },
+    { "DeleteObject", "GDI32.dll", "DeleteObject", 0,
+      reinterpret_cast<void*>(&Detour_DeleteObject), reinterpret_cast<void**>(&orig_DeleteObject) },
+    { "CreateFontIndirectA", "GDI32.dll", "CreateFontIndirectA", 0,
+      reinterpret_cast<void*>(&Detour_CreateFontIndirectA), reinterpret_cast<void**>(&orig_CreateFontIndirectA) },
+    { "DeleteDC", "GDI32.dll", "DeleteDC", 0,
+      reinterpret_cast<void*>(&Detour_DeleteDC), reinterpret_cast<void**>(&orig_DeleteDC) },
+    { "SelectObject", "GDI32.dll", "SelectObject", 0,
+      reinterpret_cast<void*>(&Detour_SelectObject), reinterpret_cast<void**>(&orig_SelectObject) },
+    { "SetBkColor", "GDI32.dll", "SetBkColor", 0,
+      reinterpret_cast<void*>(&Detour_SetBkColor), reinterpret_cast<void**>(&orig_SetBkColor) },
+    { "SetBkMode", "GDI32.dll", "SetBkMode", 0,
+      reinterpret_cast<void*>(&Detour_SetBkMode), reinterpret_cast<void**>(&orig_SetBkMode) },
+    { "GetObjectA", "GDI32.dll", "GetObjectA", 0,
+      reinterpret_cast<void*>(&Detour_GetObjectA), reinterpret_cast<void**>(&orig_GetObjectA) },
+    { "GetTextExtentPoint32A", "GDI32.dll", "GetTextExtentPoint32A", 0,
+      reinterpret_cast<void*>(&Detour_GetTextExtentPoint32A), reinterpret_cast<void**>(&orig_GetTextExtentPoint32A) },
+    { "GetTextMetricsA", "GDI32.dll", "GetTextMetricsA", 0,
+      reinterpret_cast<void*>(&Detour_GetTextMetricsA), reinterpret_cast<void**>(&orig_GetTextMetricsA) },
+    { "SetTextColor", "GDI32.dll", "SetTextColor", 0,
+      reinterpret_cast<void*>(&Detour_SetTextColor), reinterpret_cast<void**>(&orig_SetTextColor) },
+    { "TextOutA", "GDI32.dll", "TextOutA", 0,
+      reinterpret_cast<void*>(&Detour_TextOutA), reinterpret_cast<void**>(&orig_TextOutA) },
+};
+
+// Install hooks for all the GDI functions listed above.  The hooks are
+// created and queued here; InstallHooks() enables them together with
+// the digi.exe hooks via ApplyQueuedHooks().
 void InstallGDIHooks() {
-    HMODULE gdi = GetModuleHandleA("GDI32.dll");
-    if (!gdi) {
+    if (!GetModuleHandleA("GDI32.dll")) {
         return;
     }
-    // For each function, call MH_CreateHook and pass the address of the
-    // detour and a pointer to store the original.  If a hook fails we
-    // simply skip it; MinHook will return an error code which we ignore
-    // here for brevity.
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "CreateCompatibleDC")),
-                  reinterpret_cast<void*>(&Detour_CreateCompatibleDC),
-                  reinterpret_cast<void**>(&orig_CreateCompatibleDC));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "CreateDIBSection")),
-                  reinterpret_cast<void*>(&Detour_CreateDIBSection),
-                  reinterpret_cast<void**>(&orig_CreateDIBSection));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "CreateFontA")),
-                  reinterpret_cast<void*>(&Detour_CreateFontA),
-                  reinterpret_cast<void**>(&orig_CreateFontA));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "DeleteObject")),
-                  reinterpret_cast<void*>(&Detour_DeleteObject),
-                  reinterpret_cast<void**>(&orig_DeleteObject));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "CreateFontIndirectA")),
-                  reinterpret_cast<void*>(&Detour_CreateFontIndirectA),
-                  reinterpret_cast<void**>(&orig_CreateFontIndirectA));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "DeleteDC")),
-                  reinterpret_cast<void*>(&Detour_DeleteDC),
-                  reinterpret_cast<void**>(&orig_DeleteDC));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "SelectObject")),
-                  reinterpret_cast<void*>(&Detour_SelectObject),
-                  reinterpret_cast<void**>(&orig_SelectObject));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "SetBkColor")),
-                  reinterpret_cast<void*>(&Detour_SetBkColor),
-                  reinterpret_cast<void**>(&orig_SetBkColor));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "SetBkMode")),
-                  reinterpret_cast<void*>(&Detour_SetBkMode),
-                  reinterpret_cast<void**>(&orig_SetBkMode));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "GetObjectA")),
-                  reinterpret_cast<void*>(&Detour_GetObjectA),
-                  reinterpret_cast<void**>(&orig_GetObjectA));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "GetTextExtentPoint32A")),
-                  reinterpret_cast<void*>(&Detour_GetTextExtentPoint32A),
-                  reinterpret_cast<void**>(&orig_GetTextExtentPoint32A));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "GetTextMetricsA")),
-                  reinterpret_cast<void*>(&Detour_GetTextMetricsA),
-                  reinterpret_cast<void**>(&orig_GetTextMetricsA));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "SetTextColor")),
-                  reinterpret_cast<void*>(&Detour_SetTextColor),
-                  reinterpret_cast<void**>(&orig_SetTextColor));
-    MH_CreateHook(reinterpret_cast<void*>(GetProcAddress(gdi, "TextOutA")),
-                  reinterpret_cast<void*>(&Detour_TextOutA),
-                  reinterpret_cast<void**>(&orig_TextOutA));
+    InstallHookTable("GDI32", kGdiHooks);
+
+    // The metrics cache builds its tables through the trampolines so
+    // it never re-enters the detours above.
+    FontMetricsSource source;
+    source.getTextMetrics = orig_GetTextMetricsA;
+    source.getTextExtent  = orig_GetTextExtentPoint32A;
+    SetFontMetricsSource(source);
 }
\ No newline at end of file
@@ -0,0 +1,504 @@
+// Copyright (c) 2025
+//
+// Implementation of the persistent glyph cache.  See glyph_cache.h
+// for an overview.
+//
+// Cache file layout (all little endian):
+//
+//   GlyphCacheHeader
+//   GlyphCacheEntry[glyphCount]   sorted by code point
+//   coverage data                 one tightly packed bitmap per entry
+//
+// A file is only trusted if its magic, version and font description
+// match the font being looked up; anything else is rebuilt.
+
+#include "glyph_cache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const char     kGlyphCacheMagic[4] = { 'D', 'W', 'G', 'C' };
+    const uint32_t kGlyphCacheVersion  = 1;
+    const DWORD    kMaxWorkers         = 4;
+
+    struct GlyphCacheHeader {
+        char     magic[4];
+        uint32_t version;
+        int32_t  height;
+        int32_t  weight;
+        uint8_t  italic;
+        uint8_t  charSet;
+        uint8_t  quality;
+        uint8_t  reserved;
+        char     faceName[LF_FACESIZE];
+        uint32_t glyphCount;
+        uint32_t dataOffset;
+        uint32_t fileSize;
+    };
+
+    struct GlyphCacheEntry {
+        uint32_t code;
+        uint16_t width;
+        uint16_t height;
+        int16_t  advance;
+        int16_t  bearingX;
+        int16_t  bearingY;
+        uint16_t reserved;
+        uint32_t offset;
+    };
+
+    // A read-only view of one cache file.  `refs` counts the font
+    // cache that publishes it plus every lookup whose coverage pointer
+    // is still in use; the view is unmapped when it drops to zero.
+    struct GlyphCacheFile {
+        LONG                    refs;
+        HANDLE                  file;
+        HANDLE                  mapping;
+        const BYTE*             view;
+        size_t                  size;
+        const GlyphCacheHeader* header;
+        const GlyphCacheEntry*  entries;
+    };
+
+    // One entry per distinct face/size/weight.  Entries are never
+    // freed: background builders may still reference them while the
+    // DLL is being unloaded.
+    struct FontCache {
+        LOGFONTA                     lfA;
+        std::string                  path;
+        std::atomic<GlyphCacheFile*> file{ nullptr };
+    };
+
+    struct BuiltGlyph {
+        UINT              code;
+        GLYPHMETRICS      gm;
+        std::vector<BYTE> coverage;
+    };
+
+    struct WorkerJob {
+        const FontCache*          cache;
+        const std::vector<WCHAR>* chars;
+        size_t                    begin;
+        size_t                    end;
+        std::vector<BuiltGlyph>   out;
+    };
+
+    std::mutex                                  g_fontMutex;
+    std::unordered_map<std::string, FontCache*> g_cachesByKey;
+    std::unordered_map<HFONT, FontCache*>       g_fontToCache;
+    std::mutex                                  g_buildMutex;
+    std::atomic<bool>                           g_cancel{ false };
+    std::vector<WCHAR>                          g_charset;
+    std::once_flag                              g_charsetOnce;
+
+    std::string GetCacheDirectory() {
+        char path[MAX_PATH];
+        DWORD len = GetModuleFileNameA(nullptr, path, MAX_PATH);
+        std::string dir(path, len);
+        size_t slash = dir.find_last_of("\\/");
+        dir = (slash == std::string::npos) ? std::string() : dir.substr(0, slash + 1);
+        return dir + "glyph_cache\\";
+    }
+
+    uint32_t HashFaceName(const char* face) {
+        uint32_t h = 2166136261u;
+        for (const char* p = face; *p; ++p) {
+            h ^= static_cast<unsigned char>(*p);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    std::string MakeFontKey(const LOGFONTA& lf) {
+        char buf[LF_FACESIZE + 64];
+        std::snprintf(buf, sizeof(buf), "%.*s|%ld|%ld|%u|%u", LF_FACESIZE, lf.lfFaceName,
+                      static_cast<long>(lf.lfHeight), static_cast<long>(lf.lfWeight),
+                      lf.lfItalic, lf.lfCharSet);
+        return buf;
+    }
+
+    // The name carries everything MakeFontKey does, so two fonts that
+    // get separate FontCache entries never share (and keep rebuilding)
+    // one file.
+    std::string MakeCachePath(const LOGFONTA& lf) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "glyphs_%08X_%ld_%ld_%u%s.bin", HashFaceName(lf.lfFaceName),
+                      static_cast<long>(lf.lfHeight), static_cast<long>(lf.lfWeight),
+                      lf.lfCharSet, lf.lfItalic ? "_i" : "");
+        return GetCacheDirectory() + name;
+    }
+
+    // The game's text is EUC-KR, so the character set is ASCII plus
+    // the KS X 1001 symbol and Hangul rows.  Any extra characters
+    // listed in strings_korean.txt (UTF-8, next to digi.exe) are added
+    // on top so rarely used glyphs are covered as well.
+    void BuildCharset() {
+        std::vector<WCHAR> chars;
+        for (WCHAR c = 0x20; c < 0x7F; ++c) {
+            chars.push_back(c);
+        }
+        for (int lead = 0xA1; lead <= 0xC8; ++lead) {
+            if (lead > 0xAC && lead < 0xB0) {
+                continue;
+            }
+            for (int trail = 0xA1; trail <= 0xFE; ++trail) {
+                char mb[2] = { static_cast<char>(lead), static_cast<char>(trail) };
+                WCHAR wc = 0;
+                if (MultiByteToWideChar(949, MB_ERR_INVALID_CHARS, mb, 2, &wc, 1) == 1) {
+                    chars.push_back(wc);
+                }
+            }
+        }
+        std::string listPath = GetCacheDirectory();
+        listPath.resize(listPath.size() - std::strlen("glyph_cache\\"));
+        listPath += "strings_korean.txt";
+        if (FILE* f = std::fopen(listPath.c_str(), "rb")) {
+            std::string utf8;
+            char buf[4096];
+            size_t n;
+            while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) {
+                utf8.append(buf, n);
+            }
+            std::fclose(f);
+            int wlen = MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), nullptr, 0);
+            if (wlen > 0) {
+                std::vector<WCHAR> wide(static_cast<size_t>(wlen));
+                MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), wide.data(), wlen);
+                for (WCHAR c : wide) {
+                    if (c >= 0x20 && (c < 0xD800 || c > 0xDFFF)) {
+                        chars.push_back(c);
+                    }
+                }
+            }
+        }
+        std::sort(chars.begin(), chars.end());
+        chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+        g_charset.swap(chars);
+    }
+
+    // Drop one reference; the last one unmaps and closes the file.
+    void ReleaseCacheFile(GlyphCacheFile* file) {
+        if (!file || InterlockedDecrement(&file->refs) != 0) {
+            return;
+        }
+        if (file->view) {
+            UnmapViewOfFile(file->view);
+        }
+        if (file->mapping) {
+            CloseHandle(file->mapping);
+        }
+        if (file->file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file->file);
+        }
+        delete file;
+    }
+
+    // Map and validate an existing cache file.  Returns nullptr if the
+    // file is missing, truncated or describes a different font.
+    GlyphCacheFile* OpenCacheFile(const FontCache& cache) {
+        HANDLE file = CreateFileA(cache.path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+        GlyphCacheFile* result = new GlyphCacheFile{ 1, file, nullptr, nullptr, 0, nullptr, nullptr };
+        DWORD size = GetFileSize(file, nullptr);
+        if (size == INVALID_FILE_SIZE || size < sizeof(GlyphCacheHeader)) {
+            ReleaseCacheFile(result);
+            return nullptr;
+        }
+        result->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!result->mapping) {
+            ReleaseCacheFile(result);
+            return nullptr;
+        }
+        result->view = static_cast<const BYTE*>(MapViewOfFile(result->mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!result->view) {
+            ReleaseCacheFile(result);
+            return nullptr;
+        }
+        result->size    = size;
+        result->header  = reinterpret_cast<const GlyphCacheHeader*>(result->view);
+        result->entries = reinterpret_cast<const GlyphCacheEntry*>(result->view + sizeof(GlyphCacheHeader));
+
+        const GlyphCacheHeader& h = *result->header;
+        const LOGFONTA& lf = cache.lfA;
+        uint64_t tableEnd = sizeof(GlyphCacheHeader) + static_cast<uint64_t>(h.glyphCount) * sizeof(GlyphCacheEntry);
+        bool valid = std::memcmp(h.magic, kGlyphCacheMagic, sizeof(h.magic)) == 0 &&
+                     h.version == kGlyphCacheVersion &&
+                     h.fileSize == size &&
+                     h.height == lf.lfHeight &&
+                     h.weight == lf.lfWeight &&
+                     h.italic == lf.lfItalic &&
+                     h.charSet == lf.lfCharSet &&
+                     std::strncmp(h.faceName, lf.lfFaceName, LF_FACESIZE) == 0 &&
+                     tableEnd <= h.dataOffset && h.dataOffset <= size;
+        for (uint32_t i = 0; valid && i < h.glyphCount; ++i) {
+            const GlyphCacheEntry& e = result->entries[i];
+            uint64_t end = static_cast<uint64_t>(h.dataOffset) + e.offset + static_cast<uint64_t>(e.width) * e.height;
+            valid = end <= size && (i == 0 || result->entries[i - 1].code < e.code);
+        }
+        if (!valid) {
+            ReleaseCacheFile(result);
+            return nullptr;
+        }
+        return result;
+    }
+
+    DWORD WINAPI RasterWorker(LPVOID param) {
+        WorkerJob* job = static_cast<WorkerJob*>(param);
+        // Each worker owns its DC and font object; GDI objects must not
+        // be shared between threads while in use.  The font is created
+        // through the wide entry point, which is not hooked, so worker
+        // fonts never re-enter RegisterGlyphCacheFont.
+        const LOGFONTA& lfA = job->cache->lfA;
+        LOGFONTW lfW;
+        std::memcpy(&lfW, &lfA, offsetof(LOGFONTA, lfFaceName));
+        MultiByteToWideChar(CP_ACP, 0, lfA.lfFaceName, -1, lfW.lfFaceName, LF_FACESIZE);
+        lfW.lfFaceName[LF_FACESIZE - 1] = 0;
+        HDC dc = CreateCompatibleDC(nullptr);
+        HFONT font = CreateFontIndirectW(&lfW);
+        if (!dc || !font) {
+            if (font) DeleteObject(font);
+            if (dc) DeleteDC(dc);
+            return 1;
+        }
+        HGDIOBJ oldFont = SelectObject(dc, font);
+        MAT2 mat = {{0,1},{0,0},{0,0},{0,1}};
+        std::vector<BYTE> buffer;
+        for (size_t i = job->begin; i < job->end && !g_cancel.load(std::memory_order_relaxed); ++i) {
+            UINT ch = (*job->chars)[i];
+            GLYPHMETRICS gm;
+            DWORD size = GetGlyphOutlineW(dc, ch, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &mat);
+            if (size == GDI_ERROR || size == 0) {
+                continue;
+            }
+            buffer.resize(size);
+            if (GetGlyphOutlineW(dc, ch, GGO_GRAY8_BITMAP, &gm, size, buffer.data(), &mat) == GDI_ERROR) {
+                continue;
+            }
+            BuiltGlyph glyph;
+            glyph.code = ch;
+            glyph.gm = gm;
+            UINT pitch = (gm.gmBlackBoxX + 3) & ~3u;
+            glyph.coverage.resize(static_cast<size_t>(gm.gmBlackBoxX) * gm.gmBlackBoxY);
+            for (UINT y = 0; y < gm.gmBlackBoxY; ++y) {
+                std::memcpy(&glyph.coverage[static_cast<size_t>(y) * gm.gmBlackBoxX],
+                            &buffer[static_cast<size_t>(y) * pitch], gm.gmBlackBoxX);
+            }
+            job->out.push_back(std::move(glyph));
+        }
+        SelectObject(dc, oldFont);
+        DeleteObject(font);
+        DeleteDC(dc);
+        return 0;
+    }
+
+    bool WriteCacheFile(const FontCache& cache, std::vector<BuiltGlyph>& glyphs) {
+        std::sort(glyphs.begin(), glyphs.end(),
+                  [](const BuiltGlyph& a, const BuiltGlyph& b) { return a.code < b.code; });
+        GlyphCacheHeader header{};
+        std::memcpy(header.magic, kGlyphCacheMagic, sizeof(header.magic));
+        header.version    = kGlyphCacheVersion;
+        header.height     = cache.lfA.lfHeight;
+        header.weight     = cache.lfA.lfWeight;
+        header.italic     = cache.lfA.lfItalic;
+        header.charSet    = cache.lfA.lfCharSet;
+        header.quality    = cache.lfA.lfQuality;
+        std::strncpy(header.faceName, cache.lfA.lfFaceName, LF_FACESIZE);
+        header.glyphCount = static_cast<uint32_t>(glyphs.size());
+        header.dataOffset = static_cast<uint32_t>(sizeof(GlyphCacheHeader) + glyphs.size() * sizeof(GlyphCacheEntry));
+
+        std::vector<GlyphCacheEntry> entries(glyphs.size());
+        uint32_t offset = 0;
+        for (size_t i = 0; i < glyphs.size(); ++i) {
+            const GLYPHMETRICS& gm = glyphs[i].gm;
+            GlyphCacheEntry& e = entries[i];
+            e.code     = glyphs[i].code;
+            e.width    = static_cast<uint16_t>(gm.gmBlackBoxX);
+            e.height   = static_cast<uint16_t>(gm.gmBlackBoxY);
+            e.advance  = static_cast<int16_t>(gm.gmCellIncX);
+            e.bearingX = static_cast<int16_t>(gm.gmptGlyphOrigin.x);
+            e.bearingY = static_cast<int16_t>(gm.gmptGlyphOrigin.y);
+            e.reserved = 0;
+            e.offset   = offset;
+            offset += static_cast<uint32_t>(glyphs[i].coverage.size());
+        }
+        header.fileSize = header.dataOffset + offset;
+
+        // Write to a temporary name and rename so a crash mid-write never
+        // leaves a truncated file that a later launch would reject.
+        std::string tmpPath = cache.path + ".tmp";
+        FILE* f = std::fopen(tmpPath.c_str(), "wb");
+        if (!f) {
+            return false;
+        }
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+        if (ok && !entries.empty()) {
+            ok = std::fwrite(entries.data(), sizeof(GlyphCacheEntry), entries.size(), f) == entries.size();
+        }
+        for (size_t i = 0; ok && i < glyphs.size(); ++i) {
+            const std::vector<BYTE>& c = glyphs[i].coverage;
+            ok = c.empty() || std::fwrite(c.data(), 1, c.size(), f) == c.size();
+        }
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok) {
+            DeleteFileA(tmpPath.c_str());
+            return false;
+        }
+        return MoveFileExA(tmpPath.c_str(), cache.path.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
+    }
+
+    // Background builder for one font.  Splits the character set across
+    // worker threads, merges their results, writes the cache file and
+    // publishes the mapped view.
+    DWORD WINAPI BuildFontCache(LPVOID param) {
+        FontCache* cache = static_cast<FontCache*>(param);
+        std::lock_guard<std::mutex> buildLock(g_buildMutex);
+        std::call_once(g_charsetOnce, BuildCharset);
+
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        DWORD workers = si.dwNumberOfProcessors > 1 ? si.dwNumberOfProcessors - 1 : 1;
+        workers = std::min(workers, kMaxWorkers);
+
+        std::vector<WorkerJob> jobs(workers);
+        std::vector<HANDLE> threads;
+        size_t perWorker = (g_charset.size() + workers - 1) / workers;
+        for (DWORD i = 0; i < workers; ++i) {
+            jobs[i].cache = cache;
+            jobs[i].chars = &g_charset;
+            jobs[i].begin = std::min(g_charset.size(), i * perWorker);
+            jobs[i].end   = std::min(g_charset.size(), (i + 1) * perWorker);
+            if (i + 1 < workers) {
+                HANDLE t = CreateThread(nullptr, 0, RasterWorker, &jobs[i], 0, nullptr);
+                if (t) {
+                    threads.push_back(t);
+                    continue;
+                }
+            }
+            // The last slice, and any slice whose thread could not be
+            // created, is rasterised on the builder thread itself.
+            RasterWorker(&jobs[i]);
+        }
+        for (HANDLE t : threads) {
+            WaitForSingleObject(t, INFINITE);
+            CloseHandle(t);
+        }
+        if (g_cancel.load()) {
+            return 0;
+        }
+
+        std::vector<BuiltGlyph> glyphs;
+        for (WorkerJob& job : jobs) {
+            std::move(job.out.begin(), job.out.end(), std::back_inserter(glyphs));
+        }
+        CreateDirectoryA(GetCacheDirectory().c_str(), nullptr);
+        if (!WriteCacheFile(*cache, glyphs)) {
+            OutputDebugStringA("[glyph cache] failed to write cache file\n");
+            return 1;
+        }
+        if (GlyphCacheFile* file = OpenCacheFile(*cache)) {
+            cache->file.store(file, std::memory_order_release);
+            char buf[128];
+            std::snprintf(buf, sizeof(buf), "[glyph cache] built %u glyphs for %.*s\n",
+                          file->header->glyphCount, LF_FACESIZE, cache->lfA.lfFaceName);
+            OutputDebugStringA(buf);
+        }
+        return 0;
+    }
+}
+
+void RegisterGlyphCacheFont(HFONT font, const LOGFONTA& lf) {
+    if (!font) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_fontMutex);
+    std::string key = MakeFontKey(lf);
+    auto it = g_cachesByKey.find(key);
+    FontCache* cache = nullptr;
+    if (it != g_cachesByKey.end()) {
+        cache = it->second;
+    } else {
+        cache = new FontCache();
+        cache->lfA  = lf;
+        cache->path = MakeCachePath(lf);
+        g_cachesByKey.emplace(key, cache);
+        if (GlyphCacheFile* file = OpenCacheFile(*cache)) {
+            cache->file.store(file, std::memory_order_release);
+        } else {
+            HANDLE t = CreateThread(nullptr, 0, BuildFontCache, cache, 0, nullptr);
+            if (t) {
+                CloseHandle(t);
+            }
+        }
+    }
+    g_fontToCache[font] = cache;
+}
+
+bool LookupCachedGlyph(HFONT font, UINT ch, CachedGlyph* out) {
+    GlyphCacheFile* file = nullptr;
+    {
+        // ShutdownGlyphCache drops the published reference under the
+        // same lock, so the file cannot be unmapped between the load
+        // and our own reference.
+        std::lock_guard<std::mutex> lock(g_fontMutex);
+        auto it = g_fontToCache.find(font);
+        if (it == g_fontToCache.end()) {
+            return false;
+        }
+        file = it->second->file.load(std::memory_order_acquire);
+        if (!file) {
+            return false;
+        }
+        InterlockedIncrement(&file->refs);
+    }
+    const GlyphCacheEntry* begin = file->entries;
+    const GlyphCacheEntry* end   = begin + file->header->glyphCount;
+    const GlyphCacheEntry* e = std::lower_bound(begin, end, ch,
+        [](const GlyphCacheEntry& entry, UINT code) { return entry.code < code; });
+    if (e == end || e->code != ch) {
+        ReleaseCacheFile(file);
+        return false;
+    }
+    out->width    = e->width;
+    out->height   = e->height;
+    out->advance  = e->advance;
+    out->bearingX = e->bearingX;
+    out->bearingY = e->bearingY;
+    out->coverage = file->view + file->header->dataOffset + e->offset;
+    out->file     = file;
+    return true;
+}
+
+void ReleaseCachedGlyph(CachedGlyph* glyph) {
+    ReleaseCacheFile(static_cast<GlyphCacheFile*>(glyph->file));
+    glyph->file     = nullptr;
+    glyph->coverage = nullptr;
+}
+
+void ForgetGlyphCacheFont(HFONT font) {
+    std::lock_guard<std::mutex> lock(g_fontMutex);
+    g_fontToCache.erase(font);
+}
+
+void ShutdownGlyphCache() {
+    // Builders notice the flag between glyphs and exit without
+    // publishing.  We cannot wait for them here because this runs
+    // under the loader lock, so FontCache objects are left alive.
+    g_cancel.store(true);
+    std::lock_guard<std::mutex> lock(g_fontMutex);
+    g_fontToCache.clear();
+    for (auto& kv : g_cachesByKey) {
+        ReleaseCacheFile(kv.second->file.exchange(nullptr));
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2025
+//
+// Persistent glyph cache for the text renderer.  Whenever the game
+// creates a font we rasterise the game's character set for it on
+// background threads and store the coverage bitmaps in a versioned
+// file under `glyph_cache\` next to digi.exe.  Later launches map that
+// file and answer glyph requests without calling GetGlyphOutlineW.
+
+#pragma once
+
+#include <windows.h>
+
+// Coverage bitmap for a single glyph.  `coverage` points into the
+// mapped cache file and holds width*height GGO_GRAY8 values (0-64)
+// with no row padding.  The lookup holds a reference on the mapping
+// through `file`, so the pointer stays valid until ReleaseCachedGlyph
+// even if the cache is shut down meanwhile.
+struct CachedGlyph {
+    int                  width;
+    int                  height;
+    int                  advance;
+    int                  bearingX;
+    int                  bearingY;
+    const unsigned char* coverage;
+    void*                file;
+};
+
+// Associate a newly created font with its cache file.  If the file
+// for this face/size/weight already exists it is mapped immediately,
+// otherwise a background build is started.  Safe to call for the same
+// LOGFONT many times.
+void RegisterGlyphCacheFont(HFONT font, const LOGFONTA& lf);
+
+// Look up a glyph for `font`.  Returns false if the font is unknown,
+// its cache is still being built or the character is not cached.  A
+// successful lookup must be paired with ReleaseCachedGlyph once the
+// coverage has been read.
+bool LookupCachedGlyph(HFONT font, UINT ch, CachedGlyph* out);
+void ReleaseCachedGlyph(CachedGlyph* glyph);
+
+// Forget which cache file `font` uses.  Called when the font is
+// deleted; the file stays mapped for other fonts of the same face.
+void ForgetGlyphCacheFont(HFONT font);
+
+// Stop outstanding builds and unmap every cache file.
+void ShutdownGlyphCache();
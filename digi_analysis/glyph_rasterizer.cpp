@@ -0,0 +1,202 @@
+// Copyright (c) 2025
+//
+// Worker pool for glyph rasterisation.  See glyph_rasterizer.h.
+
+#include "glyph_rasterizer.h"
+#include "sdf_text.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace {
+    // Enough for a 128x128 glyph with GDI's 4-byte row padding, which
+    // covers every font size the game creates.
+    const DWORD kScratchSize = 128 * 128;
+    const DWORD kMaxWorkers  = 2;
+
+    struct RasterRequest {
+        HFONT font;
+        UINT  code;
+        bool  wide;
+        bool  sdf;
+    };
+
+    std::mutex                  g_queueMutex;
+    std::condition_variable     g_queueCv;
+    std::deque<RasterRequest>   g_requests;
+    std::condition_variable     g_resultCv;
+    std::vector<RasterizedGlyph> g_results;
+    std::vector<HANDLE>         g_workers;
+    bool                        g_started = false;
+    bool                        g_stopping = false;
+
+    DWORD WINAPI RasterWorkerThread(LPVOID) {
+        HDC dc = CreateCompatibleDC(nullptr);
+        if (!dc) {
+            return 1;
+        }
+        HGDIOBJ defaultFont = GetCurrentObject(dc, OBJ_FONT);
+        HFONT selected = nullptr;
+        for (;;) {
+            RasterRequest req;
+            {
+                std::unique_lock<std::mutex> lock(g_queueMutex);
+                if (g_requests.empty() && selected) {
+                    // Do not keep the game's font selected while idle so
+                    // a DeleteObject on the game thread can free it.
+                    SelectObject(dc, defaultFont);
+                    selected = nullptr;
+                }
+                g_queueCv.wait(lock, [] { return g_stopping || !g_requests.empty(); });
+                if (g_stopping) {
+                    break;
+                }
+                req = g_requests.front();
+                g_requests.pop_front();
+            }
+            if (req.font != selected) {
+                SelectObject(dc, req.font ? (HGDIOBJ)req.font : defaultFont);
+                selected = req.font;
+            }
+            RasterizedGlyph glyph;
+            RasterizeGlyph(dc, req.code, req.wide, &glyph);
+            glyph.font = req.font;
+            if (req.sdf) {
+                ConvertGlyphToDistanceField(&glyph);
+            }
+            {
+                std::lock_guard<std::mutex> lock(g_queueMutex);
+                g_results.push_back(std::move(glyph));
+            }
+            g_resultCv.notify_all();
+        }
+        SelectObject(dc, defaultFont);
+        DeleteDC(dc);
+        return 0;
+    }
+
+    bool StartWorkers() {
+        if (g_started) {
+            return !g_workers.empty();
+        }
+        g_started = true;
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        DWORD count = si.dwNumberOfProcessors > 1 ? si.dwNumberOfProcessors - 1 : 1;
+        count = std::min(count, kMaxWorkers);
+        for (DWORD i = 0; i < count; ++i) {
+            HANDLE t = CreateThread(nullptr, 0, RasterWorkerThread, nullptr, 0, nullptr);
+            if (t) {
+                g_workers.push_back(t);
+            }
+        }
+        return !g_workers.empty();
+    }
+}
+
+bool RasterizeGlyph(HDC hdc, UINT code, bool wide, RasterizedGlyph* out) {
+    static thread_local std::vector<BYTE> scratch(kScratchSize);
+    MAT2 mat = {{0,1},{0,0},{0,0},{0,1}};
+    GLYPHMETRICS gm;
+    out->code = code;
+    out->wide = wide;
+    out->sdf = false;
+    out->ok = false;
+    out->width = out->height = out->advance = out->bearingX = out->bearingY = 0;
+    out->coverage.clear();
+
+    // Try to fetch the bitmap in one call.  GDI fails the call when the
+    // buffer is too small, in which case we fall back to the classic
+    // size query followed by a second call.
+    DWORD size = wide
+        ? GetGlyphOutlineW(hdc, code, GGO_GRAY8_BITMAP, &gm, kScratchSize, scratch.data(), &mat)
+        : GetGlyphOutlineA(hdc, code, GGO_GRAY8_BITMAP, &gm, kScratchSize, scratch.data(), &mat);
+    if (size == GDI_ERROR) {
+        size = wide
+            ? GetGlyphOutlineW(hdc, code, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &mat)
+            : GetGlyphOutlineA(hdc, code, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &mat);
+        if (size == GDI_ERROR) {
+            return false;
+        }
+        if (size > scratch.size()) {
+            scratch.resize(size);
+        }
+        if (size != 0) {
+            DWORD got = wide
+                ? GetGlyphOutlineW(hdc, code, GGO_GRAY8_BITMAP, &gm, size, scratch.data(), &mat)
+                : GetGlyphOutlineA(hdc, code, GGO_GRAY8_BITMAP, &gm, size, scratch.data(), &mat);
+            if (got == GDI_ERROR) {
+                return false;
+            }
+        }
+    }
+    out->advance  = gm.gmCellIncX;
+    out->bearingX = gm.gmptGlyphOrigin.x;
+    out->bearingY = gm.gmptGlyphOrigin.y;
+    if (size == 0) {
+        // Blank glyph such as a space: metrics only.
+        return false;
+    }
+    out->width  = static_cast<int>(gm.gmBlackBoxX);
+    out->height = static_cast<int>(gm.gmBlackBoxY);
+    size_t pitch = (gm.gmBlackBoxX + 3) & ~3u;
+    out->coverage.resize(static_cast<size_t>(out->width) * out->height);
+    for (int y = 0; y < out->height; ++y) {
+        std::copy_n(&scratch[y * pitch], out->width, &out->coverage[static_cast<size_t>(y) * out->width]);
+    }
+    out->ok = true;
+    return true;
+}
+
+bool RequestGlyphRaster(HFONT font, UINT code, bool wide, bool sdf) {
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        if (g_stopping || !StartWorkers()) {
+            return false;
+        }
+        g_requests.push_back(RasterRequest{ font, code, wide, sdf });
+    }
+    g_queueCv.notify_one();
+    return true;
+}
+
+size_t CollectRasterizedGlyphs(std::vector<RasterizedGlyph>* out, unsigned timeoutMicros) {
+    std::unique_lock<std::mutex> lock(g_queueMutex);
+    if (g_results.empty() && timeoutMicros != 0) {
+        g_resultCv.wait_for(lock, std::chrono::microseconds(timeoutMicros),
+                            [] { return !g_results.empty(); });
+    }
+    size_t count = g_results.size();
+    for (RasterizedGlyph& g : g_results) {
+        out->push_back(std::move(g));
+    }
+    g_results.clear();
+    return count;
+}
+
+void CancelGlyphRasters(HFONT font) {
+    std::lock_guard<std::mutex> lock(g_queueMutex);
+    g_requests.erase(std::remove_if(g_requests.begin(), g_requests.end(),
+                                    [font](const RasterRequest& r) { return r.font == font; }),
+                     g_requests.end());
+    g_results.erase(std::remove_if(g_results.begin(), g_results.end(),
+                                   [font](const RasterizedGlyph& g) { return g.font == font; }),
+                    g_results.end());
+}
+
+void ShutdownGlyphRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(g_queueMutex);
+        g_stopping = true;
+        g_requests.clear();
+    }
+    g_queueCv.notify_all();
+    // Workers exit on their own; waiting here could deadlock on the
+    // loader lock during DLL_PROCESS_DETACH.
+    for (HANDLE t : g_workers) {
+        CloseHandle(t);
+    }
+    g_workers.clear();
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2025
+//
+// Background glyph rasterisation.  Glyph cache misses in TextRenderer
+// are queued here and rasterised by a small pool of worker threads,
+// each with its own memory DC, so GetGlyphOutline never runs on the
+// game thread.  Finished coverage bitmaps are collected by the game
+// thread and turned into textures there.
+
+#pragma once
+
+#include <windows.h>
+#include <vector>
+
+// Result of rasterising one glyph.  `coverage` holds width*height
+// GGO_GRAY8 values (0-64) with no row padding, or for `sdf` requests
+// a distance field as produced by ConvertGlyphToDistanceField.  `ok`
+// is false when the font has no outline for the character; the
+// metrics are still valid so the caller can advance the pen.
+struct RasterizedGlyph {
+    HFONT                      font;
+    UINT                       code;
+    bool                       wide;
+    bool                       sdf;
+    bool                       ok;
+    int                        width;
+    int                        height;
+    int                        advance;
+    int                        bearingX;
+    int                        bearingY;
+    std::vector<unsigned char> coverage;
+};
+
+// Rasterise a glyph on the calling thread into `out`.  `hdc` must
+// already have the desired font selected.  Uses a single
+// GetGlyphOutline call whenever the bitmap fits the scratch buffer.
+bool RasterizeGlyph(HDC hdc, UINT code, bool wide, RasterizedGlyph* out);
+
+// Queue a glyph for the worker pool.  The pool is started on first
+// use.  With `sdf` set the worker also converts the result into a
+// distance field.  Returns false if no worker could be started, in
+// which case the caller should rasterise synchronously.
+bool RequestGlyphRaster(HFONT font, UINT code, bool wide, bool sdf);
+
+// Move every finished glyph into `out` and return how many were added.
+// If nothing is ready and `timeoutMicros` is non-zero, wait up to that
+// long for the next result.
+size_t CollectRasterizedGlyphs(std::vector<RasterizedGlyph>* out, unsigned timeoutMicros);
+
+// Drop the queued requests and undelivered results for `font`.  A
+// request already being worked on still delivers its result.
+void CancelGlyphRasters(HFONT font);
+
+// Stop the worker pool.  Pending requests are discarded.
+void ShutdownGlyphRasterizer();
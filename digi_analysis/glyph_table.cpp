@@ -0,0 +1,170 @@
+// Copyright (c) 2025
+//
+// Implementation of the bounded glyph texture cache.  See
+// glyph_table.h.
+
+#include "glyph_table.h"
+#include "d3d8_gl_bridge.h"
+#include "opengl_utils.h"
+
+namespace {
+    const size_t kInitialSlots = 256;
+
+    // Accounted size of one glyph: its RGBA texture plus the slot.
+    uint32_t EntryBytes(const GlyphInfo& info, size_t slotSize) {
+        size_t texBytes = info.texture ? static_cast<size_t>(info.width) * info.height * 4 : 0;
+        return static_cast<uint32_t>(texBytes + slotSize);
+    }
+}
+
+GlyphTable::GlyphTable(size_t budgetBytes)
+    : m_slots(kInitialSlots), m_mask(kInitialSlots - 1), m_hand(0), m_stats{} {
+    m_stats.budget = budgetBytes;
+}
+
+// splitmix64 finaliser over the packed key.  The old XOR of the raw
+// fields put most glyphs of a font into a handful of buckets.
+uint64_t GlyphTable::Hash(const GlyphKey& key) {
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key.font));
+    h ^= (static_cast<uint64_t>(key.code) << 32) | (static_cast<uint64_t>(key.color) << 1) | (key.wide ? 1u : 0u);
+    h += 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+// Index of the slot holding `key`, or of the empty slot where it
+// would be inserted.
+size_t GlyphTable::Probe(const GlyphKey& key) const {
+    size_t i = static_cast<size_t>(Hash(key)) & m_mask;
+    while (m_slots[i].used && !(m_slots[i].key == key)) {
+        i = (i + 1) & m_mask;
+    }
+    return i;
+}
+
+GlyphInfo* GlyphTable::Find(const GlyphKey& key) {
+    Slot& slot = m_slots[Probe(key)];
+    if (!slot.used) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+    ++m_stats.hits;
+    slot.referenced = true;
+    return &slot.info;
+}
+
+GlyphInfo* GlyphTable::Insert(const GlyphKey& key, const GlyphInfo& info) {
+    uint32_t bytes = EntryBytes(info, sizeof(Slot));
+    if (m_stats.bytes + bytes > m_stats.budget) {
+        EvictUntil(m_stats.budget > bytes ? m_stats.budget - bytes : 0);
+    }
+    // Keep the load factor at or below one half.
+    if ((m_stats.entries + 1) * 2 > m_slots.size()) {
+        Grow();
+    }
+    size_t i = Probe(key);
+    Slot& slot = m_slots[i];
+    if (slot.used) {
+        // Replacing an existing entry; retire its texture.
+        if (slot.info.texture) {
+            RetireTexture(slot.info.texture);
+        }
+        m_stats.bytes -= slot.bytes;
+        --m_stats.entries;
+    }
+    slot.key        = key;
+    slot.info       = info;
+    slot.bytes      = bytes;
+    slot.used       = true;
+    slot.referenced = true;
+    m_stats.bytes += bytes;
+    ++m_stats.entries;
+    return &slot.info;
+}
+
+void GlyphTable::SetBudget(size_t budgetBytes) {
+    m_stats.budget = budgetBytes;
+    if (m_stats.bytes > budgetBytes) {
+        EvictUntil(budgetBytes);
+    }
+}
+
+size_t GlyphTable::EraseFont(HFONT font) {
+    size_t erased = 0;
+    size_t i = 0;
+    while (i < m_slots.size()) {
+        if (m_slots[i].used && m_slots[i].key.font == font) {
+            // EraseAt may shift a later entry into this slot, so look
+            // at it again.
+            EraseAt(i);
+            ++erased;
+        } else {
+            ++i;
+        }
+    }
+    return erased;
+}
+
+void GlyphTable::Grow() {
+    std::vector<Slot> old;
+    old.swap(m_slots);
+    m_slots.assign(old.size() * 2, Slot{});
+    m_mask = m_slots.size() - 1;
+    m_hand = 0;
+    for (Slot& s : old) {
+        if (s.used) {
+            m_slots[Probe(s.key)] = s;
+        }
+    }
+}
+
+// CLOCK sweep: entries touched since the hand last passed get a second
+// chance, everything else is evicted until we are under `limit`.
+void GlyphTable::EvictUntil(size_t limit) {
+    size_t scanned = 0;
+    size_t maxScan = m_slots.size() * 2;
+    while (m_stats.bytes > limit && m_stats.entries > 0 && scanned < maxScan) {
+        Slot& slot = m_slots[m_hand];
+        ++scanned;
+        if (!slot.used) {
+            m_hand = (m_hand + 1) & m_mask;
+            continue;
+        }
+        if (slot.referenced) {
+            slot.referenced = false;
+            m_hand = (m_hand + 1) & m_mask;
+            continue;
+        }
+        // EraseAt may shift a later entry into this slot, so the hand
+        // stays put and examines it next.
+        EraseAt(m_hand);
+        ++m_stats.evictions;
+    }
+}
+
+// Remove the entry at `index` using backward-shift deletion so probe
+// chains stay intact without tombstones.
+void GlyphTable::EraseAt(size_t index) {
+    Slot& victim = m_slots[index];
+    if (victim.info.texture) {
+        RetireTexture(victim.info.texture);
+    }
+    m_stats.bytes -= victim.bytes;
+    --m_stats.entries;
+    size_t hole = index;
+    size_t next = (hole + 1) & m_mask;
+    while (m_slots[next].used) {
+        size_t home = static_cast<size_t>(Hash(m_slots[next].key)) & m_mask;
+        // Move the entry back if its home position is not in the
+        // cyclic range (hole, next].
+        bool inRange = (hole <= next) ? (home > hole && home <= next)
+                                      : (home > hole || home <= next);
+        if (!inRange) {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+        }
+        next = (next + 1) & m_mask;
+    }
+    m_slots[hole] = Slot{};
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2025
+//
+// Bounded glyph texture cache used by TextRenderer.  Entries live in a
+// single open-addressed array (linear probing, backward-shift
+// deletion) so lookups touch one or two cache lines.  The total size
+// of the glyph textures is capped by a byte budget; when an insert
+// would exceed it, entries are evicted with the CLOCK algorithm and
+// their textures are handed to the render thread for release.
+
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class IDirect3DTexture8;
+
+struct GlyphInfo {
+    IDirect3DTexture8* texture;
+    int width;
+    int height;
+    int advance;
+    int bearingX;
+    int bearingY;
+};
+
+struct GlyphKey {
+    HFONT    font;
+    UINT     code;
+    COLORREF color;
+    bool     wide;
+    bool operator==(const GlyphKey& other) const {
+        return font == other.font && code == other.code && color == other.color && wide == other.wide;
+    }
+};
+
+struct GlyphTableStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t   entries;
+    size_t   bytes;
+    size_t   budget;
+};
+
+class GlyphTable {
+public:
+    explicit GlyphTable(size_t budgetBytes);
+
+    // Returns the cached glyph or nullptr.  The pointer is only valid
+    // until the next call to Insert.
+    GlyphInfo* Find(const GlyphKey& key);
+
+    // Insert a glyph, evicting older entries if the byte budget would
+    // be exceeded.  Takes ownership of `info.texture`.
+    GlyphInfo* Insert(const GlyphKey& key, const GlyphInfo& info);
+
+    // Change the byte budget, evicting immediately if necessary.
+    void SetBudget(size_t budgetBytes);
+
+    // Remove every glyph of `font`, retiring its textures, and return
+    // how many were removed.  Not counted as evictions.
+    size_t EraseFont(HFONT font);
+
+    // Number of evictions so far.  Callers holding texture pointers
+    // taken from the table compare this before and after a batch of
+    // inserts to detect that some of them may have been retired.
+    uint64_t Generation() const { return m_stats.evictions; }
+
+    GlyphTableStats Stats() const { return m_stats; }
+
+private:
+    struct Slot {
+        GlyphKey  key;
+        GlyphInfo info;
+        uint32_t  bytes;
+        bool      used;
+        bool      referenced;
+    };
+
+    static uint64_t Hash(const GlyphKey& key);
+    size_t Probe(const GlyphKey& key) const;
+    void Grow();
+    void EvictUntil(size_t limit);
+    void EraseAt(size_t index);
+
+    std::vector<Slot> m_slots;
+    size_t            m_mask;
+    size_t            m_hand;
+    GlyphTableStats   m_stats;
+};
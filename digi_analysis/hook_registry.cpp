@@ -0,0 +1,95 @@
+// Copyright (c) 2025
+//
+// Hook table installation.  See hook_registry.h.
+
+#include "hook_registry.h"
+#include <windows.h>
+#include <cstdio>
+#include "MinHook.h"
+#include "function_tracer.h"
+
+namespace {
+    // Totals across all tables since the last ApplyQueuedHooks.  Hooks
+    // are installed from DllMain on one thread, so no locking.
+    size_t   g_created  = 0;
+    size_t   g_failed   = 0;
+    LONGLONG g_createTicks = 0;
+
+    LONGLONG Now() {
+        LARGE_INTEGER t;
+        QueryPerformanceCounter(&t);
+        return t.QuadPart;
+    }
+
+    double Microseconds(LONGLONG ticks) {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        return static_cast<double>(ticks) * 1e6 / static_cast<double>(freq.QuadPart);
+    }
+
+    void* ResolveTarget(const HookSpec& spec) {
+        if (!spec.module) {
+            return reinterpret_cast<void*>(spec.address);
+        }
+        HMODULE module = GetModuleHandleA(spec.module);
+        if (!module) {
+            return nullptr;
+        }
+        return reinterpret_cast<void*>(GetProcAddress(module, spec.symbol));
+    }
+
+    void ReportFailure(const char* group, const HookSpec& spec, const char* reason) {
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "[Hooks] %s: %s failed: %s\n", group, spec.name, reason);
+        OutputDebugStringA(buf);
+    }
+}
+
+size_t InstallHookTable(const char* group, const HookSpec* table, size_t count) {
+    LONGLONG start = Now();
+    size_t queued = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const HookSpec& spec = table[i];
+        void* target = ResolveTarget(spec);
+        if (!target) {
+            ReportFailure(group, spec, "target not found");
+            ++g_failed;
+            continue;
+        }
+        // With the tracer running, MinHook jumps to a timing thunk that
+        // enters the detour; see function_tracer.h.
+        void* detour = WrapWithTracer(spec.name, reinterpret_cast<uintptr_t>(target), spec.detour);
+        MH_STATUS status = MH_CreateHook(target, detour, spec.original);
+        if (status == MH_OK) {
+            status = MH_QueueEnableHook(target);
+        }
+        if (status != MH_OK) {
+            ReportFailure(group, spec, MH_StatusToString(status));
+            ++g_failed;
+            continue;
+        }
+        ++queued;
+    }
+    g_created += queued;
+    g_createTicks += Now() - start;
+    return queued;
+}
+
+bool ApplyQueuedHooks() {
+    LONGLONG start = Now();
+    MH_STATUS status = MH_ApplyQueued();
+    double applyUs  = Microseconds(Now() - start);
+    double createUs = Microseconds(g_createTicks);
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+                  "[Hooks] %u hooks installed, %u failed; create %.1f us, apply %.1f us (%s)\n",
+                  static_cast<unsigned>(g_created), static_cast<unsigned>(g_failed),
+                  createUs, applyUs, MH_StatusToString(status));
+    OutputDebugStringA(buf);
+
+    g_created = 0;
+    g_failed = 0;
+    g_createTicks = 0;
+    return status == MH_OK;
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2025
+//
+// Declarative hook tables.  Every detour is described by one HookSpec
+// row, grouped into a table per source file (hooks.cpp for digi.exe
+// addresses, gdi_hooks.cpp for GDI32 exports).  InstallHookTable
+// creates each row's hook and queues it for enabling; once every table
+// is registered, ApplyQueuedHooks enables the lot with a single
+// MH_ApplyQueued, i.e. one suspend/resume of the process's threads
+// however many detours there are.
+//
+// Adding a detour for a reconstructed function is therefore a matter
+// of adding a row: no extra MH_CreateHook call, no extra freeze, and a
+// failure to hook one target is reported and skipped rather than
+// silently ignored.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct HookSpec {
+    // Name used in reports.
+    const char* name;
+    // Target: an export of `module` when `module` is set, otherwise
+    // the absolute address `address` inside digi.exe.
+    const char* module;
+    const char* symbol;
+    uintptr_t   address;
+    // Replacement, and where MinHook stores the trampoline to the
+    // original.  `original` may be null for detours that never call
+    // through.
+    void*       detour;
+    void**      original;
+};
+
+// Create and queue every hook in `table`.  Rows whose target cannot be
+// resolved or hooked are logged and skipped.  Returns the number of
+// hooks queued.  MH_Initialize must have been called.
+size_t InstallHookTable(const char* group, const HookSpec* table, size_t count);
+
+template <size_t N>
+size_t InstallHookTable(const char* group, const HookSpec (&table)[N]) {
+    return InstallHookTable(group, table, N);
+}
+
+// Enable every queued hook in one batch and log a summary of the
+// install: hooks created and failed across all tables, and the time
+// spent creating and applying them.  Returns false if the batch could
+// not be applied.
+bool ApplyQueuedHooks();
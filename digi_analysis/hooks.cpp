@@ -9,6 +9,8 @@
 #include "hooks.h"
 #include <windows.h>
 #include <cstdint>
+#include <atomic>
+#include <cstdlib>
 #include <vector>
 #include "functions.h"
 #include "text_renderer.h"
@@ -21,6 +23,12 @@ extern "C" void __stdcall sub_004A1F8A();
 
 // Include MinHook.  The header is provided in third_party/minhook/include.
 #include "MinHook.h"
+#include "function_tracer.h"
+#include "hook_registry.h"
+#include "import_profiler.h"
+#include "sampling_profiler.h"
+#include "call_site_patcher.h"
+#include "ab_benchmark.h"
 
 // Type definition for the original function at 0x401000.  When using
 // MinHook we request the original pointer so we can call through if
@@ -102,10 +110,17 @@ static OrigFunc00495DEB s_orig00495DEB = nullptr;
 
 // 0x00486730: ExtractAndProcessFontMetrics(int* fontMetricsArray, HANDLE currentHandle,
 //                                           void** fontMetricsArrayPtr) -> int
-using OrigFunc00486730 = int(__cdecl*)(int*, HANDLE, void**);
+// This is the statically linked D3DXCreateFont(device, HFONT, ppFont):
+// it reads the LOGFONT with GetObjectA and hands it to the create
+// routine at 0x00486655.  The function cleans its own arguments
+// (ret 0Ch), so it is __stdcall.
+using OrigFunc00486730 = int(__stdcall*)(int*, HANDLE, void**);
 static OrigFunc00486730 s_orig00486730 = nullptr;
 
 // 0x00429170: MeasureStringDimensions(this, undefined4, int, undefined4) -> void
+// Stores the string at this+0x1C, selects font table entry `param2`
+// into the shared measuring DC and writes GetTextExtentPoint32A's
+// result to this+0x14/0x18.
 using OrigFunc00429170 = void(__thiscall*)(void*, unsigned int, int, unsigned int);
 static OrigFunc00429170 s_orig00429170 = nullptr;
 
@@ -132,11 +147,12 @@ static unsigned int* __fastcall Detour00495F5B(void* _this, void* /*not used*/,
     if (!a7) {
         return a1;
     }
-    HDC hdc = GetDC(nullptr);
+    // Use the thread's cached DC and font instead of acquiring a screen
+    // DC per call.  Repeated strings are answered from the layout cache
+    // inside TextRenderer without touching GDI at all.
+    HDC hdc = TextRenderer::GetThreadDC();
     if (hdc) {
-        HFONT font = (HFONT)GetStockObject(SYSTEM_FONT);
-        TextRenderer::DrawTextW(hdc, font, 0, 0, a7, lstrlenW(a7), RGB(255,255,255));
-        ReleaseDC(nullptr, hdc);
+        TextRenderer::DrawTextW(hdc, TextRenderer::GetDefaultFont(), 0, 0, a7, lstrlenW(a7), RGB(255,255,255));
     }
     return a1;
 }
@@ -163,11 +179,16 @@ static int __fastcall Detour00495DEB(int param1, void* unused) {
     return s_orig00495DEB ? s_orig00495DEB(param1, unused) : 0;
 }
 
-static int Detour00486730(int* fontMetricsArray, HANDLE currentHandle, void** fontMetricsArrayPtr) {
+// The GetObjectA call inside is answered by the metrics cache in
+// gdi_hooks.cpp for every font the game created.
+static int __stdcall Detour00486730(int* fontMetricsArray, HANDLE currentHandle, void** fontMetricsArrayPtr) {
     OutputDebugStringA("Detour00486730: ExtractAndProcessFontMetrics called\n");
     return s_orig00486730 ? s_orig00486730(fontMetricsArray, currentHandle, fontMetricsArrayPtr) : -1;
 }
 
+// The original keeps its MFC string and font selection bookkeeping;
+// the measurement itself goes through the GetTextExtentPoint32A detour
+// and is answered from the per-font metrics table.
 static void __fastcall Detour00429170(void* _this, void* /*not used*/, unsigned int param1, int param2, unsigned int param3) {
     OutputDebugStringA("Detour00429170: MeasureStringDimensions called\n");
     if (s_orig00429170) {
@@ -220,9 +241,71 @@ static void Detour004A1F8A() {
     }
 }
 
-// Installs the hooks for all reconstructed functions.  Additional
-// functions can be hooked by repeating the call to MH_CreateHook
-// with the appropriate addresses.
+// Hooks into digi.exe, one row per detour.  The sine routines come
+// first, then the entry point stub, then the text and font routines.
+// Add reconstructed functions here; see hook_registry.h.
+static const HookSpec kGameHooks[] = {
+    { "SinLookup", nullptr, nullptr, 0x00401000,
+      reinterpret_cast<void*>(&Detour401000), reinterpret_cast<void**>(&s_orig401000) },
+    { "SinLookupOffset", nullptr, nullptr, 0x00401020,
+      reinterpret_cast<void*>(&Detour401020), reinterpret_cast<void**>(&s_orig401020) },
+    { "SinWrapper", nullptr, nullptr, 0x00401040,
+      reinterpret_cast<void*>(&Detour401040), reinterpret_cast<void**>(&s_orig401040) },
+    { "SinOffsetWrapper", nullptr, nullptr, 0x00401050,
+      reinterpret_cast<void*>(&Detour401050), reinterpret_cast<void**>(&s_orig401050) },
+    { "EntryPoint", nullptr, nullptr, 0x004A1F8A,
+      reinterpret_cast<void*>(&Detour004A1F8A), reinterpret_cast<void**>(&s_orig004A1F8A) },
+    { "ProcessFontsAndMetrics", nullptr, nullptr, 0x00428EE0,
+      reinterpret_cast<void*>(&Detour00428EE0), reinterpret_cast<void**>(&s_orig00428EE0) },
+    { "CreateTextRenderSurface", nullptr, nullptr, 0x00495E1A,
+      reinterpret_cast<void*>(&Detour00495E1A), reinterpret_cast<void**>(&s_orig00495E1A) },
+    { "RenderText", nullptr, nullptr, 0x00495F5B,
+      reinterpret_cast<void*>(&Detour00495F5B), reinterpret_cast<void**>(&s_orig00495F5B) },
+    { "CDWWnd::PreCreateWindow", nullptr, nullptr, 0x0040EA40,
+      reinterpret_cast<void*>(&Detour0040EA40), reinterpret_cast<void**>(&s_orig0040EA40) },
+    { "TextRenderState::Initialize", nullptr, nullptr, 0x00492EFF,
+      reinterpret_cast<void*>(&Detour00492EFF), reinterpret_cast<void**>(&s_orig00492EFF) },
+    { "FreeTextSurfaceResources", nullptr, nullptr, 0x00495AE4,
+      reinterpret_cast<void*>(&Detour00495AE4), reinterpret_cast<void**>(&s_orig00495AE4) },
+    { "RestoreSelectedGDIObject", nullptr, nullptr, 0x00495DEB,
+      reinterpret_cast<void*>(&Detour00495DEB), reinterpret_cast<void**>(&s_orig00495DEB) },
+    { "ExtractAndProcessFontMetrics", nullptr, nullptr, 0x00486730,
+      reinterpret_cast<void*>(&Detour00486730), reinterpret_cast<void**>(&s_orig00486730) },
+    { "MeasureStringDimensions", nullptr, nullptr, 0x00429170,
+      reinterpret_cast<void*>(&Detour00429170), reinterpret_cast<void**>(&s_orig00429170) },
+};
+
+// Direct calls to the sine lookups, retargeted at the replacements so
+// the hot loops skip the detour; see call_site_patcher.h.  The wrappers
+// at 0x401040 and 0x401050 are all the game calls directly, and they
+// only forward to 0x401020 and 0x401000, so their call sites go
+// straight to the underlying lookup.
+static const CallSiteRedirect kSinCallSites[] = {
+    { "SinLookup",        0x00401000, 0x12, reinterpret_cast<void*>(&func_401000) },
+    { "SinLookupOffset",  0x00401020, 0x17, reinterpret_cast<void*>(&func_401020) },
+    { "SinWrapper",       0x00401040, 0x0E, reinterpret_cast<void*>(&func_401020) },
+    { "SinOffsetWrapper", 0x00401050, 0x0E, reinterpret_cast<void*>(&func_401000) },
+};
+
+// Reconstructions timed against the originals' trampolines when
+// DIGI_AB_BENCH is set; see ab_benchmark.h.  Add a row here whenever a
+// reconstruction lands.  The wrappers' originals call 0x401020 and
+// 0x401000, whose detours would run func_401020 and func_401000, so
+// those hooks are listed as callees and are off while the row runs.
+static const AbBenchCase kAbCases[] = {
+    { "SinLookup", 0x00401000, reinterpret_cast<void**>(&s_orig401000),
+      reinterpret_cast<void*>(&func_401000), 1, INT32_MIN, INT32_MAX, 0xFFFF },
+    { "SinLookupOffset", 0x00401020, reinterpret_cast<void**>(&s_orig401020),
+      reinterpret_cast<void*>(&func_401020), 1, INT32_MIN, INT32_MAX, 0xFFFF },
+    { "SinWrapper", 0x00401040, reinterpret_cast<void**>(&s_orig401040),
+      reinterpret_cast<void*>(&func_401040), 1, INT32_MIN, INT32_MAX, 0xFFFF, { 0x00401020 } },
+    { "SinOffsetWrapper", 0x00401050, reinterpret_cast<void**>(&s_orig401050),
+      reinterpret_cast<void*>(&func_401050), 1, INT32_MIN, INT32_MAX, 0xFFFF, { 0x00401000 } },
+};
+
+// Installs the hooks for all reconstructed functions listed in
+// kGameHooks and the GDI table in gdi_hooks.cpp, then enables them in
+// one batch.
 void InstallHooks() {
     // Initialise the hooking library.  Ignore errors for repeated
     // initialisation; MH_Initialize will return MH_ERROR_ALREADY_INITIALIZED
@@ -231,44 +314,66 @@ void InstallHooks() {
     if (status != MH_OK && status != MH_ERROR_ALREADY_INITIALIZED) {
         return;
     }
-    // Create a hook for 0x401000.  On success the original pointer
-    // will be stored in s_orig401000.
-    MH_CreateHook(reinterpret_cast<void*>(0x401000), reinterpret_cast<void*>(&Detour401000), reinterpret_cast<void**>(&s_orig401000));
-    // Create a hook for 0x401020 as well.  This allows you to intercept
-    // calls to the second sine lookup routine.
-    MH_CreateHook(reinterpret_cast<void*>(0x401020), reinterpret_cast<void*>(&Detour401020), reinterpret_cast<void**>(&s_orig401020));
-    // Create hooks for the simple wrapper functions at 0x401040 and 0x401050.
-    MH_CreateHook(reinterpret_cast<void*>(0x401040), reinterpret_cast<void*>(&Detour401040), reinterpret_cast<void**>(&s_orig401040));
-    MH_CreateHook(reinterpret_cast<void*>(0x401050), reinterpret_cast<void*>(&Detour401050), reinterpret_cast<void**>(&s_orig401050));
-    // Create a hook for the new function at 0x004A1F8A.
-    MH_CreateHook(reinterpret_cast<void*>(0x004A1F8A), reinterpret_cast<void*>(&Detour004A1F8A), reinterpret_cast<void**>(&s_orig004A1F8A));
-    // ---------------------------------------------------------------------
-    // Install hooks for text and font processing functions.  These
-    // addresses are taken from the disassembly provided by the user.  Each
-    // call will be logged and forwarded to the original implementation
-    // through the s_origXXXX function pointers defined above.  Once you
-    // understand the behaviour of these routines you can replace the
-    // calls to the originals with custom code.
-    MH_CreateHook(reinterpret_cast<void*>(0x00428EE0), reinterpret_cast<void*>(&Detour00428EE0), reinterpret_cast<void**>(&s_orig00428EE0));
-    MH_CreateHook(reinterpret_cast<void*>(0x00495E1A), reinterpret_cast<void*>(&Detour00495E1A), reinterpret_cast<void**>(&s_orig00495E1A));
-    MH_CreateHook(reinterpret_cast<void*>(0x00495F5B), reinterpret_cast<void*>(&Detour00495F5B), reinterpret_cast<void**>(&s_orig00495F5B));
-    MH_CreateHook(reinterpret_cast<void*>(0x0040EA40), reinterpret_cast<void*>(&Detour0040EA40), reinterpret_cast<void**>(&s_orig0040EA40));
-    MH_CreateHook(reinterpret_cast<void*>(0x00492EFF), reinterpret_cast<void*>(&Detour00492EFF), reinterpret_cast<void**>(&s_orig00492EFF));
-    MH_CreateHook(reinterpret_cast<void*>(0x00495AE4), reinterpret_cast<void*>(&Detour00495AE4), reinterpret_cast<void**>(&s_orig00495AE4));
-    // Hook RestoreSelectedGDIObject at 0x00495DEB.
-    MH_CreateHook(reinterpret_cast<void*>(0x00495DEB), reinterpret_cast<void*>(&Detour00495DEB), reinterpret_cast<void**>(&s_orig00495DEB));
-    // Hook ExtractAndProcessFontMetrics at 0x00486730.
-    MH_CreateHook(reinterpret_cast<void*>(0x00486730), reinterpret_cast<void*>(&Detour00486730), reinterpret_cast<void**>(&s_orig00486730));
-    // Hook MeasureStringDimensions at 0x00429170.
-    MH_CreateHook(reinterpret_cast<void*>(0x00429170), reinterpret_cast<void*>(&Detour00429170), reinterpret_cast<void**>(&s_orig00429170));
+    // DIGI_TRACE=<path> times every hook below and dumps the results
+    // to <path> when the DLL unloads.
+    char tracePath[MAX_PATH];
+    DWORD traceLen = GetEnvironmentVariableA("DIGI_TRACE", tracePath, MAX_PATH);
+    if (traceLen > 0 && traceLen < MAX_PATH) {
+        StartFunctionTracer(tracePath);
+    }
+    // DIGI_PROFILE_IMPORTS=<path> times every call through digi.exe's
+    // import table; see import_profiler.h.
+    char importPath[MAX_PATH];
+    DWORD importLen = GetEnvironmentVariableA("DIGI_PROFILE_IMPORTS", importPath, MAX_PATH);
+    if (importLen > 0 && importLen < MAX_PATH) {
+        StartImportProfiler(importPath);
+    }
+    // DIGI_SAMPLE=<path> samples the game thread into folded stacks;
+    // DIGI_SAMPLE_HZ overrides the default rate.
+    char samplePath[MAX_PATH];
+    DWORD sampleLen = GetEnvironmentVariableA("DIGI_SAMPLE", samplePath, MAX_PATH);
+    if (sampleLen > 0 && sampleLen < MAX_PATH) {
+        char hz[16];
+        DWORD hzLen = GetEnvironmentVariableA("DIGI_SAMPLE_HZ", hz, sizeof(hz));
+        StartSamplingProfiler(samplePath, hzLen > 0 && hzLen < sizeof(hz) ? std::atoi(hz) : 0);
+    }
+    InstallHookTable("digi.exe", kGameHooks);
     // Install hooks for GDI functions.  These hooks allow us to
     // intercept calls to CreateCompatibleDC, CreateFontA, etc. and
     // replace them with OpenGL-aware implementations.  The function
     // is defined in gdi_hooks.cpp.
     extern void InstallGDIHooks();
     InstallGDIHooks();
-    // Enable all hooks at once.  If needed you can enable/disable
-    // individual hooks by passing the target address instead of
-    // MH_ALL_HOOKS.
-    MH_EnableHook(MH_ALL_HOOKS);
-}
\ No newline at end of file
+    // Serve asset reads out of the mapped archive when there is one;
+    // see file_hooks.cpp.
+    extern void InstallFileHooks();
+    InstallFileHooks();
+    // Enable everything queued above with a single thread freeze and
+    // report how long the install took.
+    ApplyQueuedHooks();
+    // Patched call sites bypass the detours, and with them the tracer
+    // thunks, so leave them alone while tracing.
+    if (!IsFunctionTracerRunning()) {
+        RedirectCallSites(kSinCallSites);
+    }
+}
+
+void RunDeferredHookWork() {
+    static std::atomic<bool> s_done(false);
+    if (s_done.exchange(true)) {
+        return;
+    }
+    MeasureFunctionTracerOverhead();
+    // DIGI_CALLSITE_BENCH logs the detour and direct cost of each
+    // lookup.
+    if (GetEnvironmentVariableA("DIGI_CALLSITE_BENCH", nullptr, 0) > 0) {
+        BenchmarkCallSites(kSinCallSites);
+    }
+    // DIGI_AB_BENCH=<path> checks and times each reconstruction
+    // against the original and writes the results as JSON.
+    char abPath[MAX_PATH];
+    DWORD abLen = GetEnvironmentVariableA("DIGI_AB_BENCH", abPath, MAX_PATH);
+    if (abLen > 0 && abLen < MAX_PATH) {
+        RunAbBenchmarks(abPath, kAbCases);
+    }
+}
@@ -4,8 +4,9 @@
 // PC executable at runtime.  Hooks allow you to redirect calls from
 // the original code to your reconstructed functions in this project.
 //
-// This header declares a single function, `InstallHooks()`, which
-// initialises MinHook and installs all configured detours.  See
+// This header declares `InstallHooks()`, which initialises MinHook and
+// installs all configured detours, and `RunDeferredHookWork()` for what
+// cannot run from DllMain.  See
 // hooks.cpp for the implementation and README.md for usage details.
 
 #pragma once
@@ -14,4 +15,12 @@
 // entry point or from an injected initialisation routine.  It is
 // safe to call `InstallHooks()` multiple times; repeated calls will
 // simply re‑apply the same patches.
-void InstallHooks();
\ No newline at end of file
+void InstallHooks();
+
+// Measure the tracer's overhead and run the benchmarks selected by
+// DIGI_CALLSITE_BENCH and DIGI_AB_BENCH.  These spin for milliseconds,
+// call into the game and disable and enable hooks, none of which may
+// happen under the loader lock, so DllMain cannot run them; the DLL
+// calls this from its first Direct3DCreate8, before the game has
+// started its loop.  Calls after the first do nothing.
+void RunDeferredHookWork();
\ No newline at end of file
@@ -0,0 +1,267 @@
+// Copyright (c) 2025
+//
+// Import table profiler.  See import_profiler.h.
+
+#include "import_profiler.h"
+#include "function_tracer.h"
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    const DWORD kReportEvery = 1000;    // milliseconds between samples
+    const int   kLogEvery    = 5;       // samples between log lines
+    const int   kLogTop      = 8;
+
+    // Imports that must not be routed through a thunk: they read or
+    // rewrite their own return address or caller frame (_EH_prolog,
+    // setjmp), are entered by the exception dispatcher rather than
+    // called, or pass their argument or result on the x87 stack, which
+    // the exit thunk's C++ code is free to use.  Of digi.exe's MSVCRT
+    // imports the last are _CIasin, _CIacos and _ftol (argument in
+    // ST(0)) and floor (result in ST(0)).
+    const char* const kSkipped[] = {
+        "_EH_prolog", "_except_handler3", "__CxxFrameHandler",
+        "_setjmp", "_setjmp3", "longjmp",
+        "_CIasin", "_CIacos", "_ftol", "floor",
+    };
+
+    struct ApiRow {
+        const char* name;
+        uint64_t    calls;
+        uint64_t    cycles;
+        double      rate;       // calls per second over the last sample
+        double      peakRate;
+    };
+
+    char                            g_tablePath[MAX_PATH];
+    std::deque<std::string>         g_names;        // stable storage
+    std::unordered_set<const char*> g_importNames;
+    std::mutex                      g_rowsLock;
+    std::vector<ApiRow>             g_rows;         // index == import
+    HANDLE                          g_reporter = nullptr;
+    std::atomic<bool>               g_stop{false};
+    LARGE_INTEGER                   g_startQpc;
+    bool                            g_started = false;
+
+    bool IsSkipped(const char* name) {
+        for (const char* s : kSkipped) {
+            if (std::strcmp(s, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Data exports (MSVCRT's _adjust_fdiv, _acmdln, ...) sit in the IAT
+    // too; only slots that point at code are instrumented.
+    bool IsCode(const void* address) {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (!VirtualQuery(address, &mbi, sizeof(mbi))) {
+            return false;
+        }
+        const DWORD exec = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+        return (mbi.Protect & exec) != 0;
+    }
+
+    double Seconds(const LARGE_INTEGER& a, const LARGE_INTEGER& b) {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        return static_cast<double>(b.QuadPart - a.QuadPart) / static_cast<double>(freq.QuadPart);
+    }
+
+    // Fold a tracer snapshot into g_rows.  Caller holds g_rowsLock.
+    void UpdateRows(const std::vector<TraceSnapshot>& snap, double interval) {
+        size_t row = 0;
+        for (const TraceSnapshot& s : snap) {
+            if (!g_importNames.count(s.name)) {
+                continue;
+            }
+            if (row == g_rows.size()) {
+                ApiRow r{ s.name, 0, 0, 0.0, 0.0 };
+                g_rows.push_back(r);
+            }
+            ApiRow& r = g_rows[row++];
+            r.rate = interval > 0.0 ? static_cast<double>(s.calls - r.calls) / interval : 0.0;
+            r.peakRate = std::max(r.peakRate, r.rate);
+            r.calls  = s.calls;
+            r.cycles = s.cycles;
+        }
+    }
+
+    void LogTop(double cyclesPerNs) {
+        std::vector<ApiRow> rows;
+        {
+            std::lock_guard<std::mutex> lock(g_rowsLock);
+            rows = g_rows;
+        }
+        std::sort(rows.begin(), rows.end(), [](const ApiRow& a, const ApiRow& b) {
+            return a.rate > b.rate;
+        });
+        char buf[160];
+        OutputDebugStringA("[Imports] busiest APIs (calls/s, mean us):\n");
+        for (int i = 0; i < kLogTop && i < static_cast<int>(rows.size()) && rows[i].rate > 0.0; ++i) {
+            double mean = rows[i].calls ? static_cast<double>(rows[i].cycles) / rows[i].calls / cyclesPerNs / 1e3 : 0.0;
+            std::snprintf(buf, sizeof(buf), "[Imports]   %-40s %10.1f %10.2f\n", rows[i].name, rows[i].rate, mean);
+            OutputDebugStringA(buf);
+        }
+    }
+
+    DWORD WINAPI ReporterThread(LPVOID) {
+        std::vector<TraceSnapshot> snap;
+        LARGE_INTEGER last = g_startQpc;
+        int tick = 0;
+        while (!g_stop.load(std::memory_order_relaxed)) {
+            Sleep(kReportEvery);
+            double cpn = SnapshotFunctionTracer(&snap);
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            {
+                std::lock_guard<std::mutex> lock(g_rowsLock);
+                UpdateRows(snap, Seconds(last, now));
+            }
+            last = now;
+            if (++tick % kLogEvery == 0) {
+                LogTop(cpn);
+            }
+        }
+        return 0;
+    }
+
+    void WriteTable(double cyclesPerNs) {
+        FILE* f = std::fopen(g_tablePath, "w");
+        if (!f) {
+            OutputDebugStringA("[Imports] cannot open table file\n");
+            return;
+        }
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        double elapsed = Seconds(g_startQpc, now);
+        std::vector<ApiRow> rows = g_rows;
+        std::sort(rows.begin(), rows.end(), [](const ApiRow& a, const ApiRow& b) {
+            return a.cycles > b.cycles;
+        });
+        std::fprintf(f, "# digi.exe import profile, %.1f s\n", elapsed);
+        std::fprintf(f, "# api  calls  calls_per_s  peak_per_s  mean_us  total_ms\n");
+        for (const ApiRow& r : rows) {
+            if (r.calls == 0) {
+                continue;
+            }
+            double totalNs = static_cast<double>(r.cycles) / cyclesPerNs;
+            std::fprintf(f, "%s  %llu  %.1f  %.1f  %.3f  %.3f\n", r.name,
+                         static_cast<unsigned long long>(r.calls),
+                         elapsed > 0.0 ? static_cast<double>(r.calls) / elapsed : 0.0,
+                         r.peakRate, totalNs / static_cast<double>(r.calls) / 1e3, totalNs / 1e6);
+        }
+        std::fclose(f);
+    }
+}
+
+int StartImportProfiler(const char* tablePath) {
+    if (g_started || !tablePath || !*tablePath) {
+        return 0;
+    }
+    if (!IsFunctionTracerRunning() && !StartFunctionTracer(nullptr)) {
+        return 0;
+    }
+    lstrcpynA(g_tablePath, tablePath, MAX_PATH);
+
+    BYTE* base = reinterpret_cast<BYTE*>(GetModuleHandleA(nullptr));
+    PIMAGE_NT_HEADERS nt = reinterpret_cast<PIMAGE_NT_HEADERS>(
+        base + reinterpret_cast<PIMAGE_DOS_HEADER>(base)->e_lfanew);
+    const IMAGE_DATA_DIRECTORY& dir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+    if (!dir.VirtualAddress) {
+        return 0;
+    }
+
+    int instrumented = 0;
+    int skipped = 0;
+    for (PIMAGE_IMPORT_DESCRIPTOR desc = reinterpret_cast<PIMAGE_IMPORT_DESCRIPTOR>(base + dir.VirtualAddress);
+         desc->Name; ++desc) {
+        const char* dll = reinterpret_cast<const char*>(base + desc->Name);
+        // The lookup table names the imports; the IAT holds the bound
+        // addresses.  Old linkers leave OriginalFirstThunk zero.
+        PIMAGE_THUNK_DATA names = reinterpret_cast<PIMAGE_THUNK_DATA>(
+            base + (desc->OriginalFirstThunk ? desc->OriginalFirstThunk : desc->FirstThunk));
+        PIMAGE_THUNK_DATA slots = reinterpret_cast<PIMAGE_THUNK_DATA>(base + desc->FirstThunk);
+        for (; names->u1.AddressOfData; ++names, ++slots) {
+            char label[160];
+            const char* func = nullptr;
+            if (IMAGE_SNAP_BY_ORDINAL32(names->u1.Ordinal)) {
+                std::snprintf(label, sizeof(label), "%s!#%u", dll,
+                              static_cast<unsigned>(IMAGE_ORDINAL32(names->u1.Ordinal)));
+            } else {
+                func = reinterpret_cast<PIMAGE_IMPORT_BY_NAME>(base + names->u1.AddressOfData)->Name;
+                std::snprintf(label, sizeof(label), "%s!%s", dll, func);
+            }
+            void* target = reinterpret_cast<void*>(slots->u1.Function);
+            if ((func && IsSkipped(func)) || !IsCode(target)) {
+                ++skipped;
+                continue;
+            }
+            g_names.push_back(label);
+            const char* name = g_names.back().c_str();
+            void* thunk = WrapWithTracer(name, reinterpret_cast<uintptr_t>(target), target);
+            if (thunk == target) {
+                g_names.pop_back();
+                continue;       // out of tracer sites
+            }
+            DWORD old;
+            if (!VirtualProtect(&slots->u1.Function, sizeof(DWORD), PAGE_READWRITE, &old)) {
+                g_names.pop_back();
+                continue;
+            }
+            slots->u1.Function = static_cast<DWORD>(reinterpret_cast<uintptr_t>(thunk));
+            VirtualProtect(&slots->u1.Function, sizeof(DWORD), old, &old);
+            g_importNames.insert(name);
+            ++instrumented;
+        }
+    }
+
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "[Imports] %d imports instrumented, %d skipped\n", instrumented, skipped);
+    OutputDebugStringA(buf);
+
+    QueryPerformanceCounter(&g_startQpc);
+    g_stop.store(false);
+    g_reporter = CreateThread(nullptr, 0, ReporterThread, nullptr, 0, nullptr);
+    g_started = true;
+    return instrumented;
+}
+
+void StopImportProfiler() {
+    if (!g_started) {
+        return;
+    }
+    g_stop.store(true);
+    if (g_reporter) {
+        // Bounded for the same loader-lock reason as the tracer.
+        WaitForSingleObject(g_reporter, kReportEvery * 2);
+        CloseHandle(g_reporter);
+        g_reporter = nullptr;
+    }
+    // At process exit the reporter, or the tracer's drain thread, may
+    // still be running or have been killed holding its lock; waiting
+    // for either could hang the exit.  Without the rows lock nothing is
+    // written; without the tracer's, the table has the last sample.
+    std::unique_lock<std::mutex> lock(g_rowsLock, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        OutputDebugStringA("[Imports] reporter still busy; table not written\n");
+        g_started = false;
+        return;
+    }
+    std::vector<TraceSnapshot> snap;
+    double cpn = 0.0;
+    if (TrySnapshotFunctionTracer(&snap, &cpn)) {
+        UpdateRows(snap, 0.0);
+    }
+    WriteTable(cpn);
+    g_started = false;
+}
@@ -0,0 +1,26 @@
+// Copyright (c) 2025
+//
+// Import table profiler.  Walks digi.exe's import directory at load
+// time and points every function slot of its IAT at a counting and
+// timing thunk from the function tracer (function_tracer.h), so each
+// call the game makes into KERNEL32, USER32, GDI32, WINMM, DSOUND,
+// MSVCRT, MFC42 and friends is timed without writing a detour for it.
+//
+// A reporter thread turns the tracer's totals into a live table of
+// calls per second and mean latency per API, logging the busiest
+// entries every few seconds.  The full table is written to a file when
+// the DLL unloads.
+//
+// Enabled by setting DIGI_PROFILE_IMPORTS to the output path.  Only
+// calls through the IAT are seen: functions the game resolves with
+// GetProcAddress, and calls MFC42 makes on its own, are not.
+
+#pragma once
+
+// Start the tracer if needed, patch the IAT and start the reporter.
+// Returns the number of imports instrumented.
+int StartImportProfiler(const char* tablePath);
+
+// Stop the reporter and write the table.  The IAT keeps pointing at
+// the thunks, which remain valid.
+void StopImportProfiler();
@@ -0,0 +1,157 @@
+// Copyright (c) 2025
+//
+// LZ4 block codec.  See lz4_block.h.
+//
+// A block is a series of sequences: a token byte (literal count in the
+// high nibble, match length minus four in the low one, 15 meaning more
+// length bytes follow), the literals, a 16-bit little-endian offset
+// back into the output and the match.  The last sequence is literals
+// only.  The format requires the last five bytes to be literals and
+// no match to start in the last twelve.
+
+#include "lz4_block.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+    const size_t   kMinMatch     = 4;
+    const size_t   kLastLiterals = 5;
+    const size_t   kMatchLimit   = 12;
+    const size_t   kMaxOffset    = 65535;
+    const unsigned kHashBits     = 16;
+
+    uint32_t Read32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    uint32_t Hash(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - kHashBits);
+    }
+
+    // A length of 15 or more continues in bytes of 255 and a final
+    // byte below 255.
+    uint8_t* WriteLength(uint8_t* out, size_t length) {
+        for (; length >= 255; length -= 255) {
+            *out++ = 255;
+        }
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalCount, size_t offset,
+                           size_t matchLength) {
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>((literalCount < 15 ? literalCount : 15) << 4);
+        if (literalCount >= 15) {
+            out = WriteLength(out, literalCount - 15);
+        }
+        std::memcpy(out, literals, literalCount);
+        out += literalCount;
+        if (matchLength == 0) {
+            return out;
+        }
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+        size_t extra = matchLength - kMinMatch;
+        *token |= static_cast<uint8_t>(extra < 15 ? extra : 15);
+        if (extra >= 15) {
+            out = WriteLength(out, extra - 15);
+        }
+        return out;
+    }
+
+    // Read a length continuation; false if it runs off the input.
+    bool ReadLength(const uint8_t** in, const uint8_t* end, size_t* length) {
+        uint8_t b;
+        do {
+            if (*in == end) {
+                return false;
+            }
+            b = *(*in)++;
+            *length += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+size_t Lz4Compress(const uint8_t* src, size_t size, uint8_t* dst) {
+    uint8_t* out = dst;
+    size_t anchor = 0;
+    if (size > kMatchLimit) {
+        // Positions plus one, so zero means empty.
+        std::vector<uint32_t> table(size_t(1) << kHashBits, 0);
+        size_t limit = size - kMatchLimit;
+        size_t matchEnd = size - kLastLiterals;
+        size_t i = 0;
+        while (i < limit) {
+            uint32_t sequence = Read32(src + i);
+            uint32_t& slot = table[Hash(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(i + 1);
+            if (candidate == 0 || i - (candidate - 1) > kMaxOffset || Read32(src + candidate - 1) != sequence) {
+                ++i;
+                continue;
+            }
+            size_t from = candidate - 1;
+            size_t length = kMinMatch;
+            while (i + length < matchEnd && src[from + length] == src[i + length]) {
+                ++length;
+            }
+            out = WriteSequence(out, src + anchor, i - anchor, i - from, length);
+            i += length;
+            anchor = i;
+        }
+    }
+    out = WriteSequence(out, src + anchor, size - anchor, 0, 0);
+    return static_cast<size_t>(out - dst);
+}
+
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcSize;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + dstSize;
+    while (in < inEnd) {
+        uint8_t token = *in++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !ReadLength(&in, inEnd, &literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+        std::memcpy(out, in, literals);
+        in += literals;
+        out += literals;
+        if (in == inEnd) {
+            break;                          // the final, literal-only sequence
+        }
+        if (inEnd - in < 2) {
+            return false;
+        }
+        size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        size_t length = token & 0xF;
+        if (length == 15 && !ReadLength(&in, inEnd, &length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (offset == 0 || offset > static_cast<size_t>(out - dst) || length > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+        const uint8_t* match = out - offset;
+        if (offset >= length) {
+            std::memcpy(out, match, length);
+            out += length;
+        } else {
+            // Overlapping: the match repeats the bytes it is writing.
+            for (size_t i = 0; i < length; ++i) {
+                *out++ = match[i];
+            }
+        }
+    }
+    return out == outEnd;
+}
@@ -0,0 +1,28 @@
+// Copyright (c) 2025
+//
+// LZ4 block format (the raw sequence stream, without the frame
+// header) for the asset archive.  Decompression is the part that runs
+// in the game: it checks every length and offset against both buffers,
+// so a damaged archive fails a read instead of writing past the
+// caller's buffer.  Compression only runs in tools/digi_pack and is a
+// plain greedy matcher over a 64K-entry hash of four-byte sequences;
+// its output is ordinary LZ4 and decodes with any LZ4 implementation.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Worst-case compressed size of `size` bytes.
+inline size_t Lz4CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+// Compress `size` bytes into `dst`, which must hold
+// Lz4CompressBound(size) bytes.  Returns the compressed size.
+size_t Lz4Compress(const uint8_t* src, size_t size, uint8_t* dst);
+
+// Decompress the block `src` into exactly `dstSize` bytes.  Returns
+// false if the block is malformed or does not decode to exactly
+// `dstSize` bytes.
+bool Lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
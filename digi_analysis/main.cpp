@@ -16,7 +16,7 @@
 #include <cwchar>
 
 #include "digi_table.h"
-#include "strings.h"
+#include "string_table.h"
 #include "functions.h"
 #include "hooks.h"
 
@@ -62,10 +62,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     // Show the first few extracted strings in a message box to prove the strings
     // were correctly decoded.  We limit to a handful to avoid huge dialogs.
     message += "\nSample extracted strings:\n";
-    std::size_t sampleCount = (g_strings_count < 10) ? g_strings_count : 10;
+    std::size_t sampleCount = (StringCount() < 10) ? StringCount() : 10;
     for (std::size_t i = 0; i < sampleCount; ++i) {
         // Convert each wide string to UTF‑8 and then append.
-        std::wstring ws(g_strings[i]);
+        std::wstring ws(StringAt(i), StringLength(i));
         int len = WideCharToMultiByte(CP_UTF8, 0, ws.c_str(), -1, NULL, 0, NULL, NULL);
         std::string utf8(static_cast<size_t>(len), '\0');
         WideCharToMultiByte(CP_UTF8, 0, ws.c_str(), -1, &utf8[0], len, NULL, NULL);
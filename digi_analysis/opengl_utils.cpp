@@ -4,6 +4,7 @@
 
 #include "opengl_utils.h"
 #include "d3d8_gl_bridge.h"
+#include "sdf_text.h"
 #include <GL/gl.h>
 #include <mutex>
 
@@ -26,6 +27,11 @@ namespace {
     std::vector<PendingDraw> g_frameQueue;
     std::vector<PendingDraw> g_renderQueue;
 
+    // Textures retired while building the current frame, and those
+    // waiting for the render thread to finish the frame they belong to.
+    std::vector<IDirect3DTexture8*> g_frameRetired;
+    std::vector<IDirect3DTexture8*> g_renderRetired;
+
     // Clear state passed between threads.
     bool  g_clearRequested = false;
     float g_clearR = 0.f, g_clearG = 0.f, g_clearB = 0.f;
@@ -63,7 +69,8 @@ namespace {
     DWORD WINAPI RenderThread(LPVOID) {
         wglMakeCurrent(g_hDCGL, g_hGLRC);
         glEnable(GL_TEXTURE_2D);
-        
+        InitSdfProgram();
+
         while (g_running) {
             if (g_resizePending) {
                 glViewport(0, 0, g_width, g_height);
@@ -71,6 +78,7 @@ namespace {
             }
 
             std::vector<PendingDraw> localQueue;
+            std::vector<IDirect3DTexture8*> localRetired;
             bool doClear = false; 
             float cr = 0, cg = 0, cb = 0;
             
@@ -78,6 +86,8 @@ namespace {
                 std::lock_guard<std::mutex> lock(g_drawMutex);
                 localQueue = std::move(g_renderQueue);
                 g_renderQueue.clear();
+                localRetired = std::move(g_renderRetired);
+                g_renderRetired.clear();
                 doClear = g_clearRequested;
                 cr = g_clearR; cg = g_clearG; cb = g_clearB;
                 g_clearRequested = false;
@@ -96,6 +106,9 @@ namespace {
                     glBindTexture(GL_TEXTURE_2D, 0);
                 }
 
+                if (draw.sdf) {
+                    BeginSdfDraw(draw.color, draw.sdfSmoothing);
+                }
                 glBegin(draw.mode);
                 if (!draw.indices.empty()) {
                     for (auto idx : draw.indices) {
@@ -114,6 +127,15 @@ namespace {
                     }
                 }
                 glEnd();
+                if (draw.sdf) {
+                    EndSdfDraw();
+                }
+            }
+
+            // Nothing drawn after this point can reference the retired
+            // textures, so they can be released with the context current.
+            for (IDirect3DTexture8* tex : localRetired) {
+                tex->Release();
             }
 
             if (g_hDCGL) {
@@ -246,4 +268,21 @@ void PresentFrame() {
     std::lock_guard<std::mutex> lock(g_drawMutex);
     g_renderQueue = std::move(g_frameQueue);
     g_frameQueue.clear();
+    // Append rather than replace: if the render thread skipped the
+    // previous batch its retired textures still need releasing.
+    g_renderRetired.insert(g_renderRetired.end(), g_frameRetired.begin(), g_frameRetired.end());
+    g_frameRetired.clear();
+}
+
+void RetireTexture(IDirect3DTexture8* texture) {
+    if (!texture) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_drawMutex);
+    if (!g_running) {
+        // No render thread to hand it to.
+        texture->Release();
+        return;
+    }
+    g_frameRetired.push_back(texture);
 }
\ No newline at end of file
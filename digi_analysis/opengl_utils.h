@@ -23,6 +23,12 @@ struct PendingDraw {
     std::vector<float>        vertices;
     std::vector<unsigned short> indices;
     IDirect3DTexture8*        texture;
+    // Signed distance field text (see sdf_text.h).  When set, the
+    // texture's alpha holds a distance field which is thresholded and
+    // drawn in `color`; `sdfSmoothing` is the edge half-width.
+    bool                      sdf = false;
+    float                     color[4] = { 1.f, 1.f, 1.f, 1.f };
+    float                     sdfSmoothing = 0.f;
 };
 
 // Initializes a simple OpenGL window and context.  Returns true on
@@ -40,4 +46,10 @@ void EnqueueClear(float r, float g, float b);
 
 // Promote queued draw calls to the render thread.  Called when the
 // game presents a frame.
-void PresentFrame();
\ No newline at end of file
+void PresentFrame();
+
+// Release a texture once every frame queued so far has been drawn.
+// Used by caches that evict textures which may still be referenced by
+// pending draw calls.  The final Release happens on the render thread
+// so the GL texture is deleted with the context current.
+void RetireTexture(IDirect3DTexture8* texture);
\ No newline at end of file
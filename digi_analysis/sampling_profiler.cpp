@@ -0,0 +1,312 @@
+// Copyright (c) 2025
+//
+// Sampling profiler.  See sampling_profiler.h.
+
+#include "sampling_profiler.h"
+#include <windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#pragma comment(lib, "winmm.lib")
+
+namespace {
+    const int       kMaxDepth  = 16;
+    const uintptr_t kScanBytes = 1024;     // stack scanned when EBP is not a frame
+
+    struct RawSample {
+        int       depth;
+        uintptr_t pcs[kMaxDepth];          // pcs[0] is EIP
+    };
+
+    // digi.exe code range and the function starts found in it.
+    const uint8_t*        g_imageBase = nullptr;
+    uintptr_t             g_textBegin = 0;
+    uintptr_t             g_textEnd   = 0;
+    std::vector<uint32_t> g_functionStarts;
+
+    HANDLE            g_gameThread = nullptr;
+    HANDLE            g_sampler    = nullptr;
+    std::atomic<bool> g_stop{false};
+    DWORD             g_period     = 1;
+    char              g_outPath[MAX_PATH];
+    bool              g_started    = false;
+
+    // Owned by the sampler thread until it stops.
+    std::map<std::vector<uintptr_t>, uint64_t> g_stacks;
+    std::map<uintptr_t, std::string>           g_moduleNames;
+    uint64_t g_samples = 0;
+    uint64_t g_failed  = 0;
+
+    bool InText(uintptr_t a) {
+        return a >= g_textBegin && a < g_textEnd;
+    }
+
+    // Scan .text for call rel32 targets.  Stray E8 bytes inside other
+    // instructions produce junk targets, so a target is only kept if
+    // it is called more than once or sits right after padding or a
+    // return, which is where MSVC places function starts.
+    void BuildFunctionMap() {
+        const uint8_t* code = reinterpret_cast<const uint8_t*>(g_textBegin);
+        size_t size = g_textEnd - g_textBegin;
+        std::vector<uint32_t> targets;
+        for (size_t i = 0; i + 5 <= size; ++i) {
+            if (code[i] != 0xE8) {
+                continue;
+            }
+            int32_t rel;
+            std::memcpy(&rel, code + i + 1, 4);
+            uintptr_t target = g_textBegin + i + 5 + rel;
+            if (InText(target)) {
+                targets.push_back(static_cast<uint32_t>(target));
+            }
+        }
+        std::sort(targets.begin(), targets.end());
+        g_functionStarts.clear();
+        g_functionStarts.push_back(static_cast<uint32_t>(g_textBegin));
+        for (size_t i = 0; i < targets.size();) {
+            size_t j = i;
+            while (j < targets.size() && targets[j] == targets[i]) {
+                ++j;
+            }
+            const uint8_t* t = reinterpret_cast<const uint8_t*>(targets[i]);
+            bool aligned = targets[i] > g_textBegin &&
+                           (t[-1] == 0xCC || t[-1] == 0x90 || t[-1] == 0xC3 ||
+                            (targets[i] >= g_textBegin + 3 && t[-3] == 0xC2));
+            if (j - i > 1 || aligned) {
+                g_functionStarts.push_back(targets[i]);
+            }
+            i = j;
+        }
+        const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(
+            g_imageBase + reinterpret_cast<const IMAGE_DOS_HEADER*>(g_imageBase)->e_lfanew);
+        g_functionStarts.push_back(static_cast<uint32_t>(
+            reinterpret_cast<uintptr_t>(g_imageBase) + nt->OptionalHeader.AddressOfEntryPoint));
+        std::sort(g_functionStarts.begin(), g_functionStarts.end());
+        g_functionStarts.erase(std::unique(g_functionStarts.begin(), g_functionStarts.end()),
+                               g_functionStarts.end());
+    }
+
+    bool FindText() {
+        g_imageBase = reinterpret_cast<const uint8_t*>(GetModuleHandleA(nullptr));
+        const IMAGE_NT_HEADERS* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(
+            g_imageBase + reinterpret_cast<const IMAGE_DOS_HEADER*>(g_imageBase)->e_lfanew);
+        const IMAGE_SECTION_HEADER* sec = IMAGE_FIRST_SECTION(const_cast<IMAGE_NT_HEADERS*>(nt));
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++sec) {
+            if (sec->Characteristics & IMAGE_SCN_MEM_EXECUTE) {
+                g_textBegin = reinterpret_cast<uintptr_t>(g_imageBase) + sec->VirtualAddress;
+                g_textEnd   = g_textBegin + sec->Misc.VirtualSize;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True if `ret` is in digi.exe and directly follows a call
+    // instruction: E8 rel32, or FF /2 in any of its encodings.
+    bool IsReturnAddress(uintptr_t ret) {
+        if (ret < g_textBegin + 7 || ret > g_textEnd) {
+            return false;
+        }
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(ret);
+        if (p[-5] == 0xE8) {
+            return true;
+        }
+        if (p[-2] == 0xFF && (p[-1] & 0x38) == 0x10 && (p[-1] >= 0xD0 || p[-1] < 0x40)) {
+            return true;    // call reg / call [reg]
+        }
+        if (p[-3] == 0xFF && (p[-2] & 0xF8) == 0x50) {
+            return true;    // call [reg+disp8]
+        }
+        if (p[-6] == 0xFF && (p[-5] == 0x15 || (p[-5] & 0xF8) == 0x90)) {
+            return true;    // call [abs32] / call [reg+disp32]
+        }
+        if (p[-7] == 0xFF && p[-6] == 0x94) {
+            return true;    // call [sib+disp32]
+        }
+        return false;
+    }
+
+    // Walk the suspended thread's stack.  Only reads memory inside the
+    // committed stack region that contains ESP, and calls nothing but
+    // VirtualQuery.
+    void WalkStack(uintptr_t ebp, uintptr_t esp, RawSample* s) {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (!VirtualQuery(reinterpret_cast<void*>(esp), &mbi, sizeof(mbi))) {
+            return;
+        }
+        uintptr_t top = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+        uintptr_t fp = ebp;
+        while (s->depth < kMaxDepth && fp >= esp && fp + 8 <= top && !(fp & 3)) {
+            const uintptr_t* frame = reinterpret_cast<const uintptr_t*>(fp);
+            if (!frame[1]) {
+                break;
+            }
+            s->pcs[s->depth++] = frame[1];
+            if (frame[0] <= fp) {
+                break;
+            }
+            fp = frame[0];
+        }
+        if (s->depth > 1) {
+            return;
+        }
+        // No usable frame chain (frame pointer omitted): fall back to
+        // the return addresses found near the top of the stack.
+        for (uintptr_t p = esp; p + 4 <= top && p < esp + kScanBytes && s->depth < kMaxDepth; p += 4) {
+            uintptr_t v = *reinterpret_cast<const uintptr_t*>(p);
+            if (IsReturnAddress(v)) {
+                s->pcs[s->depth++] = v;
+            }
+        }
+    }
+
+    bool TakeSample(RawSample* s) {
+        if (SuspendThread(g_gameThread) == static_cast<DWORD>(-1)) {
+            return false;
+        }
+        CONTEXT ctx;
+        ctx.ContextFlags = CONTEXT_CONTROL;
+        bool ok = GetThreadContext(g_gameThread, &ctx) != FALSE;
+        if (ok) {
+            s->depth = 0;
+            s->pcs[s->depth++] = ctx.Eip;
+            WalkStack(ctx.Ebp, ctx.Esp, s);
+        }
+        ResumeThread(g_gameThread);
+        return ok;
+    }
+
+    // Frame key for an address: the start of its digi.exe function, or
+    // the base of the module it belongs to (0 if none).
+    uintptr_t FrameKey(uintptr_t pc) {
+        if (InText(pc)) {
+            auto it = std::upper_bound(g_functionStarts.begin(), g_functionStarts.end(),
+                                       static_cast<uint32_t>(pc));
+            return it == g_functionStarts.begin() ? g_textBegin : *(it - 1);
+        }
+        HMODULE module = nullptr;
+        if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                reinterpret_cast<LPCSTR>(pc), &module)) {
+            return 0;
+        }
+        uintptr_t key = reinterpret_cast<uintptr_t>(module);
+        if (!g_moduleNames.count(key)) {
+            char path[MAX_PATH];
+            DWORD n = GetModuleFileNameA(module, path, MAX_PATH);
+            const char* name = path;
+            for (DWORD i = 0; i < n; ++i) {
+                if (path[i] == '\\' || path[i] == '/') {
+                    name = path + i + 1;
+                }
+            }
+            g_moduleNames[key] = n ? std::string("[") + name + "]" : "[unknown]";
+        }
+        return key;
+    }
+
+    void Record(const RawSample& s) {
+        std::vector<uintptr_t> key;
+        key.reserve(s.depth);
+        for (int i = s.depth - 1; i >= 0; --i) {
+            uintptr_t frame = FrameKey(s.pcs[i]);
+            // Collapse consecutive samples inside one module or function
+            // (recursion, or a DLL calling itself).
+            if (key.empty() || key.back() != frame) {
+                key.push_back(frame);
+            }
+        }
+        ++g_stacks[key];
+    }
+
+    DWORD WINAPI SamplerThread(LPVOID) {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+        timeBeginPeriod(1);
+        RawSample s;
+        while (!g_stop.load(std::memory_order_relaxed)) {
+            Sleep(g_period);
+            if (TakeSample(&s)) {
+                Record(s);
+                ++g_samples;
+            } else {
+                ++g_failed;
+            }
+        }
+        timeEndPeriod(1);
+        return 0;
+    }
+
+    std::string FrameName(uintptr_t key) {
+        if (InText(key)) {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "sub_%08X", static_cast<unsigned>(key));
+            return buf;
+        }
+        auto it = g_moduleNames.find(key);
+        return it != g_moduleNames.end() ? it->second : "[unknown]";
+    }
+}
+
+bool StartSamplingProfiler(const char* foldedPath, int samplesPerSecond) {
+    if (g_started || !foldedPath || !*foldedPath || !FindText()) {
+        return false;
+    }
+    g_gameThread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION,
+                              FALSE, GetCurrentThreadId());
+    if (!g_gameThread) {
+        return false;
+    }
+    lstrcpynA(g_outPath, foldedPath, MAX_PATH);
+    if (samplesPerSecond <= 0) {
+        samplesPerSecond = 1000;
+    }
+    // Sleep granularity is 1 ms even with timeBeginPeriod(1).
+    g_period = samplesPerSecond >= 1000 ? 1 : static_cast<DWORD>(1000 / samplesPerSecond);
+    BuildFunctionMap();
+
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "[Sampler] %u functions mapped, sampling every %u ms\n",
+                  static_cast<unsigned>(g_functionStarts.size()), static_cast<unsigned>(g_period));
+    OutputDebugStringA(buf);
+
+    g_stop.store(false);
+    g_sampler = CreateThread(nullptr, 0, SamplerThread, nullptr, 0, nullptr);
+    g_started = g_sampler != nullptr;
+    return g_started;
+}
+
+void StopSamplingProfiler() {
+    if (!g_started) {
+        return;
+    }
+    g_stop.store(true);
+    // Bounded for the loader-lock reason given in function_tracer.cpp.
+    WaitForSingleObject(g_sampler, g_period * 10 + 10);
+    CloseHandle(g_sampler);
+    g_sampler = nullptr;
+
+    FILE* f = std::fopen(g_outPath, "w");
+    if (f) {
+        for (const auto& entry : g_stacks) {
+            const std::vector<uintptr_t>& frames = entry.first;
+            for (size_t i = 0; i < frames.size(); ++i) {
+                std::fprintf(f, "%s%s", i ? ";" : "", FrameName(frames[i]).c_str());
+            }
+            std::fprintf(f, " %llu\n", static_cast<unsigned long long>(entry.second));
+        }
+        std::fclose(f);
+    }
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "[Sampler] %llu samples, %llu failed, %u distinct stacks\n",
+                  static_cast<unsigned long long>(g_samples), static_cast<unsigned long long>(g_failed),
+                  static_cast<unsigned>(g_stacks.size()));
+    OutputDebugStringA(buf);
+    CloseHandle(g_gameThread);
+    g_gameThread = nullptr;
+    g_started = false;
+}
@@ -0,0 +1,33 @@
+// Copyright (c) 2025
+//
+// Sampling profiler for the game thread.  Entry hooks only see the
+// functions we already hook; this samples everything.  A
+// time-critical thread wakes at a fixed rate, suspends the game
+// thread, reads EIP and walks a few frames up its stack, resumes it,
+// and only then attributes the addresses to functions.  Nothing that
+// could take a lock the game thread holds (the heap, the loader) is
+// called while it is suspended.
+//
+// digi.exe ships without symbols and digi_disasm.asm covers only the
+// start of .text, so the function map is derived from the image: every
+// `call rel32` target inside .text, plus the entry point, starts a
+// function, and an address belongs to the nearest start below it.
+// Functions are named sub_XXXXXXXX after their start address, the way
+// sub_004A1F8A is; addresses outside digi.exe are attributed to their
+// module.
+//
+// The output is one line per distinct stack in the folded format
+// flamegraph.pl and speedscope read: frames outermost first, separated
+// by ';', followed by the sample count.
+//
+// Enabled by DIGI_SAMPLE=<output path>; DIGI_SAMPLE_HZ sets the rate
+// (default 1000).
+
+#pragma once
+
+// Start sampling the calling thread, which is taken to be the game
+// thread (InstallHooks runs on it from DllMain).
+bool StartSamplingProfiler(const char* foldedPath, int samplesPerSecond);
+
+// Stop sampling and write the folded stacks.
+void StopSamplingProfiler();
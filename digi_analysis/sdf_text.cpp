@@ -0,0 +1,213 @@
+// Copyright (c) 2025
+//
+// Distance field generation and the SDF threshold shader.  See
+// sdf_text.h.
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include "sdf_text.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float kInf = 1e20f;
+
+    GLuint g_program        = 0;
+    GLint  g_colorLoc       = -1;
+    GLint  g_smoothingLoc   = -1;
+    bool   g_programChecked = false;
+
+    const char* kVertexSource =
+        "void main() {\n"
+        "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+        "    gl_Position = ftransform();\n"
+        "}\n";
+
+    const char* kFragmentSource =
+        "uniform sampler2D tex;\n"
+        "uniform vec4 color;\n"
+        "uniform float smoothing;\n"
+        "void main() {\n"
+        "    float d = texture2D(tex, gl_TexCoord[0].st).a;\n"
+        "    float a = smoothstep(0.5 - smoothing, 0.5 + smoothing, d);\n"
+        "    gl_FragColor = vec4(color.rgb, color.a * a);\n"
+        "}\n";
+
+    // One-dimensional squared Euclidean distance transform
+    // (Felzenszwalb & Huttenlocher).  `f` holds 0 for feature cells and
+    // kInf elsewhere; `d` receives the squared distance to the nearest
+    // feature.  `v` and `z` are scratch buffers of n and n+1 entries.
+    void Edt1D(const float* f, float* d, int n, int* v, float* z) {
+        int k = 0;
+        v[0] = 0;
+        z[0] = -kInf;
+        z[1] = kInf;
+        for (int q = 1; q < n; ++q) {
+            float s;
+            for (;;) {
+                int p = v[k];
+                s = ((f[q] + q * q) - (f[p] + p * p)) / (2.0f * (q - p));
+                if (s > z[k] || k == 0) break;
+                --k;
+            }
+            if (s <= z[k]) {
+                // k == 0 and the new parabola dominates everywhere.
+                v[0] = q;
+                z[1] = kInf;
+                continue;
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = kInf;
+        }
+        k = 0;
+        for (int q = 0; q < n; ++q) {
+            while (z[k + 1] < q) ++k;
+            int p = v[k];
+            d[q] = (q - p) * (q - p) + f[p];
+        }
+    }
+
+    // Squared distance from every cell to the nearest cell where
+    // grid[] is 0, computed separably over columns then rows.
+    void Edt2D(std::vector<float>& grid, int w, int h) {
+        int n = std::max(w, h);
+        std::vector<float> f(n), d(n), z(n + 1);
+        std::vector<int> v(n);
+        for (int x = 0; x < w; ++x) {
+            for (int y = 0; y < h; ++y) f[y] = grid[y * w + x];
+            Edt1D(f.data(), d.data(), h, v.data(), z.data());
+            for (int y = 0; y < h; ++y) grid[y * w + x] = d[y];
+        }
+        for (int y = 0; y < h; ++y) {
+            Edt1D(&grid[y * w], d.data(), w, v.data(), z.data());
+            std::copy(d.begin(), d.begin() + w, grid.begin() + y * w);
+        }
+    }
+
+    GLuint CompileShader(GLenum type, const char* source) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+        GLint ok = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            OutputDebugStringA("[SDF] shader compilation failed\n");
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+void BuildDistanceField(const BYTE* coverage, int pitch, int width, int height,
+                        std::vector<BYTE>* field, int* fieldWidth, int* fieldHeight) {
+    const int w = width + 2 * kSdfSpread;
+    const int h = height + 2 * kSdfSpread;
+    // `outside` measures distance to the nearest inside cell and
+    // `inside` the distance to the nearest outside cell.
+    std::vector<float> outside(static_cast<size_t>(w) * h, kInf);
+    std::vector<float> inside(static_cast<size_t>(w) * h, 0.0f);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (coverage[y * pitch + x] >= 32) {
+                size_t i = static_cast<size_t>(y + kSdfSpread) * w + (x + kSdfSpread);
+                outside[i] = 0.0f;
+                inside[i]  = kInf;
+            }
+        }
+    }
+    Edt2D(outside, w, h);
+    Edt2D(inside, w, h);
+
+    field->resize(static_cast<size_t>(w) * h);
+    const float scale = 127.0f / kSdfSpread;
+    for (size_t i = 0; i < field->size(); ++i) {
+        float dist = std::sqrt(inside[i]) - std::sqrt(outside[i]);
+        float v = 128.0f + dist * scale;
+        (*field)[i] = static_cast<BYTE>(std::min(255.0f, std::max(0.0f, v)));
+    }
+    *fieldWidth  = w;
+    *fieldHeight = h;
+}
+
+void ConvertGlyphToDistanceField(RasterizedGlyph* glyph) {
+    glyph->sdf = true;
+    if (!glyph->ok) {
+        return;
+    }
+    std::vector<BYTE> field;
+    int w = 0, h = 0;
+    BuildDistanceField(glyph->coverage.data(), glyph->width, glyph->width, glyph->height, &field, &w, &h);
+    glyph->coverage.swap(field);
+    glyph->width     = w;
+    glyph->height    = h;
+    glyph->bearingX -= kSdfSpread;
+    glyph->bearingY += kSdfSpread;
+}
+
+bool InitSdfProgram() {
+    if (g_programChecked) {
+        return g_program != 0;
+    }
+    g_programChecked = true;
+    if (glewInit() != GLEW_OK || !GLEW_VERSION_2_0) {
+        OutputDebugStringA("[SDF] GLSL unavailable, using alpha test\n");
+        return false;
+    }
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, kVertexSource);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, kFragmentSource);
+    if (!vs || !fs) {
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        return false;
+    }
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        OutputDebugStringA("[SDF] shader link failed\n");
+        glDeleteProgram(program);
+        return false;
+    }
+    g_program      = program;
+    g_colorLoc     = glGetUniformLocation(program, "color");
+    g_smoothingLoc = glGetUniformLocation(program, "smoothing");
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "tex"), 0);
+    glUseProgram(0);
+    return true;
+}
+
+void BeginSdfDraw(const float color[4], float smoothing) {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (g_program) {
+        glUseProgram(g_program);
+        glUniform4fv(g_colorLoc, 1, color);
+        glUniform1f(g_smoothingLoc, smoothing);
+    } else {
+        // Fixed-function fallback: the texture is white with the field
+        // in alpha, so modulating by the colour and testing alpha
+        // against the iso-line gives hard but correctly sized edges.
+        glEnable(GL_ALPHA_TEST);
+        glAlphaFunc(GL_GREATER, 0.5f);
+        glColor4fv(color);
+    }
+}
+
+void EndSdfDraw() {
+    if (g_program) {
+        glUseProgram(0);
+    } else {
+        glDisable(GL_ALPHA_TEST);
+        glColor4f(1.f, 1.f, 1.f, 1.f);
+    }
+    glDisable(GL_BLEND);
+}
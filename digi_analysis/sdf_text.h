@@ -0,0 +1,43 @@
+// Copyright (c) 2025
+//
+// Signed distance field support for the text renderer.  In SDF mode
+// each glyph is rasterised once at a reference size and converted
+// into a distance field; the render thread then draws it at any size
+// by thresholding the field in a fragment shader.  When shaders are
+// unavailable an alpha test at the 0.5 iso-line is used instead.
+//
+// This header deliberately avoids GL includes: sdf_text.cpp includes
+// GLEW, which must come before <GL/gl.h>.
+
+#pragma once
+
+#include <windows.h>
+#include <vector>
+#include "glyph_rasterizer.h"
+
+// Em height the distance fields are generated at, and how many pixels
+// of distance the field encodes on each side of the outline.
+const int kSdfReferenceSize = 48;
+const int kSdfSpread        = 6;
+
+// Convert a GGO_GRAY8 coverage bitmap (values 0-64, `pitch` bytes per
+// row) into an 8-bit distance field padded by kSdfSpread on every
+// side.  128 is the outline; larger values are inside the glyph.
+void BuildDistanceField(const BYTE* coverage, int pitch, int width, int height,
+                        std::vector<BYTE>* field, int* fieldWidth, int* fieldHeight);
+
+// Replace a rasterised glyph's coverage with its distance field,
+// growing the box and shifting the bearings by kSdfSpread so the
+// outline stays in place.  Glyphs without an outline are only marked.
+void ConvertGlyphToDistanceField(RasterizedGlyph* glyph);
+
+// Render thread only.  Compile the threshold shader; returns false if
+// the driver lacks GLSL support, in which case the alpha-test path is
+// used.
+bool InitSdfProgram();
+
+// Render thread only.  Set up state for an SDF draw in `color`
+// (RGBA, 0-1).  `smoothing` is half the width of the anti-aliased
+// edge in distance-field units.
+void BeginSdfDraw(const float color[4], float smoothing);
+void EndSdfDraw();
@@ -0,0 +1,160 @@
+// Copyright (c) 2025
+//
+// Batch sine and cosine lookups.  See sin_table.h.
+//
+// AVX2 has a real gather, so that path computes eight indices at a
+// time and fetches all eight entries with one instruction.  The gather
+// reads 32 bits per lane, so it runs over a copy of the table padded by
+// one entry and keeps the low half of each lane.  SSE2 has no gather:
+// that path still computes and narrows eight indices in one go and
+// stores eight results at once, but fetches the entries one by one.
+// Both are compiled with per-function target attributes on GCC and
+// Clang so the file needs no special flags, and picked at run time;
+// see cpu_features.h.
+
+#include "sin_table.h"
+#include "cpu_features.h"
+
+namespace {
+    enum BatchPath { kScalar, kSse2, kAvx2 };
+
+    void ScalarBatch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (sinOut) {
+                sinOut[i] = SinLookup(angles[i]);
+            }
+            if (cosOut) {
+                cosOut[i] = CosLookup(angles[i]);
+            }
+        }
+    }
+
+#if DIGI_X86
+    // The table plus one entry of padding, so the 32-bit gather of the
+    // last entry stays inside the array.
+    alignas(32) const int16_t kGatherTable[4096 + 2] = {
+#include "digi_table.inc"
+        0, 0,
+    };
+
+    DIGI_TARGET_SSE2
+    void Sse2Batch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count) {
+        const __m128i mask    = _mm_set1_epi32(static_cast<int>(kSinTableMask));
+        const __m128i quarter = _mm_set1_epi32(static_cast<int>(kSinQuarterTurn));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(angles + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(angles + i + 4));
+            // Indices are below 4096, so they narrow to 16 bits losslessly.
+            __m128i s = _mm_packs_epi32(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+            __m128i c = _mm_packs_epi32(_mm_and_si128(_mm_add_epi32(a, quarter), mask),
+                                        _mm_and_si128(_mm_add_epi32(b, quarter), mask));
+            if (sinOut) {
+                __m128i v = _mm_setzero_si128();
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 0)], 0);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 1)], 1);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 2)], 2);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 3)], 3);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 4)], 4);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 5)], 5);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 6)], 6);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(s, 7)], 7);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sinOut + i), v);
+            }
+            if (cosOut) {
+                __m128i v = _mm_setzero_si128();
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 0)], 0);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 1)], 1);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 2)], 2);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 3)], 3);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 4)], 4);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 5)], 5);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 6)], 6);
+                v = _mm_insert_epi16(v, kSinTable[_mm_extract_epi16(c, 7)], 7);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(cosOut + i), v);
+            }
+        }
+        ScalarBatch(angles + i, sinOut ? sinOut + i : nullptr, cosOut ? cosOut + i : nullptr, count - i);
+    }
+
+    // Gather eight entries and narrow them to 16 bits in the low lane
+    // of the result.
+    DIGI_TARGET_AVX2
+    __m128i Gather8(__m256i index) {
+        __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(kGatherTable), index, 2);
+        v = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+        return _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    }
+
+    DIGI_TARGET_AVX2
+    void Avx2Batch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count) {
+        const __m256i mask    = _mm256_set1_epi32(static_cast<int>(kSinTableMask));
+        const __m256i quarter = _mm256_set1_epi32(static_cast<int>(kSinQuarterTurn));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(angles + i));
+            if (sinOut) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sinOut + i), Gather8(_mm256_and_si256(a, mask)));
+            }
+            if (cosOut) {
+                __m256i c = _mm256_and_si256(_mm256_add_epi32(a, quarter), mask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(cosOut + i), Gather8(c));
+            }
+        }
+        ScalarBatch(angles + i, sinOut ? sinOut + i : nullptr, cosOut ? cosOut + i : nullptr, count - i);
+    }
+#endif
+
+    BatchPath DetectPath() {
+#if DIGI_X86
+        if (CpuHasAvx2()) {
+            return kAvx2;
+        }
+        if (CpuHasSse2()) {
+            return kSse2;
+        }
+#endif
+        return kScalar;
+    }
+
+    BatchPath Path() {
+        static const BatchPath s_path = DetectPath();
+        return s_path;
+    }
+
+    void Batch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count) {
+        switch (Path()) {
+#if DIGI_X86
+        case kAvx2:
+            Avx2Batch(angles, sinOut, cosOut, count);
+            return;
+        case kSse2:
+            Sse2Batch(angles, sinOut, cosOut, count);
+            return;
+#endif
+        default:
+            ScalarBatch(angles, sinOut, cosOut, count);
+            return;
+        }
+    }
+}
+
+void SinLookupBatch(const int32_t* angles, int16_t* out, size_t count) {
+    Batch(angles, out, nullptr, count);
+}
+
+void CosLookupBatch(const int32_t* angles, int16_t* out, size_t count) {
+    Batch(angles, nullptr, out, count);
+}
+
+void SinCosLookupBatch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count) {
+    Batch(angles, sinOut, cosOut, count);
+}
+
+const char* SinBatchPath() {
+    switch (Path()) {
+    case kAvx2: return "avx2";
+    case kSse2: return "sse2";
+    default:    return "scalar";
+    }
+}
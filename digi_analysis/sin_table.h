@@ -0,0 +1,44 @@
+// Copyright (c) 2025
+//
+// Portable sine and cosine lookups over the game's table (see
+// digi_table.h).  Angles are in table units, 4096 to a full turn, and
+// wrap the way the original routines wrap them: only the low 12 bits
+// are used.  Results are scaled by 4096.
+//
+// SinLookup and CosLookup are the C++ equivalents of 0x401000 and
+// 0x401020 and are usable in constant expressions.  The batch
+// functions convert whole arrays; on x86 they pick an AVX2 gather or
+// an SSE2 path at run time and fall back to the scalar loop
+// elsewhere, so they build with MSVC, GCC and Clang alike.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "digi_table.h"
+
+const uint32_t kSinTableMask      = 0xFFF;
+const uint32_t kSinQuarterTurn    = 0x400;
+
+constexpr int16_t SinLookup(int32_t angle) {
+    return kSinTable[static_cast<uint32_t>(angle) & kSinTableMask];
+}
+
+// Unsigned arithmetic so INT32_MAX wraps the way the game's `add`
+// does instead of overflowing.
+constexpr int16_t CosLookup(int32_t angle) {
+    return kSinTable[(static_cast<uint32_t>(angle) + kSinQuarterTurn) & kSinTableMask];
+}
+
+// out[i] = SinLookup(angles[i]) for i < count.
+void SinLookupBatch(const int32_t* angles, int16_t* out, size_t count);
+
+// out[i] = CosLookup(angles[i]) for i < count.
+void CosLookupBatch(const int32_t* angles, int16_t* out, size_t count);
+
+// Both at once, sharing the index computation.
+void SinCosLookupBatch(const int32_t* angles, int16_t* sinOut, int16_t* cosOut, size_t count);
+
+// Name of the path the batch functions use on this CPU: "avx2",
+// "sse2" or "scalar".
+const char* SinBatchPath();
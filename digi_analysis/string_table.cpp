@@ -0,0 +1,52 @@
+// Copyright (c) 2025
+//
+// String table lookup.  See string_table.h.
+
+#include "string_table.h"
+#include "strings.h"
+
+#include <cwchar>
+
+// The blob is UTF-16 and StringAt hands out pointers into it.
+static_assert(sizeof(wchar_t) == 2, "the string blob holds UTF-16 code units");
+
+std::size_t StringCount() {
+    return kStringCount;
+}
+
+const wchar_t* StringAt(std::size_t index) {
+    return g_string_blob + g_string_offsets[index];
+}
+
+std::size_t StringLength(std::size_t index) {
+    // The unit before the text is its length.
+    return static_cast<uint16_t>(g_string_blob[g_string_offsets[index] - 1]);
+}
+
+uint32_t StringAddress(std::size_t index) {
+    return g_string_addresses[index];
+}
+
+std::size_t FindString(const wchar_t* text, std::size_t length) {
+    std::size_t slot = PerfectHashSlot(g_string_text_displacements, kStringTextCount,
+                                       StringTextHash(text, length, 0),
+                                       [=](uint32_t d) { return StringTextHash(text, length, d); });
+    std::size_t index = g_string_text_slots[slot];
+    // Any text lands on some slot; only the one stored there matches.
+    if (StringLength(index) != length || std::wmemcmp(StringAt(index), text, length) != 0) {
+        return kStringNotFound;
+    }
+    return index;
+}
+
+std::size_t FindString(const wchar_t* text) {
+    return FindString(text, std::wcslen(text));
+}
+
+std::size_t FindStringAt(uint32_t address) {
+    std::size_t slot = PerfectHashSlot(g_string_address_displacements, kStringCount,
+                                       StringAddressHash(address, 0),
+                                       [=](uint32_t d) { return StringAddressHash(address, d); });
+    std::size_t index = g_string_address_slots[slot];
+    return g_string_addresses[index] == address ? index : kStringNotFound;
+}
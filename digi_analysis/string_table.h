@@ -0,0 +1,81 @@
+// Copyright (c) 2025
+//
+// Lookup over the strings digi.exe's code refers to (strings.cpp,
+// generated by tools/digi_strings).
+//
+// The text is one contiguous UTF-16 blob.  Each distinct string appears
+// in it once, preceded by its length in units and followed by a zero,
+// and every string is an index into a table of 32-bit blob offsets, so
+// the tables hold no pointers and the DLL needs no relocations for
+// them however many strings there are.  Two minimal perfect hashes,
+// built by the generator, map a string's text and its address in
+// digi.exe back to its index: a displacement table picks the second
+// hash for each first-level bucket and the result lands on exactly one
+// slot, so a lookup is two hashes and one comparison.
+//
+// The hash functions are here, in the header, because the generator
+// computes the tables with the same ones.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+const std::size_t kStringNotFound = static_cast<std::size_t>(-1);
+
+// The number of strings, in address order.
+std::size_t StringCount();
+
+// The text of string `index`, zero-terminated.  The pointer stays valid
+// for the life of the module; strings with the same text share it.
+const wchar_t* StringAt(std::size_t index);
+
+// The length of string `index` in UTF-16 units.
+std::size_t StringLength(std::size_t index);
+
+// The address of string `index` in digi.exe.
+uint32_t StringAddress(std::size_t index);
+
+// The index of the first string whose text is `text`, or
+// kStringNotFound.
+std::size_t FindString(const wchar_t* text, std::size_t length);
+std::size_t FindString(const wchar_t* text);
+
+// The index of the string at `address` in digi.exe, or kStringNotFound.
+std::size_t FindStringAt(uint32_t address);
+
+// murmur3's finaliser; spreads every input bit over the whole word.
+inline uint32_t StringHashMix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// FNV-1a over the UTF-16 units of `text`, started from `seed`.  Seed 0
+// picks the first-level bucket, the bucket's displacement the slot.
+// `Unit` is wchar_t in the DLL and uint16_t in the generator.
+template <typename Unit>
+inline uint32_t StringTextHash(const Unit* text, std::size_t length, uint32_t seed) {
+    uint32_t h = 0x811C9DC5u ^ (seed * 0x9E3779B9u);
+    for (std::size_t i = 0; i < length; ++i) {
+        h = (h ^ static_cast<uint16_t>(text[i])) * 0x01000193u;
+    }
+    return StringHashMix(h);
+}
+
+inline uint32_t StringAddressHash(uint32_t address, uint32_t seed) {
+    return StringHashMix(address ^ (seed * 0x9E3779B9u) ^ 0x811C9DC5u);
+}
+
+// The slot of a key in a perfect hash of `count` slots, given the key's
+// first-level hash and a way to hash it again with a displacement.  A
+// negative displacement is the bucket's only key placed directly.
+template <typename Rehash>
+inline std::size_t PerfectHashSlot(const int32_t* displacements, std::size_t count, uint32_t h0,
+                                   Rehash rehash) {
+    int32_t d = displacements[h0 % count];
+    return d < 0 ? static_cast<std::size_t>(-d - 1) : rehash(static_cast<uint32_t>(d)) % count;
+}
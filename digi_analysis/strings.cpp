@@ -1,70 +1,1093 @@
 // Copyright (c) 2025
 //
-// Definition of the extracted string table used by the reconstructed
-// Digimon World PC port.  In the actual project the array below
-// should contain every string extracted from the game binary, stored
-// as UTF‑16 (wchar_t) string literals.  To keep this demonstration
-// lightweight, a subset of the original strings is provided.  Replace
-// the contents with the full data set for accurate behaviour.
+// Generated by tools/digi_strings; do not edit.  See strings.h.
 
 #include "strings.h"
 
-// A sample array of strings extracted from the game.  UTF‑16 literals
-// are prefixed with `L`.  The full list in the original project
-// contained hundreds of entries; only the first few are included here
-// as an example.
-const wchar_t* g_strings[] = {
-    L"낅Q맘?",
-    L"D0>A",
-    L"ﾈ OMOC03",
-    L"?OMOC04",
-    L"=OMOC05",
-    L"=OMOC06",
-    L"=OMOC07",
-    L"=OMOC08",
-    L"=FACT01",
-    L"4FACT02",
-    L"4FACT03",
-    L"4FACT04",
-    L"4FACT05",
-    L"4FACT06",
-    L"4FACT07",
-    L"4FACT08A",
-    L"4FACT08B",
-    L"4FACT09",
-    L"4FACT10",
-    L"4FACT11A",
-    L"9GOMI01",
-    L"8GOMI02",
-    L"8MGEN01",
-    L";MGEN02",
-    L";TWNA02",
-    L"+TWNA03",
-    L"+TWNA04",
-    L"+TWNA05",
-    L"+TWNA06",
-    L"+TWNA07",
-    L"+TWNA08",
-    L"+TWNA09",
-    L"+TWNA10",
-    L"+TWNA11",
-    L"+TWNA12",
-    L"+TWNA13",
-    L"+TWNB01",
-    L"+TWNB02",
-    L"+TWNB03",
-    L"+TWNB04",
-    L"+TWNB05",
-    L"+TWNB06",
-    L"+TWNB07",
-    L"+TWNB08",
-    L"+TWNB09",
-    L"+TWNB10",
-    L"+TWNB11",
-    L"+TWNB12",
-    L"+TWNB13",
+const wchar_t g_string_blob[kStringBlobUnits] = {
+    // 0x004A7EF0 L"d3d8d.dll"
+    0x0009, 0x0064, 0x0033, 0x0064, 0x0038, 0x0064, 0x002E, 0x0064, 0x006C, 0x006C, 0x0000,
+    // 0x004A7EFC L"DebugSetMute"
+    0x000C, 0x0044, 0x0065, 0x0062, 0x0075, 0x0067, 0x0053, 0x0065, 0x0074, 0x004D, 0x0075, 0x0074,
+    0x0065, 0x0000,
+    // 0x004A7F0C L"d3d8.dll"
+    0x0008, 0x0064, 0x0033, 0x0064, 0x0038, 0x002E, 0x0064, 0x006C, 0x006C, 0x0000,
+    // 0x004A82BC L"Software\\Microsoft\\Direct3D"
+    0x001B, 0x0053, 0x006F, 0x0066, 0x0074, 0x0077, 0x0061, 0x0072, 0x0065, 0x005C, 0x004D, 0x0069,
+    0x0063, 0x0072, 0x006F, 0x0073, 0x006F, 0x0066, 0x0074, 0x005C, 0x0044, 0x0069, 0x0072, 0x0065,
+    0x0063, 0x0074, 0x0033, 0x0044, 0x0000,
+    // 0x004A82D8 L"DisableMMX"
+    0x000A, 0x0044, 0x0069, 0x0073, 0x0061, 0x0062, 0x006C, 0x0065, 0x004D, 0x004D, 0x0058, 0x0000,
+    // 0x004A82E4 L"GenuineIntel"
+    0x000C, 0x0047, 0x0065, 0x006E, 0x0075, 0x0069, 0x006E, 0x0065, 0x0049, 0x006E, 0x0074, 0x0065,
+    0x006C, 0x0000,
+    // 0x004A82F4 L"DisableD3DXPSGP"
+    0x000F, 0x0044, 0x0069, 0x0073, 0x0061, 0x0062, 0x006C, 0x0065, 0x0044, 0x0033, 0x0044, 0x0058,
+    0x0050, 0x0053, 0x0047, 0x0050, 0x0000,
+    // 0x004A9C00 L"AuthenticAMD"
+    0x000C, 0x0041, 0x0075, 0x0074, 0x0068, 0x0065, 0x006E, 0x0074, 0x0069, 0x0063, 0x0041, 0x004D,
+    0x0044, 0x0000,
+    // 0x004A9C10 L"UnknownVendr"
+    0x000C, 0x0055, 0x006E, 0x006B, 0x006E, 0x006F, 0x0077, 0x006E, 0x0056, 0x0065, 0x006E, 0x0064,
+    0x0072, 0x0000,
+    // 0x004B2400 L"MAP\\MAP%d\\%s.MAP"
+    0x0010, 0x004D, 0x0041, 0x0050, 0x005C, 0x004D, 0x0041, 0x0050, 0x0025, 0x0064, 0x005C, 0x0025,
+    0x0073, 0x002E, 0x004D, 0x0041, 0x0050, 0x0000,
+    // 0x004B2414 L"MAP\\MAP%d\\%s.TFS"
+    0x0010, 0x004D, 0x0041, 0x0050, 0x005C, 0x004D, 0x0041, 0x0050, 0x0025, 0x0064, 0x005C, 0x0025,
+    0x0073, 0x002E, 0x0054, 0x0046, 0x0053, 0x0000,
+    // 0x004B2428 L"rb"
+    0x0002, 0x0072, 0x0062, 0x0000,
+    // 0x004B242C L"%s\\%.2d_%.2d.bmp"
+    0x0010, 0x0025, 0x0073, 0x005C, 0x0025, 0x002E, 0x0032, 0x0064, 0x005F, 0x0025, 0x002E, 0x0032,
+    0x0064, 0x002E, 0x0062, 0x006D, 0x0070, 0x0000,
+    // 0x004B2440 L"MAP\\CMAP\\MAP%d\\%s"
+    0x0011, 0x004D, 0x0041, 0x0050, 0x005C, 0x0043, 0x004D, 0x0041, 0x0050, 0x005C, 0x004D, 0x0041,
+    0x0050, 0x0025, 0x0064, 0x005C, 0x0025, 0x0073, 0x0000,
+    // 0x004B2454 L"%s\\MASK%.2d.bmp"
+    0x000F, 0x0025, 0x0073, 0x005C, 0x004D, 0x0041, 0x0053, 0x004B, 0x0025, 0x002E, 0x0032, 0x0064,
+    0x002E, 0x0062, 0x006D, 0x0070, 0x0000,
+    // 0x004B2464 L"MAP\\MMAP\\MAP%d\\%s"
+    0x0011, 0x004D, 0x0041, 0x0050, 0x005C, 0x004D, 0x004D, 0x0041, 0x0050, 0x005C, 0x004D, 0x0041,
+    0x0050, 0x0025, 0x0064, 0x005C, 0x0025, 0x0073, 0x0000,
+    // 0x004B2478 L"%d"
+    0x0002, 0x0025, 0x0064, 0x0000,
+    // 0x004B2598 L"MAYO01"
+    0x0006, 0x004D, 0x0041, 0x0059, 0x004F, 0x0030, 0x0031, 0x0000,
+    // 0x004B4080 L"\uB300\uD68C \uC2A4\uCF00\uC904"
+    0x0006, 0xB300, 0xD68C, 0x0020, 0xC2A4, 0xCF00, 0xC904, 0x0000,
+    // 0x004B408C L"%d\uC77C"
+    0x0003, 0x0025, 0x0064, 0xC77C, 0x0000,
+    // 0x004B4094 L"\uB514\uC9C0\uBAAC \uC2DC\uB514\uB97C \uCC3E\uC744 \uC218 \uC5C6\uC2B5\uB2C8\uB2E4"
+    0x0011, 0xB514, 0xC9C0, 0xBAAC, 0x0020, 0xC2DC, 0xB514, 0xB97C, 0x0020, 0xCC3E, 0xC744, 0x0020,
+    0xC218, 0x0020, 0xC5C6, 0xC2B5, 0xB2C8, 0xB2E4, 0x0000,
+    // 0x004B40B4 L"Local AppWizard-Generated Applications"
+    0x0026, 0x004C, 0x006F, 0x0063, 0x0061, 0x006C, 0x0020, 0x0041, 0x0070, 0x0070, 0x0057, 0x0069,
+    0x007A, 0x0061, 0x0072, 0x0064, 0x002D, 0x0047, 0x0065, 0x006E, 0x0065, 0x0072, 0x0061, 0x0074,
+    0x0065, 0x0064, 0x0020, 0x0041, 0x0070, 0x0070, 0x006C, 0x0069, 0x0063, 0x0061, 0x0074, 0x0069,
+    0x006F, 0x006E, 0x0073, 0x0000,
+    // 0x004B40DC L"\uC2DC\uB514\uC5D0\uB7EC"
+    0x0004, 0xC2DC, 0xB514, 0xC5D0, 0xB7EC, 0x0000,
+    // 0x004B40EC L"\uC774\uB984 \uC785\uB825"
+    0x0005, 0xC774, 0xB984, 0x0020, 0xC785, 0xB825, 0x0000,
+    // 0x004B40F8 L"\uC77C\uB824\uB098 \uCE74\uB098 \uD788\uB370\uCE74\uC988 \uB3CC\uC544\uC624\uB294 \uC885\uB8CC"
+    0x0013, 0xC77C, 0xB824, 0xB098, 0x0020, 0xCE74, 0xB098, 0x0020, 0xD788, 0xB370, 0xCE74, 0xC988,
+    0x0020, 0xB3CC, 0xC544, 0xC624, 0xB294, 0x0020, 0xC885, 0xB8CC, 0x0000,
+    // 0x004B411C L"\uFF1F\uFF1F\uFF1F"
+    0x0003, 0xFF1F, 0xFF1F, 0xFF1F, 0x0000,
+    // 0x004B432C L"\uB108\uC758 \uC774\uB984"
+    0x0005, 0xB108, 0xC758, 0x0020, 0xC774, 0xB984, 0x0000,
+    // 0x004B4338 L"\uB514\uC9C0\uBAAC\uC758 \uC774\uB984"
+    0x0007, 0xB514, 0xC9C0, 0xBAAC, 0xC758, 0x0020, 0xC774, 0xB984, 0x0000,
+    // 0x004B469C L"%sSOUND\\sb.whb"
+    0x000E, 0x0025, 0x0073, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0073, 0x0062, 0x002E,
+    0x0077, 0x0068, 0x0062, 0x0000,
+    // 0x004B46AC L"%c:\\"
+    0x0004, 0x0025, 0x0063, 0x003A, 0x005C, 0x0000,
+    // 0x004B46B4 L".wav"
+    0x0004, 0x002E, 0x0077, 0x0061, 0x0076, 0x0000,
+    // 0x004B46BC L".rmi"
+    0x0004, 0x002E, 0x0072, 0x006D, 0x0069, 0x0000,
+    // 0x004B46C4 L".mid"
+    0x0004, 0x002E, 0x006D, 0x0069, 0x0064, 0x0000,
+    // 0x004B46CC L"ETCNA\\UNTI.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0055, 0x004E, 0x0054, 0x0049, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004B46DC L"Press Start Button"
+    0x0012, 0x0050, 0x0072, 0x0065, 0x0073, 0x0073, 0x0020, 0x0053, 0x0074, 0x0061, 0x0072, 0x0074,
+    0x0020, 0x0042, 0x0075, 0x0074, 0x0074, 0x006F, 0x006E, 0x0000,
+    // 0x004B46F0 L"ETCNA\\title256.tim"
+    0x0012, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0074, 0x0069, 0x0074, 0x006C, 0x0065,
+    0x0032, 0x0035, 0x0036, 0x002E, 0x0074, 0x0069, 0x006D, 0x0000,
+    // 0x004B4704 L"movie\\op1.wmv"
+    0x000D, 0x006D, 0x006F, 0x0076, 0x0069, 0x0065, 0x005C, 0x006F, 0x0070, 0x0031, 0x002E, 0x0077,
+    0x006D, 0x0076, 0x0000,
+    // 0x004B4714 L"%s-%s"
+    0x0005, 0x0025, 0x0073, 0x002D, 0x0025, 0x0073, 0x0000,
+    // 0x004B471C L"No Data"
+    0x0007, 0x004E, 0x006F, 0x0020, 0x0044, 0x0061, 0x0074, 0x0061, 0x0000,
+    // 0x004B4724 L"SAVE\\%d.sav"
+    0x000B, 0x0053, 0x0041, 0x0056, 0x0045, 0x005C, 0x0025, 0x0064, 0x002E, 0x0073, 0x0061, 0x0076,
+    0x0000,
+    // 0x004B4730 L"      \uAC8C  \uC784  \uC800  \uC7A5"
+    0x0010, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0xAC8C, 0x0020, 0x0020, 0xC784, 0x0020,
+    0x0020, 0xC800, 0x0020, 0x0020, 0xC7A5, 0x0000,
+    // 0x004B4748 L"         \uCDE8  \uC18C"
+    0x000D, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0xCDE8, 0x0020,
+    0x0020, 0xC18C, 0x0000,
+    // 0x004B4758 L"\uCD08\uAE30\uD654\uBA74\uC73C\uB85C \uB3CC\uC544\uAC00\uC2DC\uACA0\uC2B5\uB2C8\uAE4C\?"
+    0x0010, 0xCD08, 0xAE30, 0xD654, 0xBA74, 0xC73C, 0xB85C, 0x0020, 0xB3CC, 0xC544, 0xAC00, 0xC2DC,
+    0xACA0, 0xC2B5, 0xB2C8, 0xAE4C, 0x003F, 0x0000,
+    // 0x004B4778 L"      \uC800\uC7A5\uD558\uC2DC\uACA0\uC2B5\uB2C8\uAE4C\?"
+    0x000F, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0xC800, 0xC7A5, 0xD558, 0xC2DC, 0xACA0,
+    0xC2B5, 0xB2C8, 0xAE4C, 0x003F, 0x0000,
+    // 0x004B4790 L"Save\uD654\uC77C\uC744 \uB36E\uC5B4 \uC4F0\uC2DC\uACA0\uC2B5\uB2C8\uAE4C\?"
+    0x0012, 0x0053, 0x0061, 0x0076, 0x0065, 0xD654, 0xC77C, 0xC744, 0x0020, 0xB36E, 0xC5B4, 0x0020,
+    0xC4F0, 0xC2DC, 0xACA0, 0xC2B5, 0xB2C8, 0xAE4C, 0x003F, 0x0000,
+    // 0x004B47B0 L"\uC544\uB2C8\uC624"
+    0x0003, 0xC544, 0xB2C8, 0xC624, 0x0000,
+    // 0x004B47BC L"\uCD08\uAE30\uD654\uBA74\uC73C\uB85C \uAC00\uC2DC\uACA0\uC2B5\uB2C8\uAE4C\?"
+    0x000E, 0xCD08, 0xAE30, 0xD654, 0xBA74, 0xC73C, 0xB85C, 0x0020, 0xAC00, 0xC2DC, 0xACA0, 0xC2B5,
+    0xB2C8, 0xAE4C, 0x003F, 0x0000,
+    // 0x004B47D8 L"   \uCDE8  \uC18C"
+    0x0007, 0x0020, 0x0020, 0x0020, 0xCDE8, 0x0020, 0x0020, 0xC18C, 0x0000,
+    // 0x004B47E4 L"  \uCD08  \uAE30  \uD654  \uBA74"
+    0x000C, 0x0020, 0x0020, 0xCD08, 0x0020, 0x0020, 0xAE30, 0x0020, 0x0020, 0xD654, 0x0020, 0x0020,
+    0xBA74, 0x0000,
+    // 0x004B47F8 L"  \uC800  \uC7A5  \uD558  \uAE30"
+    0x000C, 0x0020, 0x0020, 0xC800, 0x0020, 0x0020, 0xC7A5, 0x0020, 0x0020, 0xD558, 0x0020, 0x0020,
+    0xAE30, 0x0000,
+    // 0x004B480C L"%d FPS, MAPID : %d, MAPHEADID : %d  evoTime : %d scrX : %d, scrY : %d"
+    0x0045, 0x0025, 0x0064, 0x0020, 0x0046, 0x0050, 0x0053, 0x002C, 0x0020, 0x004D, 0x0041, 0x0050,
+    0x0049, 0x0044, 0x0020, 0x003A, 0x0020, 0x0025, 0x0064, 0x002C, 0x0020, 0x004D, 0x0041, 0x0050,
+    0x0048, 0x0045, 0x0041, 0x0044, 0x0049, 0x0044, 0x0020, 0x003A, 0x0020, 0x0025, 0x0064, 0x0020,
+    0x0020, 0x0065, 0x0076, 0x006F, 0x0054, 0x0069, 0x006D, 0x0065, 0x0020, 0x003A, 0x0020, 0x0025,
+    0x0064, 0x0020, 0x0073, 0x0063, 0x0072, 0x0058, 0x0020, 0x003A, 0x0020, 0x0025, 0x0064, 0x002C,
+    0x0020, 0x0073, 0x0063, 0x0072, 0x0059, 0x0020, 0x003A, 0x0020, 0x0025, 0x0064, 0x0000,
+    // 0x004B4854 L"Slot %d"
+    0x0007, 0x0053, 0x006C, 0x006F, 0x0074, 0x0020, 0x0025, 0x0064, 0x0000,
+    // 0x004B485C L"movie\\op2.wmv"
+    0x000D, 0x006D, 0x006F, 0x0076, 0x0069, 0x0065, 0x005C, 0x006F, 0x0070, 0x0032, 0x002E, 0x0077,
+    0x006D, 0x0076, 0x0000,
+    // 0x004B486C L"ETCNA\\title2.tim"
+    0x0010, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0074, 0x0069, 0x0074, 0x006C, 0x0065,
+    0x0032, 0x002E, 0x0074, 0x0069, 0x006D, 0x0000,
+    // 0x004B4880 L"%d FPS, MAPID : %d"
+    0x0012, 0x0025, 0x0064, 0x0020, 0x0046, 0x0050, 0x0053, 0x002C, 0x0020, 0x004D, 0x0041, 0x0050,
+    0x0049, 0x0044, 0x0020, 0x003A, 0x0020, 0x0025, 0x0064, 0x0000,
+    // 0x004B4894 L"CARD\\CARD.ALL"
+    0x000D, 0x0043, 0x0041, 0x0052, 0x0044, 0x005C, 0x0043, 0x0041, 0x0052, 0x0044, 0x002E, 0x0041,
+    0x004C, 0x004C, 0x0000,
+    // 0x004B48A4 L"ETCDAT\\SLOT.TIM"
+    0x000F, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0053, 0x004C, 0x004F, 0x0054,
+    0x002E, 0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004B48B4 L"ETCDAT\\ETCTIM.BIN"
+    0x0011, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0045, 0x0054, 0x0043, 0x0054,
+    0x0049, 0x004D, 0x002E, 0x0042, 0x0049, 0x004E, 0x0000,
+    // 0x004B48CC L"Back"
+    0x0004, 0x0042, 0x0061, 0x0063, 0x006B, 0x0000,
+    // 0x004B48D4 L"Name"
+    0x0004, 0x004E, 0x0061, 0x006D, 0x0065, 0x0000,
+    // 0x004B48DC L"%sSOUND\\BGM\\FAALL_%.3d.sgt"
+    0x001A, 0x0025, 0x0073, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0042, 0x0047, 0x004D,
+    0x005C, 0x0046, 0x0041, 0x0041, 0x004C, 0x004C, 0x005F, 0x0025, 0x002E, 0x0033, 0x0064, 0x002E,
+    0x0073, 0x0067, 0x0074, 0x0000,
+    // 0x004B48F8 L"\uC0AD\uC81C\uD560 Slot\uC120\uD0DD"
+    0x000A, 0xC0AD, 0xC81C, 0xD560, 0x0020, 0x0053, 0x006C, 0x006F, 0x0074, 0xC120, 0xD0DD, 0x0000,
+    // 0x004B4908 L"\uC800\uC7A5\uB41C \uAC8C\uC784 \uC120\uD0DD"
+    0x0009, 0xC800, 0xC7A5, 0xB41C, 0x0020, 0xAC8C, 0xC784, 0x0020, 0xC120, 0xD0DD, 0x0000,
+    // 0x004B491C L"\uC800\uC7A5\uD560 Slot\uC120\uD0DD"
+    0x000A, 0xC800, 0xC7A5, 0xD560, 0x0020, 0x0053, 0x006C, 0x006F, 0x0074, 0xC120, 0xD0DD, 0x0000,
+    // 0x004B492C L"      \uAC8C \uC784 \uC885 \uB8CC"
+    0x000D, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0xAC8C, 0x0020, 0xC784, 0x0020, 0xC885,
+    0x0020, 0xB8CC, 0x0000,
+    // 0x004B4940 L"     \uC774 \uC5B4 \uC11C \uD558 \uAE30"
+    0x000E, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0xC774, 0x0020, 0xC5B4, 0x0020, 0xC11C, 0x0020,
+    0xD558, 0x0020, 0xAE30, 0x0000,
+    // 0x004B4954 L"    \uCC98 \uC74C \uBD80 \uD130 \uD558 \uAE30"
+    0x000F, 0x0020, 0x0020, 0x0020, 0x0020, 0xCC98, 0x0020, 0xC74C, 0x0020, 0xBD80, 0x0020, 0xD130,
+    0x0020, 0xD558, 0x0020, 0xAE30, 0x0000,
+    // 0x004B4984 L"\uD604\uC7AC \uADF8\uB798\uD53D \uCE74\uB4DC\uC758 \uD638\uD658\uC131\uC774 \uB514\uC9C0\uBAAC\uC744 \uC2E4\uD589\uD558\uAE30\uC5D0 \uBD80\uC801\uD569 \uD569\uB2C8\uB2E4.\n \uCD5C\uC2E0 \uADF8\uB798\uD53D \uB4DC\uB77C\uC774\uBC84\uB97C \uB2E4\uC2DC \uC124\uCE58\uD558\uC5EC \uC8FC\uC2E0\uB2E4\uC74C, \uB514\uC9C0\uBAAC\uC744 \uB2E4\uC2DC \uC2E4\uD589\uD558\uC2DC\uAE30 \uBC14\uB78D\uB2C8\uB2E4."
+    0x0053, 0xD604, 0xC7AC, 0x0020, 0xADF8, 0xB798, 0xD53D, 0x0020, 0xCE74, 0xB4DC, 0xC758, 0x0020,
+    0xD638, 0xD658, 0xC131, 0xC774, 0x0020, 0xB514, 0xC9C0, 0xBAAC, 0xC744, 0x0020, 0xC2E4, 0xD589,
+    0xD558, 0xAE30, 0xC5D0, 0x0020, 0xBD80, 0xC801, 0xD569, 0x0020, 0xD569, 0xB2C8, 0xB2E4, 0x002E,
+    0x000A, 0x0020, 0xCD5C, 0xC2E0, 0x0020, 0xADF8, 0xB798, 0xD53D, 0x0020, 0xB4DC, 0xB77C, 0xC774,
+    0xBC84, 0xB97C, 0x0020, 0xB2E4, 0xC2DC, 0x0020, 0xC124, 0xCE58, 0xD558, 0xC5EC, 0x0020, 0xC8FC,
+    0xC2E0, 0xB2E4, 0xC74C, 0x002C, 0x0020, 0xB514, 0xC9C0, 0xBAAC, 0xC744, 0x0020, 0xB2E4, 0xC2DC,
+    0x0020, 0xC2E4, 0xD589, 0xD558, 0xC2DC, 0xAE30, 0x0020, 0xBC14, 0xB78D, 0xB2C8, 0xB2E4, 0x002E,
+    0x0000,
+    // 0x004B4A18 L"DirectX \uC5D0\uB7EC"
+    0x000A, 0x0044, 0x0069, 0x0072, 0x0065, 0x0063, 0x0074, 0x0058, 0x0020, 0xC5D0, 0xB7EC, 0x0000,
+    // 0x004B4AC4 L"wb"
+    0x0002, 0x0077, 0x0062, 0x0000,
+    // 0x004B4AC8 L"CHDAT\\MMD%d\\%s.MMD"
+    0x0012, 0x0043, 0x0048, 0x0044, 0x0041, 0x0054, 0x005C, 0x004D, 0x004D, 0x0044, 0x0025, 0x0064,
+    0x005C, 0x0025, 0x0073, 0x002E, 0x004D, 0x004D, 0x0044, 0x0000,
+    // 0x004B5D78 L"\uC8FC\uC778\uACF5"
+    0x0003, 0xC8FC, 0xC778, 0xACF5, 0x0000,
+    // 0x004B87A8 L"CHDAT\\ALLTIM.TIM"
+    0x0010, 0x0043, 0x0048, 0x0044, 0x0041, 0x0054, 0x005C, 0x0041, 0x004C, 0x004C, 0x0054, 0x0049,
+    0x004D, 0x002E, 0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004B87BC L"%s\uC744 \uC77D\uC744 \uC218 \uC5C6\uC2B5\uB2C8\uB2E4."
+    0x000E, 0x0025, 0x0073, 0xC744, 0x0020, 0xC77D, 0xC744, 0x0020, 0xC218, 0x0020, 0xC5C6, 0xC2B5,
+    0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004B8924 L"SOUND\\sl.whb"
+    0x000C, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0073, 0x006C, 0x002E, 0x0077, 0x0068,
+    0x0062, 0x0000,
+    // 0x004B8934 L"SOUND\\ss.whb"
+    0x000C, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0073, 0x0073, 0x002E, 0x0077, 0x0068,
+    0x0062, 0x0000,
+    // 0x004B8944 L"SOUND\\VLALL\\VLALL-%d.WHB"
+    0x0018, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0056, 0x004C, 0x0041, 0x004C, 0x004C,
+    0x005C, 0x0056, 0x004C, 0x0041, 0x004C, 0x004C, 0x002D, 0x0025, 0x0064, 0x002E, 0x0057, 0x0048,
+    0x0042, 0x0000,
+    // 0x004B8960 L"SOUND\\VBALL\\VBALL-%d.WHB"
+    0x0018, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0056, 0x0042, 0x0041, 0x004C, 0x004C,
+    0x005C, 0x0056, 0x0042, 0x0041, 0x004C, 0x004C, 0x002D, 0x0025, 0x0064, 0x002E, 0x0057, 0x0048,
+    0x0042, 0x0000,
+    // 0x004B897C L"SOUND\\SB.WHB"
+    0x000C, 0x0053, 0x004F, 0x0055, 0x004E, 0x0044, 0x005C, 0x0053, 0x0042, 0x002E, 0x0057, 0x0048,
+    0x0042, 0x0000,
+    // 0x004B9AB0 L"STDDAT\\T_DAI.TMD"
+    0x0010, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0054, 0x005F, 0x0044, 0x0041,
+    0x0049, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004B9AC4 L"STDDAT\\B_DAI.TMD"
+    0x0010, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0042, 0x005F, 0x0044, 0x0041,
+    0x0049, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004B9AD8 L"STDDAT\\CHAMP.TMD"
+    0x0010, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0043, 0x0048, 0x0041, 0x004D,
+    0x0050, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004B9AEC L"STDDAT\\TIME.TIM"
+    0x000F, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0054, 0x0049, 0x004D, 0x0045,
+    0x002E, 0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004B9AFC L"STDDAT\\STDTIM.BIN"
+    0x0011, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0053, 0x0054, 0x0044, 0x0054,
+    0x0049, 0x004D, 0x002E, 0x0042, 0x0049, 0x004E, 0x0000,
+    // 0x004B9B10 L"\uC9C0\uB2A5"
+    0x0002, 0xC9C0, 0xB2A5, 0x0000,
+    // 0x004B9B18 L"\uC2A4\uD53C\uD2B8"
+    0x0003, 0xC2A4, 0xD53C, 0xD2B8, 0x0000,
+    // 0x004B9B20 L"\uBC29\uC5B4\uB825"
+    0x0003, 0xBC29, 0xC5B4, 0xB825, 0x0000,
+    // 0x004B9B28 L"\uACF5\uACA9\uB825"
+    0x0003, 0xACF5, 0xACA9, 0xB825, 0x0000,
+    // 0x004B9B30 L"MP"
+    0x0002, 0x004D, 0x0050, 0x0000,
+    // 0x004B9B34 L"HP"
+    0x0002, 0x0048, 0x0050, 0x0000,
+    // 0x004B9B38 L"STDDAT\\WIN_LOSE.TMD"
+    0x0013, 0x0053, 0x0054, 0x0044, 0x0044, 0x0041, 0x0054, 0x005C, 0x0057, 0x0049, 0x004E, 0x005F,
+    0x004C, 0x004F, 0x0053, 0x0045, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004B9B4C L"ETCHI\\EFEDAT.EFE"
+    0x0010, 0x0045, 0x0054, 0x0043, 0x0048, 0x0049, 0x005C, 0x0045, 0x0046, 0x0045, 0x0044, 0x0041,
+    0x0054, 0x002E, 0x0045, 0x0046, 0x0045, 0x0000,
+    // 0x004B9B94 L"\uAD74\uB9BC"
+    0x0002, 0xAD74, 0xB9BC, 0x0000,
+    // 0x004B9B9C L"MS PMincho"
+    0x000A, 0x004D, 0x0053, 0x0020, 0x0050, 0x004D, 0x0069, 0x006E, 0x0063, 0x0068, 0x006F, 0x0000,
+    // 0x004B9BA8 L"\uAD74\uB9BC\uCCB4"
+    0x0003, 0xAD74, 0xB9BC, 0xCCB4, 0x0000,
+    // 0x004BA08C L"SCN\\MAPHEAD.SCN"
+    0x000F, 0x0053, 0x0043, 0x004E, 0x005C, 0x004D, 0x0041, 0x0050, 0x0048, 0x0045, 0x0041, 0x0044,
+    0x002E, 0x0053, 0x0043, 0x004E, 0x0000,
+    // 0x004BA09C L"SCN\\DG.SCN"
+    0x000A, 0x0053, 0x0043, 0x004E, 0x005C, 0x0044, 0x0047, 0x002E, 0x0053, 0x0043, 0x004E, 0x0000,
+    // 0x004BA0A8 L"SCN\\convert.jk"
+    0x000E, 0x0053, 0x0043, 0x004E, 0x005C, 0x0063, 0x006F, 0x006E, 0x0076, 0x0065, 0x0072, 0x0074,
+    0x002E, 0x006A, 0x006B, 0x0000,
+    // 0x004BA0B8 L"ETCNA\\IWA1.TIM"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0049, 0x0057, 0x0041, 0x0031, 0x002E,
+    0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004BA0C8 L"ETCNA\\IWA.TMD"
+    0x000D, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0049, 0x0057, 0x0041, 0x002E, 0x0054,
+    0x004D, 0x0044, 0x0000,
+    // 0x004BA0D8 L"ETCNA\\HAKO.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0048, 0x0041, 0x004B, 0x004F, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA0E8 L"ETCNA\\DOSYA.TMD"
+    0x000F, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0044, 0x004F, 0x0053, 0x0059, 0x0041,
+    0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA0F8 L"ETCNA\\ABOX.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0041, 0x0042, 0x004F, 0x0058, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA108 L"ETCNA\\GAND.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0047, 0x0041, 0x004E, 0x0044, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA118 L"ETCHI\\OP.TIM"
+    0x000C, 0x0045, 0x0054, 0x0043, 0x0048, 0x0049, 0x005C, 0x004F, 0x0050, 0x002E, 0x0054, 0x0049,
+    0x004D, 0x0000,
+    // 0x004BA128 L"ETCHI\\BOSS_EFE.TMD"
+    0x0012, 0x0045, 0x0054, 0x0043, 0x0048, 0x0049, 0x005C, 0x0042, 0x004F, 0x0053, 0x0053, 0x005F,
+    0x0045, 0x0046, 0x0045, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA13C L"ETCDAT\\KARRING.TMD"
+    0x0012, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x004B, 0x0041, 0x0052, 0x0052,
+    0x0049, 0x004E, 0x0047, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA150 L"NULL"
+    0x0004, 0x004E, 0x0055, 0x004C, 0x004C, 0x0000,
+    // 0x004BA158 L"%s"
+    0x0002, 0x0025, 0x0073, 0x0000,
+    // 0x004BA15C L"\uD604\uC7ACBIT"
+    0x0005, 0xD604, 0xC7AC, 0x0042, 0x0049, 0x0054, 0x0000,
+    // 0x004BA164 L"\uC218\uB7C9"
+    0x0002, 0xC218, 0xB7C9, 0x0000,
+    // 0x004BA16C L"\uAC00\uACA9 %d"
+    0x0005, 0xAC00, 0xACA9, 0x0020, 0x0025, 0x0064, 0x0000,
+    // 0x004BA174 L"\uC544\uB2C8\uC694"
+    0x0003, 0xC544, 0xB2C8, 0xC694, 0x0000,
+    // 0x004BA17C L"\uC815\uB9D0 \uC785\uB2C8\uAE4C\?"
+    0x0007, 0xC815, 0xB9D0, 0x0020, 0xC785, 0xB2C8, 0xAE4C, 0x003F, 0x0000,
+    // 0x004BA18C L"%s\uCE74\uB4DC"
+    0x0004, 0x0025, 0x0073, 0xCE74, 0xB4DC, 0x0000,
+    // 0x004BA194 L"%2d"
+    0x0003, 0x0025, 0x0032, 0x0064, 0x0000,
+    // 0x004BA198 L"ETCNA\\T_YAMA.TMD"
+    0x0010, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x0054, 0x005F, 0x0059, 0x0041, 0x004D,
+    0x0041, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BA1AC L"ETCDAT\\TAMA.tim"
+    0x000F, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0054, 0x0041, 0x004D, 0x0041,
+    0x002E, 0x0074, 0x0069, 0x006D, 0x0000,
+    // 0x004BA1BC L"\uBAA8\uC73C\uB294 \uC544\uC774\uD15C"
+    0x0007, 0xBAA8, 0xC73C, 0xB294, 0x0020, 0xC544, 0xC774, 0xD15C, 0x0000,
+    // 0x004BA1CC L"\uC18C\uC9C0\uD55C \uBB3C\uAC74"
+    0x0006, 0xC18C, 0xC9C0, 0xD55C, 0x0020, 0xBB3C, 0xAC74, 0x0000,
+    // 0x004BA1D8 L"\uB9E1\uAE34 \uBB3C\uAC74"
+    0x0005, 0xB9E1, 0xAE34, 0x0020, 0xBB3C, 0xAC74, 0x0000,
+    // 0x004BA1E4 L"\uC124\uBA85\uC744 \uB4E3\uB294\uB2E4"
+    0x0007, 0xC124, 0xBA85, 0xC744, 0x0020, 0xB4E3, 0xB294, 0xB2E4, 0x0000,
+    // 0x004BA1F4 L"\uAC8C\uC784\uC744 \uC2DC\uC791\uD55C\uB2E4"
+    0x0008, 0xAC8C, 0xC784, 0xC744, 0x0020, 0xC2DC, 0xC791, 0xD55C, 0xB2E4, 0x0000,
+    // 0x004BA204 L"\u300C\uC73C\uC73C, \uC6B0\uB9AC\uAC00 \uC84C\uC5B4...\u300D"
+    0x000F, 0x300C, 0xC73C, 0xC73C, 0x002C, 0x0020, 0xC6B0, 0xB9AC, 0xAC00, 0x0020, 0xC84C, 0xC5B4,
+    0x002E, 0x002E, 0x002E, 0x300D, 0x0000,
+    // 0x004BA220 L"\u300C\uD5E4\uD5E4\uD5E4, \uC6B0\uB9AC\uC758 \uC2B9\uB9AC\uB2E4\uFF01\u300D"
+    0x000F, 0x300C, 0xD5E4, 0xD5E4, 0xD5E4, 0x002C, 0x0020, 0xC6B0, 0xB9AC, 0xC758, 0x0020, 0xC2B9,
+    0xB9AC, 0xB2E4, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA23C L"\u300C\uB108, \uC880 \uD558\uB294\uB370\uFF01\u300D"
+    0x000B, 0x300C, 0xB108, 0x002C, 0x0020, 0xC880, 0x0020, 0xD558, 0xB294, 0xB370, 0xFF01, 0x300D,
+    0x0000,
+    // 0x004BA250 L"\u300C\uC544\uC9C1 \uC2B9\uBD80\uB294 \uC774\uC81C\uBD80\uD130\uC57C\uFF01\u300D"
+    0x000F, 0x300C, 0xC544, 0xC9C1, 0x0020, 0xC2B9, 0xBD80, 0xB294, 0x0020, 0xC774, 0xC81C, 0xBD80,
+    0xD130, 0xC57C, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA270 L"\u3000\uC5C6\uAD6C\uB098\uFF01\u300D"
+    0x0006, 0x3000, 0xC5C6, 0xAD6C, 0xB098, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA280 L"\u300C\uB108\uB294, \uC815\uB9D0 \uBCC4 \uBCFC \uC77C\uC774"
+    0x000E, 0x300C, 0xB108, 0xB294, 0x002C, 0x0020, 0xC815, 0xB9D0, 0x0020, 0xBCC4, 0x0020, 0xBCFC,
+    0x0020, 0xC77C, 0xC774, 0x0000,
+    // 0x004BA298 L"\u3000\uADF8\uB7FC, \uAC8C\uC784 \uC2DC\uC791\uD55C\uB2E4\uFF01\uFF01\u300D"
+    0x000F, 0x3000, 0xADF8, 0xB7FC, 0x002C, 0x0020, 0xAC8C, 0xC784, 0x0020, 0xC2DC, 0xC791, 0xD55C,
+    0xB2E4, 0xFF01, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA2B4 L"\u3000\uC6B0\uB9AC\uC758 \uC2B9\uB9AC\uB85C \uD55C\uB2E4\uFF01"
+    0x000C, 0x3000, 0xC6B0, 0xB9AC, 0xC758, 0x0020, 0xC2B9, 0xB9AC, 0xB85C, 0x0020, 0xD55C, 0xB2E4,
+    0xFF01, 0x0000,
+    // 0x004BA2CC L"\u300C\uADF8\uB9AC\uACE0, \uBB34\uC2B9\uBD80\uC77C \uACBD\uC6B0\uB294"
+    0x000E, 0x300C, 0xADF8, 0xB9AC, 0xACE0, 0x002C, 0x0020, 0xBB34, 0xC2B9, 0xBD80, 0xC77C, 0x0020,
+    0xACBD, 0xC6B0, 0xB294, 0x0000,
+    // 0x004BA2E8 L"\u3000\uFF0D\uFF12\uC810\uC774 \uB418\uB2C8\uAE4C \uC870\uC2EC\uD574\uC57C \uD574\uFF01\uFF01\u300D"
+    0x0013, 0x3000, 0xFF0D, 0xFF12, 0xC810, 0xC774, 0x0020, 0xB418, 0xB2C8, 0xAE4C, 0x0020, 0xC870,
+    0xC2EC, 0xD574, 0xC57C, 0x0020, 0xD574, 0xFF01, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA30C L"\u300C\uC0C1\uD558\uC5D0 \uC788\uB294 \uFF22\uFF21\uFF24 \uC5D0 \uC62C\uB9AC\uBA74"
+    0x0011, 0x300C, 0xC0C1, 0xD558, 0xC5D0, 0x0020, 0xC788, 0xB294, 0x0020, 0xFF22, 0xFF21, 0xFF24,
+    0x0020, 0xC5D0, 0x0020, 0xC62C, 0xB9AC, 0xBA74, 0x0000,
+    // 0x004BA32C L"\u3000\uD478\uB978 \uC120\uC758 \uC548 \uCABD\uC774\uBA74\uFF11\uC810.\u300D"
+    0x0010, 0x3000, 0xD478, 0xB978, 0x0020, 0xC120, 0xC758, 0x0020, 0xC548, 0x0020, 0xCABD, 0xC774,
+    0xBA74, 0xFF11, 0xC810, 0x002E, 0x300D, 0x0000,
+    // 0x004BA34C L"\u300C\uC911\uC2EC\uC758 \uFF27\uFF2F\uFF2F\uFF24 \uB9C8\uD06C\uC758 \uBC14\uAE65,"
+    0x0011, 0x300C, 0xC911, 0xC2EC, 0xC758, 0x0020, 0xFF27, 0xFF2F, 0xFF2F, 0xFF24, 0x0020, 0xB9C8,
+    0xD06C, 0xC758, 0x0020, 0xBC14, 0xAE65, 0x002C, 0x0000,
+    // 0x004BA36C L"\u3000\uCEE4\uB9C1\uC2A4\uD1A4\uC744 \uC62C\uB824\uB193\uC73C\uBA74 \uFF12\uC810.\u300D"
+    0x0011, 0x3000, 0xCEE4, 0xB9C1, 0xC2A4, 0xD1A4, 0xC744, 0x0020, 0xC62C, 0xB824, 0xB193, 0xC73C,
+    0xBA74, 0x0020, 0xFF12, 0xC810, 0x002E, 0x300D, 0x0000,
+    // 0x004BA38C L"\u300C\uB4DD\uC810\uC740, \uFF27\uFF2F\uFF2F\uFF24\uB9C8\uD06C\uC5D0"
+    0x000D, 0x300C, 0xB4DD, 0xC810, 0xC740, 0x002C, 0x0020, 0xFF27, 0xFF2F, 0xFF2F, 0xFF24, 0xB9C8,
+    0xD06C, 0xC5D0, 0x0000,
+    // 0x004BA3A8 L"\u3000\uFF41\uFF48\uFF49\uB85C \uACB0\uC815.\u300D"
+    0x000A, 0x3000, 0xFF41, 0xFF48, 0xFF49, 0xB85C, 0x0020, 0xACB0, 0xC815, 0x002E, 0x300D, 0x0000,
+    // 0x004BA3BC L"\u3000\uD30C\uC6CC\uAC8C\uC774\uC9C0\uC5D0 \uB9DE\uCD94\uC5B4\uC11C"
+    0x000C, 0x3000, 0xD30C, 0xC6CC, 0xAC8C, 0xC774, 0xC9C0, 0xC5D0, 0x0020, 0xB9DE, 0xCD94, 0xC5B4,
+    0xC11C, 0x0000,
+    // 0x004BA3D4 L"\u300C\uB9C8\uC9C0\uB9C9\uC73C\uB85C, \uB358\uC9C8 \uC138\uAE30\uB97C \uC815\uD574."
+    0x0012, 0x300C, 0xB9C8, 0xC9C0, 0xB9C9, 0xC73C, 0xB85C, 0x002C, 0x0020, 0xB358, 0xC9C8, 0x0020,
+    0xC138, 0xAE30, 0xB97C, 0x0020, 0xC815, 0xD574, 0x002E, 0x0000,
+    // 0x004BA3F4 L"\u3000\uB358\uC9C8 \uBC29\uD5A5\uC744 \uC815\uD588\uC73C\uBA74\uFF41\uFF48\uFF49\uB85C \uACB0\uC815.\u300D"
+    0x0015, 0x3000, 0xB358, 0xC9C8, 0x0020, 0xBC29, 0xD5A5, 0xC744, 0x0020, 0xC815, 0xD588, 0xC73C,
+    0xBA74, 0xFF41, 0xFF48, 0xFF49, 0xB85C, 0x0020, 0xACB0, 0xC815, 0x002E, 0x300D, 0x0000,
+    // 0x004BA41C L"\u3000\uC6C0\uC9C1\uC77C  \uC218 \uC788\uC5B4\uFF01"
+    0x000B, 0x3000, 0xC6C0, 0xC9C1, 0xC77C, 0x0020, 0x0020, 0xC218, 0x0020, 0xC788, 0xC5B4, 0xFF01,
+    0x0000,
+    // 0x004BA430 L"\u300C\uC774 \uB54C, \uBC29\uD5A5\uD0A4\uC758 \uC0C1\uD558\uB85C"
+    0x000E, 0x300C, 0xC774, 0x0020, 0xB54C, 0x002C, 0x0020, 0xBC29, 0xD5A5, 0xD0A4, 0xC758, 0x0020,
+    0xC0C1, 0xD558, 0xB85C, 0x0000,
+    // 0x004BA44C L"\u3000\uBC29\uD5A5\uD0A4 \uC88C\uC6B0\uB85C \uC120\uD0DD\uD574.\u300D"
+    0x000E, 0x3000, 0xBC29, 0xD5A5, 0xD0A4, 0x0020, 0xC88C, 0xC6B0, 0xB85C, 0x0020, 0xC120, 0xD0DD,
+    0xD574, 0x002E, 0x300D, 0x0000,
+    // 0x004BA468 L"\u300C\uC774\uBC88\uC5D4, \uB358\uC9C0\uB294 \uBC29\uD5A5\uFF08\uC810\uC120\uFF09\uC744"
+    0x0011, 0x300C, 0xC774, 0xBC88, 0xC5D4, 0x002C, 0x0020, 0xB358, 0xC9C0, 0xB294, 0x0020, 0xBC29,
+    0xD5A5, 0xFF08, 0xC810, 0xC120, 0xFF09, 0xC744, 0x0000,
+    // 0x004BA488 L"\u3000\uC6C0\uC9C1\uC774\uC9C0 \uC54A\uC73C\uB2C8\uAE4C \uC798 \uC368\uC57C \uD574\u300D"
+    0x0012, 0x3000, 0xC6C0, 0xC9C1, 0xC774, 0xC9C0, 0x0020, 0xC54A, 0xC73C, 0xB2C8, 0xAE4C, 0x0020,
+    0xC798, 0x0020, 0xC368, 0xC57C, 0x0020, 0xD574, 0x300D, 0x0000,
+    // 0x004BA4AC L"\u3000\uC788\uB294\uB370, \uADF8 \uAC83\uC740 \uBA48\uCD98 \uACF3\uC5D0\uC11C"
+    0x0011, 0x3000, 0xC788, 0xB294, 0xB370, 0x002C, 0x0020, 0xADF8, 0x0020, 0xAC83, 0xC740, 0x0020,
+    0xBA48, 0xCD98, 0x0020, 0xACF3, 0xC5D0, 0xC11C, 0x0000,
+    // 0x004BA4CC L"\u300C\uAC00\uB054, \uB3CC\uC5D0 \uB124 \uB2E4\uB9AC\uAC00 \uC788\uC740 \uAC83\uC774"
+    0x0013, 0x300C, 0xAC00, 0xB054, 0x002C, 0x0020, 0xB3CC, 0xC5D0, 0x0020, 0xB124, 0x0020, 0xB2E4,
+    0xB9AC, 0xAC00, 0x0020, 0xC788, 0xC740, 0x0020, 0xAC83, 0xC774, 0x0000,
+    // 0x004BA4F0 L"\u3000\uC798 \uB9DE\uCDB0\uC57C \uD574\uFF01\u300D"
+    0x000A, 0x3000, 0xC798, 0x0020, 0xB9DE, 0xCDB0, 0xC57C, 0x0020, 0xD574, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA504 L"\u3000\uC788\uC73C\uB2C8\uAC00 \uC0AC\uC6A9\uD560 \uD0C0\uC774\uBC0D\uC744"
+    0x000E, 0x3000, 0xC788, 0xC73C, 0xB2C8, 0xAC00, 0x0020, 0xC0AC, 0xC6A9, 0xD560, 0x0020, 0xD0C0,
+    0xC774, 0xBC0D, 0xC744, 0x0000,
+    // 0x004BA520 L"\u300C\uBB34\uAC70\uC6B4\uB3CC, \uAC00\uBCBC\uC6B4\uB3CC, \uC5EC\uB7EC\uAC00\uC9C0 \uB3CC\uC774"
+    0x0014, 0x300C, 0xBB34, 0xAC70, 0xC6B4, 0xB3CC, 0x002C, 0x0020, 0xAC00, 0xBCBC, 0xC6B4, 0xB3CC,
+    0x002C, 0x0020, 0xC5EC, 0xB7EC, 0xAC00, 0xC9C0, 0x0020, 0xB3CC, 0xC774, 0x0000,
+    // 0x004BA544 L"\u3000\uC120\uD0DD\uD574.\u300D"
+    0x0006, 0x3000, 0xC120, 0xD0DD, 0xD574, 0x002E, 0x300D, 0x0000,
+    // 0x004BA550 L"\u300C\uC6B0\uC120, \uCEE4\uB9C1\uC2A4\uD1A4\uC758 \uD0C0\uC785\uC744"
+    0x000E, 0x300C, 0xC6B0, 0xC120, 0x002C, 0x0020, 0xCEE4, 0xB9C1, 0xC2A4, 0xD1A4, 0xC758, 0x0020,
+    0xD0C0, 0xC785, 0xC744, 0x0000,
+    // 0x004BA56C L"\uD3AD\uADC4\uBAAC"
+    0x0003, 0xD3AD, 0xADC4, 0xBAAC, 0x0000,
+    // 0x004BA574 L"\u300C\uC73C\uC774...\uAC70\uC758 \uC774\uACBC\uB294\uB370...\u300D"
+    0x0011, 0x300C, 0xC73C, 0xC774, 0x002E, 0x002E, 0x002E, 0xAC70, 0xC758, 0x0020, 0xC774, 0xACBC,
+    0xB294, 0xB370, 0x002E, 0x002E, 0x002E, 0x300D, 0x0000,
+    // 0x004BA590 L"\u300C\uD558\uD56B\uD56B\uFF01\uB098\uC758 \uC2B9\uB9AC\uC9C0\uFF01\u300D"
+    0x000D, 0x300C, 0xD558, 0xD56B, 0xD56B, 0xFF01, 0xB098, 0xC758, 0x0020, 0xC2B9, 0xB9AC, 0xC9C0,
+    0xFF01, 0x300D, 0x0000,
+    // 0x004BA5AC L"\u300C\uC774 \uC2B9\uBD80\uB294, \uC9C8 \uC218\uB294 \uC5C6\uC5B4\uFF01\u300D"
+    0x0011, 0x300C, 0xC774, 0x0020, 0xC2B9, 0xBD80, 0xB294, 0x002C, 0x0020, 0xC9C8, 0x0020, 0xC218,
+    0xB294, 0x0020, 0xC5C6, 0xC5B4, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA5CC L"\u300C\uC544\uC9C1 \uC84C\uB2E4\uACE0 \uD560 \uC218\uB294 \uC5C6\uC5B4\uFF01\u300D"
+    0x0011, 0x300C, 0xC544, 0xC9C1, 0x0020, 0xC84C, 0xB2E4, 0xACE0, 0x0020, 0xD560, 0x0020, 0xC218,
+    0xB294, 0x0020, 0xC5C6, 0xC5B4, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA5EC L"\u300C\uD6D7, \uC774\uB300\uB85C \uC2B9\uB9AC\uB2E4\uFF01\u300D"
+    0x000D, 0x300C, 0xD6D7, 0x002C, 0x0020, 0xC774, 0xB300, 0xB85C, 0x0020, 0xC2B9, 0xB9AC, 0xB2E4,
+    0xFF01, 0x300D, 0x0000,
+    // 0x004BA604 L"\u3000\uADF8\uB7FC, \uAC8C\uC784 \uC2DC\uC791\uC774\uB2E4\u300D"
+    0x000D, 0x3000, 0xADF8, 0xB7FC, 0x002C, 0x0020, 0xAC8C, 0xC784, 0x0020, 0xC2DC, 0xC791, 0xC774,
+    0xB2E4, 0x300D, 0x0000,
+    // 0x004BA61C L"\u300C\uB3D9\uC810\uC740, \uC6B0\uB9AC\uC758 \uC2B9\uB9AC\uFF01\uFF01"
+    0x000E, 0x300C, 0xB3D9, 0xC810, 0xC740, 0x002C, 0x0020, 0xC6B0, 0xB9AC, 0xC758, 0x0020, 0xC2B9,
+    0xB9AC, 0xFF01, 0xFF01, 0x0000,
+    // 0x004BA638 L"\u3000\uC870\uC2EC\uD574\uC57C \uD574\uFF01\u300D"
+    0x0009, 0x3000, 0xC870, 0xC2EC, 0xD574, 0xC57C, 0x0020, 0xD574, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA64C L"\u3000\uFF0D\uFF12\uC810 \uC774\uB2C8\uAE4C \uADF8 \uAC83\uB9CC\uC740"
+    0x000E, 0x3000, 0xFF0D, 0xFF12, 0xC810, 0x0020, 0xC774, 0xB2C8, 0xAE4C, 0x0020, 0xADF8, 0x0020,
+    0xAC83, 0xB9CC, 0xC740, 0x0000,
+    // 0x004BA668 L"\u300C\uC88C\uC6B0\uC5D0 \uC788\uB294\uFF22\uFF21\uFF24\uC5D0 \uC62C\uB9AC\uBA74"
+    0x000F, 0x300C, 0xC88C, 0xC6B0, 0xC5D0, 0x0020, 0xC788, 0xB294, 0xFF22, 0xFF21, 0xFF24, 0xC5D0,
+    0x0020, 0xC62C, 0xB9AC, 0xBA74, 0x0000,
+    // 0x004BA688 L"\u3000\uD30C\uB780 \uC120\uC758 \uC548\uCABD\uC774\uBA74 \uFF11\uC810.\u300D"
+    0x0010, 0x3000, 0xD30C, 0xB780, 0x0020, 0xC120, 0xC758, 0x0020, 0xC548, 0xCABD, 0xC774, 0xBA74,
+    0x0020, 0xFF11, 0xC810, 0x002E, 0x300D, 0x0000,
+    // 0x004BA6A8 L"\u300C\uB4DD\uC810\uC740, \uFF27\uFF2F\uFF2F\uFF24\uB9C8\uD06C\uB85C"
+    0x000D, 0x300C, 0xB4DD, 0xC810, 0xC740, 0x002C, 0x0020, 0xFF27, 0xFF2F, 0xFF2F, 0xFF24, 0xB9C8,
+    0xD06C, 0xB85C, 0x0000,
+    // 0x004BA6C4 L"\u3000\uC774 \uAC83\uB3C4, \uFF41\uFF48\uFF49\uB85C \uACB0\uC815.\u300D"
+    0x0010, 0x3000, 0xC774, 0x0020, 0xAC83, 0xB3C4, 0x002C, 0x0020, 0xFF41, 0xFF48, 0xFF49, 0xB85C,
+    0x0020, 0xACB0, 0xC815, 0x002E, 0x300D, 0x0000,
+    // 0x004BA6E0 L"\u300C\uB9C8\uC9C0\uB9C9\uC73C\uB85C \uB358\uC9C0\uB294 \uC138\uAE30\uB97C \uC815\uD574."
+    0x0012, 0x300C, 0xB9C8, 0xC9C0, 0xB9C9, 0xC73C, 0xB85C, 0x0020, 0xB358, 0xC9C0, 0xB294, 0x0020,
+    0xC138, 0xAE30, 0xB97C, 0x0020, 0xC815, 0xD574, 0x002E, 0x0000,
+    // 0x004BA704 L"\u3000\uC6C0\uC9C1\uC77C \uC218\uAC00 \uC788\uC5B4\uFF01"
+    0x000B, 0x3000, 0xC6C0, 0xC9C1, 0xC77C, 0x0020, 0xC218, 0xAC00, 0x0020, 0xC788, 0xC5B4, 0xFF01,
+    0x0000,
+    // 0x004BA71C L"\u3000\uBC29\uD5A5\uD0A4\uC758 \uC88C\uC6B0\uB85C \uC120\uD0DD\uD574.\u300D"
+    0x000F, 0x3000, 0xBC29, 0xD5A5, 0xD0A4, 0xC758, 0x0020, 0xC88C, 0xC6B0, 0xB85C, 0x0020, 0xC120,
+    0xD0DD, 0xD574, 0x002E, 0x300D, 0x0000,
+    // 0x004BA738 L"\u300C\uB2E4\uC74C\uC740, \uB358\uC9C0\uB294 \uBC29\uD5A5\uFF08\uC810\uC120\uFF09\uC744"
+    0x0011, 0x300C, 0xB2E4, 0xC74C, 0xC740, 0x002C, 0x0020, 0xB358, 0xC9C0, 0xB294, 0x0020, 0xBC29,
+    0xD5A5, 0xFF08, 0xC810, 0xC120, 0xFF09, 0xC744, 0x0000,
+    // 0x004BA758 L"\u3000\uC815\uB9D0 \uC798 \uC368\uC57C \uD574.\u300D"
+    0x000C, 0x3000, 0xC815, 0xB9D0, 0x0020, 0xC798, 0x0020, 0xC368, 0xC57C, 0x0020, 0xD574, 0x002E,
+    0x300D, 0x0000,
+    // 0x004BA770 L"\u3000\uC815\uC9C0\uD55C \uACF3\uC5D0\uC11C \uC6C0\uC9C1\uC774\uC9C0 \uC54A\uC73C\uB2C8\uAE4C,"
+    0x0013, 0x3000, 0xC815, 0xC9C0, 0xD55C, 0x0020, 0xACF3, 0xC5D0, 0xC11C, 0x0020, 0xC6C0, 0xC9C1,
+    0xC774, 0xC9C0, 0x0020, 0xC54A, 0xC73C, 0xB2C8, 0xAE4C, 0x002C, 0x0000,
+    // 0x004BA794 L"\u300C\uFF14\uAC1C\uC758 \uB2E4\uB9AC\uAC00 \uC788\uB294 \uB3CC\uC740"
+    0x000E, 0x300C, 0xFF14, 0xAC1C, 0xC758, 0x0020, 0xB2E4, 0xB9AC, 0xAC00, 0x0020, 0xC788, 0xB294,
+    0x0020, 0xB3CC, 0xC740, 0x0000,
+    // 0x004BA7B0 L"\u3000\uADF8 \uAC83\uC774 \uC774\uAE30\uB294 \uBE44\uACB0\uC774\uC57C\uFF01\u300D"
+    0x0010, 0x3000, 0xADF8, 0x0020, 0xAC83, 0xC774, 0x0020, 0xC774, 0xAE30, 0xB294, 0x0020, 0xBE44,
+    0xACB0, 0xC774, 0xC57C, 0xFF01, 0x300D, 0x0000,
+    // 0x004BA7D0 L"\u3000\uC801\uC808\uD558\uAC8C \uC0AC\uC6A9\uD560 \uC218\uAC00 \uC788\uC5B4."
+    0x0010, 0x3000, 0xC801, 0xC808, 0xD558, 0xAC8C, 0x0020, 0xC0AC, 0xC6A9, 0xD560, 0x0020, 0xC218,
+    0xAC00, 0x0020, 0xC788, 0xC5B4, 0x002E, 0x0000,
+    // 0x004BA7F0 L"\u300C\uB098\uB294 \uCC9C\uC7AC\uB2C8\uAE4C, \uC5EC\uB7EC \uAC00\uC9C0 \uB3CC\uC744"
+    0x0012, 0x300C, 0xB098, 0xB294, 0x0020, 0xCC9C, 0xC7AC, 0xB2C8, 0xAE4C, 0x002C, 0x0020, 0xC5EC,
+    0xB7EC, 0x0020, 0xAC00, 0xC9C0, 0x0020, 0xB3CC, 0xC744, 0x0000,
+    // 0x004BA810 L"\u3000\uC885\uB958\uB97C \uC815\uD574\uC57C\uC9C0.\u300D"
+    0x000B, 0x3000, 0xC885, 0xB958, 0xB97C, 0x0020, 0xC815, 0xD574, 0xC57C, 0xC9C0, 0x002E, 0x300D,
+    0x0000,
+    // 0x004BA828 L"\u300C\uADF8\uB807\uAD70, \uC6B0\uC120 \uCEE4\uB9C1\uC2A4\uD1A4\uC758"
+    0x000E, 0x300C, 0xADF8, 0xB807, 0xAD70, 0x002C, 0x0020, 0xC6B0, 0xC120, 0x0020, 0xCEE4, 0xB9C1,
+    0xC2A4, 0xD1A4, 0xC758, 0x0000,
+    // 0x004BA844 L"\uBA54\uD0C8\uCF69\uC54C\uBAAC"
+    0x0005, 0xBA54, 0xD0C8, 0xCF69, 0xC54C, 0xBAAC, 0x0000,
+    // 0x004BA860 L"BIT"
+    0x0003, 0x0042, 0x0049, 0x0054, 0x0000,
+    // 0x004BA864 L"%s\n"
+    0x0003, 0x0025, 0x0073, 0x000A, 0x0000,
+    // 0x004BA868 L"\uCC3E\uC744\uC218\uC5C6\uB294\uB300\uC0AC.txt"
+    0x000B, 0xCC3E, 0xC744, 0xC218, 0xC5C6, 0xB294, 0xB300, 0xC0AC, 0x002E, 0x0074, 0x0078, 0x0074,
+    0x0000,
+    // 0x004BA99A L" 9"
+    0x0002, 0x0020, 0x0039, 0x0000,
+    // 0x004BAA70 L"%s\uC744\uFF08\uB97C\uFF09\uC775\uD614\uB2E4\uFF0E"
+    0x000A, 0x0025, 0x0073, 0xC744, 0xFF08, 0xB97C, 0xFF09, 0xC775, 0xD614, 0xB2E4, 0xFF0E, 0x0000,
+    // 0x004BAA84 L"\uC758\u3000\uBA85\uB839\uC744\u3000\uB4E3\uAC8C\uB418\uC5C8\uB2E4\uFF01"
+    0x000C, 0xC758, 0x3000, 0xBA85, 0xB839, 0xC744, 0x3000, 0xB4E3, 0xAC8C, 0xB418, 0xC5C8, 0xB2E4,
+    0xFF01, 0x0000,
+    // 0x004BAAA0 L"\u300C\uC4F8\uC218\uC788\uB294\u3000\uAE30\uC220\u300D"
+    0x0009, 0x300C, 0xC4F8, 0xC218, 0xC788, 0xB294, 0x3000, 0xAE30, 0xC220, 0x300D, 0x0000,
+    // 0x004BAAB4 L"\u300C\uC774\uACBC\uB2E4\uFF01\u300D"
+    0x0006, 0x300C, 0xC774, 0xACBC, 0xB2E4, 0xFF01, 0x300D, 0x0000,
+    // 0x004BAAC4 L"\u300C\uBAA9\uD45C\uB97C\u3000\uBC14\uAFD4\uFF01\u300D"
+    0x0009, 0x300C, 0xBAA9, 0xD45C, 0xB97C, 0x3000, 0xBC14, 0xAFD4, 0xFF01, 0x300D, 0x0000,
+    // 0x004BAAD8 L"\u300C\uC801\uB2F9\uD788\u3000\uD574\uFF01\u300D"
+    0x0008, 0x300C, 0xC801, 0xB2F9, 0xD788, 0x3000, 0xD574, 0xFF01, 0x300D, 0x0000,
+    // 0x004BAAEC L"\u300C\uD798\uB0B4\uB77C\uFF01\u300D"
+    0x0006, 0x300C, 0xD798, 0xB0B4, 0xB77C, 0xFF01, 0x300D, 0x0000,
+    // 0x004BAB04 L"\uC18D\uB3C4"
+    0x0002, 0xC18D, 0xB3C4, 0x0000,
+    // 0x004BAB0C L"\uC2A4\uD53C\uB4DC"
+    0x0003, 0xC2A4, 0xD53C, 0xB4DC, 0x0000,
+    // 0x004BAB14 L"%s\\%d-%d.wav"
+    0x000C, 0x0025, 0x0073, 0x005C, 0x0025, 0x0064, 0x002D, 0x0025, 0x0064, 0x002E, 0x0077, 0x0061,
+    0x0076, 0x0000,
+    // 0x004BB0C4 L"\uD000\uD020\uD040\uD060\uD080\uD0A0\uD0C0"
+    0x0007, 0xD000, 0xD020, 0xD040, 0xD060, 0xD080, 0xD0A0, 0xD0C0, 0x0000,
+    // 0x004BB978 L"dhlptxtplh"
+    0x000A, 0x0064, 0x0068, 0x006C, 0x0070, 0x0074, 0x0078, 0x0074, 0x0070, 0x006C, 0x0068, 0x0000,
+    // 0x004BB9D4 L"C1\uC744 \uC54C\uC544\uB4E4\uC744 \uC218 \uC788\uAC8C \uB418\uC5C8\uB2E4W"
+    0x0012, 0x0043, 0x0031, 0xC744, 0x0020, 0xC54C, 0xC544, 0xB4E4, 0xC744, 0x0020, 0xC218, 0x0020,
+    0xC788, 0xAC8C, 0x0020, 0xB418, 0xC5C8, 0xB2E4, 0x0057, 0x0000,
+    // 0x004BBB60 L"C1\uC744(\uB97C) \uB5A8\uC5B4\uB728\uB838\uB2E4W"
+    0x000D, 0x0043, 0x0031, 0xC744, 0x0028, 0xB97C, 0x0029, 0x0020, 0xB5A8, 0xC5B4, 0xB728, 0xB838,
+    0xB2E4, 0x0057, 0x0000,
+    // 0x004BBB78 L"C1\uC774(\uAC00)RC7"
+    0x0009, 0x0043, 0x0031, 0xC774, 0x0028, 0xAC00, 0x0029, 0x0052, 0x0043, 0x0037, 0x0000,
+    // 0x004BBB84 L"C7"
+    0x0002, 0x0043, 0x0037, 0x0000,
+    // 0x004BBB88 L"C1\uAC00R\uBD80\uC0C1\uC744 \uC785\uC5C8\uB2E4W"
+    0x000C, 0x0043, 0x0031, 0xAC00, 0x0052, 0xBD80, 0xC0C1, 0xC744, 0x0020, 0xC785, 0xC5C8, 0xB2E4,
+    0x0057, 0x0000,
+    // 0x004BBB9C L"C7\u300C\uB9C8\uC74C\uAECF\uFF01\u300DR"
+    0x0009, 0x0043, 0x0037, 0x300C, 0xB9C8, 0xC74C, 0xAECF, 0xFF01, 0x300D, 0x0052, 0x0000,
+    // 0x004BBBAC L"C7\u300C\uC815\uB3C4\uAECF\uFF01\u300DR"
+    0x0009, 0x0043, 0x0037, 0x300C, 0xC815, 0xB3C4, 0xAECF, 0xFF01, 0x300D, 0x0052, 0x0000,
+    // 0x004BBBBC L"C7\u300C\uB5A8\uC5B4\uC9C0\uB77C\uFF01\u300DR\u300C\uD0C0\uCF13 \uBCC0\uACBD\uFF01\u300DR"
+    0x0013, 0x0043, 0x0037, 0x300C, 0xB5A8, 0xC5B4, 0xC9C0, 0xB77C, 0xFF01, 0x300D, 0x0052, 0x300C,
+    0xD0C0, 0xCF13, 0x0020, 0xBCC0, 0xACBD, 0xFF01, 0x300D, 0x0052, 0x0000,
+    // 0x004BBBE0 L"C7\u300C\uCC38\uB2E4\uFF01\u300DR"
+    0x0008, 0x0043, 0x0037, 0x300C, 0xCC38, 0xB2E4, 0xFF01, 0x300D, 0x0052, 0x0000,
+    // 0x004BBBF0 L"C7\u300C\uC7A5\uBE44\uD55C \uAE30\uC220\u300DR"
+    0x000B, 0x0043, 0x0037, 0x300C, 0xC7A5, 0xBE44, 0xD55C, 0x0020, 0xAE30, 0xC220, 0x300D, 0x0052,
+    0x0000,
+    // 0x004BBC04 L"\uFF05\uB9CC \uAC10\uC18C\uD558\uB2E4 \uFF01W"
+    0x000A, 0xFF05, 0xB9CC, 0x0020, 0xAC10, 0xC18C, 0xD558, 0xB2E4, 0x0020, 0xFF01, 0x0057, 0x0000,
+    // 0x004BBC18 L"C1\u300C\uFF2D\uFF30 \uC18C\uBE44 \uAC10R\uC18C \uB2A5\uB825\u300D\uC744 \uC2B5\uB4DD\uD588\uB2E4\uFF01\uAE30\uC220\uC758 \uC18C\uBE44 \uFF2D\uFF30\uAC00R"
+    0x0022, 0x0043, 0x0031, 0x300C, 0xFF2D, 0xFF30, 0x0020, 0xC18C, 0xBE44, 0x0020, 0xAC10, 0x0052,
+    0xC18C, 0x0020, 0xB2A5, 0xB825, 0x300D, 0xC744, 0x0020, 0xC2B5, 0xB4DD, 0xD588, 0xB2E4, 0xFF01,
+    0xAE30, 0xC220, 0xC758, 0x0020, 0xC18C, 0xBE44, 0x0020, 0xFF2D, 0xFF30, 0xAC00, 0x0052, 0x0000,
+    // 0x004BBC58 L"\uFF11\uFF10"
+    0x0002, 0xFF11, 0xFF10, 0x0000,
+    // 0x004BBC60 L"\uFF11\uFF15"
+    0x0002, 0xFF11, 0xFF15, 0x0000,
+    // 0x004BBC68 L"\uFF12\uFF10"
+    0x0002, 0xFF12, 0xFF10, 0x0000,
+    // 0x004BBC70 L"RC1\uC744 \uC775\uD614\uB2E4W"
+    0x0009, 0x0052, 0x0043, 0x0031, 0xC744, 0x0020, 0xC775, 0xD614, 0xB2E4, 0x0057, 0x0000,
+    // 0x004BBC80 L"Bits"
+    0x0004, 0x0042, 0x0069, 0x0074, 0x0073, 0x0000,
+    // 0x004BBC88 L"\uD604\uC7AC Bit %d"
+    0x0009, 0xD604, 0xC7AC, 0x0020, 0x0042, 0x0069, 0x0074, 0x0020, 0x0025, 0x0064, 0x0000,
+    // 0x004BBC94 L"DoMove - kAssist"
+    0x0010, 0x0044, 0x006F, 0x004D, 0x006F, 0x0076, 0x0065, 0x0020, 0x002D, 0x0020, 0x006B, 0x0041,
+    0x0073, 0x0073, 0x0069, 0x0073, 0x0074, 0x0000,
+    // 0x004BBCA8 L"DoMove - kAll"
+    0x000D, 0x0044, 0x006F, 0x004D, 0x006F, 0x0076, 0x0065, 0x0020, 0x002D, 0x0020, 0x006B, 0x0041,
+    0x006C, 0x006C, 0x0000,
+    // 0x004BBCB8 L"DoMove - kDirect"
+    0x0010, 0x0044, 0x006F, 0x004D, 0x006F, 0x0076, 0x0065, 0x0020, 0x002D, 0x0020, 0x006B, 0x0044,
+    0x0069, 0x0072, 0x0065, 0x0063, 0x0074, 0x0000,
+    // 0x004BCC70 L"ETCDAT\\EX.TIM"
+    0x000D, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0045, 0x0058, 0x002E, 0x0054,
+    0x0049, 0x004D, 0x0000,
+    // 0x004BCC80 L"ETCDAT\\EX.TMD"
+    0x000D, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0045, 0x0058, 0x002E, 0x0054,
+    0x004D, 0x0044, 0x0000,
+    // 0x004BCC90 L"ETCDAT\\FEEL_EF.TMD"
+    0x0012, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0046, 0x0045, 0x0045, 0x004C,
+    0x005F, 0x0045, 0x0046, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BCCA4 L"ETCHI\\MAHI.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x0048, 0x0049, 0x005C, 0x004D, 0x0041, 0x0048, 0x0049, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BCCB4 L"ETCDAT\\DEFEFF.TIM"
+    0x0011, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0044, 0x0045, 0x0046, 0x0045,
+    0x0046, 0x0046, 0x002E, 0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004BCCC8 L"ETCDAT\\DEFEFF.TMD"
+    0x0011, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0044, 0x0045, 0x0046, 0x0045,
+    0x0046, 0x0046, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BCD3C L"|||"
+    0x0003, 0x007C, 0x007C, 0x007C, 0x0000,
+    // 0x004BCD3D L"||"
+    0x0002, 0x007C, 0x007C, 0x0000,
+    // 0x004BCD4C L"%d\n"
+    0x0003, 0x0025, 0x0064, 0x000A, 0x0000,
+    // 0x004BD198 L"\uC544\uC774\uD15C\uC744 \uC8FC\uC6B8 \uC218 \uC5C6\uB2E4."
+    0x000D, 0xC544, 0xC774, 0xD15C, 0xC744, 0x0020, 0xC8FC, 0xC6B8, 0x0020, 0xC218, 0x0020, 0xC5C6,
+    0xB2E4, 0x002E, 0x0000,
+    // 0x004BD1B0 L"\uCD95\uD558\uD569\uB2C8\uB2E4"
+    0x0005, 0xCD95, 0xD558, 0xD569, 0xB2C8, 0xB2E4, 0x0000,
+    // 0x004BD1BC L"ETCHI\\LIFE.TIM"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x0048, 0x0049, 0x005C, 0x004C, 0x0049, 0x0046, 0x0045, 0x002E,
+    0x0054, 0x0049, 0x004D, 0x0000,
+    // 0x004BD1CC L"MOVIE\\EDR.wmv"
+    0x000D, 0x004D, 0x004F, 0x0056, 0x0049, 0x0045, 0x005C, 0x0045, 0x0044, 0x0052, 0x002E, 0x0077,
+    0x006D, 0x0076, 0x0000,
+    // 0x004BD1DC L"MOVIE\\ED2.wmv"
+    0x000D, 0x004D, 0x004F, 0x0056, 0x0049, 0x0045, 0x005C, 0x0045, 0x0044, 0x0032, 0x002E, 0x0077,
+    0x006D, 0x0076, 0x0000,
+    // 0x004BD1F4 L"save\\%d.sav"
+    0x000B, 0x0073, 0x0061, 0x0076, 0x0065, 0x005C, 0x0025, 0x0064, 0x002E, 0x0073, 0x0061, 0x0076,
+    0x0000,
+    // 0x004BD200 L"%s!"
+    0x0003, 0x0025, 0x0073, 0x0021, 0x0000,
+    // 0x004BD4DE L"\\\"b"
+    0x0003, 0x005C, 0x0022, 0x0062, 0x0000,
+    // 0x004BD4F6 L"t\"5"
+    0x0003, 0x0074, 0x0022, 0x0035, 0x0000,
+    // 0x004BE0B4 L"\uBA54\uB2EC"
+    0x0002, 0xBA54, 0xB2EC, 0x0000,
+    // 0x004BE8D4 L"\uC815\uB9D0\uB85C \uBC84\uB9AC\uC2DC\uACA0\uC2B5\uB2C8\uAE4C\?"
+    0x000C, 0xC815, 0xB9D0, 0xB85C, 0x0020, 0xBC84, 0xB9AC, 0xC2DC, 0xACA0, 0xC2B5, 0xB2C8, 0xAE4C,
+    0x003F, 0x0000,
+    // 0x004BE8EC L"\uCE74\uB4DC"
+    0x0002, 0xCE74, 0xB4DC, 0x0000,
+    // 0x004BE8F4 L"\uB514\uC9C0\uBAAC"
+    0x0003, 0xB514, 0xC9C0, 0xBAAC, 0x0000,
+    // 0x004BE8FC L"STATS"
+    0x0005, 0x0053, 0x0054, 0x0041, 0x0054, 0x0053, 0x0000,
+    // 0x004BE904 L"\uAE30\uC220"
+    0x0002, 0xAE30, 0xC220, 0x0000,
+    // 0x004BE90C L"\uB2A5\uB825\uCE58"
+    0x0003, 0xB2A5, 0xB825, 0xCE58, 0x0000,
+    // 0x004BE914 L"\uAE30\uC220 \uC120\uD0DD \uB3C4\uC6C0\uB9D0"
+    0x0009, 0xAE30, 0xC220, 0x0020, 0xC120, 0xD0DD, 0x0020, 0xB3C4, 0xC6C0, 0xB9D0, 0x0000,
+    // 0x004BE928 L"\uB204\uB974\uAE30"
+    0x0003, 0xB204, 0xB974, 0xAE30, 0x0000,
+    // 0x004BE930 L"\uB3C4\uC6C0\uB9D0"
+    0x0003, 0xB3C4, 0xC6C0, 0xB9D0, 0x0000,
+    // 0x004BE938 L"\uC744 \uB204\uB974\uBA74 \uCDE8\uC18C"
+    0x0008, 0xC744, 0x0020, 0xB204, 0xB974, 0xBA74, 0x0020, 0xCDE8, 0xC18C, 0x0000,
+    // 0x004BE948 L"\uAE30\uC220 \uC138\uD305 \uBAA8\uB4DC"
+    0x0008, 0xAE30, 0xC220, 0x0020, 0xC138, 0xD305, 0x0020, 0xBAA8, 0xB4DC, 0x0000,
+    // 0x004BE958 L"\uC744 \uB204\uB974\uBA74"
+    0x0005, 0xC744, 0x0020, 0xB204, 0xB974, 0xBA74, 0x0000,
+    // 0x004BE964 L"\uD30C\uC774\uB110"
+    0x0003, 0xD30C, 0xC774, 0xB110, 0x0000,
+    // 0x004BE96C L"\uD604\uC7AC \uAD50\uCCB4\uD558\uB824\uACE0 \uC120\uD0DD\uD55C \uAE30\uC220\uC785\uB2C8\uB2E4."
+    0x0013, 0xD604, 0xC7AC, 0x0020, 0xAD50, 0xCCB4, 0xD558, 0xB824, 0xACE0, 0x0020, 0xC120, 0xD0DD,
+    0xD55C, 0x0020, 0xAE30, 0xC220, 0xC785, 0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004BE990 L"\uD604\uC7AC\uC758 \uB514\uC9C0\uBAAC\uC740 \uC774 \uAE30\uC220\uC744 \uBC30\uC6B8 \uC218 \uC5C6\uC2B5\uB2C8\uB2E4."
+    0x0019, 0xD604, 0xC7AC, 0xC758, 0x0020, 0xB514, 0xC9C0, 0xBAAC, 0xC740, 0x0020, 0xC774, 0x0020,
+    0xAE30, 0xC220, 0xC744, 0x0020, 0xBC30, 0xC6B8, 0x0020, 0xC218, 0x0020, 0xC5C6, 0xC2B5, 0xB2C8,
+    0xB2E4, 0x002E, 0x0000,
+    // 0x004BE9BC L"\uAE30\uC220\uC740 \uBC30\uC6E0\uC9C0\uB9CC \uC138\uD2B8\uD560 \uC218 \uC5C6\uB294 \uAE30\uC220\uC785\uB2C8\uB2E4."
+    0x0018, 0xAE30, 0xC220, 0xC740, 0x0020, 0xBC30, 0xC6E0, 0xC9C0, 0xB9CC, 0x0020, 0xC138, 0xD2B8,
+    0xD560, 0x0020, 0xC218, 0x0020, 0xC5C6, 0xB294, 0x0020, 0xAE30, 0xC220, 0xC785, 0xB2C8, 0xB2E4,
+    0x002E, 0x0000,
+    // 0x004BE9E8 L"\uC55E\uC73C\uB85C \uBC30\uC6B8 \uC218 \uC788\uC73C\uBA70 \uC138\uD2B8 \uAC00\uB2A5\uD55C \uAE30\uC220\uC785\uB2C8\uB2E4."
+    0x001A, 0xC55E, 0xC73C, 0xB85C, 0x0020, 0xBC30, 0xC6B8, 0x0020, 0xC218, 0x0020, 0xC788, 0xC73C,
+    0xBA70, 0x0020, 0xC138, 0xD2B8, 0x0020, 0xAC00, 0xB2A5, 0xD55C, 0x0020, 0xAE30, 0xC220, 0xC785,
+    0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004BEA18 L"\uAD50\uD658 \uAC00\uB2A5\uD55C \uAE30\uC220\uC785\uB2C8\uB2E4."
+    0x000D, 0xAD50, 0xD658, 0x0020, 0xAC00, 0xB2A5, 0xD55C, 0x0020, 0xAE30, 0xC220, 0xC785, 0xB2C8,
+    0xB2E4, 0x002E, 0x0000,
+    // 0x004BEA30 L"\uD604\uC7AC \uC138\uD2B8\uB418\uC5B4 \uC788\uB294 \uAE30\uC220\uC785\uB2C8\uB2E4."
+    0x0011, 0xD604, 0xC7AC, 0x0020, 0xC138, 0xD2B8, 0xB418, 0xC5B4, 0x0020, 0xC788, 0xB294, 0x0020,
+    0xAE30, 0xC220, 0xC785, 0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004BEA50 L"\uC120\uD0DD\uCDE8\uC18C :"
+    0x0006, 0xC120, 0xD0DD, 0xCDE8, 0xC18C, 0x0020, 0x003A, 0x0000,
+    // 0x004BEA5C L"\uAE30\uC220\uC120\uD0DD :"
+    0x0006, 0xAE30, 0xC220, 0xC120, 0xD0DD, 0x0020, 0x003A, 0x0000,
+    // 0x004BEA68 L"\uB97C \uC120\uD0DD"
+    0x0004, 0xB97C, 0x0020, 0xC120, 0xD0DD, 0x0000,
+    // 0x004BEA70 L"\uAE30\uC220\uC815\uBCF4"
+    0x0004, 0xAE30, 0xC220, 0xC815, 0xBCF4, 0x0000,
+    // 0x004BEA7C L"\uBCF4\uC870\uAE30"
+    0x0003, 0xBCF4, 0xC870, 0xAE30, 0x0000,
+    // 0x004BEA84 L"\uC804\uCCB4\uAE30"
+    0x0003, 0xC804, 0xCCB4, 0xAE30, 0x0000,
+    // 0x004BEA8C L"\uC6D0\uAC70\uB9AC"
+    0x0003, 0xC6D0, 0xAC70, 0xB9AC, 0x0000,
+    // 0x004BEA94 L"\uADFC\uAC70\uB9AC"
+    0x0003, 0xADFC, 0xAC70, 0xB9AC, 0x0000,
+    // 0x004BEA9C L"\?\?"
+    0x0002, 0x003F, 0x003F, 0x0000,
+    // 0x004BEAA4 L"%d   %s"
+    0x0007, 0x0025, 0x0064, 0x0020, 0x0020, 0x0020, 0x0025, 0x0073, 0x0000,
+    // 0x004BEAAC L"\uC644\uC804\uCCB4"
+    0x0003, 0xC644, 0xC804, 0xCCB4, 0x0000,
+    // 0x004BEAB4 L"\uC131\uC219\uAE30"
+    0x0003, 0xC131, 0xC219, 0xAE30, 0x0000,
+    // 0x004BEABC L"\uC131\uC7A5\uAE30"
+    0x0003, 0xC131, 0xC7A5, 0xAE30, 0x0000,
+    // 0x004BEAC4 L"\uC720\uB144\uAE30"
+    0x0003, 0xC720, 0xB144, 0xAE30, 0x0000,
+    // 0x004BEACC L"\uC9C4\uD654\uACC4"
+    0x0003, 0xC9C4, 0xD654, 0xACC4, 0x0000,
+    // 0x004BEAD4 L"Tree"
+    0x0004, 0x0054, 0x0072, 0x0065, 0x0065, 0x0000,
+    // 0x004BEADC L"\uBC84\uB9AC\uAE30"
+    0x0003, 0xBC84, 0xB9AC, 0xAE30, 0x0000,
+    // 0x004BEAE4 L"\uC815\uB82C"
+    0x0002, 0xC815, 0xB82C, 0x0000,
+    // 0x004BEAEC L"\uC774\uB3D9"
+    0x0002, 0xC774, 0xB3D9, 0x0000,
+    // 0x004BEAF4 L"\uC0AC\uC6A9"
+    0x0002, 0xC0AC, 0xC6A9, 0x0000,
+    // 0x004BEAFC L"\uAE30\uBCF8"
+    0x0002, 0xAE30, 0xBCF8, 0x0000,
+    // 0x004BEB04 L"\uC721\uC131\uC6A9"
+    0x0003, 0xC721, 0xC131, 0xC6A9, 0x0000,
+    // 0x004BEB0C L"\uC804\uD22C\uC6A9"
+    0x0003, 0xC804, 0xD22C, 0xC6A9, 0x0000,
+    // 0x004BEB14 L"30"
+    0x0002, 0x0033, 0x0030, 0x0000,
+    // 0x004BEB18 L"\uD0A4 \uCDE8\uC18C"
+    0x0004, 0xD0A4, 0x0020, 0xCDE8, 0xC18C, 0x0000,
+    // 0x004BEB20 L"\uD0A4 \uC120\uD0DD"
+    0x0004, 0xD0A4, 0x0020, 0xC120, 0xD0DD, 0x0000,
+    // 0x004BEB28 L"\uC58D \uC58D"
+    0x0003, 0xC58D, 0x0020, 0xC58D, 0x0000,
+    // 0x004BEB30 L"\uD68D\uB4DD \uBA54\uB2EC"
+    0x0005, 0xD68D, 0xB4DD, 0x0020, 0xBA54, 0xB2EC, 0x0000,
+    // 0x004BEB3C L"Card List"
+    0x0009, 0x0043, 0x0061, 0x0072, 0x0064, 0x0020, 0x004C, 0x0069, 0x0073, 0x0074, 0x0000,
+    // 0x004BEB48 L"ETCNA\\MEDAL.TMD"
+    0x000F, 0x0045, 0x0054, 0x0043, 0x004E, 0x0041, 0x005C, 0x004D, 0x0045, 0x0044, 0x0041, 0x004C,
+    0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004BECD0 L"ETCDAT\\TAMA.TMD"
+    0x000F, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0054, 0x0041, 0x004D, 0x0041,
+    0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004C0880 L"'()('-,-!\"!#)*(,+-"
+    0x0012, 0x0027, 0x0028, 0x0029, 0x0028, 0x0027, 0x002D, 0x002C, 0x002D, 0x0021, 0x0022, 0x0021,
+    0x0023, 0x0029, 0x002A, 0x0028, 0x002C, 0x002B, 0x002D, 0x0000,
+    // 0x004C0888 L"!\"!#)*(,+-"
+    0x000A, 0x0021, 0x0022, 0x0021, 0x0023, 0x0029, 0x002A, 0x0028, 0x002C, 0x002B, 0x002D, 0x0000,
+    // 0x004C088C L")*(,+-"
+    0x0006, 0x0029, 0x002A, 0x0028, 0x002C, 0x002B, 0x002D, 0x0000,
+    // 0x004C0894 L"\"$\"#%#"
+    0x0006, 0x0022, 0x0024, 0x0022, 0x0023, 0x0025, 0x0023, 0x0000,
+    // 0x004C099C L"0123456789"
+    0x000A, 0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038, 0x0039, 0x0000,
+    // 0x004C09A8 L".TMD"
+    0x0004, 0x002E, 0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004C09B0 L"DOOR\\DOOR"
+    0x0009, 0x0044, 0x004F, 0x004F, 0x0052, 0x005C, 0x0044, 0x004F, 0x004F, 0x0052, 0x0000,
+    // 0x004C09BC L"ETCDAT\\SEA.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0053, 0x0045, 0x0041, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004C09CC L"%dD,%d"
+    0x0006, 0x0025, 0x0064, 0x0044, 0x002C, 0x0025, 0x0064, 0x0000,
+    // 0x004C09D4 L"ETCDAT\\SAO.TMD"
+    0x000E, 0x0045, 0x0054, 0x0043, 0x0044, 0x0041, 0x0054, 0x005C, 0x0053, 0x0041, 0x004F, 0x002E,
+    0x0054, 0x004D, 0x0044, 0x0000,
+    // 0x004C09E4 L"\uC2E4\uC774 \uB04A\uC5B4\uC838 \uBC84\uB838\uB2E4"
+    0x000A, 0xC2E4, 0xC774, 0x0020, 0xB04A, 0xC5B4, 0xC838, 0x0020, 0xBC84, 0xB838, 0xB2E4, 0x0000,
+    // 0x004C09F8 L"\uC7A1\uC558\uB2E4"
+    0x0003, 0xC7A1, 0xC558, 0xB2E4, 0x0000,
+    // 0x004C0A00 L"\uAC00 \uAC78\uB838\uB2E4!"
+    0x0006, 0xAC00, 0x0020, 0xAC78, 0xB838, 0xB2E4, 0x0021, 0x0000,
+    // 0x004C0A0C L"..\uADF8\uB7EC\uB098, \uAC00\uBC1C\uC774 \uAF49\uCC28\uC11C \uAC16\uC744 \uC218 \uC5C6\uB2E4"
+    0x0016, 0x002E, 0x002E, 0xADF8, 0xB7EC, 0xB098, 0x002C, 0x0020, 0xAC00, 0xBC1C, 0xC774, 0x0020,
+    0xAF49, 0xCC28, 0xC11C, 0x0020, 0xAC16, 0xC744, 0x0020, 0xC218, 0x0020, 0xC5C6, 0xB2E4, 0x0000,
+    // 0x004C0A34 L"\uC744(\uB97C) \uB9E4\uB2EC\uC544 \uC62C\uB838\uB2E4"
+    0x000C, 0xC744, 0x0028, 0xB97C, 0x0029, 0x0020, 0xB9E4, 0xB2EC, 0xC544, 0x0020, 0xC62C, 0xB838,
+    0xB2E4, 0x0000,
+    // 0x004C0A4C L"\uB77C\uB3C4 \uAC00\uC5FD\uAE30 \uB54C\uBB38\uC5D0 \uB193\uC544\uC8FC\uACE0 \uB4E4 \uAC83 \uAC19\uB2E4"
+    0x0016, 0xB77C, 0xB3C4, 0x0020, 0xAC00, 0xC5FD, 0xAE30, 0x0020, 0xB54C, 0xBB38, 0xC5D0, 0x0020,
+    0xB193, 0xC544, 0xC8FC, 0xACE0, 0x0020, 0xB4E4, 0x0020, 0xAC83, 0x0020, 0xAC19, 0xB2E4, 0x0000,
+    // 0x004C0A74 L"\uC804\uCCB4\uAE38\uC774 %d\uC0AC\uC774\uC988"
+    0x000A, 0xC804, 0xCCB4, 0xAE38, 0xC774, 0x0020, 0x0025, 0x0064, 0xC0AC, 0xC774, 0xC988, 0x0000,
+    // 0x004C0A88 L"\uAD49\uC7A5\uD558\uB2E4! \uC804\uCCB4\uAE38\uC774 %d\uC0AC\uC774\uC988"
+    0x0010, 0xAD49, 0xC7A5, 0xD558, 0xB2E4, 0x0021, 0x0020, 0xC804, 0xCCB4, 0xAE38, 0xC774, 0x0020,
+    0x0025, 0x0064, 0xC0AC, 0xC774, 0xC988, 0x0000,
+    // 0x004C0AA4 L"\uAC78\uB838\uB2E4!!!"
+    0x0006, 0xAC78, 0xB838, 0xB2E4, 0x0021, 0x0021, 0x0021, 0x0000,
+    // 0x004C0AB0 L"\uC544\uCC28! \uB108\uBB34 \uBE68\uB790\uB2E4"
+    0x000A, 0xC544, 0xCC28, 0x0021, 0x0020, 0xB108, 0xBB34, 0x0020, 0xBE68, 0xB790, 0xB2E4, 0x0000,
+    // 0x004C0AC4 L"\uADF8\uB798\uB3C4 \uBBF8\uB07C\uB294 \uADF8\uB300\uB85C \uC788\uB2E4."
+    0x000F, 0xADF8, 0xB798, 0xB3C4, 0x0020, 0xBBF8, 0xB07C, 0xB294, 0x0020, 0xADF8, 0xB300, 0xB85C,
+    0x0020, 0xC788, 0xB2E4, 0x002E, 0x0000,
+    // 0x004C0AE0 L"\uC544\uCC28! \uB108\uBB34 \uB2A6\uC5C8\uB2E4"
+    0x000A, 0xC544, 0xCC28, 0x0021, 0x0020, 0xB108, 0xBB34, 0x0020, 0xB2A6, 0xC5C8, 0xB2E4, 0x0000,
+    // 0x004C0AF4 L"\uBBF8\uB07C\uAC00 \uB5A8\uC5B4\uC838 \uB098\uAC14\uB2E4."
+    0x000C, 0xBBF8, 0xB07C, 0xAC00, 0x0020, 0xB5A8, 0xC5B4, 0xC838, 0x0020, 0xB098, 0xAC14, 0xB2E4,
+    0x002E, 0x0000,
+    // 0x004C0B0C L"\uBB54\uAC00 \uAC78\uB838\uC744\uB824\uB098\?"
+    0x0009, 0xBB54, 0xAC00, 0x0020, 0xAC78, 0xB838, 0xC744, 0xB824, 0xB098, 0x003F, 0x0000,
+    // 0x004C0B20 L"%x::%s"
+    0x0006, 0x0025, 0x0078, 0x003A, 0x003A, 0x0025, 0x0073, 0x0000,
+    // 0x004C0B28 L"DirectX 8.1\uBC84\uC804\uC774 \uC124\uCE58\uB418\uC5B4 \uC788\uC73C\uB098 \"\uD558\uB4DC\uC6E8\uC5B4 \uAC00\uC18D Direct3D\"\uB97C \uCD08\uAE30\uD654 \uD560 \uC218 \uC5C6\uC2B5\uB2C8\uB2E4."
+    0x0039, 0x0044, 0x0069, 0x0072, 0x0065, 0x0063, 0x0074, 0x0058, 0x0020, 0x0038, 0x002E, 0x0031,
+    0xBC84, 0xC804, 0xC774, 0x0020, 0xC124, 0xCE58, 0xB418, 0xC5B4, 0x0020, 0xC788, 0xC73C, 0xB098,
+    0x0020, 0x0022, 0xD558, 0xB4DC, 0xC6E8, 0xC5B4, 0x0020, 0xAC00, 0xC18D, 0x0020, 0x0044, 0x0069,
+    0x0072, 0x0065, 0x0063, 0x0074, 0x0033, 0x0044, 0x0022, 0xB97C, 0x0020, 0xCD08, 0xAE30, 0xD654,
+    0x0020, 0xD560, 0x0020, 0xC218, 0x0020, 0xC5C6, 0xC2B5, 0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004C0B7C L"DirectX 8.1\uBC84\uC804\uC774 \uC124\uCE58\uB418\uC5B4 \uC788\uC9C0 \uC54A\uC2B5\uB2C8\uB2E4."
+    0x001C, 0x0044, 0x0069, 0x0072, 0x0065, 0x0063, 0x0074, 0x0058, 0x0020, 0x0038, 0x002E, 0x0031,
+    0xBC84, 0xC804, 0xC774, 0x0020, 0xC124, 0xCE58, 0xB418, 0xC5B4, 0x0020, 0xC788, 0xC9C0, 0x0020,
+    0xC54A, 0xC2B5, 0xB2C8, 0xB2E4, 0x002E, 0x0000,
+    // 0x004C0BA8 L"\uCD5C\uB300 \uFF28\uFF30"
+    0x0005, 0xCD5C, 0xB300, 0x0020, 0xFF28, 0xFF30, 0x0000,
+    // 0x004C0BB4 L"\uCD5C\uB300 \uFF2D\uFF30"
+    0x0005, 0xCD5C, 0xB300, 0x0020, 0xFF2D, 0xFF30, 0x0000,
+    // 0x004C0BF0 L"\uFF10\uFF11\uFF12\uFF13\uFF14\uFF15\uFF16\uFF17\uFF18\uFF19"
+    0x000A, 0xFF10, 0xFF11, 0xFF12, 0xFF13, 0xFF14, 0xFF15, 0xFF16, 0xFF17, 0xFF18, 0xFF19, 0x0000,
+    // 0x004C0E28 L"\uD68C\uBCF5 \uD50C\uB85C\uD53C"
+    0x0006, 0xD68C, 0xBCF5, 0x0020, 0xD50C, 0xB85C, 0xD53C, 0x0000,
+    // 0x004C6788 L".vW@"
+    0x0004, 0x002E, 0x0076, 0x0057, 0x0040, 0x0000,
+    // 0x004C8168 L",L"
+    0x0002, 0x002C, 0x004C, 0x0000,
 };
 
-// Compute the number of strings at compile time.  Using constexpr
-// ensures this value is known at build time and avoids mismatches.
-const std::size_t g_strings_count = sizeof(g_strings) / sizeof(g_strings[0]);
\ No newline at end of file
+const uint32_t g_string_offsets[kStringCount] = {
+         1,     12,     26,     36,     65,     77,     91,    108,
+       122,    136,    154,    172,    176,    194,    213,    230,
+       249,    253,    261,    269,    274,    293,    333,    339,
+       346,    367,    372,    379,    388,    404,    410,    416,
+       422,    428,    444,    464,    484,    499,    506,    515,
+       528,    546,    561,    579,    596,    616,    621,    637,
+       646,    660,    674,    745,    754,    769,    787,    807,
+       822,    839,    858,    864,    870,    898,    910,    921,
+       933,    948,    964,    981,   1066,   1078,   1082,   1102,
+      1107,   1125,   1141,   1155,   1169,   1195,   1221,   1235,
+      1253,   1271,   1289,   1306,   1325,   1329,   1334,   1339,
+      1344,   1348,   1352,   1373,   1391,   1395,   1407,   1412,
+      1429,   1441,   1457,   1473,   1488,   1504,   1521,   1537,
+      1553,   1567,   1587,   1607,   1613,   1617,   1624,   1628,
+      1635,   1640,   1649,   1655,   1660,   1678,   1695,   1704,
+      1712,   1719,   1728,   1738,   1755,   1772,   1785,   1802,
+      1810,   1826,   1843,   1857,   1873,   1894,   1913,   1931,
+      1950,   1969,   1984,   1996,   2010,   2030,   2053,   2066,
+      2082,   2098,   2117,   2137,   2156,   2177,   2189,   2205,
+      2227,   2235,   2251,   2256,   2275,   2290,   2309,   2328,
+      2343,   2358,   2374,   2385,   2401,   2418,   2436,   2451,
+      2469,   2489,   2502,   2519,   2538,   2552,   2573,   2589,
+      2607,   2625,   2645,   2658,   2674,   2681,   2686,   2691,
+      2704,   2708,   2720,   2734,   2745,   2753,   2764,   2774,
+      2782,   2786,   2791,   2805,   2814,   2826,   2846,   2861,
+      2872,   2876,   2890,   2901,   2912,   2933,   2943,   2956,
+      2968,   3004,   3008,   3012,   3016,   3027,   3033,   3044,
+      3062,   3077,   3095,   3110,   3125,   3145,   3161,   3180,
+      3199,   3204,   3208,   3213,   3228,   3235,   3251,   3266,
+      3281,   3294,   3299,   3304,   3309,   3313,   3327,   3331,
+      3336,   3343,   3347,   3352,   3363,   3368,   3373,   3383,
+      3393,   3400,   3405,   3426,   3453,   3479,   3507,   3522,
+      3541,   3549,   3557,   3563,   3569,   3574,   3579,   3584,
+      3589,   3593,   3602,   3607,   3612,   3617,   3622,   3627,
+      3633,   3638,   3642,   3646,   3650,   3654,   3659,   3664,
+      3668,   3674,   3680,   3685,   3692,   3703,   3720,   3737,
+      3757,   3769,   3777,   3785,   3797,   3803,   3814,   3830,
+      3838,   3854,   3866,   3871,   3879,   3903,   3917,   3941,
+      3953,   3971,   3979,   3991,   4008,   4020,   4034,   4045,
+      4053,   4112,   4142,   4149,   4156,   4168,   4176,   4182,
+};
+
+const uint32_t g_string_addresses[kStringCount] = {
+    0x004A7EF0, 0x004A7EFC, 0x004A7F0C, 0x004A82BC, 0x004A82D8, 0x004A82E4, 0x004A82F4, 0x004A9C00,
+    0x004A9C10, 0x004B2400, 0x004B2414, 0x004B2428, 0x004B242C, 0x004B2440, 0x004B2454, 0x004B2464,
+    0x004B2478, 0x004B2598, 0x004B4080, 0x004B408C, 0x004B4094, 0x004B40B4, 0x004B40DC, 0x004B40EC,
+    0x004B40F8, 0x004B411C, 0x004B432C, 0x004B4338, 0x004B469C, 0x004B46AC, 0x004B46B4, 0x004B46BC,
+    0x004B46C4, 0x004B46CC, 0x004B46DC, 0x004B46F0, 0x004B4704, 0x004B4714, 0x004B471C, 0x004B4724,
+    0x004B4730, 0x004B4748, 0x004B4758, 0x004B4778, 0x004B4790, 0x004B47B0, 0x004B47BC, 0x004B47D8,
+    0x004B47E4, 0x004B47F8, 0x004B480C, 0x004B4854, 0x004B485C, 0x004B486C, 0x004B4880, 0x004B4894,
+    0x004B48A4, 0x004B48B4, 0x004B48CC, 0x004B48D4, 0x004B48DC, 0x004B48F8, 0x004B4908, 0x004B491C,
+    0x004B492C, 0x004B4940, 0x004B4954, 0x004B4984, 0x004B4A18, 0x004B4AC4, 0x004B4AC8, 0x004B5D78,
+    0x004B87A8, 0x004B87BC, 0x004B8924, 0x004B8934, 0x004B8944, 0x004B8960, 0x004B897C, 0x004B9AB0,
+    0x004B9AC4, 0x004B9AD8, 0x004B9AEC, 0x004B9AFC, 0x004B9B10, 0x004B9B18, 0x004B9B20, 0x004B9B28,
+    0x004B9B30, 0x004B9B34, 0x004B9B38, 0x004B9B4C, 0x004B9B94, 0x004B9B9C, 0x004B9BA8, 0x004BA08C,
+    0x004BA09C, 0x004BA0A8, 0x004BA0B8, 0x004BA0C8, 0x004BA0D8, 0x004BA0E8, 0x004BA0F8, 0x004BA108,
+    0x004BA118, 0x004BA128, 0x004BA13C, 0x004BA150, 0x004BA158, 0x004BA15C, 0x004BA164, 0x004BA16C,
+    0x004BA174, 0x004BA17C, 0x004BA18C, 0x004BA194, 0x004BA198, 0x004BA1AC, 0x004BA1BC, 0x004BA1CC,
+    0x004BA1D8, 0x004BA1E4, 0x004BA1F4, 0x004BA204, 0x004BA220, 0x004BA23C, 0x004BA250, 0x004BA270,
+    0x004BA280, 0x004BA298, 0x004BA2B4, 0x004BA2CC, 0x004BA2E8, 0x004BA30C, 0x004BA32C, 0x004BA34C,
+    0x004BA36C, 0x004BA38C, 0x004BA3A8, 0x004BA3BC, 0x004BA3D4, 0x004BA3F4, 0x004BA41C, 0x004BA430,
+    0x004BA44C, 0x004BA468, 0x004BA488, 0x004BA4AC, 0x004BA4CC, 0x004BA4F0, 0x004BA504, 0x004BA520,
+    0x004BA544, 0x004BA550, 0x004BA56C, 0x004BA574, 0x004BA590, 0x004BA5AC, 0x004BA5CC, 0x004BA5EC,
+    0x004BA604, 0x004BA61C, 0x004BA638, 0x004BA64C, 0x004BA668, 0x004BA688, 0x004BA6A8, 0x004BA6C4,
+    0x004BA6E0, 0x004BA704, 0x004BA71C, 0x004BA738, 0x004BA758, 0x004BA770, 0x004BA794, 0x004BA7B0,
+    0x004BA7D0, 0x004BA7F0, 0x004BA810, 0x004BA828, 0x004BA844, 0x004BA860, 0x004BA864, 0x004BA868,
+    0x004BA99A, 0x004BAA70, 0x004BAA84, 0x004BAAA0, 0x004BAAB4, 0x004BAAC4, 0x004BAAD8, 0x004BAAEC,
+    0x004BAB04, 0x004BAB0C, 0x004BAB14, 0x004BB0C4, 0x004BB978, 0x004BB9D4, 0x004BBB60, 0x004BBB78,
+    0x004BBB84, 0x004BBB88, 0x004BBB9C, 0x004BBBAC, 0x004BBBBC, 0x004BBBE0, 0x004BBBF0, 0x004BBC04,
+    0x004BBC18, 0x004BBC58, 0x004BBC60, 0x004BBC68, 0x004BBC70, 0x004BBC80, 0x004BBC88, 0x004BBC94,
+    0x004BBCA8, 0x004BBCB8, 0x004BCC70, 0x004BCC80, 0x004BCC90, 0x004BCCA4, 0x004BCCB4, 0x004BCCC8,
+    0x004BCD3C, 0x004BCD3D, 0x004BCD4C, 0x004BD198, 0x004BD1B0, 0x004BD1BC, 0x004BD1CC, 0x004BD1DC,
+    0x004BD1F4, 0x004BD200, 0x004BD4DE, 0x004BD4F6, 0x004BE0B4, 0x004BE8D4, 0x004BE8EC, 0x004BE8F4,
+    0x004BE8FC, 0x004BE904, 0x004BE90C, 0x004BE914, 0x004BE928, 0x004BE930, 0x004BE938, 0x004BE948,
+    0x004BE958, 0x004BE964, 0x004BE96C, 0x004BE990, 0x004BE9BC, 0x004BE9E8, 0x004BEA18, 0x004BEA30,
+    0x004BEA50, 0x004BEA5C, 0x004BEA68, 0x004BEA70, 0x004BEA7C, 0x004BEA84, 0x004BEA8C, 0x004BEA94,
+    0x004BEA9C, 0x004BEAA4, 0x004BEAAC, 0x004BEAB4, 0x004BEABC, 0x004BEAC4, 0x004BEACC, 0x004BEAD4,
+    0x004BEADC, 0x004BEAE4, 0x004BEAEC, 0x004BEAF4, 0x004BEAFC, 0x004BEB04, 0x004BEB0C, 0x004BEB14,
+    0x004BEB18, 0x004BEB20, 0x004BEB28, 0x004BEB30, 0x004BEB3C, 0x004BEB48, 0x004BECD0, 0x004C0880,
+    0x004C0888, 0x004C088C, 0x004C0894, 0x004C099C, 0x004C09A8, 0x004C09B0, 0x004C09BC, 0x004C09CC,
+    0x004C09D4, 0x004C09E4, 0x004C09F8, 0x004C0A00, 0x004C0A0C, 0x004C0A34, 0x004C0A4C, 0x004C0A74,
+    0x004C0A88, 0x004C0AA4, 0x004C0AB0, 0x004C0AC4, 0x004C0AE0, 0x004C0AF4, 0x004C0B0C, 0x004C0B20,
+    0x004C0B28, 0x004C0B7C, 0x004C0BA8, 0x004C0BB4, 0x004C0BF0, 0x004C0E28, 0x004C6788, 0x004C8168,
+};
+
+const int32_t g_string_text_displacements[kStringTextCount] = {
+         0,      0,      0,     -5,     -6,      1,     -8,      2,
+         0,    -11,    -15,      4,    -25,      0,      2,      4,
+       -28,      3,      0,      0,      1,      0,      0,      2,
+         0,      0,      0,    -30,    -38,      0,    -42,    -43,
+         1,      0,      0,    -44,      0,      0,      0,      0,
+         2,      2,      5,      1,      0,    -46,      0,    -47,
+         0,    -50,      0,      0,    -53,      1,    -55,      0,
+       -56,      1,      0,      1,      1,    -61,    -70,      0,
+       -74,      1,      0,    -77,    -82,      0,    -84,      2,
+       -86,      1,    -87,      0,      0,      0,      1,    -94,
+         0,   -105,      0,      5,      0,      0,   -107,   -110,
+      -111,      0,      1,      0,      0,      0,      3,      0,
+      -112,      0,      0,   -118,      0,      0,      0,      0,
+         0,      0,      1,   -120,      0,      0,      1,   -124,
+         1,      1,      2,   -126,   -127,   -129,   -131,   -134,
+         0,      0,      2,   -142,      0,      0,      0,      1,
+      -146,      0,      1,   -151,   -152,   -153,   -158,      0,
+      -161,      0,      1,      1,      7,      1,   -163,      0,
+      -170,      1,   -172,      1,      1,   -174,   -175,   -176,
+         0,      1,   -178,      0,      0,   -179,   -184,      0,
+      -185,   -188,      7,      0,   -190,      2,   -193,      0,
+         0,   -194,      2,   -195,      0,   -197,   -199,      8,
+         0,   -201,      0,      1,      9,      0,      0,      0,
+         0,      0,      0,      0,      0,      1,      0,      0,
+         2,   -205,   -207,      2,      1,      0,      3,   -208,
+      -213,   -214,   -222,      2,      0,   -224,      2,   -228,
+         0,      0,      0,      0,   -235,      5,      0,      0,
+      -238,      1,      1,   -240,      1,      1,      1,      3,
+         0,      0,      2,      0,      0,   -241,   -242,      1,
+         1,   -245,   -248,      1,      0,   -251,   -252,      0,
+         0,      2,   -253,      0,      3,   -255,     12,      0,
+         0,   -259,      4,      0,   -260,   -261,   -265,      2,
+         0,   -266,   -267,      1,      1,     13,   -269,      7,
+      -271,      0,   -272,      0,      0,   -275,   -278,      0,
+         2,      0,      0,      0,   -280,      0,      5,      0,
+        11,      0,      7,      0,   -281,      0,      4,      9,
+         0,      0,      0,      0,      1,   -284,      0,   -285,
+         6,      4,   -286,   -289,   -292,      0,   -294,      9,
+        18,      0,      6,   -297,      0,      0,   -301,   -303,
+         0,   -305,   -307,      0,      8,   -308,     14,   -314,
+};
+
+const uint32_t g_string_text_slots[kStringTextCount] = {
+       185,    203,    279,     29,     21,     17,    110,     78,
+        46,     77,    182,    260,    189,    284,     36,    229,
+        60,     71,     64,    273,     75,    228,    241,    114,
+       180,    311,    223,     70,    234,      2,    174,    224,
+        59,      3,    147,    128,    268,    100,    183,    319,
+       296,    286,     16,    207,     92,    146,     39,    137,
+       105,     10,     62,    291,     74,    212,     35,    305,
+        85,    217,    113,    206,     91,    308,    294,    133,
+       162,    126,    299,    280,    285,     63,    297,     50,
+       255,    163,    222,    141,    161,     82,    176,    169,
+       160,    152,      7,    166,    122,    109,    239,     79,
+       197,    236,     23,    184,     19,    252,    111,     49,
+       139,    186,    265,    261,    270,    233,    250,    153,
+       318,    167,    173,    257,    175,    205,    199,    132,
+       102,     95,    302,    193,    142,    198,    249,    158,
+       136,    106,    138,    171,    309,    214,    243,      0,
+       253,    247,    211,    232,    293,     40,    303,    101,
+       307,    201,    190,     48,    208,    287,    200,     84,
+       104,    178,    301,    219,    310,    306,    315,    266,
+       107,    149,    204,    144,     57,     65,    216,    274,
+       155,     68,     87,      1,    172,     18,      6,    289,
+       226,    267,     13,    125,    157,     53,    168,     76,
+       288,    227,    151,    225,    194,    195,      5,    251,
+       259,    159,    262,    118,    130,    235,    179,    215,
+        34,    242,    314,     93,     67,    221,     33,     55,
+       210,    134,     24,    135,     88,    246,    248,     38,
+       164,     41,    292,    121,     86,    238,     47,    131,
+       256,     54,     45,    129,    298,    313,     72,     31,
+         4,     73,    191,    283,     28,     14,    230,     98,
+        58,    240,     80,     42,     37,     32,    156,    317,
+        94,    245,    213,    143,     25,    254,    312,    177,
+       108,    304,     61,    231,    187,    300,    117,     66,
+       263,     15,    278,     89,     30,     22,    202,    218,
+       127,     43,    237,    316,    112,    290,    150,     97,
+        83,    271,     69,     90,    281,    154,      9,    277,
+       145,    119,    181,    123,    116,     44,    209,    165,
+       269,     99,    124,    264,    276,    272,    282,     52,
+        12,    258,      8,    115,     27,     20,     51,     26,
+       188,    170,    120,     81,    220,    140,    192,    196,
+       244,     56,    275,    148,    103,    295,     11,     96,
+};
+
+const int32_t g_string_address_displacements[kStringCount] = {
+        -4,      1,      0,      0,      0,     -7,      0,      1,
+         2,      0,    -11,    -16,    -17,    -18,    -20,      1,
+       -22,    -23,      0,    -25,      0,    -26,    -30,    -31,
+         1,    -34,      0,      1,      0,    -35,    -39,      0,
+       -40,    -42,      0,      0,    -44,      0,    -47,    -48,
+         1,      1,      0,    -52,    -55,      3,      1,      0,
+         1,      0,      0,    -59,    -60,      0,    -61,      0,
+         0,      0,      0,    -68,    -70,    -73,      0,      0,
+         7,    -75,      0,    -76,      0,      0,      1,      2,
+       -83,    -84,      0,      0,    -94,    -96,      0,   -100,
+         1,   -101,      0,      0,      0,      0,      2,   -103,
+      -104,   -105,   -118,   -122,      0,      0,      1,      2,
+      -123,   -125,      0,      0,   -127,      0,      2,      0,
+      -129,      1,      1,      0,      2,   -133,   -138,      1,
+      -139,   -140,   -142,      0,      2,      0,      1,      2,
+         0,      0,      0,      1,      0,      0,      0,      0,
+         0,      0,      1,      0,   -145,      2,      1,   -146,
+         0,      0,     10,      8,      5,      1,   -147,      0,
+      -151,      0,      0,      0,      0,   -159,   -164,      1,
+         0,   -165,      1,   -166,   -168,      0,      0,   -170,
+      -175,   -177,   -179,   -180,      0,      5,   -183,      1,
+        12,      0,   -190,   -194,      0,      2,      0,      7,
+      -199,      1,      0,      0,   -200,      0,      1,   -201,
+         0,   -204,   -205,   -206,   -208,      0,      0,      7,
+         2,      1,      0,      3,      0,      2,   -211,   -213,
+         0,   -217,      9,      3,      0,      0,      0,      1,
+         0,      0,      0,      1,   -218,   -219,      1,      0,
+      -220,   -222,      0,      1,   -223,   -224,   -232,      0,
+         0,      3,      4,   -234,      1,      3,      0,   -236,
+      -238,   -244,      2,      0,   -245,      0,      3,   -246,
+      -247,      6,   -251,      0,   -253,      0,      8,      0,
+         1,   -254,      0,   -255,      0,      0,   -256,   -257,
+         1,      1,   -259,      0,      5,      0,      0,      0,
+         0,      4,   -261,   -264,      3,      0,   -271,   -272,
+      -274,      0,      6,      4,      0,      1,      0,   -275,
+      -277,   -278,      0,      0,   -287,      7,      0,   -289,
+      -292,      0,      5,      1,      0,      1,      0,   -293,
+      -294,   -295,   -297,      2,   -298,   -300,      0,      0,
+         0,      1,   -304,      2,      0,   -310,      3,      6,
+         0,   -312,     16,   -316,   -317,   -318,   -319,      2,
+};
+
+const uint32_t g_string_address_slots[kStringCount] = {
+       170,     25,      2,     31,    156,    242,     28,     19,
+       230,    298,    100,    163,    315,    278,    116,    237,
+       227,    286,    178,     77,    141,    311,     75,    194,
+        13,    261,    295,    122,    140,    213,     27,     32,
+        42,     40,    205,    158,    103,     60,     63,    238,
+       115,     36,     69,    128,     33,    106,    167,     48,
+       300,    159,    222,    250,    135,    172,     62,     43,
+        74,    109,    277,     50,     17,     65,     92,    180,
+       287,    306,     91,    192,     51,    137,    174,    197,
+        99,    102,    303,    265,    108,    175,    212,    225,
+        45,     53,    258,    166,     89,    125,      0,      1,
+        54,     67,     15,    269,    219,     39,    124,     14,
+       260,     59,    255,    257,    254,    317,      3,    235,
+       243,    164,    281,    284,    208,    267,    107,    302,
+       117,    114,     10,    308,    217,    246,    279,    301,
+       266,    152,    218,    214,     72,    293,    310,     57,
+         9,    248,    189,    176,     22,    196,     73,     29,
+       105,    209,    187,    142,    259,    253,    169,    289,
+        37,    241,     78,     87,     80,    233,     38,    299,
+        85,    290,    207,    291,     83,    148,     66,    185,
+       150,     58,    305,    294,    113,     84,    210,    270,
+       274,     94,     97,    229,    151,      4,    182,    123,
+       232,    121,    112,    273,    198,     47,    215,    202,
+       134,    111,     23,    132,     81,    120,     16,    228,
+        98,    239,      7,     56,     11,    195,    139,    262,
+       138,     68,    226,    296,     95,    216,    285,    157,
+       244,    200,    276,    236,    179,    271,     96,    307,
+       119,     79,    118,    171,     90,    275,    264,     46,
+       280,     93,     71,    304,    220,    282,    252,    247,
+        76,    153,    319,    251,    129,    144,    162,    203,
+       221,    101,    110,     86,     82,    312,     26,    206,
+       318,    181,    309,    188,     30,    292,    249,     18,
+       130,     88,     12,    126,    165,    256,    272,    240,
+        49,     64,    234,    183,     20,    204,    193,    173,
+        70,    263,     44,    149,    223,     24,    201,    177,
+       161,      6,    145,      5,    313,    133,    184,    155,
+       143,    314,    154,    186,     61,    297,    199,    127,
+        21,    104,    268,    160,    224,     52,    288,      8,
+       231,    211,     34,     55,    168,    191,    146,    245,
+        41,    147,    283,    131,    316,    136,    190,     35,
+};
@@ -1,21 +1,38 @@
 // Copyright (c) 2025
 //
-// Declarations for the wide string table extracted from the Digimon
-// World PC executable.  The definitions live in strings.cpp.  The
-// strings are stored as UTF‑16 (wchar_t) constants because the PC
-// port contains a mixture of Korean and high‑ASCII characters.
+// The strings digi.exe's code refers to, decoded to UTF-16.  Generated
+// by tools/digi_strings from the data sections and the xref index of
+// an analysis database; do not edit, regenerate with
+//
+//     digi_strings generate <digi.exe> <db.adb> digi_analysis
+//
+// The game's ANSI strings are CP949 and a few are UTF-16; both come
+// out as UTF-16 here.  Use the functions in string_table.h rather
+// than these tables.
 
 #pragma once
 
 #include <cstddef>
 #include <cstdint>
 
-// Pointer to an array of wide C‑strings containing text extracted
-// directly from digi.exe.  The actual definitions live in
-// strings.cpp.
-extern const wchar_t* g_strings[];
+// Strings, distinct texts, and UTF-16 units in the blob.
+const std::size_t kStringCount      = 320;
+const std::size_t kStringTextCount  = 320;
+const std::size_t kStringBlobUnits  = 4185;
+
+// Each distinct text once, as its length, the text and a zero.
+extern const wchar_t g_string_blob[kStringBlobUnits];
+
+// Per string, in address order: where its text starts in the blob
+// and its address in digi.exe.
+extern const uint32_t g_string_offsets[kStringCount];
+extern const uint32_t g_string_addresses[kStringCount];
+
+// Minimal perfect hash of the distinct texts: displacement per
+// bucket, then the first string with that text per slot.
+extern const int32_t  g_string_text_displacements[kStringTextCount];
+extern const uint32_t g_string_text_slots[kStringTextCount];
 
-// The number of entries in g_strings.  You can compute this at build
-// time by taking sizeof(g_strings)/sizeof(g_strings[0]) in
-// strings.cpp.
-extern const std::size_t g_strings_count;
\ No newline at end of file
+// Minimal perfect hash of the addresses, laid out the same way.
+extern const int32_t  g_string_address_displacements[kStringCount];
+extern const uint32_t g_string_address_slots[kStringCount];
@@ -0,0 +1,232 @@
+// Copyright (c) 2025
+//
+// Implementation of the per-font text metrics cache.  See
+// text_metrics.h.
+
+#include "text_metrics.h"
+#include <algorithm>
+#include <cstdint>
+#include <emmintrin.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    struct FontMetrics {
+        TEXTMETRICA tm;
+        bool        lead[256];     // DBCS lead bytes of the font's code page
+        int         advance[256];  // single-byte advances
+        int         dbcsAdvance;   // advance of every double-byte character
+        // Kerning pairs sorted by (first << 16 | second).
+        std::vector<uint32_t> kernKeys;
+        std::vector<int>      kernAmounts;
+    };
+
+    FontMetricsSource g_source = {};
+
+    // Metrics are looked up from the game thread and, through the
+    // TextRenderer, from its helper threads, so the tables are guarded.
+    // Entries are only removed by ForgetFontMetrics.
+    std::mutex                                               g_metricsMutex;
+    std::unordered_map<HFONT, std::unique_ptr<FontMetrics>> g_metrics;
+    std::unordered_map<HFONT, LOGFONTA>                     g_logFonts;
+
+    UINT CodePageForCharset(BYTE charset) {
+        CHARSETINFO csi;
+        if (TranslateCharsetInfo(reinterpret_cast<DWORD*>(static_cast<uintptr_t>(charset)), &csi, TCI_SRCCHARSET)) {
+            return csi.ciACP;
+        }
+        return GetACP();
+    }
+
+    // Read everything we need from GDI.  `font` is already selected
+    // into `hdc`.
+    std::unique_ptr<FontMetrics> BuildMetrics(HDC hdc) {
+        if (!g_source.getTextMetrics || !g_source.getTextExtent) {
+            return nullptr;
+        }
+        std::unique_ptr<FontMetrics> m(new FontMetrics());
+        if (!g_source.getTextMetrics(hdc, &m->tm) ||
+            !GetCharWidth32A(hdc, 0, 255, m->advance)) {
+            return nullptr;
+        }
+        UINT codePage = CodePageForCharset(m->tm.tmCharSet);
+        bool hasLeadBytes = false;
+        for (int c = 0; c < 256; ++c) {
+            m->lead[c] = IsDBCSLeadByteEx(codePage, static_cast<BYTE>(c)) != FALSE;
+            hasLeadBytes |= m->lead[c];
+        }
+        m->dbcsAdvance = m->tm.tmMaxCharWidth;
+        if (hasLeadBytes) {
+            // Double-byte faces (Gulim, Dotum, Batang, ...) draw every
+            // Hangul and Hanja character in the same full-width cell, so
+            // one measurement covers them all.  U+AC00 in CP949 is used
+            // as the sample; other code pages fall back to the maximum
+            // character width.
+            SIZE size;
+            if (codePage == 949 && g_source.getTextExtent(hdc, "\xB0\xA1", 2, &size)) {
+                m->dbcsAdvance = size.cx - m->tm.tmOverhang;
+            }
+        }
+        DWORD pairs = GetKerningPairsA(hdc, 0, nullptr);
+        if (pairs != 0) {
+            std::vector<KERNINGPAIR> kp(pairs);
+            pairs = GetKerningPairsA(hdc, pairs, kp.data());
+            kp.resize(pairs);
+            std::sort(kp.begin(), kp.end(), [](const KERNINGPAIR& a, const KERNINGPAIR& b) {
+                return ((uint32_t)a.wFirst << 16 | a.wSecond) < ((uint32_t)b.wFirst << 16 | b.wSecond);
+            });
+            for (const KERNINGPAIR& p : kp) {
+                m->kernKeys.push_back((uint32_t)p.wFirst << 16 | p.wSecond);
+                m->kernAmounts.push_back(p.iKernAmount);
+            }
+        }
+        return m;
+    }
+
+    // Caller holds g_metricsMutex.
+    const FontMetrics* FindOrBuild(HDC hdc, HFONT font) {
+        auto it = g_metrics.find(font);
+        if (it != g_metrics.end()) {
+            return it->second.get();
+        }
+        std::unique_ptr<FontMetrics> m = BuildMetrics(hdc);
+        if (!m) {
+            return nullptr;
+        }
+        return (g_metrics[font] = std::move(m)).get();
+    }
+
+    inline int ScalarStep(const FontMetrics& m, const unsigned char* s, int n, int* i) {
+        unsigned char c = s[*i];
+        if (m.lead[c] && *i + 1 < n) {
+            *i += 2;
+            return m.dbcsAdvance;
+        }
+        *i += 1;
+        return m.advance[c];
+    }
+
+    // Sum of advances.  Sixteen bytes are classified at a time; runs
+    // without a high bit (the bulk of the game's UI strings) cannot
+    // contain lead bytes and are summed four lanes at a time, the rest
+    // is walked character by character.
+    int SumAdvances(const FontMetrics& m, const unsigned char* s, int n) {
+        __m128i acc = _mm_setzero_si128();
+        int scalar = 0;
+        int i = 0;
+        while (i + 16 <= n) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            if (_mm_movemask_epi8(v) == 0) {
+                const int* a = m.advance;
+                const unsigned char* p = s + i;
+                acc = _mm_add_epi32(acc, _mm_setr_epi32(a[p[0]],  a[p[1]],  a[p[2]],  a[p[3]]));
+                acc = _mm_add_epi32(acc, _mm_setr_epi32(a[p[4]],  a[p[5]],  a[p[6]],  a[p[7]]));
+                acc = _mm_add_epi32(acc, _mm_setr_epi32(a[p[8]],  a[p[9]],  a[p[10]], a[p[11]]));
+                acc = _mm_add_epi32(acc, _mm_setr_epi32(a[p[12]], a[p[13]], a[p[14]], a[p[15]]));
+                i += 16;
+                continue;
+            }
+            // A trailing byte may carry us one past the block; the next
+            // block simply starts there.
+            int end = i + 16;
+            while (i < end) {
+                scalar += ScalarStep(m, s, n, &i);
+            }
+        }
+        while (i < n) {
+            scalar += ScalarStep(m, s, n, &i);
+        }
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(acc) + scalar;
+    }
+
+    int SumKerning(const FontMetrics& m, const unsigned char* s, int n) {
+        if (m.kernKeys.empty()) {
+            return 0;
+        }
+        int total = 0;
+        uint32_t prev = 0xFFFFFFFFu;
+        for (int i = 0; i < n;) {
+            uint32_t code = s[i];
+            if (m.lead[code] && i + 1 < n) {
+                code = (code << 8) | s[i + 1];
+                i += 2;
+            } else {
+                i += 1;
+            }
+            if (prev != 0xFFFFFFFFu) {
+                uint32_t key = (prev << 16) | code;
+                auto it = std::lower_bound(m.kernKeys.begin(), m.kernKeys.end(), key);
+                if (it != m.kernKeys.end() && *it == key) {
+                    total += m.kernAmounts[it - m.kernKeys.begin()];
+                }
+            }
+            prev = code;
+        }
+        return total;
+    }
+}
+
+void SetFontMetricsSource(const FontMetricsSource& source) {
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    g_source = source;
+}
+
+void RegisterFontLogFont(HFONT font, const LOGFONTA& lf) {
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    g_logFonts[font] = lf;
+}
+
+bool GetCachedLogFont(HFONT font, LOGFONTA* lf) {
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    auto it = g_logFonts.find(font);
+    if (it == g_logFonts.end()) {
+        return false;
+    }
+    *lf = it->second;
+    return true;
+}
+
+bool GetCachedTextMetrics(HDC hdc, HFONT font, TEXTMETRICA* tm) {
+    if (!font || !tm) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    const FontMetrics* m = FindOrBuild(hdc, font);
+    if (!m) {
+        return false;
+    }
+    *tm = m->tm;
+    return true;
+}
+
+bool GetCachedTextExtent(HDC hdc, HFONT font, const char* text, int count, SIZE* size, bool applyKerning) {
+    // Empty strings are left to GDI; they are rare and GDI's answer
+    // for them is the one thing we would have to guess.
+    if (!font || !size || count <= 0 || !text) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    const FontMetrics* m = FindOrBuild(hdc, font);
+    if (!m) {
+        return false;
+    }
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+    int width = SumAdvances(*m, s, count);
+    if (applyKerning) {
+        width += SumKerning(*m, s, count);
+    }
+    // GDI adds the simulated bold/italic overhang once per string.
+    size->cx = width + m->tm.tmOverhang;
+    size->cy = m->tm.tmHeight;
+    return true;
+}
+
+void ForgetFontMetrics(HFONT font) {
+    std::lock_guard<std::mutex> lock(g_metricsMutex);
+    g_metrics.erase(font);
+    g_logFonts.erase(font);
+}
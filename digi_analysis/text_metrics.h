@@ -0,0 +1,45 @@
+// Copyright (c) 2025
+//
+// Per-font text metrics cache.  The game measures strings constantly
+// through GetTextExtentPoint32A and GetTextMetricsA, and queries font
+// descriptions through GetObjectA.  The first time a font is seen its
+// TEXTMETRIC, per-character advances, double-byte advance and kerning
+// pairs are read from GDI once; every later query is answered from the
+// table without leaving the process.
+//
+// Metrics are keyed by HFONT alone.  The game only draws into memory
+// DCs in MM_TEXT mode with no extra character spacing, so a font's
+// metrics do not depend on the DC it is selected into.
+
+#pragma once
+
+#include <windows.h>
+
+// Unhooked GDI entry points used to build a table.  gdi_hooks.cpp
+// passes its trampolines so building a table never re-enters the
+// detours that consult it.
+struct FontMetricsSource {
+    BOOL (WINAPI* getTextMetrics)(HDC, LPTEXTMETRICA);
+    BOOL (WINAPI* getTextExtent)(HDC, LPCSTR, int, LPSIZE);
+};
+
+void SetFontMetricsSource(const FontMetricsSource& source);
+
+// Remember the LOGFONTA a font was created from so GetObjectA can be
+// answered without GDI.
+void RegisterFontLogFont(HFONT font, const LOGFONTA& lf);
+bool GetCachedLogFont(HFONT font, LOGFONTA* lf);
+
+// `font` must be the font currently selected into `hdc`; it is only
+// used to build the table on first sight.  Return false if the table
+// could not be built, in which case the caller should ask GDI.
+bool GetCachedTextMetrics(HDC hdc, HFONT font, TEXTMETRICA* tm);
+
+// Width and height of a multi-byte string as GetTextExtentPoint32A
+// reports it.  Kerning is not part of GDI's extents, so it is only
+// added when `applyKerning` is set.
+bool GetCachedTextExtent(HDC hdc, HFONT font, const char* text, int count, SIZE* size, bool applyKerning);
+
+// Drop everything cached for a font.  Called when it is deleted so a
+// recycled handle never picks up stale metrics.
+void ForgetFontMetrics(HFONT font);
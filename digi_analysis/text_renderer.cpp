@@ -1,16 +1,118 @@
 #include "text_renderer.h"
+#include "cp949.h"
+#include "glyph_cache.h"
+#include "sdf_text.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <emmintrin.h>
+#include <mutex>
 #include <vector>
 
-std::unordered_map<TextRenderer::GlyphKey, GlyphInfo, TextRenderer::GlyphKeyHash> TextRenderer::s_glyphCache;
+// Glyph textures are capped at 16 MiB by default; coverage bitmaps
+// kept for re-colouring get a quarter of that.
+static const size_t kDefaultGlyphBudget = 16 * 1024 * 1024;
 
-static void BuildDraw(int x, int y, const GlyphInfo& info) {
+GlyphTable TextRenderer::s_glyphCache(kDefaultGlyphBudget);
+std::unordered_map<TextRenderer::RunKey, TextRenderer::TextRun, TextRenderer::RunKeyHash> TextRenderer::s_runCache;
+std::unordered_map<TextRenderer::CoverageKey, RasterizedGlyph, TextRenderer::CoverageKeyHash> TextRenderer::s_coverage;
+size_t TextRenderer::s_coverageBytes = 0;
+static size_t s_coverageBudget = kDefaultGlyphBudget / 4;
+std::unordered_set<TextRenderer::CoverageKey, TextRenderer::CoverageKeyHash> TextRenderer::s_pending;
+std::unordered_map<TextRenderer::CoverageKey, GlyphInfo, TextRenderer::CoverageKeyHash> TextRenderer::s_placeholders;
+bool TextRenderer::s_sdfMode = false;
+std::unordered_map<HFONT, TextRenderer::SdfFont> TextRenderer::s_sdfFonts;
+std::unordered_map<std::wstring, HFONT> TextRenderer::s_sdfReferences;
+
+// Distance field textures are white with the field in alpha; the text
+// colour is applied by the shader at draw time.
+static const COLORREF kSdfTextureColor = RGB(255, 255, 255);
+
+// Glyph miss handling.  The budget bounds how long the game thread may
+// wait for the worker pool within a single frame in Block mode.
+static GlyphMissPolicy s_missPolicy       = GlyphMissPolicy::Placeholder;
+static unsigned        s_budgetMicros     = 2000;
+static unsigned        s_frameSpentMicros = 0;
+
+// Upper bound on the number of cached runs.  The game only shows a few
+// dozen distinct strings per screen, so when the cache fills up it is
+// simply flushed rather than tracking per-run usage.
+static const size_t kMaxCachedRuns = 1024;
+
+// Per-thread GDI context.  The DC is created lazily and destroyed when
+// the owning thread exits.
+struct TextThreadContext {
+    HDC   dc   = nullptr;
+    HFONT font = nullptr;
+    ~TextThreadContext() {
+        if (dc) {
+            DeleteDC(dc);
+        }
+    }
+};
+
+static thread_local TextThreadContext t_textContext;
+
+static TextThreadContext& AcquireThreadContext() {
+    if (!t_textContext.dc) {
+        t_textContext.dc   = CreateCompatibleDC(nullptr);
+        t_textContext.font = (HFONT)GetStockObject(SYSTEM_FONT);
+    }
+    return t_textContext;
+}
+
+HDC TextRenderer::GetThreadDC() {
+    return AcquireThreadContext().dc;
+}
+
+HFONT TextRenderer::GetDefaultFont() {
+    return AcquireThreadContext().font;
+}
+
+// 64-bit FNV-1a over the raw string bytes.
+static uint64_t HashBytes(const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// `scale` is 1 except for distance field glyphs, whose reference-size
+// metrics are scaled to the requested font size.
+static RunQuad MakeQuad(float penX, const GlyphInfo& info, float scale, bool sdf) {
+    RunQuad q;
+    q.texture = info.texture;
+    q.x0 = penX + info.bearingX * scale;
+    // Distance fields carry kSdfSpread pixels of padding above the
+    // glyph's black box.
+    q.y0 = sdf ? -kSdfSpread * scale : 0.f;
+    q.x1 = q.x0 + info.width * scale;
+    q.y1 = q.y0 + info.height * scale;
+    // One screen pixel spans 127 / (kSdfSpread * scale) field levels;
+    // smooth over about one pixel.
+    q.smoothing = sdf ? std::min(0.5f, 0.5f * 127.f / (255.f * kSdfSpread * scale)) : 0.f;
+    return q;
+}
+
+static void BuildDraw(float x, float y, const RunQuad& quad, COLORREF color) {
     PendingDraw draw;
     draw.mode = GL_TRIANGLE_STRIP;
-    draw.texture = info.texture;
-    float x0 = static_cast<float>(x + info.bearingX);
-    float y0 = static_cast<float>(y);
-    float x1 = x0 + static_cast<float>(info.width);
-    float y1 = y0 + static_cast<float>(info.height);
+    draw.texture = quad.texture;
+    if (quad.smoothing > 0.f) {
+        draw.sdf = true;
+        draw.sdfSmoothing = quad.smoothing;
+        draw.color[0] = GetRValue(color) / 255.f;
+        draw.color[1] = GetGValue(color) / 255.f;
+        draw.color[2] = GetBValue(color) / 255.f;
+        draw.color[3] = 1.f;
+    }
+    float x0 = x + quad.x0;
+    float y0 = y + quad.y0;
+    float x1 = x + quad.x1;
+    float y1 = y + quad.y1;
     draw.vertices = {
         x0, y0, 0.f, 0.f, 0.f,
         x1, y0, 0.f, 1.f, 0.f,
@@ -20,118 +122,427 @@ static void BuildDraw(int x, int y, const GlyphInfo& info) {
     SubmitDrawCall(std::move(draw));
 }
 
-GlyphInfo* TextRenderer::GetGlyphA(HDC hdc, HFONT font, UINT ch, COLORREF color) {
-    GlyphKey key{font, ch, color};
-    auto it = s_glyphCache.find(key);
-    if (it != s_glyphCache.end()) {
-        return &it->second;
-    }
-    if (font) {
-        SelectObject(hdc, font);
-    }
-    MAT2 mat = {{0,1},{0,0},{0,0},{0,1}};
-    GLYPHMETRICS gm;
-    DWORD size = GetGlyphOutlineA(hdc, ch, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &mat);
-    if (size == GDI_ERROR || size == 0) {
+const TextRenderer::TextRun* TextRenderer::FindRun(const RunKey& key, const void* bytes, size_t size) {
+    auto it = s_runCache.find(key);
+    if (it == s_runCache.end()) {
         return nullptr;
     }
-    std::vector<BYTE> buffer(size);
-    if (GetGlyphOutlineA(hdc, ch, GGO_GRAY8_BITMAP, &gm, size, buffer.data(), &mat) == GDI_ERROR) {
+    const TextRun& run = it->second;
+    if (run.bytes.size() != size || std::memcmp(run.bytes.data(), bytes, size) != 0) {
         return nullptr;
     }
-    UINT width = gm.gmBlackBoxX;
-    UINT height = gm.gmBlackBoxY;
-    int pitch = ((width + 3) & ~3);
-    std::vector<unsigned char> pixels(width * height * 4);
-    BYTE r = GetRValue(color);
-    BYTE g = GetGValue(color);
-    BYTE b = GetBValue(color);
+    return &run;
+}
+
+const TextRenderer::TextRun& TextRenderer::StoreRun(const RunKey& key, const void* bytes, size_t size,
+                                                    std::vector<RunQuad>&& quads) {
+    if (s_runCache.size() >= kMaxCachedRuns) {
+        s_runCache.clear();
+    }
+    TextRun& run = s_runCache[key];
+    run.bytes.assign(static_cast<const char*>(bytes), size);
+    run.quads = std::move(quads);
+    return run;
+}
+
+void TextRenderer::SubmitRun(const TextRun& run, int x, int y, COLORREF color) {
+    float fx = static_cast<float>(x);
+    float fy = static_cast<float>(y);
+    for (const RunQuad& q : run.quads) {
+        if (q.texture) {
+            BuildDraw(fx, fy, q, color);
+        }
+    }
+}
+
+// Expand an 8-bit coverage bitmap into solid-colour RGBA.  Sixteen
+// pixels are produced per iteration by widening the coverage bytes
+// into the alpha lane and OR-ing in the constant colour.
+static void ExpandCoverage(const BYTE* coverage, int pitch, UINT width, UINT height, COLORREF color, unsigned char* rgba) {
+    const uint32_t rgb = static_cast<uint32_t>(GetRValue(color)) |
+                         (static_cast<uint32_t>(GetGValue(color)) << 8) |
+                         (static_cast<uint32_t>(GetBValue(color)) << 16);
+    const __m128i rgbv = _mm_set1_epi32(static_cast<int>(rgb));
+    const __m128i zero = _mm_setzero_si128();
     for (UINT y = 0; y < height; ++y) {
-        for (UINT x = 0; x < width; ++x) {
-            BYTE a = buffer[y * pitch + x];
-            size_t idx = (y * width + x) * 4;
-            pixels[idx + 0] = r;
-            pixels[idx + 1] = g;
-            pixels[idx + 2] = b;
-            pixels[idx + 3] = a;
+        const BYTE* src = coverage + static_cast<size_t>(y) * pitch;
+        uint32_t* dst = reinterpret_cast<uint32_t*>(rgba) + static_cast<size_t>(y) * width;
+        UINT x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m128i a  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            __m128i lo = _mm_unpacklo_epi8(zero, a);
+            __m128i hi = _mm_unpackhi_epi8(zero, a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x +  0), _mm_or_si128(rgbv, _mm_unpacklo_epi16(zero, lo)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x +  4), _mm_or_si128(rgbv, _mm_unpackhi_epi16(zero, lo)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x +  8), _mm_or_si128(rgbv, _mm_unpacklo_epi16(zero, hi)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 12), _mm_or_si128(rgbv, _mm_unpackhi_epi16(zero, hi)));
+        }
+        for (; x < width; ++x) {
+            dst[x] = rgb | (static_cast<uint32_t>(src[x]) << 24);
         }
     }
-    GlyphInfo info{};
-    info.width = width;
-    info.height = height;
-    info.advance = gm.gmCellIncX;
-    info.bearingX = gm.gmptGlyphOrigin.x;
-    info.bearingY = gm.gmptGlyphOrigin.y;
-    info.texture = new IDirect3DTexture8(width, height);
-    info.texture->UpdateData(pixels.data(), pixels.size());
-    auto res = s_glyphCache.emplace(key, info);
-    return &res.first->second;
-}
-
-GlyphInfo* TextRenderer::GetGlyphW(HDC hdc, HFONT font, UINT ch, COLORREF color) {
-    GlyphKey key{font, ch, color};
-    auto it = s_glyphCache.find(key);
-    if (it != s_glyphCache.end()) {
+}
+
+static IDirect3DTexture8* CreateGlyphTexture(const BYTE* coverage, int pitch, UINT width, UINT height, COLORREF color, bool sdf) {
+    std::vector<unsigned char> pixels(width * height * 4);
+    ExpandCoverage(coverage, pitch, width, height, color, pixels.data());
+    IDirect3DTexture8* texture = new IDirect3DTexture8(width, height);
+    texture->UpdateData(pixels.data(), pixels.size());
+    texture->SetLinearFilter(sdf);
+    return texture;
+}
+
+void TextRenderer::SetGlyphMissPolicy(GlyphMissPolicy policy) {
+    s_missPolicy = policy;
+}
+
+void TextRenderer::SetRasterBudgetMicros(unsigned micros) {
+    s_budgetMicros = micros;
+}
+
+void TextRenderer::BeginFrame() {
+    s_frameSpentMicros = 0;
+}
+
+void TextRenderer::SetGlyphCacheBudget(size_t bytes) {
+    s_glyphCache.SetBudget(bytes);
+    s_coverageBudget = bytes / 4;
+    // Cached runs may point at textures that were just evicted.
+    s_runCache.clear();
+}
+
+GlyphTableStats TextRenderer::GetGlyphCacheStats() {
+    return s_glyphCache.Stats();
+}
+
+void TextRenderer::SetSdfMode(bool enabled) {
+    if (s_sdfMode != enabled) {
+        s_sdfMode = enabled;
+        s_runCache.clear();
+    }
+}
+
+// Erase the entries of an unordered container keyed by `font`.
+template <typename Map, typename KeyFont>
+static void EraseFontEntries(Map& map, HFONT font, KeyFont keyFont) {
+    for (auto it = map.begin(); it != map.end();) {
+        if (keyFont(*it) == font) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Fonts deleted since the drawing thread last looked.  DeleteObject
+// can run on any thread, so ForgetFont only records the font here.
+static std::mutex         s_forgottenMutex;
+static std::vector<HFONT> s_forgotten;
+static std::atomic<bool>  s_haveForgotten{ false };
+
+void TextRenderer::ForgetFont(HFONT font) {
+    if (!font) {
+        return;
+    }
+    // The rasteriser queue has its own lock; cancelling now also keeps
+    // the workers from selecting the font after it is gone.
+    CancelGlyphRasters(font);
+    std::lock_guard<std::mutex> lock(s_forgottenMutex);
+    s_forgotten.push_back(font);
+    s_haveForgotten.store(true, std::memory_order_release);
+}
+
+// Called by the drawing thread before it looks anything up, so a font
+// created with a recycled handle never finds its predecessor's glyphs.
+void TextRenderer::PurgeForgottenFonts() {
+    if (!s_haveForgotten.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::vector<HFONT> fonts;
+    {
+        std::lock_guard<std::mutex> lock(s_forgottenMutex);
+        fonts.swap(s_forgotten);
+        s_haveForgotten.store(false, std::memory_order_relaxed);
+    }
+    for (HFONT font : fonts) {
+        // Results still in flight are dropped by DrainRasterResults once
+        // their key is no longer pending.
+        EraseFontEntries(s_pending, font, [](const CoverageKey& k) { return k.font; });
+        for (auto it = s_coverage.begin(); it != s_coverage.end();) {
+            if (it->first.font == font) {
+                s_coverageBytes -= it->second.coverage.size();
+                it = s_coverage.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        EraseFontEntries(s_placeholders, font, [](const auto& kv) { return kv.first.font; });
+        s_sdfFonts.erase(font);
+        s_glyphCache.EraseFont(font);
+        EraseFontEntries(s_runCache, font, [](const auto& kv) { return kv.first.font; });
+    }
+}
+
+// Build (or share) the reference-size font for `font`.  Fonts that
+// differ only in height map to the same reference font; the sign of
+// lfHeight is kept so cell and character heights scale consistently.
+TextRenderer::SdfFont TextRenderer::CreateSdfFont(HFONT font) {
+    SdfFont result{ nullptr, 1.f };
+    LOGFONTW lf{};
+    if (!GetObjectW(font, sizeof(lf), &lf) || lf.lfHeight == 0) {
+        // Default-height fonts have no size to scale from.
+        return result;
+    }
+    LONG em = lf.lfHeight < 0 ? -lf.lfHeight : lf.lfHeight;
+    LOGFONTW ref = lf;
+    ref.lfHeight  = lf.lfHeight < 0 ? -kSdfReferenceSize : kSdfReferenceSize;
+    ref.lfWidth   = lf.lfWidth * kSdfReferenceSize / em;
+    ref.lfQuality = ANTIALIASED_QUALITY;
+
+    std::wstring key(ref.lfFaceName);
+    key += L'|' + std::to_wstring(ref.lfHeight) + L'|' + std::to_wstring(ref.lfWidth) +
+           L'|' + std::to_wstring(ref.lfWeight) + L'|' + std::to_wstring(ref.lfItalic) +
+           L'|' + std::to_wstring(ref.lfCharSet);
+    HFONT& reference = s_sdfReferences[key];
+    if (!reference) {
+        // CreateFontIndirectW is not hooked, so the reference font is
+        // not registered with the glyph cache builder.  Reference fonts
+        // live for the rest of the process.
+        reference = CreateFontIndirectW(&ref);
+        if (!reference) {
+            OutputDebugStringA("[TextRenderer] failed to create SDF reference font\n");
+            s_sdfReferences.erase(key);
+            return result;
+        }
+    }
+    result.reference = reference;
+    result.scale = static_cast<float>(em) / kSdfReferenceSize;
+    return result;
+}
+
+// The font text on `hdc` is drawn with: `font`, or for a DC whose
+// state is not tracked (null `font`) whatever the DC has selected.
+HFONT TextRenderer::ResolveFont(HDC hdc, HFONT font) {
+    return font ? font : (HFONT)GetCurrentObject(hdc, OBJ_FONT);
+}
+
+// Font whose glyphs are actually rasterised for `font`: the font
+// itself, or its reference font in SDF mode.
+HFONT TextRenderer::ResolveGlyphFont(HDC hdc, HFONT font, float* scale, bool* sdf) {
+    *scale = 1.f;
+    *sdf = false;
+    font = ResolveFont(hdc, font);
+    if (!s_sdfMode || !font) {
+        return font;
+    }
+    auto it = s_sdfFonts.find(font);
+    if (it == s_sdfFonts.end()) {
+        it = s_sdfFonts.emplace(font, CreateSdfFont(font)).first;
+    }
+    if (!it->second.reference) {
+        return font;
+    }
+    *scale = it->second.scale;
+    *sdf = true;
+    return it->second.reference;
+}
+
+// Coverage bitmaps are cheap to regenerate, so when they exceed their
+// budget the whole map is dropped instead of tracking usage.
+void TextRenderer::StoreCoverage(const CoverageKey& key, RasterizedGlyph&& glyph) {
+    if (s_coverageBytes + glyph.coverage.size() > s_coverageBudget) {
+        s_coverage.clear();
+        s_coverageBytes = 0;
+    }
+    s_coverageBytes += glyph.coverage.size();
+    RasterizedGlyph& slot = s_coverage[key];
+    s_coverageBytes -= slot.coverage.size();
+    slot = std::move(glyph);
+}
+
+void TextRenderer::DrainRasterResults(unsigned timeoutMicros) {
+    std::vector<RasterizedGlyph> results;
+    if (CollectRasterizedGlyphs(&results, timeoutMicros) == 0) {
+        return;
+    }
+    for (RasterizedGlyph& g : results) {
+        CoverageKey key{g.font, g.code, g.wide};
+        // Not pending means the font was deleted while the glyph was
+        // queued; its handle may already belong to another font.
+        if (s_pending.erase(key) != 0) {
+            StoreCoverage(key, std::move(g));
+        }
+    }
+}
+
+// Block until `key` has been rasterised or this frame's budget is
+// used up, whichever comes first.
+void TextRenderer::WaitForCoverage(const CoverageKey& key) {
+    LARGE_INTEGER freq, start, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+    while (s_pending.count(key) && s_frameSpentMicros < s_budgetMicros) {
+        DrainRasterResults(s_budgetMicros - s_frameSpentMicros);
+        QueryPerformanceCounter(&now);
+        unsigned elapsed = static_cast<unsigned>((now.QuadPart - start.QuadPart) * 1000000 / freq.QuadPart);
+        s_frameSpentMicros += elapsed > 0 ? elapsed : 1;
+        start = now;
+    }
+}
+
+// Empty glyph used while the real one is being rasterised.  The
+// advance is estimated from the font height so the rest of the line
+// stays roughly in place.
+GlyphInfo* TextRenderer::GetPlaceholder(HFONT font, bool fullWidth) {
+    CoverageKey key{font, 0, fullWidth};
+    auto it = s_placeholders.find(key);
+    if (it != s_placeholders.end()) {
         return &it->second;
     }
-    if (font) {
-        SelectObject(hdc, font);
+    LOGFONTA lf{};
+    int em = 16;
+    if (font && GetObjectA(font, sizeof(lf), &lf) && lf.lfHeight != 0) {
+        em = lf.lfHeight < 0 ? -lf.lfHeight : lf.lfHeight;
     }
-    MAT2 mat = {{0,1},{0,0},{0,0},{0,1}};
-    GLYPHMETRICS gm;
-    DWORD size = GetGlyphOutlineW(hdc, ch, GGO_GRAY8_BITMAP, &gm, 0, nullptr, &mat);
-    if (size == GDI_ERROR || size == 0) {
-        return nullptr;
+    GlyphInfo info{};
+    info.advance = fullWidth ? em : em / 2;
+    return &s_placeholders.emplace(key, info).first->second;
+}
+
+GlyphInfo* TextRenderer::GetGlyph(HDC hdc, HFONT font, UINT ch, COLORREF color, bool wide, bool sdf, bool* pending) {
+    if (!font) {
+        // Resolve the DC's current font so the workers, which have their
+        // own DCs, rasterise with the same face.
+        font = (HFONT)GetCurrentObject(hdc, OBJ_FONT);
     }
-    std::vector<BYTE> buffer(size);
-    if (GetGlyphOutlineW(hdc, ch, GGO_GRAY8_BITMAP, &gm, size, buffer.data(), &mat) == GDI_ERROR) {
-        return nullptr;
+    GlyphKey key{font, ch, color, wide};
+    if (GlyphInfo* hit = s_glyphCache.Find(key)) {
+        return hit;
     }
-    UINT width = gm.gmBlackBoxX;
-    UINT height = gm.gmBlackBoxY;
-    int pitch = ((width + 3) & ~3);
-    std::vector<unsigned char> pixels(width * height * 4);
-    BYTE r = GetRValue(color);
-    BYTE g = GetGValue(color);
-    BYTE b = GetBValue(color);
-    for (UINT y = 0; y < height; ++y) {
-        for (UINT x = 0; x < width; ++x) {
-            BYTE a = buffer[y * pitch + x];
-            size_t idx = (y * width + x) * 4;
-            pixels[idx + 0] = r;
-            pixels[idx + 1] = g;
-            pixels[idx + 2] = b;
-            pixels[idx + 3] = a;
+    // Glyphs pre-rasterised into the on-disk cache skip GDI entirely.
+    CachedGlyph cached;
+    if (wide && !sdf && LookupCachedGlyph(font, ch, &cached)) {
+        GlyphInfo info{};
+        if (cached.width > 0 && cached.height > 0) {
+            info.width = cached.width;
+            info.height = cached.height;
+            info.advance = cached.advance;
+            info.bearingX = cached.bearingX;
+            info.bearingY = cached.bearingY;
+            info.texture = CreateGlyphTexture(cached.coverage, cached.width, cached.width, cached.height, color, false);
+        }
+        ReleaseCachedGlyph(&cached);
+        if (info.texture) {
+            return s_glyphCache.Insert(key, info);
         }
     }
+
+    CoverageKey ck{font, ch, wide};
+    DrainRasterResults(0);
+    auto cov = s_coverage.find(ck);
+    if (cov == s_coverage.end()) {
+        if (s_pending.insert(ck).second && !RequestGlyphRaster(font, ch, wide, sdf)) {
+            // No worker pool; rasterise on this thread as a last resort.
+            s_pending.erase(ck);
+            RasterizedGlyph g;
+            SelectObject(hdc, font);
+            RasterizeGlyph(hdc, ch, wide, &g);
+            g.font = font;
+            if (sdf) {
+                ConvertGlyphToDistanceField(&g);
+            }
+            StoreCoverage(ck, std::move(g));
+        }
+        if (s_missPolicy == GlyphMissPolicy::Block) {
+            WaitForCoverage(ck);
+        }
+        cov = s_coverage.find(ck);
+        if (cov == s_coverage.end()) {
+            *pending = true;
+            return GetPlaceholder(font, wide && ch >= 0x80);
+        }
+    }
+    const RasterizedGlyph& g = cov->second;
     GlyphInfo info{};
-    info.width = width;
-    info.height = height;
-    info.advance = gm.gmCellIncX;
-    info.bearingX = gm.gmptGlyphOrigin.x;
-    info.bearingY = gm.gmptGlyphOrigin.y;
-    info.texture = new IDirect3DTexture8(width, height);
-    info.texture->UpdateData(pixels.data(), pixels.size());
-    auto res = s_glyphCache.emplace(key, info);
-    return &res.first->second;
+    info.width = g.width;
+    info.height = g.height;
+    info.advance = g.advance;
+    info.bearingX = g.bearingX;
+    info.bearingY = g.bearingY;
+    if (g.ok) {
+        info.texture = CreateGlyphTexture(g.coverage.data(), g.width, g.width, g.height, color, sdf);
+    }
+    return s_glyphCache.Insert(key, info);
 }
 
-void TextRenderer::DrawTextA(HDC hdc, HFONT font, int x, int y, const char* text, int count, COLORREF color) {
-    int penX = x;
+// Lay out `count` UTF-16 characters starting at the pen origin.
+// Returns true if the run must not be cached: it still contains
+// placeholders, so the real glyphs should show up once the workers
+// deliver them, or the glyph cache evicted something while laying it
+// out, so some of its quads may reference retired textures which stay
+// valid for this frame only.
+bool TextRenderer::LayOutRun(HDC hdc, HFONT font, const wchar_t* text, int count, COLORREF color, TextRun* run) {
+    run->quads.reserve(static_cast<size_t>(count));
+    bool pending = false;
+    uint64_t generation = s_glyphCache.Generation();
+    float scale;
+    bool sdf;
+    HFONT glyphFont = ResolveGlyphFont(hdc, font, &scale, &sdf);
+    COLORREF glyphColor = sdf ? kSdfTextureColor : color;
+    float penX = 0.f;
     for (int i = 0; i < count; ++i) {
-        GlyphInfo* g = GetGlyphA(hdc, font, static_cast<unsigned char>(text[i]), color);
+        GlyphInfo* g = GetGlyph(hdc, glyphFont, static_cast<UINT>(text[i]), glyphColor, true, sdf, &pending);
         if (!g) continue;
-        BuildDraw(penX, y, *g);
-        penX += g->advance;
+        run->quads.push_back(MakeQuad(penX, *g, scale, sdf));
+        penX += g->advance * scale;
+    }
+    if (s_glyphCache.Generation() != generation) {
+        s_runCache.clear();
+        pending = true;
+    }
+    return pending;
+}
+
+// ANSI text is CP949.  Runs are cached on the raw bytes so a repeated
+// string is never decoded twice; new strings are decoded to UTF-16 and
+// laid out with the same glyphs as DrawTextW.
+void TextRenderer::DrawTextA(HDC hdc, HFONT font, int x, int y, const char* text, int count, COLORREF color) {
+    if (!text || count <= 0) {
+        return;
+    }
+    PurgeForgottenFonts();
+    // Runs are keyed by the font actually drawn with, so a DC that
+    // selects another font never replays the old one's run.
+    font = ResolveFont(hdc, font);
+    size_t size = static_cast<size_t>(count);
+    RunKey key{font, HashBytes(text, size), color, false};
+    if (const TextRun* run = FindRun(key, text, size)) {
+        SubmitRun(*run, x, y, color);
+        return;
+    }
+    static thread_local std::vector<wchar_t> decoded;
+    if (decoded.size() < size) {
+        decoded.resize(size);
     }
+    int length = DecodeCp949(text, count, decoded.data());
+    TextRun run;
+    bool pending = LayOutRun(hdc, font, decoded.data(), length, color, &run);
+    SubmitRun(pending ? run : StoreRun(key, text, size, std::move(run.quads)), x, y, color);
 }
 
 void TextRenderer::DrawTextW(HDC hdc, HFONT font, int x, int y, const wchar_t* text, int count, COLORREF color) {
-    int penX = x;
-    for (int i = 0; i < count; ++i) {
-        GlyphInfo* g = GetGlyphW(hdc, font, static_cast<UINT>(text[i]), color);
-        if (!g) continue;
-        BuildDraw(penX, y, *g);
-        penX += g->advance;
+    if (!text || count <= 0) {
+        return;
+    }
+    PurgeForgottenFonts();
+    font = ResolveFont(hdc, font);
+    size_t size = static_cast<size_t>(count) * sizeof(wchar_t);
+    RunKey key{font, HashBytes(text, size), color, true};
+    if (const TextRun* run = FindRun(key, text, size)) {
+        SubmitRun(*run, x, y, color);
+        return;
     }
+    TextRun run;
+    bool pending = LayOutRun(hdc, font, text, count, color, &run);
+    SubmitRun(pending ? run : StoreRun(key, text, size, std::move(run.quads)), x, y, color);
 }
@@ -1,37 +1,139 @@
 #pragma once
 #include <windows.h>
+#include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <vector>
+#include <unordered_set>
 #include "d3d8_gl_bridge.h"
+#include "glyph_rasterizer.h"
+#include "glyph_table.h"
 #include "opengl_utils.h"
 
-struct GlyphInfo {
+// One positioned glyph inside a cached text run.  The rectangle is
+// relative to the pen origin passed to DrawTextA/DrawTextW so the same
+// run can be replayed at any screen position.
+struct RunQuad {
     IDirect3DTexture8* texture;
-    int width;
-    int height;
-    int advance;
-    int bearingX;
-    int bearingY;
+    float x0, y0, x1, y1;
+    // Edge half-width for distance field glyphs; zero for ordinary
+    // pre-coloured glyph textures.
+    float smoothing;
+};
+
+// What DrawTextA/DrawTextW do when a glyph has not been rasterised yet.
+enum class GlyphMissPolicy {
+    // Wait for the worker pool, but never longer than the per-frame
+    // budget; glyphs still missing after that use a placeholder.
+    Block,
+    // Never wait.  The glyph's slot is left empty for the frame(s) it
+    // takes the workers to produce it.
+    Placeholder,
 };
 
 class TextRenderer {
 public:
+    // DrawTextA takes CP949 text; it is decoded to UTF-16 and shares the
+    // glyphs drawn by DrawTextW.
     static void DrawTextA(HDC hdc, HFONT font, int x, int y, const char* text, int count, COLORREF color);
     static void DrawTextW(HDC hdc, HFONT font, int x, int y, const wchar_t* text, int count, COLORREF color);
+
+    // Memory DC owned by the calling thread.  Created on first use and
+    // reused for every later call so the render detours do not have to
+    // acquire and release a screen DC per string.
+    static HDC GetThreadDC();
+    // Stock font cached alongside the thread DC.
+    static HFONT GetDefaultFont();
+
+    // Glyph miss handling.  Defaults to Placeholder with a 2 ms budget.
+    static void SetGlyphMissPolicy(GlyphMissPolicy policy);
+    static void SetRasterBudgetMicros(unsigned micros);
+    // Reset the per-frame rasterisation budget.  Called from Present.
+    static void BeginFrame();
+
+    // Byte budget for glyph textures (default 16 MiB) and the glyph
+    // cache's hit/miss/eviction counters.
+    static void SetGlyphCacheBudget(size_t bytes);
+    static GlyphTableStats GetGlyphCacheStats();
+
+    // Signed distance field mode (off by default).  Every font is then
+    // rasterised once at kSdfReferenceSize per face/weight/style and
+    // drawn at its real size by scaling the distance field, so the many
+    // heights the game creates share one set of glyph textures.
+    static void SetSdfMode(bool enabled);
+
+    // Drop every glyph, coverage bitmap, placeholder, cached run and
+    // SDF mapping keyed by `font`.  Called when the game deletes the
+    // font, since GDI hands the same handle value to later fonts.  Safe
+    // from any thread: the renderer's maps are only touched by the
+    // thread drawing text, so the font is queued and purged at the start
+    // of its next DrawTextA/DrawTextW.
+    static void ForgetFont(HFONT font);
 private:
-    struct GlyphKey {
+    // Colour-independent key for rasterised coverage bitmaps.
+    struct CoverageKey {
+        HFONT font;
+        UINT  code;
+        bool  wide;
+        bool operator==(const CoverageKey& other) const {
+            return font == other.font && code == other.code && wide == other.wide;
+        }
+    };
+    struct CoverageKeyHash {
+        size_t operator()(const CoverageKey& k) const {
+            return reinterpret_cast<size_t>(k.font) ^ (static_cast<size_t>(k.code) << 1) ^ static_cast<size_t>(k.wide);
+        }
+    };
+    // Layout cache key.  The string itself is identified by a 64-bit
+    // FNV-1a hash of its bytes; the run keeps a copy of the bytes so a
+    // hash collision never replays the wrong text.
+    struct RunKey {
         HFONT    font;
-        UINT     code;
+        uint64_t hash;
         COLORREF color;
-        bool operator==(const GlyphKey& other) const {
-            return font == other.font && code == other.code && color == other.color;
+        bool     wide;
+        bool operator==(const RunKey& other) const {
+            return font == other.font && hash == other.hash && color == other.color && wide == other.wide;
         }
     };
-    struct GlyphKeyHash {
-        size_t operator()(const GlyphKey& k) const {
-            return reinterpret_cast<size_t>(k.font) ^ (static_cast<size_t>(k.code) << 1) ^ (static_cast<size_t>(k.color) << 2);
+    struct RunKeyHash {
+        size_t operator()(const RunKey& k) const {
+            return static_cast<size_t>(k.hash ^ (k.hash >> 32));
         }
     };
-    static GlyphInfo* GetGlyphA(HDC hdc, HFONT font, UINT ch, COLORREF color);
-    static GlyphInfo* GetGlyphW(HDC hdc, HFONT font, UINT ch, COLORREF color);
-    static std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> s_glyphCache;
+    struct TextRun {
+        std::string          bytes;
+        std::vector<RunQuad> quads;
+    };
+    // `pending` is set when a placeholder was returned because the
+    // glyph is still being rasterised.
+    // Reference-size font used for a game font in SDF mode, and the
+    // factor mapping its metrics back to the game font's size.  A null
+    // `reference` means the font is drawn normally.
+    struct SdfFont {
+        HFONT reference;
+        float scale;
+    };
+    static GlyphInfo* GetGlyph(HDC hdc, HFONT font, UINT ch, COLORREF color, bool wide, bool sdf, bool* pending);
+    static HFONT ResolveFont(HDC hdc, HFONT font);
+    static HFONT ResolveGlyphFont(HDC hdc, HFONT font, float* scale, bool* sdf);
+    static void PurgeForgottenFonts();
+    static SdfFont CreateSdfFont(HFONT font);
+    static GlyphInfo* GetPlaceholder(HFONT font, bool fullWidth);
+    static void DrainRasterResults(unsigned timeoutMicros);
+    static void WaitForCoverage(const CoverageKey& key);
+    static const TextRun* FindRun(const RunKey& key, const void* bytes, size_t size);
+    static const TextRun& StoreRun(const RunKey& key, const void* bytes, size_t size, std::vector<RunQuad>&& quads);
+    static void SubmitRun(const TextRun& run, int x, int y, COLORREF color);
+    static void StoreCoverage(const CoverageKey& key, RasterizedGlyph&& glyph);
+    static bool LayOutRun(HDC hdc, HFONT font, const wchar_t* text, int count, COLORREF color, TextRun* run);
+    static GlyphTable s_glyphCache;
+    static std::unordered_map<RunKey, TextRun, RunKeyHash> s_runCache;
+    static std::unordered_map<CoverageKey, RasterizedGlyph, CoverageKeyHash> s_coverage;
+    static size_t s_coverageBytes;
+    static std::unordered_set<CoverageKey, CoverageKeyHash> s_pending;
+    static std::unordered_map<CoverageKey, GlyphInfo, CoverageKeyHash> s_placeholders;
+    static bool s_sdfMode;
+    static std::unordered_map<HFONT, SdfFont> s_sdfFonts;
+    static std::unordered_map<std::wstring, HFONT> s_sdfReferences;
 };
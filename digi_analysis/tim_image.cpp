@@ -0,0 +1,425 @@
+// Copyright (c) 2025
+//
+// TIM decoder.  See tim_image.h.
+//
+// The CLUT row is converted to A8R8G8B8 once per decode, so the CLUT
+// paths only have to look colours up.  With sixteen colours, every
+// channel of the palette fits one 16-byte register and SSSE3's pshufb
+// looks up sixteen pixels per channel at once; the four channel
+// registers are then interleaved back into pixels.  256 colours do not
+// fit a shuffle, so the 8-bit path gathers eight converted colours per
+// AVX2 instruction and falls back to scalar lookups without it.  15-bit
+// rows are converted eight pixels at a time with SSE2 shifts and masks,
+// 24-bit rows four at a time with one shuffle.  As in sin_table.cpp the
+// paths carry the per-function target attributes from cpu_features.h
+// and are picked at run time.
+
+#include "tim_image.h"
+#include "cpu_features.h"
+
+namespace {
+    enum DecodePath { kScalar, kSse2, kSsse3, kAvx2 };
+
+    const uint32_t kTimTag        = 0x10;
+    const uint32_t kTimModeMask   = 0x7;
+    const uint32_t kTimHasClut    = 0x8;
+    const size_t   kTimHeaderSize = 8;
+    const size_t   kBlockHeader   = 12;     // length, x, y, width, height
+
+    uint16_t Read16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t Read32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    struct Block {
+        uint16_t       x;
+        uint16_t       y;
+        uint16_t       width;               // in 16-bit units
+        uint16_t       height;
+        const uint8_t* data;
+    };
+
+    // The block at data[*at], whose length must match its rectangle
+    // exactly; advances *at past it.
+    bool ReadBlock(const uint8_t* data, size_t size, size_t* at, Block* block) {
+        if (size - *at < kBlockHeader) {
+            return false;
+        }
+        const uint8_t* p = data + *at;
+        block->x      = Read16(p + 4);
+        block->y      = Read16(p + 6);
+        block->width  = Read16(p + 8);
+        block->height = Read16(p + 10);
+        block->data   = p + kBlockHeader;
+        uint64_t length = Read32(p);
+        if (block->width == 0 || block->height == 0 ||
+            length != kBlockHeader + 2ull * block->width * block->height || length > size - *at) {
+            return false;
+        }
+        *at += static_cast<size_t>(length);
+        return true;
+    }
+
+    uint32_t* Row(uint32_t* out, size_t pitch, uint32_t y) {
+        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(out) + y * pitch);
+    }
+
+    uint32_t Rgb24(const uint8_t* p) {
+        return 0xFF000000u | (p[0] << 16) | (p[1] << 8) | p[2];
+    }
+
+    // CLUT row `palette` as A8R8G8B8, `count` entries; the entries the
+    // row does not have are transparent.
+    void ConvertClut(const TimImage& image, uint32_t palette, uint32_t* colours, uint32_t count) {
+        const uint8_t* row = image.clut + 2ull * palette * image.clutColours;
+        uint32_t n = image.clutColours < count ? image.clutColours : count;
+        for (uint32_t i = 0; i < n; ++i) {
+            colours[i] = TimColour(Read16(row + 2 * i));
+        }
+        for (uint32_t i = n; i < count; ++i) {
+            colours[i] = 0;
+        }
+    }
+
+    // Row converters: `x` is where the SIMD loop stopped, so the scalar
+    // ones double as the tails of the others.
+    void Row4Scalar(const uint8_t* src, const uint32_t* colours, uint32_t* dst, uint32_t x, uint32_t width) {
+        for (; x < width; ++x) {
+            dst[x] = colours[(src[x >> 1] >> ((x & 1) * 4)) & 0xF];
+        }
+    }
+
+    void Row8Scalar(const uint8_t* src, const uint32_t* colours, uint32_t* dst, uint32_t x, uint32_t width) {
+        for (; x < width; ++x) {
+            dst[x] = colours[src[x]];
+        }
+    }
+
+    void Row15Scalar(const uint8_t* src, uint32_t* dst, uint32_t x, uint32_t width) {
+        for (; x < width; ++x) {
+            dst[x] = TimColour(Read16(src + 2 * x));
+        }
+    }
+
+    void Row24Scalar(const uint8_t* src, uint32_t* dst, uint32_t x, uint32_t width) {
+        for (; x < width; ++x) {
+            dst[x] = Rgb24(src + 3 * x);
+        }
+    }
+
+#if DIGI_X86
+    // Eight 15-bit colours at a time to A8R8G8B8, the same as TimColour:
+    // each 5-bit channel widens as (c << 3) | (c >> 2), STP picks alpha
+    // 0x80 over 0xFF, and 0x0000 clears the whole pixel.
+    DIGI_TARGET_SSE2
+    void Decode15Sse2(const TimImage& image, uint32_t* out, size_t pitch) {
+        const __m128i five  = _mm_set1_epi16(0x1F);
+        const __m128i ff    = _mm_set1_epi16(0xFF);
+        const __m128i half  = _mm_set1_epi16(0x7F);
+        const __m128i zero  = _mm_setzero_si128();
+        for (uint32_t y = 0; y < image.height; ++y) {
+            const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+            uint32_t* dst = Row(out, pitch, y);
+            uint32_t x = 0;
+            for (; x + 8 <= image.width; x += 8) {
+                __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * x));
+                __m128i r = _mm_and_si128(c, five);
+                __m128i g = _mm_and_si128(_mm_srli_epi16(c, 5), five);
+                __m128i b = _mm_and_si128(_mm_srli_epi16(c, 10), five);
+                r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+                g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+                b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+                __m128i a  = _mm_sub_epi16(ff, _mm_and_si128(_mm_srai_epi16(c, 15), half));
+                __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+                __m128i ra = _mm_or_si128(r, _mm_slli_epi16(a, 8));
+                __m128i clear = _mm_cmpeq_epi16(c, zero);
+                __m128i lo = _mm_andnot_si128(_mm_unpacklo_epi16(clear, clear), _mm_unpacklo_epi16(bg, ra));
+                __m128i hi = _mm_andnot_si128(_mm_unpackhi_epi16(clear, clear), _mm_unpackhi_epi16(bg, ra));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 4), hi);
+            }
+            Row15Scalar(src, dst, x, image.width);
+        }
+    }
+
+    // Sixteen pixels from each eight bytes; the low nibble is the left
+    // pixel.  The sixteen colours are first split into one register per
+    // byte of the pixel, so pshufb on the indices looks up one channel
+    // of sixteen pixels.
+    DIGI_TARGET_SSSE3
+    void Decode4Ssse3(const TimImage& image, const uint32_t* colours, uint32_t* out, size_t pitch) {
+        // Register j: word k holds byte k of colours 4j..4j+3.
+        const __m128i split = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        __m128i c0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(colours)), split);
+        __m128i c1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(colours + 4)), split);
+        __m128i c2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(colours + 8)), split);
+        __m128i c3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(colours + 12)), split);
+        // Transpose the 4x4 matrix of words, one channel per register.
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+        __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+        __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+        const __m128i pb = _mm_unpacklo_epi64(t0, t1);
+        const __m128i pg = _mm_unpackhi_epi64(t0, t1);
+        const __m128i pr = _mm_unpacklo_epi64(t2, t3);
+        const __m128i pa = _mm_unpackhi_epi64(t2, t3);
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        for (uint32_t y = 0; y < image.height; ++y) {
+            const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+            uint32_t* dst = Row(out, pitch, y);
+            uint32_t x = 0;
+            for (; x + 16 <= image.width; x += 16) {
+                __m128i v   = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x / 2));
+                __m128i lo  = _mm_and_si128(v, nibble);
+                __m128i hi  = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                __m128i idx = _mm_unpacklo_epi8(lo, hi);
+                __m128i b = _mm_shuffle_epi8(pb, idx);
+                __m128i g = _mm_shuffle_epi8(pg, idx);
+                __m128i r = _mm_shuffle_epi8(pr, idx);
+                __m128i a = _mm_shuffle_epi8(pa, idx);
+                __m128i bgLo = _mm_unpacklo_epi8(b, g);
+                __m128i bgHi = _mm_unpackhi_epi8(b, g);
+                __m128i raLo = _mm_unpacklo_epi8(r, a);
+                __m128i raHi = _mm_unpackhi_epi8(r, a);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),      _mm_unpacklo_epi16(bgLo, raLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 4),  _mm_unpackhi_epi16(bgLo, raLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 8),  _mm_unpacklo_epi16(bgHi, raHi));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 12), _mm_unpackhi_epi16(bgHi, raHi));
+            }
+            Row4Scalar(src, colours, dst, x, image.width);
+        }
+    }
+
+    // Four R, G, B pixels per shuffle.  The load reads four bytes past
+    // the twelve it uses, so the loop stops while those are still in
+    // the row.
+    DIGI_TARGET_SSSE3
+    void Decode24Ssse3(const TimImage& image, uint32_t* out, size_t pitch) {
+        const __m128i order = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        for (uint32_t y = 0; y < image.height; ++y) {
+            const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+            uint32_t* dst = Row(out, pitch, y);
+            uint32_t x = 0;
+            for (; x + 4 <= image.width && 3 * x + 16 <= image.stride; x += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * x));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_or_si128(_mm_shuffle_epi8(v, order), alpha));
+            }
+            Row24Scalar(src, dst, x, image.width);
+        }
+    }
+
+    DIGI_TARGET_AVX2
+    void Decode8Avx2(const TimImage& image, const uint32_t* colours, uint32_t* out, size_t pitch) {
+        for (uint32_t y = 0; y < image.height; ++y) {
+            const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+            uint32_t* dst = Row(out, pitch, y);
+            uint32_t x = 0;
+            for (; x + 8 <= image.width; x += 8) {
+                __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x)));
+                __m256i v   = _mm256_i32gather_epi32(reinterpret_cast<const int*>(colours), idx, 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), v);
+            }
+            Row8Scalar(src, colours, dst, x, image.width);
+        }
+    }
+#endif
+
+    DecodePath DetectPath() {
+#if DIGI_X86
+        if (CpuHasAvx2()) {
+            return kAvx2;
+        }
+        if (CpuHasSsse3()) {
+            return kSsse3;
+        }
+        if (CpuHasSse2()) {
+            return kSse2;
+        }
+#endif
+        return kScalar;
+    }
+
+    DecodePath Path() {
+        static const DecodePath s_path = DetectPath();
+        return s_path;
+    }
+
+    bool HasPalette(const TimImage& image, uint32_t palette) {
+        if (image.mode != kTim4Bit && image.mode != kTim8Bit) {
+            return true;
+        }
+        return image.clut && palette < image.clutCount;
+    }
+}
+
+uint32_t TimColour(uint16_t colour) {
+    if (colour == 0) {
+        return 0;
+    }
+    uint32_t r = colour & 0x1F;
+    uint32_t g = (colour >> 5) & 0x1F;
+    uint32_t b = (colour >> 10) & 0x1F;
+    uint32_t a = (colour & 0x8000) ? 0x80 : 0xFF;
+    return (a << 24) | (((r << 3) | (r >> 2)) << 16) | (((g << 3) | (g >> 2)) << 8) | ((b << 3) | (b >> 2));
+}
+
+bool ParseTim(const uint8_t* data, size_t size, TimImage* image) {
+    if (size < kTimHeaderSize || Read32(data) != kTimTag) {
+        return false;
+    }
+    uint32_t flags = Read32(data + 4);
+    uint32_t mode = flags & kTimModeMask;
+    if ((flags & ~(kTimModeMask | kTimHasClut)) != 0 || mode > kTim24Bit) {
+        return false;
+    }
+    bool indexed = mode == kTim4Bit || mode == kTim8Bit;
+    if (indexed && !(flags & kTimHasClut)) {
+        return false;
+    }
+
+    TimImage t = {};
+    t.mode = mode;
+    size_t at = kTimHeaderSize;
+    Block block;
+    if (flags & kTimHasClut) {
+        if (!ReadBlock(data, size, &at, &block)) {
+            return false;
+        }
+        t.clut        = block.data;
+        t.clutColours = block.width;
+        t.clutCount   = block.height;
+        t.clutX       = block.x;
+        t.clutY       = block.y;
+    }
+    if (!ReadBlock(data, size, &at, &block)) {
+        return false;
+    }
+    switch (mode) {
+    case kTim4Bit:  t.width = block.width * 4u; break;
+    case kTim8Bit:  t.width = block.width * 2u; break;
+    case kTim15Bit: t.width = block.width; break;
+    default:        t.width = block.width * 2u / 3u; break;
+    }
+    if (t.width == 0) {
+        return false;
+    }
+    t.height = block.height;
+    t.stride = block.width * 2u;
+    t.pixels = block.data;
+    t.vramX  = block.x;
+    t.vramY  = block.y;
+    t.size   = static_cast<uint32_t>(at);
+    *image = t;
+    return true;
+}
+
+size_t ParseTimBundle(const uint8_t* data, size_t size, std::vector<TimImage>* images) {
+    size_t found = 0;
+    size_t at = 0;
+    while (size - at >= kTimHeaderSize) {
+        TimImage image;
+        if (ParseTim(data + at, size - at, &image)) {
+            image.offset = static_cast<uint32_t>(at);
+            images->push_back(image);
+            ++found;
+            at += image.size;
+        } else {
+            at += 4;
+        }
+    }
+    return found;
+}
+
+bool DecodeTimReference(const TimImage& image, uint32_t palette, uint32_t* out, size_t pitch) {
+    if (!HasPalette(image, palette)) {
+        return false;
+    }
+    const uint8_t* clut = image.clut ? image.clut + 2ull * palette * image.clutColours : nullptr;
+    for (uint32_t y = 0; y < image.height; ++y) {
+        const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+        uint32_t* dst = Row(out, pitch, y);
+        for (uint32_t x = 0; x < image.width; ++x) {
+            uint32_t index;
+            switch (image.mode) {
+            case kTim4Bit:
+                index = (src[x >> 1] >> ((x & 1) * 4)) & 0xF;
+                dst[x] = index < image.clutColours ? TimColour(Read16(clut + 2 * index)) : 0;
+                break;
+            case kTim8Bit:
+                index = src[x];
+                dst[x] = index < image.clutColours ? TimColour(Read16(clut + 2 * index)) : 0;
+                break;
+            case kTim15Bit:
+                dst[x] = TimColour(Read16(src + 2 * x));
+                break;
+            default:
+                dst[x] = Rgb24(src + 3 * x);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool DecodeTim(const TimImage& image, uint32_t palette, uint32_t* out, size_t pitch) {
+    if (!HasPalette(image, palette)) {
+        return false;
+    }
+    // 32-byte aligned for the gather; 256 entries cover any 8-bit index.
+    alignas(32) uint32_t colours[256];
+    if (image.mode == kTim4Bit || image.mode == kTim8Bit) {
+        ConvertClut(image, palette, colours, image.mode == kTim4Bit ? 16 : 256);
+    }
+    switch (Path()) {
+#if DIGI_X86
+    case kAvx2:
+        if (image.mode == kTim8Bit) {
+            Decode8Avx2(image, colours, out, pitch);
+            return true;
+        }
+        // fall through
+    case kSsse3:
+        if (image.mode == kTim4Bit) {
+            Decode4Ssse3(image, colours, out, pitch);
+            return true;
+        }
+        if (image.mode == kTim24Bit) {
+            Decode24Ssse3(image, out, pitch);
+            return true;
+        }
+        // fall through
+    case kSse2:
+        if (image.mode == kTim15Bit) {
+            Decode15Sse2(image, out, pitch);
+            return true;
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+    for (uint32_t y = 0; y < image.height; ++y) {
+        const uint8_t* src = image.pixels + static_cast<size_t>(y) * image.stride;
+        uint32_t* dst = Row(out, pitch, y);
+        switch (image.mode) {
+        case kTim4Bit:  Row4Scalar(src, colours, dst, 0, image.width); break;
+        case kTim8Bit:  Row8Scalar(src, colours, dst, 0, image.width); break;
+        case kTim15Bit: Row15Scalar(src, dst, 0, image.width); break;
+        default:        Row24Scalar(src, dst, 0, image.width); break;
+        }
+    }
+    return true;
+}
+
+const char* TimDecodePath() {
+    switch (Path()) {
+    case kAvx2:  return "avx2";
+    case kSsse3: return "ssse3";
+    case kSse2:  return "sse2";
+    default:     return "scalar";
+    }
+}
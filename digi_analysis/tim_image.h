@@ -0,0 +1,86 @@
+// Copyright (c) 2025
+//
+// Decoder for the PlayStation TIM images the game loads (CHDAT\ALLTIM.TIM,
+// ETCDAT\ETCTIM.BIN, STDDAT\STDTIM.BIN, ETCNA\title256.tim and the rest),
+// so textures can be recognised and converted as they arrive rather
+// than as anonymous pixels.
+//
+// A TIM is a 0x10 tag, a flags word (pixel mode in bits 0-2, bit 3 set
+// when a colour lookup table follows), the optional CLUT block and the
+// image block.  Each block is a byte length, a VRAM rectangle in 16-bit
+// units and the data.  4- and 8-bit images index a row of the CLUT; 15-bit
+// images hold the colours themselves; 24-bit images are packed R, G, B.
+// The bundles are TIMs laid end to end, at most with padding or a table
+// in between.
+//
+// Parsing only points into the caller's bytes, which are meant to be a
+// read-only mapping of the file: nothing is copied until DecodeTim
+// writes 32-bit A8R8G8B8 pixels (B, G, R, A in memory, the layout of the
+// bridge's textures).  15-bit colours carry the STP bit into alpha:
+//
+//     0x0000             alpha 0x00   transparent, as the GPU skips it
+//     STP clear          alpha 0xFF   opaque
+//     STP set            alpha 0x80   semi-transparent where the
+//                                     primitive enables blending
+//
+// 24-bit pixels are always opaque.  The CLUT is converted once per
+// decode and expanded with SSSE3 byte shuffles (4-bit: the sixteen
+// colours fit one shuffle table per channel) or an AVX2 gather (8-bit);
+// 15- and 24-bit rows convert eight and four pixels at a time with SSE2
+// and SSSE3.  The path is picked at run time as in sin_table.cpp.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum TimPixelMode {
+    kTim4Bit  = 0,
+    kTim8Bit  = 1,
+    kTim15Bit = 2,
+    kTim24Bit = 3,
+};
+
+struct TimImage {
+    uint32_t       mode;            // TimPixelMode
+    uint32_t       width;           // in pixels
+    uint32_t       height;
+    uint32_t       stride;          // bytes per row of `pixels`
+    const uint8_t* pixels;
+    const uint8_t* clut;            // clutCount rows of clutColours 16-bit entries, or nullptr
+    uint32_t       clutColours;
+    uint32_t       clutCount;
+    uint16_t       vramX;           // where the game uploads the image and CLUT
+    uint16_t       vramY;
+    uint16_t       clutX;
+    uint16_t       clutY;
+    uint32_t       offset;          // of the TIM in the bytes it was parsed from
+    uint32_t       size;            // of the TIM, in bytes
+};
+
+// Parse the TIM at the start of `data`.  Returns false unless the tag,
+// the mode and both block lengths are consistent and everything lies
+// within `size` bytes.  Mixed-mode TIMs (mode 4) are rejected.
+bool ParseTim(const uint8_t* data, size_t size, TimImage* image);
+
+// Append every TIM in `data` to `images` and return how many were
+// found.  After each TIM the search continues at its end; where no TIM
+// starts it steps one 32-bit word, so padding and tables are skipped.
+size_t ParseTimBundle(const uint8_t* data, size_t size, std::vector<TimImage>* images);
+
+// Decode `image` with CLUT row `palette` (ignored for 15- and 24-bit
+// images) into `out`, `pitch` bytes per row.  Returns false if the
+// image needs a CLUT it does not have or `palette` is out of range.
+bool DecodeTim(const TimImage& image, uint32_t palette, uint32_t* out, size_t pitch);
+
+// DecodeTim one pixel at a time, for checking and benchmarking the
+// SIMD paths against.
+bool DecodeTimReference(const TimImage& image, uint32_t palette, uint32_t* out, size_t pitch);
+
+// The A8R8G8B8 value of a 15-bit colour, as described above.
+uint32_t TimColour(uint16_t colour);
+
+// Name of the path DecodeTim uses on this CPU: "avx2", "ssse3", "sse2"
+// or "scalar".
+const char* TimDecodePath();
@@ -0,0 +1,220 @@
+// Copyright (c) 2025
+//
+// Analysis database file.  See analysis_db.h.
+
+#include "analysis_db.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    const char kMagic[8] = { 'D', 'I', 'G', 'I', 'A', 'D', 'B', 0 };
+
+    struct FileHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t chunkCount;
+    };
+
+    struct ChunkEntry {
+        uint32_t id;
+        uint32_t offset;            // from the start of the file, 8-byte aligned
+        uint32_t size;
+        uint32_t reserved;
+    };
+
+    struct PendingChunk {
+        uint32_t    id;
+        const void* data;
+        size_t      size;
+    };
+
+    size_t Align8(size_t n) {
+        return (n + 7) & ~static_cast<size_t>(7);
+    }
+
+    template <typename T>
+    const T* ChunkArray(const AnalysisDbView& view, uint32_t id, size_t* count) {
+        size_t size = 0;
+        const void* p = view.Chunk(id, &size);
+        *count = p ? size / sizeof(T) : 0;
+        return static_cast<const T*>(p);
+    }
+
+    bool WriteChunks(const char* path, const std::vector<PendingChunk>& chunks) {
+        FileHeader header = {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kDbVersion;
+        header.chunkCount = static_cast<uint32_t>(chunks.size());
+
+        std::vector<ChunkEntry> directory(chunks.size());
+        size_t offset = Align8(sizeof(header) + directory.size() * sizeof(ChunkEntry));
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            directory[i].id = chunks[i].id;
+            directory[i].offset = static_cast<uint32_t>(offset);
+            directory[i].size = static_cast<uint32_t>(chunks[i].size);
+            offset = Align8(offset + chunks[i].size);
+        }
+
+        std::FILE* f = std::fopen(path, "wb");
+        if (!f) {
+            return false;
+        }
+        static const uint8_t s_zero[8] = {};
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+                  std::fwrite(directory.data(), sizeof(ChunkEntry), directory.size(), f) == directory.size();
+        size_t written = sizeof(header) + directory.size() * sizeof(ChunkEntry);
+        for (size_t i = 0; ok && i < chunks.size(); ++i) {
+            size_t pad = directory[i].offset - written;
+            ok = std::fwrite(s_zero, 1, pad, f) == pad &&
+                 (chunks[i].size == 0 || std::fwrite(chunks[i].data, 1, chunks[i].size, f) == chunks[i].size);
+            written = directory[i].offset + chunks[i].size;
+        }
+        return std::fclose(f) == 0 && ok;
+    }
+}
+
+uint32_t ImageChecksum(const uint8_t* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+bool WriteAnalysisDb(const char* path, const AnalysisDb& db) {
+    std::vector<PendingChunk> chunks = {
+        { kDbChunkInfo, &db.info, sizeof(db.info) },
+        { kDbChunkFlags, db.flags.data(), db.flags.size() },
+        { kDbChunkFunctions, db.functions.data(), db.functions.size() * sizeof(DbFunction) },
+        { kDbChunkJumpTables, db.jumpTables.data(), db.jumpTables.size() * sizeof(DbJumpTable) },
+        { kDbChunkXrefs, db.xrefs.data(), db.xrefs.size() * sizeof(DbXref) },
+        { kDbChunkFunctionHashes, db.functionHashes.data(), db.functionHashes.size() * sizeof(DbFunctionHash) },
+        { kDbChunkFunctionInsns, db.functionInsns.data(), db.functionInsns.size() * sizeof(uint32_t) },
+    };
+    for (const AnalysisDb::Chunk& c : db.extraChunks) {
+        chunks.push_back({ c.id, c.data.data(), c.data.size() });
+    }
+    return WriteChunks(path, chunks);
+}
+
+bool UpdateAnalysisDb(const char* path, const std::vector<AnalysisDb::Chunk>& chunks) {
+    // Copy out what is kept, then let go of the mapping before the file
+    // is rewritten; Windows will not truncate a mapped file.
+    std::vector<AnalysisDb::Chunk> kept;
+    {
+        AnalysisDbView view;
+        if (!view.Open(path)) {
+            return false;
+        }
+        for (uint32_t id : view.ChunkIds()) {
+            bool replaced = std::any_of(chunks.begin(), chunks.end(),
+                                        [id](const AnalysisDb::Chunk& c) { return c.id == id; });
+            size_t size = 0;
+            const uint8_t* p = static_cast<const uint8_t*>(view.Chunk(id, &size));
+            if (!replaced && p) {
+                kept.push_back({ id, std::vector<uint8_t>(p, p + size) });
+            }
+        }
+    }
+
+    std::vector<PendingChunk> pending;
+    for (const AnalysisDb::Chunk& c : kept) {
+        pending.push_back({ c.id, c.data.data(), c.data.size() });
+    }
+    for (const AnalysisDb::Chunk& c : chunks) {
+        pending.push_back({ c.id, c.data.data(), c.data.size() });
+    }
+    return WriteChunks(path, pending);
+}
+
+bool AnalysisDbView::Open(const char* path) {
+    if (!m_file.Open(path) || m_file.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(m_file.data());
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kDbVersion ||
+        sizeof(FileHeader) + static_cast<size_t>(header->chunkCount) * sizeof(ChunkEntry) > m_file.size()) {
+        m_file.Close();
+        return false;
+    }
+    size_t infoSize = 0;
+    m_info = static_cast<const DbInfo*>(Chunk(kDbChunkInfo, &infoSize));
+    size_t flagsSize = 0;
+    m_flags = static_cast<const uint8_t*>(Chunk(kDbChunkFlags, &flagsSize));
+    if (!m_info || infoSize < sizeof(DbInfo) || !m_flags || flagsSize < m_info->textSize) {
+        m_file.Close();
+        return false;
+    }
+    m_functions = ChunkArray<DbFunction>(*this, kDbChunkFunctions, &m_functionCount);
+    m_jumpTables = ChunkArray<DbJumpTable>(*this, kDbChunkJumpTables, &m_jumpTableCount);
+    m_xrefs = ChunkArray<DbXref>(*this, kDbChunkXrefs, &m_xrefCount);
+    size_t hashCount = 0;
+    m_functionHashes = ChunkArray<DbFunctionHash>(*this, kDbChunkFunctionHashes, &hashCount);
+    m_functionInsns = ChunkArray<uint32_t>(*this, kDbChunkFunctionInsns, &m_functionInsnCount);
+    if (hashCount != m_functionCount) {
+        m_functionHashes = nullptr;
+    }
+    return true;
+}
+
+std::vector<uint32_t> AnalysisDbView::ChunkIds() const {
+    std::vector<uint32_t> ids;
+    if (m_file.data()) {
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(m_file.data());
+        const ChunkEntry* directory = reinterpret_cast<const ChunkEntry*>(header + 1);
+        for (uint32_t i = 0; i < header->chunkCount; ++i) {
+            ids.push_back(directory[i].id);
+        }
+    }
+    return ids;
+}
+
+const void* AnalysisDbView::Chunk(uint32_t id, size_t* size) const {
+    if (!m_file.data()) {
+        return nullptr;
+    }
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(m_file.data());
+    const ChunkEntry* directory = reinterpret_cast<const ChunkEntry*>(header + 1);
+    for (uint32_t i = 0; i < header->chunkCount; ++i) {
+        const ChunkEntry& c = directory[i];
+        if (c.id == id && static_cast<size_t>(c.offset) + c.size <= m_file.size()) {
+            if (size) {
+                *size = c.size;
+            }
+            return m_file.data() + c.offset;
+        }
+    }
+    return nullptr;
+}
+
+uint8_t AnalysisDbView::FlagsAt(uint32_t va) const {
+    uint32_t offset = va - m_info->textStart;
+    return offset < m_info->textSize ? m_flags[offset] : 0;
+}
+
+const DbFunction* AnalysisDbView::FunctionAt(uint32_t va) const {
+    const DbFunction* end = m_functions + m_functionCount;
+    const DbFunction* it = std::upper_bound(m_functions, end, va,
+                                            [](uint32_t a, const DbFunction& f) { return a < f.start; });
+    if (it == m_functions) {
+        return nullptr;
+    }
+    --it;
+    return va < it->end ? it : nullptr;
+}
+
+const DbFunction* AnalysisDbView::FunctionStartingAt(uint32_t va) const {
+    const DbFunction* end = m_functions + m_functionCount;
+    const DbFunction* it = std::lower_bound(m_functions, end, va,
+                                            [](const DbFunction& f, uint32_t a) { return f.start < a; });
+    return it != end && it->start == va ? it : nullptr;
+}
+
+const DbJumpTable* AnalysisDbView::JumpTableAt(uint32_t va) const {
+    const DbJumpTable* end = m_jumpTables + m_jumpTableCount;
+    const DbJumpTable* it = std::lower_bound(m_jumpTables, end, va,
+                                             [](const DbJumpTable& t, uint32_t a) { return t.jump < a; });
+    return it != end && it->jump == va ? it : nullptr;
+}
@@ -0,0 +1,195 @@
+// Copyright (c) 2025
+//
+// On-disk analysis database written by digi_disasm and read by the
+// other analysis tools.  The file is a small header, a chunk directory
+// and a run of chunks, each an array of little-endian POD records
+// aligned to 8 bytes, so a reader maps the file and indexes straight
+// into it; nothing is parsed or copied on open.  Tools that derive
+// more data (an xref index, a hash cache) add chunks of their own
+// under new ids rather than changing the existing ones.
+//
+//     'INFO'  DbInfo, one record
+//     'FLAG'  one DbByteFlags byte per byte of .text
+//     'FUNC'  DbFunction, sorted by start
+//     'JTAB'  DbJumpTable, sorted by jump address
+//     'XREF'  DbXref, sorted by (from, to)
+//     'FHSH'  DbFunctionHash, one per 'FUNC' record and in the same order
+//     'FINS'  uint32_t VAs of the instructions each function owns
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mapped_file.h"
+
+constexpr uint32_t DbChunkId(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) |
+           (static_cast<uint32_t>(d) << 24);
+}
+
+const uint32_t kDbChunkInfo      = DbChunkId('I', 'N', 'F', 'O');
+const uint32_t kDbChunkFlags     = DbChunkId('F', 'L', 'A', 'G');
+const uint32_t kDbChunkFunctions = DbChunkId('F', 'U', 'N', 'C');
+const uint32_t kDbChunkJumpTables = DbChunkId('J', 'T', 'A', 'B');
+const uint32_t kDbChunkXrefs     = DbChunkId('X', 'R', 'E', 'F');
+const uint32_t kDbChunkFunctionHashes = DbChunkId('F', 'H', 'S', 'H');
+const uint32_t kDbChunkFunctionInsns = DbChunkId('F', 'I', 'N', 'S');
+
+const uint32_t kDbVersion = 1;
+
+struct DbInfo {
+    uint32_t imageBase;
+    uint32_t entryPoint;
+    uint32_t textStart;         // VA of .text
+    uint32_t textSize;          // bytes covered by the 'FLAG' chunk
+    uint32_t imageSize;         // file size of the analysed image
+    uint32_t imageChecksum;     // FNV-1a of the file, to catch a stale database
+    uint32_t instructionCount;
+    uint32_t reserved;
+};
+
+enum DbByteFlags : uint8_t {
+    kDbInsn     = 0x01,         // first byte of an instruction
+    kDbCode     = 0x02,         // any byte of a decoded instruction
+    kDbFunction = 0x04,         // function entry point
+    kDbBlock    = 0x08,         // branch target, so a basic block starts here
+    kDbData     = 0x10,         // jump table or index table inside .text
+};
+
+enum DbFunctionFlags : uint32_t {
+    kDbFuncEntry   = 0x01,      // the image entry point
+    kDbFuncExport  = 0x02,
+    kDbFuncCalled  = 0x04,      // target of a direct call
+    kDbFuncPointer = 0x08,      // found through an address in data or an immediate
+    kDbFuncSwitch  = 0x10,      // contains a jump table
+    kDbFuncThunk   = 0x20,      // a single jmp
+    kDbFuncUnreferenced = 0x40, // found in a gap nothing reached; likely dead library code
+};
+
+struct DbFunction {
+    uint32_t start;
+    uint32_t end;               // one past the highest instruction byte it owns
+    uint32_t instructionCount;
+    uint32_t blockCount;
+    uint32_t flags;             // DbFunctionFlags
+    uint32_t reserved;
+};
+
+struct DbJumpTable {
+    uint32_t jump;              // the jmp [reg*4 + table] instruction
+    uint32_t table;             // VA of the dword target table
+    uint32_t count;             // targets in it
+    uint32_t indexTable;        // VA of the byte index table MSVC emits for sparse cases, or 0
+    uint32_t indexCount;
+    uint32_t reserved;
+};
+
+// What a function's analysis depended on: its own instructions (the
+// ones its extent walk reached, listed in 'FINS'), the jump and index
+// tables they use and any relocations inside them, hashed along with
+// their addresses.  A later run over a patched image reuses everything
+// recorded for a function whose hash comes out the same.
+struct DbFunctionHash {
+    uint64_t hash;
+    uint32_t firstInsn;         // index of its first VA in 'FINS'
+    uint32_t insnCount;         // ascending VAs from there
+};
+
+enum DbXrefKind : uint32_t {
+    kDbXrefCall,                // direct call
+    kDbXrefJump,                // unconditional direct jump
+    kDbXrefBranch,              // conditional jump, loop, jecxz
+    kDbXrefCase,                // jump table entry; `from` is the jmp
+    kDbXrefMemory,              // memory operand at an absolute address
+    kDbXrefOffset,              // immediate that is an address in the image
+    kDbXrefPointer,             // dword in a data section pointing into .text; `from` is the dword
+    kDbXrefImport,              // call or jmp through an IAT slot; `to` is the slot
+};
+
+struct DbXref {
+    uint32_t from;
+    uint32_t to;
+    uint32_t kind;              // DbXrefKind
+};
+
+// Everything digi_disasm produces, in memory, ready to be written.
+struct AnalysisDb {
+    DbInfo                   info = {};
+    std::vector<uint8_t>     flags;
+    std::vector<DbFunction>  functions;
+    std::vector<DbJumpTable> jumpTables;
+    std::vector<DbXref>      xrefs;
+    std::vector<DbFunctionHash> functionHashes;
+    std::vector<uint32_t>    functionInsns;
+
+    struct Chunk {
+        uint32_t             id;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Chunk>       extraChunks;
+};
+
+// Write `db` to `path`.  Returns false if the file cannot be written.
+bool WriteAnalysisDb(const char* path, const AnalysisDb& db);
+
+// Add `chunks` to the database at `path`, replacing any already there
+// under the same ids and keeping everything else.  This is how the
+// later tools store what they derive.  Returns false if `path` is not
+// a database or cannot be rewritten; no view of it may be open.
+bool UpdateAnalysisDb(const char* path, const std::vector<AnalysisDb::Chunk>& chunks);
+
+// FNV-1a over a whole image, for DbInfo::imageChecksum.
+uint32_t ImageChecksum(const uint8_t* data, size_t size);
+
+// Read-only view of a database file.  The accessors point into the
+// mapping and stay valid until the view is closed.
+class AnalysisDbView {
+public:
+    // Map and validate `path`.  Returns false if it is missing, not a
+    // database, or of another version.
+    bool Open(const char* path);
+
+    const DbInfo& info() const { return *m_info; }
+    const uint8_t* flags() const { return m_flags; }
+    const DbFunction* functions() const { return m_functions; }
+    size_t functionCount() const { return m_functionCount; }
+    const DbJumpTable* jumpTables() const { return m_jumpTables; }
+    size_t jumpTableCount() const { return m_jumpTableCount; }
+    const DbXref* xrefs() const { return m_xrefs; }
+    size_t xrefCount() const { return m_xrefCount; }
+    // Parallel to functions(); nullptr in a database written before the
+    // hashes were recorded.
+    const DbFunctionHash* functionHashes() const { return m_functionHashes; }
+    const uint32_t* functionInsns() const { return m_functionInsns; }
+    size_t functionInsnCount() const { return m_functionInsnCount; }
+
+    // Any chunk by id, or nullptr.
+    const void* Chunk(uint32_t id, size_t* size) const;
+    // Ids of every chunk in the file, in directory order.
+    std::vector<uint32_t> ChunkIds() const;
+
+    // Per-byte flags of `va`, 0 outside .text.
+    uint8_t FlagsAt(uint32_t va) const;
+    // The function whose [start, end) holds `va`, or nullptr.
+    const DbFunction* FunctionAt(uint32_t va) const;
+    // The function starting exactly at `va`, or nullptr.
+    const DbFunction* FunctionStartingAt(uint32_t va) const;
+    // The jump table whose jmp is at `va`, or nullptr.
+    const DbJumpTable* JumpTableAt(uint32_t va) const;
+
+private:
+    MappedFile         m_file;
+    const DbInfo*      m_info = nullptr;
+    const uint8_t*     m_flags = nullptr;
+    const DbFunction*  m_functions = nullptr;
+    size_t             m_functionCount = 0;
+    const DbJumpTable* m_jumpTables = nullptr;
+    size_t             m_jumpTableCount = 0;
+    const DbXref*      m_xrefs = nullptr;
+    size_t             m_xrefCount = 0;
+    const DbFunctionHash* m_functionHashes = nullptr;
+    const uint32_t*    m_functionInsns = nullptr;
+    size_t             m_functionInsnCount = 0;
+};
@@ -0,0 +1,36 @@
+// Copyright (c) 2025
+//
+// Read-only memory mapping of a whole file, for the analysis tools
+// under tools/.  On Windows it is a file mapping view, elsewhere an
+// mmap; either way the tools index straight into the bytes of
+// digi.exe (or a database they wrote) without reading it into a
+// buffer first.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map `path`.  Returns false (and leaves the object empty) if the
+    // file cannot be opened or is empty.
+    bool Open(const char* path);
+    void Close();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+#if defined(_WIN32)
+    void*          m_file = nullptr;
+    void*          m_mapping = nullptr;
+#endif
+};
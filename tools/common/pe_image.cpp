@@ -0,0 +1,242 @@
+// Copyright (c) 2025
+//
+// PE32 reader.  See pe_image.h.
+
+#include "pe_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const uint32_t kDirExport = 0;
+    const uint32_t kDirImport = 1;
+    const uint32_t kDirBaseReloc = 5;
+
+    uint16_t U16(const uint8_t* p) {
+        uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    uint32_t U32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+}
+
+bool PeImage::Load(const uint8_t* data, size_t size) {
+    m_data = data;
+    m_size = size;
+    m_sections.clear();
+    m_imports.clear();
+    m_exports.clear();
+    m_relocations.clear();
+    if (size < 0x40 || data[0] != 'M' || data[1] != 'Z') {
+        return false;
+    }
+    uint32_t pe = U32(data + 0x3C);
+    if (pe > size - 24 || std::memcmp(data + pe, "PE\0\0", 4) != 0) {
+        return false;
+    }
+    const uint8_t* file = data + pe + 4;
+    uint16_t sectionCount = U16(file + 2);
+    uint16_t optSize = U16(file + 16);
+    const uint8_t* opt = file + 20;
+    if (pe + 24 + static_cast<size_t>(optSize) > size || optSize < 96 || U16(opt) != 0x10B) {
+        return false;       // not PE32
+    }
+    m_imageBase = U32(opt + 28);
+    m_entryPoint = m_imageBase + U32(opt + 16);
+    m_sizeOfImage = U32(opt + 56);
+    uint32_t dirCount = U32(opt + 92);
+    auto dir = [&](uint32_t index, uint32_t* rva, uint32_t* length) {
+        if (index >= dirCount || 96 + index * 8 + 8 > optSize) {
+            *rva = *length = 0;
+            return;
+        }
+        *rva = U32(opt + 96 + index * 8);
+        *length = U32(opt + 96 + index * 8 + 4);
+    };
+
+    const uint8_t* sec = opt + optSize;
+    if (sec + static_cast<size_t>(sectionCount) * 40 > data + size) {
+        return false;
+    }
+    for (uint16_t i = 0; i < sectionCount; ++i, sec += 40) {
+        PeSection s;
+        std::memcpy(s.name, sec, 8);
+        s.name[8] = '\0';
+        s.virtualSize = U32(sec + 8);
+        s.va = m_imageBase + U32(sec + 12);
+        s.rawSize = U32(sec + 16);
+        s.rawOffset = U32(sec + 20);
+        s.characteristics = U32(sec + 36);
+        if (s.rawOffset > size) {
+            s.rawSize = 0;
+        } else if (s.rawSize > size - s.rawOffset) {
+            s.rawSize = static_cast<uint32_t>(size - s.rawOffset);
+        }
+        m_sections.push_back(s);
+    }
+
+    uint32_t rva, length;
+    dir(kDirImport, &rva, &length);
+    if (rva && !ParseImports(rva)) {
+        return false;
+    }
+    dir(kDirExport, &rva, &length);
+    if (rva && !ParseExports(rva)) {
+        return false;
+    }
+    dir(kDirBaseReloc, &rva, &length);
+    if (rva && !ParseRelocations(rva, length)) {
+        return false;
+    }
+    return true;
+}
+
+const PeSection* PeImage::SectionAt(uint32_t va) const {
+    for (const PeSection& s : m_sections) {
+        if (s.Contains(va)) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* PeImage::At(uint32_t va, size_t* avail) const {
+    const PeSection* s = SectionAt(va);
+    if (!s || va - s->va >= s->rawSize) {
+        return nullptr;
+    }
+    if (avail) {
+        *avail = s->rawSize - (va - s->va);
+    }
+    return m_data + s->rawOffset + (va - s->va);
+}
+
+bool PeImage::IsCode(uint32_t va) const {
+    const PeSection* s = SectionAt(va);
+    return s && s->IsCode();
+}
+
+bool PeImage::ReadU32(uint32_t va, uint32_t* out) const {
+    size_t avail;
+    const uint8_t* p = At(va, &avail);
+    if (!p || avail < 4) {
+        return false;
+    }
+    *out = U32(p);
+    return true;
+}
+
+const char* PeImage::StringAt(uint32_t va) const {
+    size_t avail;
+    const char* p = reinterpret_cast<const char*>(At(va, &avail));
+    if (!p || !std::memchr(p, 0, avail)) {
+        return nullptr;
+    }
+    return p;
+}
+
+bool PeImage::ParseImports(uint32_t rva) {
+    for (uint32_t desc = m_imageBase + rva;; desc += 20) {
+        size_t avail;
+        const uint8_t* d = At(desc, &avail);
+        if (!d || avail < 20) {
+            return false;
+        }
+        uint32_t lookup = U32(d), nameRva = U32(d + 12), iat = U32(d + 16);
+        if (!nameRva) {
+            return true;
+        }
+        const char* dll = StringAt(m_imageBase + nameRva);
+        if (!dll) {
+            return false;
+        }
+        // Old linkers leave the lookup table empty and only fill the IAT.
+        uint32_t names = m_imageBase + (lookup ? lookup : iat);
+        for (uint32_t i = 0;; ++i) {
+            uint32_t entry;
+            if (!ReadU32(names + i * 4, &entry)) {
+                return false;
+            }
+            if (!entry) {
+                break;
+            }
+            PeImport imp;
+            imp.dll = dll;
+            imp.iatVa = m_imageBase + iat + i * 4;
+            if (entry & 0x80000000u) {
+                imp.ordinal = static_cast<uint16_t>(entry);
+            } else {
+                const char* name = StringAt(m_imageBase + entry + 2);
+                if (!name) {
+                    return false;
+                }
+                imp.ordinal = 0;
+                imp.name = name;
+            }
+            m_imports.push_back(imp);
+        }
+    }
+}
+
+bool PeImage::ParseExports(uint32_t rva) {
+    size_t avail;
+    const uint8_t* d = At(m_imageBase + rva, &avail);
+    if (!d || avail < 40) {
+        return false;
+    }
+    uint32_t base = U32(d + 16), functionCount = U32(d + 20), nameCount = U32(d + 24);
+    uint32_t functions = m_imageBase + U32(d + 28);
+    uint32_t names = m_imageBase + U32(d + 32);
+    uint32_t ordinals = m_imageBase + U32(d + 36);
+    std::vector<std::string> byIndex(functionCount);
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        uint32_t nameRva;
+        const uint8_t* ord = At(ordinals + i * 2);
+        if (!ReadU32(names + i * 4, &nameRva) || !ord) {
+            return false;
+        }
+        uint16_t index = U16(ord);
+        const char* name = StringAt(m_imageBase + nameRva);
+        if (index < functionCount && name) {
+            byIndex[index] = name;
+        }
+    }
+    for (uint32_t i = 0; i < functionCount; ++i) {
+        uint32_t target;
+        if (!ReadU32(functions + i * 4, &target)) {
+            return false;
+        }
+        if (target) {
+            m_exports.push_back(PeExport{ byIndex[i], static_cast<uint16_t>(base + i), m_imageBase + target });
+        }
+    }
+    return true;
+}
+
+bool PeImage::ParseRelocations(uint32_t rva, uint32_t size) {
+    uint32_t block = m_imageBase + rva, end = block + size;
+    while (block + 8 <= end) {
+        uint32_t page = 0, blockSize = 0;
+        if (!ReadU32(block, &page) || !ReadU32(block + 4, &blockSize) || blockSize < 8) {
+            return blockSize == 0;
+        }
+        const uint8_t* entries = At(block + 8);
+        if (!entries) {
+            return false;
+        }
+        for (uint32_t i = 0; i < (blockSize - 8) / 2; ++i) {
+            uint16_t e = U16(entries + i * 2);
+            if ((e >> 12) == 3) {       // IMAGE_REL_BASED_HIGHLOW
+                m_relocations.push_back(m_imageBase + page + (e & 0xFFF));
+            }
+        }
+        block += blockSize;
+    }
+    std::sort(m_relocations.begin(), m_relocations.end());
+    return true;
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2025
+//
+// Minimal PE32 reader for the analysis tools.  Parses the headers,
+// section table, import and export directories and base relocations
+// of an image held in memory (normally a MappedFile of digi.exe) and
+// translates virtual addresses to the file bytes behind them.  Nothing
+// is copied: the image must outlive the PeImage.
+//
+// Only what the tools need is decoded, and nothing depends on
+// <windows.h>, so the tools build on Linux as well.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct PeSection {
+    char     name[9];
+    uint32_t va;                // absolute, image base included
+    uint32_t virtualSize;
+    uint32_t rawOffset;
+    uint32_t rawSize;
+    uint32_t characteristics;
+
+    bool IsCode() const { return (characteristics & 0x20000000) != 0; }       // IMAGE_SCN_MEM_EXECUTE
+    bool IsWritable() const { return (characteristics & 0x80000000) != 0; }   // IMAGE_SCN_MEM_WRITE
+    bool Contains(uint32_t address) const {
+        return address >= va && address - va < (virtualSize ? virtualSize : rawSize);
+    }
+};
+
+struct PeImport {
+    std::string dll;
+    std::string name;           // empty when imported by ordinal
+    uint16_t    ordinal;
+    uint32_t    iatVa;          // address of the IAT slot
+};
+
+struct PeExport {
+    std::string name;           // empty for ordinal-only exports
+    uint16_t    ordinal;
+    uint32_t    va;
+};
+
+class PeImage {
+public:
+    // Parse `data`.  Returns false if it is not a 32-bit PE image.
+    bool Load(const uint8_t* data, size_t size);
+
+    uint32_t imageBase() const { return m_imageBase; }
+    uint32_t entryPoint() const { return m_entryPoint; }
+    uint32_t sizeOfImage() const { return m_sizeOfImage; }
+    const uint8_t* fileData() const { return m_data; }
+    size_t fileSize() const { return m_size; }
+
+    const std::vector<PeSection>& sections() const { return m_sections; }
+    const std::vector<PeImport>& imports() const { return m_imports; }
+    const std::vector<PeExport>& exports() const { return m_exports; }
+    // Addresses of the 32-bit fields the base relocations patch, in
+    // ascending order.  Empty for digi.exe, which was linked with
+    // relocations stripped.
+    const std::vector<uint32_t>& relocations() const { return m_relocations; }
+
+    const PeSection* SectionAt(uint32_t va) const;
+
+    // The file bytes behind `va`, or nullptr if `va` is outside every
+    // section or in the zero-filled tail past its raw data.  `avail`
+    // receives the number of file bytes from `va` to the end of the
+    // section's raw data.
+    const uint8_t* At(uint32_t va, size_t* avail = nullptr) const;
+
+    bool IsCode(uint32_t va) const;
+    bool ReadU32(uint32_t va, uint32_t* out) const;
+
+private:
+    bool ParseImports(uint32_t rva);
+    bool ParseExports(uint32_t rva);
+    bool ParseRelocations(uint32_t rva, uint32_t size);
+    const char* StringAt(uint32_t va) const;
+
+    const uint8_t*         m_data = nullptr;
+    size_t                 m_size = 0;
+    uint32_t               m_imageBase = 0;
+    uint32_t               m_entryPoint = 0;
+    uint32_t               m_sizeOfImage = 0;
+    std::vector<PeSection> m_sections;
+    std::vector<PeImport>  m_imports;
+    std::vector<PeExport>  m_exports;
+    std::vector<uint32_t>  m_relocations;
+};
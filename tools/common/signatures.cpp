@@ -0,0 +1,581 @@
+// Copyright (c) 2025
+//
+// Signature libraries and matching.  See signatures.h.
+
+#include "signatures.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <tuple>
+
+#include "x86_decode.h"
+
+struct SignatureLibrary::Entry {
+    uint64_t hash;              // SkeletonHash of the bytes
+    uint32_t length;
+    uint32_t pattern;           // offset of `length` bytes, then one bit per byte that must match
+    uint32_t name;              // offset into the names
+    uint32_t reserved;
+};
+
+namespace {
+    const char kMagic[8] = { 'D', 'I', 'G', 'I', 'S', 'I', 'G', 0 };
+    const uint32_t kVersion = 1;
+
+    struct FileHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t slotCount;         // a power of two
+        uint32_t patternSize;
+        uint32_t nameSize;
+        uint32_t reserved;
+    };
+
+    size_t Align8(size_t n) {
+        return (n + 7) & ~static_cast<size_t>(7);
+    }
+
+    class Fnv64 {
+    public:
+        void Add(const uint8_t* p, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                m_hash = (m_hash ^ p[i]) * 1099511628211ull;
+            }
+        }
+        void Add32(uint32_t v) {
+            const uint8_t b[4] = { static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+                                   static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24) };
+            Add(b, sizeof(b));
+        }
+        uint64_t value() const { return m_hash; }
+
+    private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    uint16_t U16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t U32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0] | (p[1] << 8) | (p[2] << 16)) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    // The lookup key: the length and the bytes of the linearly decoded
+    // instructions with every 32-bit displacement and immediate zeroed,
+    // relative branch offsets included.  Those are where relocations
+    // and call targets sit, so the key comes out the same for the
+    // reference function and its linked copy.  Bytes that do not
+    // decode go in as they are.
+    uint64_t SkeletonHash(const uint8_t* code, uint32_t length) {
+        Fnv64 h;
+        h.Add32(length);
+        uint32_t offset = 0;
+        while (offset < length) {
+            X86Insn insn;
+            if (!DecodeX86(code + offset, length - offset, offset, &insn)) {
+                h.Add(code + offset, 1);
+                ++offset;
+                continue;
+            }
+            uint8_t bytes[16];
+            std::memcpy(bytes, code + offset, insn.length);
+            if (insn.dispSize == 4) {
+                std::memset(bytes + insn.dispOffset, 0, 4);
+            }
+            if (insn.immSize == 4) {
+                std::memset(bytes + insn.immOffset, 0, 4);
+            }
+            h.Add(bytes, insn.length);
+            offset += insn.length;
+        }
+        return h.value();
+    }
+
+    // ---- COFF -----------------------------------------------------------
+
+    const uint16_t kMachineI386 = 0x14C;
+    const uint32_t kScnCode = 0x00000020;
+    const uint32_t kScnRelocOverflow = 0x01000000;
+    const uint8_t  kClassExternal = 2;
+    const uint8_t  kClassStatic = 3;
+    const uint16_t kTypeFunction = 0x20;
+
+    // A patched field, relative to the start of its section.
+    struct CoffReloc {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct CoffSymbol {
+        std::string name;
+        uint32_t    value;
+        uint32_t    section;        // 1-based
+    };
+
+    uint32_t RelocSize(uint16_t type) {
+        switch (type) {
+        case 0x0006:                // IMAGE_REL_I386_DIR32
+        case 0x0007:                // IMAGE_REL_I386_DIR32NB
+        case 0x000B:                // IMAGE_REL_I386_SECREL
+        case 0x0014:                // IMAGE_REL_I386_REL32
+            return 4;
+        case 0x000A:                // IMAGE_REL_I386_SECTION
+            return 2;
+        default:
+            return 0;
+        }
+    }
+
+    // The reference function in the `length` bytes at `code`, whose
+    // relocations are `relocs` (offsets relative to `code`, sorted).
+    //
+    // MSVC places a switch's jump table after the function's code, in
+    // the same section, so the code ends at the first relocation that
+    // is not a displacement or immediate field of an instruction; the
+    // int3 and no-op padding before the next function is dropped too.
+    // What remains covers what digi_disasm counts as the function.
+    void BuildReference(const std::string& name, const uint8_t* code, uint32_t length,
+                        const std::vector<CoffReloc>& relocs, std::vector<SigFunction>* out) {
+        std::vector<X86Insn> insns;
+        uint32_t codeEnd = 0;
+        auto reloc = relocs.begin();
+        for (uint32_t offset = 0; offset < length;) {
+            X86Insn insn;
+            if (!DecodeX86(code + offset, length - offset, offset, &insn)) {
+                break;
+            }
+            bool data = false;
+            for (; reloc != relocs.end() && reloc->offset < offset + insn.length; ++reloc) {
+                uint32_t field = reloc->offset - offset;
+                data |= reloc->offset < offset ||
+                        !((insn.dispSize && field == insn.dispOffset) || (insn.immSize && field == insn.immOffset));
+            }
+            if (data) {
+                break;
+            }
+            if (insn.opcode != 0xCC && !X86IsFiller(insn)) {
+                codeEnd = offset + insn.length;
+            }
+            insns.push_back(insn);
+            offset += insn.length;
+        }
+        if (!codeEnd) {
+            return;
+        }
+
+        SigFunction f;
+        f.name = name;
+        f.bytes.assign(code, code + codeEnd);
+        f.fixed.assign(codeEnd, 1);
+        for (const CoffReloc& r : relocs) {
+            for (uint32_t i = r.offset; i < r.offset + r.size && i < codeEnd; ++i) {
+                f.fixed[i] = 0;
+            }
+        }
+        // A branch out of the function lands wherever the linker put its
+        // target; one within it is part of the code.
+        for (const X86Insn& insn : insns) {
+            bool relative = insn.flow == X86Flow::kJump || insn.flow == X86Flow::kCondJump || insn.flow == X86Flow::kCall;
+            if (relative && insn.immSize == 4 && insn.address < codeEnd && insn.target >= codeEnd) {
+                std::fill(f.fixed.begin() + insn.address + insn.immOffset,
+                          f.fixed.begin() + insn.address + insn.immOffset + 4, 0);
+            }
+        }
+        for (uint32_t i = 0; i < codeEnd; ++i) {
+            if (!f.fixed[i]) {
+                f.bytes[i] = 0;
+            }
+        }
+        out->push_back(std::move(f));
+    }
+
+    // The functions of one COFF object.  Returns false if `data` is not
+    // an i386 object.
+    bool ReadObject(const uint8_t* data, size_t size, std::vector<SigFunction>* out) {
+        if (size < 20 || U16(data) != kMachineI386) {
+            return false;
+        }
+        uint32_t sectionCount = U16(data + 2);
+        uint32_t symbolOffset = U32(data + 8);
+        uint32_t symbolCount = U32(data + 12);
+        size_t sectionTable = 20 + U16(data + 16);
+        if (sectionTable + sectionCount * 40ull > size || symbolOffset + symbolCount * 18ull > size) {
+            return false;
+        }
+        const uint8_t* strings = data + symbolOffset + symbolCount * 18;
+        size_t stringSize = size - (symbolOffset + symbolCount * 18);
+
+        std::vector<CoffSymbol> symbols;
+        for (uint32_t i = 0; i < symbolCount; i += 1 + data[symbolOffset + i * 18 + 17]) {
+            const uint8_t* s = data + symbolOffset + i * 18;
+            int16_t section = static_cast<int16_t>(U16(s + 12));
+            uint16_t type = U16(s + 14);
+            uint8_t storage = s[16];
+            if (section <= 0 || static_cast<uint32_t>(section) > sectionCount ||
+                !(storage == kClassExternal || (storage == kClassStatic && type == kTypeFunction))) {
+                continue;
+            }
+            const uint8_t* sec = data + sectionTable + (section - 1) * 40;
+            if (!(U32(sec + 36) & kScnCode)) {
+                continue;
+            }
+            CoffSymbol symbol;
+            if (U32(s) == 0) {
+                uint32_t at = U32(s + 4);
+                if (at >= stringSize) {
+                    continue;
+                }
+                const char* p = reinterpret_cast<const char*>(strings + at);
+                symbol.name.assign(p, strnlen(p, stringSize - at));
+            } else {
+                const char* p = reinterpret_cast<const char*>(s);
+                symbol.name.assign(p, strnlen(p, 8));
+            }
+            symbol.value = U32(s + 8);
+            symbol.section = static_cast<uint32_t>(section);
+            symbols.push_back(symbol);
+        }
+        std::stable_sort(symbols.begin(), symbols.end(), [](const CoffSymbol& a, const CoffSymbol& b) {
+            return a.section != b.section ? a.section < b.section : a.value < b.value;
+        });
+
+        std::vector<CoffReloc> sectionRelocs;
+        uint32_t relocSection = 0;
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            const CoffSymbol& symbol = symbols[i];
+            // Aliases share a body; the first name stands for it.
+            if (i && symbols[i - 1].section == symbol.section && symbols[i - 1].value == symbol.value) {
+                continue;
+            }
+            const uint8_t* sec = data + sectionTable + (symbol.section - 1) * 40;
+            uint32_t rawSize = U32(sec + 16);
+            uint32_t rawOffset = U32(sec + 20);
+            if (!rawOffset || rawOffset + static_cast<uint64_t>(rawSize) > size || symbol.value >= rawSize) {
+                continue;
+            }
+            if (relocSection != symbol.section) {
+                relocSection = symbol.section;
+                sectionRelocs.clear();
+                uint32_t relocOffset = U32(sec + 24);
+                uint32_t relocCount = U16(sec + 32);
+                uint32_t first = 0;
+                if ((U32(sec + 36) & kScnRelocOverflow) && relocCount == 0xFFFF &&
+                    relocOffset + 10ull <= size) {
+                    // The real count is in the first record, which is
+                    // not itself a relocation.
+                    relocCount = U32(data + relocOffset);
+                    first = 1;
+                }
+                for (uint32_t r = first; r < relocCount && relocOffset + (r + 1) * 10ull <= size; ++r) {
+                    const uint8_t* p = data + relocOffset + r * 10;
+                    if (uint32_t fieldSize = RelocSize(U16(p + 8))) {
+                        sectionRelocs.push_back({ U32(p), fieldSize });
+                    }
+                }
+                std::sort(sectionRelocs.begin(), sectionRelocs.end(),
+                          [](const CoffReloc& a, const CoffReloc& b) { return a.offset < b.offset; });
+            }
+            uint32_t end = rawSize;
+            for (size_t j = i + 1; j < symbols.size() && symbols[j].section == symbol.section; ++j) {
+                if (symbols[j].value > symbol.value) {
+                    end = std::min(end, symbols[j].value);
+                    break;
+                }
+            }
+            std::vector<CoffReloc> relocs;
+            for (const CoffReloc& r : sectionRelocs) {
+                if (r.offset >= symbol.value && r.offset < end) {
+                    relocs.push_back({ r.offset - symbol.value, r.size });
+                }
+            }
+            BuildReference(symbol.name, data + rawOffset + symbol.value, end - symbol.value, relocs, out);
+        }
+        return true;
+    }
+
+    template <typename T>
+    AnalysisDb::Chunk MakeChunk(uint32_t id, const std::vector<T>& records) {
+        AnalysisDb::Chunk chunk;
+        chunk.id = id;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(records.data());
+        chunk.data.assign(p, p + records.size() * sizeof(T));
+        return chunk;
+    }
+}
+
+bool ReadObjectFunctions(const uint8_t* data, size_t size, std::vector<SigFunction>* out, std::string* error) {
+    const char kArchive[8] = { '!', '<', 'a', 'r', 'c', 'h', '>', '\n' };
+    if (size < sizeof(kArchive) || std::memcmp(data, kArchive, sizeof(kArchive)) != 0) {
+        if (!ReadObject(data, size, out)) {
+            *error = "not an i386 COFF object or library";
+            return false;
+        }
+        return true;
+    }
+    size_t offset = sizeof(kArchive);
+    while (offset + 60 <= size) {
+        const uint8_t* header = data + offset;
+        char digits[11] = {};
+        std::memcpy(digits, header + 48, 10);
+        size_t memberSize = std::strtoul(digits, nullptr, 10);
+        const uint8_t* member = header + 60;
+        if (offset + 60 + memberSize > size) {
+            *error = "truncated library member";
+            return false;
+        }
+        // "/" is a linker member and "//" the long name table; "/123"
+        // is an object whose name is in that table.
+        bool special = header[0] == '/' && (header[1] == ' ' || header[1] == '/');
+        bool import = memberSize >= 4 && U16(member) == 0 && U16(member + 2) == 0xFFFF;
+        if (!special && !import) {
+            ReadObject(member, memberSize, out);
+        }
+        offset += 60 + memberSize + (memberSize & 1);
+    }
+    return true;
+}
+
+bool WriteSignatureLibrary(const char* path, const std::vector<SigFunction>& functions, SigBuildStats* stats) {
+    *stats = SigBuildStats();
+    stats->functions = static_cast<uint32_t>(functions.size());
+
+    struct Pending {
+        uint64_t           hash;
+        const SigFunction* function;
+    };
+    std::vector<Pending> pending;
+    for (const SigFunction& f : functions) {
+        if (static_cast<uint32_t>(std::count(f.fixed.begin(), f.fixed.end(), 1)) < kSigMinFixedBytes) {
+            ++stats->tooShort;
+            continue;
+        }
+        pending.push_back({ SkeletonHash(f.bytes.data(), static_cast<uint32_t>(f.bytes.size())), &f });
+    }
+    auto key = [](const Pending& p) {
+        return std::tie(p.hash, p.function->bytes, p.function->fixed, p.function->name);
+    };
+    std::sort(pending.begin(), pending.end(), [&](const Pending& a, const Pending& b) { return key(a) < key(b); });
+    auto last = std::unique(pending.begin(), pending.end(), [&](const Pending& a, const Pending& b) {
+        return key(a) == key(b);
+    });
+    stats->duplicates = static_cast<uint32_t>(pending.end() - last);
+    pending.erase(last, pending.end());
+    stats->signatures = static_cast<uint32_t>(pending.size());
+
+    std::vector<SignatureLibrary::Entry> entries;
+    std::vector<uint8_t> patterns;
+    std::string names;
+    for (const Pending& p : pending) {
+        const SigFunction& f = *p.function;
+        uint32_t length = static_cast<uint32_t>(f.bytes.size());
+        entries.push_back({ p.hash, length, static_cast<uint32_t>(patterns.size()), static_cast<uint32_t>(names.size()), 0 });
+        patterns.insert(patterns.end(), f.bytes.begin(), f.bytes.end());
+        size_t bits = patterns.size();
+        patterns.resize(bits + (length + 7) / 8);
+        for (uint32_t i = 0; i < length; ++i) {
+            patterns[bits + i / 8] |= static_cast<uint8_t>(f.fixed[i] << (i % 8));
+        }
+        names.append(f.name);
+        names.push_back('\0');
+    }
+
+    // Linear probing at a load of at most one half.
+    uint32_t slotCount = 16;
+    while (slotCount < entries.size() * 2) {
+        slotCount *= 2;
+    }
+    std::vector<uint32_t> slots(slotCount);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        uint32_t s = static_cast<uint32_t>(entries[i].hash) & (slotCount - 1);
+        while (slots[s]) {
+            s = (s + 1) & (slotCount - 1);
+        }
+        slots[s] = static_cast<uint32_t>(i + 1);
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.slotCount = slotCount;
+    header.patternSize = static_cast<uint32_t>(patterns.size());
+    header.nameSize = static_cast<uint32_t>(names.size());
+
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    static const uint8_t s_zero[8] = {};
+    const struct {
+        const void* data;
+        size_t      size;
+    } parts[] = {
+        { &header, sizeof(header) },
+        { entries.data(), entries.size() * sizeof(SignatureLibrary::Entry) },
+        { slots.data(), slots.size() * sizeof(uint32_t) },
+        { patterns.data(), patterns.size() },
+        { names.data(), names.size() },
+    };
+    bool ok = true;
+    for (const auto& part : parts) {
+        size_t pad = Align8(part.size) - part.size;
+        ok = ok && (part.size == 0 || std::fwrite(part.data, 1, part.size, f) == part.size) &&
+             std::fwrite(s_zero, 1, pad, f) == pad;
+    }
+    return std::fclose(f) == 0 && ok;
+}
+
+bool SignatureLibrary::Open(const char* path) {
+    if (!m_file.Open(path) || m_file.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        !header.slotCount || (header.slotCount & (header.slotCount - 1))) {
+        return false;
+    }
+    size_t entries = Align8(sizeof(header));
+    size_t slots = entries + Align8(header.entryCount * sizeof(Entry));
+    size_t patterns = slots + Align8(header.slotCount * sizeof(uint32_t));
+    size_t names = patterns + Align8(header.patternSize);
+    if (names + header.nameSize > m_file.size()) {
+        return false;
+    }
+    const uint8_t* base = m_file.data();
+    m_entries = reinterpret_cast<const Entry*>(base + entries);
+    m_count = header.entryCount;
+    m_slots = reinterpret_cast<const uint32_t*>(base + slots);
+    m_slotMask = header.slotCount - 1;
+    m_patterns = base + patterns;
+    m_patternSize = header.patternSize;
+    m_names = reinterpret_cast<const char*>(base + names);
+    m_nameSize = header.nameSize;
+    return true;
+}
+
+void SignatureLibrary::Find(const uint8_t* code, uint32_t length, std::vector<const char*>* names) const {
+    if (!m_count) {
+        return;
+    }
+    uint64_t hash = SkeletonHash(code, length);
+    for (uint32_t s = static_cast<uint32_t>(hash) & m_slotMask; m_slots[s]; s = (s + 1) & m_slotMask) {
+        const Entry& e = m_entries[m_slots[s] - 1];
+        if (e.hash != hash || e.length != length || e.pattern + length + (length + 7) / 8 > m_patternSize ||
+            e.name >= m_nameSize) {
+            continue;
+        }
+        const uint8_t* bytes = m_patterns + e.pattern;
+        const uint8_t* fixed = bytes + length;
+        uint32_t i = 0;
+        while (i < length && (!((fixed[i / 8] >> (i % 8)) & 1) || code[i] == bytes[i])) {
+            ++i;
+        }
+        if (i == length) {
+            names->push_back(m_names + e.name);
+        }
+    }
+}
+
+std::vector<AnalysisDb::Chunk> MatchSignatures(const PeImage& image, const AnalysisDbView& db,
+                                               const std::vector<const SignatureLibrary*>& libraries,
+                                               unsigned threads, SigMatchStats* stats) {
+    auto start = std::chrono::steady_clock::now();
+    const DbFunction* functions = db.functions();
+    size_t count = db.functionCount();
+    *stats = SigMatchStats();
+    stats->functions = static_cast<uint32_t>(count);
+    stats->threads = std::max(1u, threads ? threads : std::thread::hardware_concurrency());
+
+    // One slot per function, each written by whichever thread took it,
+    // so the result does not depend on the scheduling.
+    std::vector<const char*> found(count);
+    std::vector<uint8_t> ambiguous(count);
+    std::atomic<size_t> next(0);
+    auto work = [&] {
+        const size_t kBatch = 64;
+        std::vector<const char*> names;
+        for (size_t first; (first = next.fetch_add(kBatch)) < count;) {
+            for (size_t i = first; i < std::min(count, first + kBatch); ++i) {
+                const DbFunction& f = functions[i];
+                size_t avail = 0;
+                const uint8_t* code = image.At(f.start, &avail);
+                uint32_t length = f.end - f.start;
+                if (!code || !length || avail < length) {
+                    continue;
+                }
+                for (const SignatureLibrary* library : libraries) {
+                    names.clear();
+                    library->Find(code, length, &names);
+                    if (names.empty()) {
+                        continue;
+                    }
+                    auto less = [](const char* a, const char* b) { return std::strcmp(a, b) < 0; };
+                    auto same = [](const char* a, const char* b) { return std::strcmp(a, b) == 0; };
+                    std::sort(names.begin(), names.end(), less);
+                    names.erase(std::unique(names.begin(), names.end(), same), names.end());
+                    if (names.size() == 1) {
+                        found[i] = names[0];
+                    } else {
+                        ambiguous[i] = 1;
+                    }
+                    break;
+                }
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < stats->threads; ++i) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    std::vector<DbLabel> labels;
+    std::vector<uint8_t> names;
+    for (size_t i = 0; i < count; ++i) {
+        stats->ambiguous += ambiguous[i];
+        if (!found[i]) {
+            continue;
+        }
+        const DbFunction& f = functions[i];
+        labels.push_back({ f.start, static_cast<uint32_t>(names.size()), f.end - f.start, 0 });
+        names.insert(names.end(), found[i], found[i] + std::strlen(found[i]) + 1);
+        ++stats->matched;
+        stats->bytes += f.end - f.start;
+    }
+    stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    AnalysisDb::Chunk nameChunk;
+    nameChunk.id = kDbChunkLabelNames;
+    nameChunk.data = std::move(names);
+    return { MakeChunk(kDbChunkLabels, labels), std::move(nameChunk) };
+}
+
+bool LabelIndex::Open(const AnalysisDbView& db) {
+    size_t size = 0;
+    size_t nameSize = 0;
+    const DbLabel* labels = static_cast<const DbLabel*>(db.Chunk(kDbChunkLabels, &size));
+    m_names = static_cast<const char*>(db.Chunk(kDbChunkLabelNames, &nameSize));
+    if (!labels || !m_names) {
+        return false;
+    }
+    m_first = labels;
+    m_last = labels + size / sizeof(DbLabel);
+    return std::all_of(m_first, m_last, [nameSize](const DbLabel& l) { return l.name < nameSize; });
+}
+
+const char* LabelIndex::NameAt(uint32_t address) const {
+    const DbLabel* l = std::lower_bound(m_first, m_last, address,
+                                        [](const DbLabel& a, uint32_t v) { return a.address < v; });
+    return l != m_last && l->address == address ? Name(*l) : nullptr;
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2025
+//
+// Signature matching of statically linked library code.
+//
+// A good part of digi.exe is the MSVC C runtime and MFC, linked in
+// from the libraries that shipped with the compiler.  Those functions
+// need no reconstruction, only a name.  A signature library holds the
+// functions of reference object files (a LIBC.LIB or NAFXCW.LIB, or
+// single .obj files): their bytes, with the fields the linker patches
+// masked out, and their names.  MatchSignatures compares every
+// function of an analysis database against it and records a label for
+// each that matches, as extra chunks of the database:
+//
+//     'LABL'  DbLabel, sorted by address
+//     'LNAM'  the NUL-terminated names the labels point into
+//
+// The masked fields differ on the two sides.  In an object file they
+// are the relocations; in digi.exe, whose relocations were stripped,
+// they cannot be told from constants.  So the lookup key is a
+// skeleton hash that ignores every 32-bit displacement and immediate
+// (and every 32-bit branch offset) on both sides, and a hit is then
+// confirmed byte for byte against the reference, which masks only
+// the relocated fields and the branches leaving the function.
+//
+// The signature file is laid out like the database: a header, the
+// entries, an open-addressing table of entry indices keyed by the
+// skeleton hash, and the pattern and name bytes, all of which a
+// SignatureLibrary maps and probes in place.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "analysis_db.h"
+#include "mapped_file.h"
+#include "pe_image.h"
+
+const uint32_t kDbChunkLabels     = DbChunkId('L', 'A', 'B', 'L');
+const uint32_t kDbChunkLabelNames = DbChunkId('L', 'N', 'A', 'M');
+
+struct DbLabel {
+    uint32_t address;           // start of the function
+    uint32_t name;              // offset into 'LNAM'
+    uint32_t length;            // bytes of it the signature covered
+    uint32_t reserved;
+};
+
+// A function read from a reference object file.
+struct SigFunction {
+    std::string          name;  // as decorated in the symbol table
+    std::vector<uint8_t> bytes; // relocated fields zeroed
+    std::vector<uint8_t> fixed; // 1 per byte that must match, 0 per masked byte
+};
+
+// Append the functions of the COFF object or library (ar archive of
+// objects) in `data` to `out`.  Import members and objects for other
+// machines are skipped.  Returns false with `error` set if the file is
+// neither.
+bool ReadObjectFunctions(const uint8_t* data, size_t size, std::vector<SigFunction>* out, std::string* error);
+
+struct SigBuildStats {
+    uint32_t functions = 0;     // read
+    uint32_t signatures = 0;    // written
+    uint32_t duplicates = 0;    // same name and bytes as one already written
+    uint32_t tooShort = 0;      // fewer than kSigMinFixedBytes bytes to compare
+};
+
+// A function with fewer bytes than this left after masking matches too
+// much to be worth a label.
+const uint32_t kSigMinFixedBytes = 12;
+
+// Write the signature library for `functions` to `path`.
+bool WriteSignatureLibrary(const char* path, const std::vector<SigFunction>& functions, SigBuildStats* stats);
+
+// A mapped signature library.
+class SignatureLibrary {
+public:
+    struct Entry;               // the on-disk record, in signatures.cpp
+
+    bool Open(const char* path);
+
+    size_t count() const { return m_count; }
+
+    // Every entry whose bytes match the `length` bytes at `code`,
+    // appended to `names`.
+    void Find(const uint8_t* code, uint32_t length, std::vector<const char*>* names) const;
+
+private:
+    MappedFile      m_file;
+    const Entry*    m_entries = nullptr;
+    size_t          m_count = 0;
+    const uint32_t* m_slots = nullptr;
+    uint32_t        m_slotMask = 0;
+    const uint8_t*  m_patterns = nullptr;
+    size_t          m_patternSize = 0;
+    const char*     m_names = nullptr;
+    size_t          m_nameSize = 0;
+};
+
+struct SigMatchStats {
+    uint32_t functions = 0;     // in the database
+    uint32_t matched = 0;       // labelled
+    uint32_t ambiguous = 0;     // matched several different names, left unlabelled
+    uint32_t bytes = 0;         // covered by the labelled functions
+    unsigned threads = 0;
+    double   seconds = 0.0;
+};
+
+// Look every function of `db` (built from `image`) up in `libraries`,
+// the first library with a hit deciding, on `threads` threads (0 for
+// one per core).  The result goes to UpdateAnalysisDb.
+std::vector<AnalysisDb::Chunk> MatchSignatures(const PeImage& image, const AnalysisDbView& db,
+                                               const std::vector<const SignatureLibrary*>& libraries,
+                                               unsigned threads, SigMatchStats* stats);
+
+// The labels of a database MatchSignatures has been run on.
+class LabelIndex {
+public:
+    // Returns false if `db` has no labels.
+    bool Open(const AnalysisDbView& db);
+
+    const DbLabel* begin() const { return m_first; }
+    const DbLabel* end() const { return m_last; }
+    const char* Name(const DbLabel& label) const { return m_names + label.name; }
+    // The label of the function starting at `address`, or nullptr.
+    const char* NameAt(uint32_t address) const;
+
+private:
+    const DbLabel* m_first = nullptr;
+    const DbLabel* m_last = nullptr;
+    const char*    m_names = nullptr;
+};
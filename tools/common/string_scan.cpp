@@ -0,0 +1,266 @@
+// Copyright (c) 2025
+//
+// Whole-image string scanner.  See string_scan.h.
+
+#include "string_scan.h"
+
+#include <algorithm>
+#include <tuple>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DIGI_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    // A pair of ASCII characters, two Hangul syllables (the xref index
+    // asks for three, but with the lead bytes held to the text rows
+    // two-syllable words such as 굴림 come through clean), two UTF-16
+    // units.
+    const uint32_t kMinAsciiBytes = 2;
+    const uint32_t kMinCp949Bytes = 4;
+    const uint32_t kMinUtf16Bytes = 4;
+
+    bool IsTextByte(uint8_t c) {
+        return (c >= 0x20 && c < 0x7F) || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool IsKsByte(uint8_t c) {
+        return c >= 0xA1 && c <= 0xFE;
+    }
+
+    // Lead bytes of the KS X 1001 rows the game's text uses: symbols,
+    // full-width ASCII and jamo (0xA1-0xA4) and the Hangul syllables
+    // (0xB0-0xC8).  Kana, Greek, box drawing and Hanja turn up only in
+    // binary data.
+    bool IsTextLead(uint8_t c) {
+        return (c >= 0xA1 && c <= 0xA4) || (c >= 0xB0 && c <= 0xC8);
+    }
+
+    bool IsTextUnit(uint16_t u) {
+        return u < 0x80 ? IsTextByte(static_cast<uint8_t>(u)) : u >= 0xAC00 && u <= 0xD7A3;
+    }
+
+    unsigned CountTrailingZeros(uint64_t v) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        if (_BitScanForward(&i, static_cast<uint32_t>(v))) {
+            return i;
+        }
+        _BitScanForward(&i, static_cast<uint32_t>(v >> 32));
+        return 32 + i;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+    }
+
+    // Bit i of each bitmap is byte (or UTF-16 unit) i of a section.
+    struct ClassBits {
+        std::vector<uint64_t> text;
+        std::vector<uint64_t> zero;
+    };
+
+#if DIGI_SCAN_SSE2
+    // Text and zero masks of sixteen bytes.  KS X 1001 bytes (0xA1 to
+    // 0xFE) become the printable range with the top bit flipped, so the
+    // same signed compares serve both.
+    uint32_t ByteMask(__m128i v, uint32_t* zero) {
+        const __m128i low = _mm_set1_epi8(0x1F);
+        const __m128i high = _mm_set1_epi8(0x7F);
+        __m128i text = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+        text = _mm_or_si128(text, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        text = _mm_or_si128(text, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        text = _mm_or_si128(text, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+        __m128i flipped = _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0x80)));
+        text = _mm_or_si128(text, _mm_and_si128(_mm_cmpgt_epi8(flipped, _mm_set1_epi8(0x20)),
+                                                _mm_cmplt_epi8(flipped, high)));
+        *zero = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())));
+        return static_cast<uint32_t>(_mm_movemask_epi8(text));
+    }
+
+    // The same for eight UTF-16 units.  Hangul is tested as an unsigned
+    // range by biasing both sides by 0x8000.
+    uint32_t UnitMask(__m128i u, uint32_t* zero) {
+        const __m128i none = _mm_setzero_si128();
+        __m128i lo = _mm_and_si128(u, _mm_set1_epi16(0xFF));
+        __m128i ascii = _mm_and_si128(_mm_cmpgt_epi16(lo, _mm_set1_epi16(0x1F)), _mm_cmplt_epi16(lo, _mm_set1_epi16(0x7F)));
+        ascii = _mm_or_si128(ascii, _mm_cmpeq_epi16(lo, _mm_set1_epi16('\t')));
+        ascii = _mm_or_si128(ascii, _mm_cmpeq_epi16(lo, _mm_set1_epi16('\n')));
+        ascii = _mm_or_si128(ascii, _mm_cmpeq_epi16(lo, _mm_set1_epi16('\r')));
+        ascii = _mm_and_si128(ascii, _mm_cmpeq_epi16(_mm_srli_epi16(u, 8), none));
+        __m128i offset = _mm_xor_si128(_mm_sub_epi16(u, _mm_set1_epi16(static_cast<short>(0xAC00))),
+                                       _mm_set1_epi16(static_cast<short>(0x8000)));
+        __m128i hangul = _mm_cmplt_epi16(offset, _mm_set1_epi16(static_cast<short>((0xD7A3 - 0xAC00 + 1) ^ 0x8000)));
+        __m128i text = _mm_or_si128(ascii, hangul);
+        *zero = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(_mm_cmpeq_epi16(u, none), none)));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(text, none)));
+    }
+#endif
+
+    void ClassifyBytes(const uint8_t* p, size_t n, ClassBits* bits) {
+        bits->text.assign((n + 63) / 64, 0);
+        bits->zero.assign((n + 63) / 64, 0);
+        size_t i = 0;
+#if DIGI_SCAN_SSE2
+        for (; i + 64 <= n; i += 64) {
+            uint64_t text = 0;
+            uint64_t zero = 0;
+            for (int k = 0; k < 4; ++k) {
+                uint32_t z;
+                uint32_t t = ByteMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + k * 16)), &z);
+                text |= static_cast<uint64_t>(t) << (k * 16);
+                zero |= static_cast<uint64_t>(z) << (k * 16);
+            }
+            bits->text[i / 64] = text;
+            bits->zero[i / 64] = zero;
+        }
+#endif
+        for (; i < n; ++i) {
+            bits->text[i / 64] |= static_cast<uint64_t>(IsTextByte(p[i]) || IsKsByte(p[i])) << (i % 64);
+            bits->zero[i / 64] |= static_cast<uint64_t>(p[i] == 0) << (i % 64);
+        }
+    }
+
+    void ClassifyUnits(const uint8_t* p, size_t units, ClassBits* bits) {
+        bits->text.assign((units + 63) / 64, 0);
+        bits->zero.assign((units + 63) / 64, 0);
+        size_t i = 0;
+#if DIGI_SCAN_SSE2
+        for (; i + 64 <= units; i += 64) {
+            uint64_t text = 0;
+            uint64_t zero = 0;
+            for (int k = 0; k < 8; ++k) {
+                uint32_t z;
+                uint32_t t = UnitMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + (i + k * 8) * 2)), &z);
+                text |= static_cast<uint64_t>(t) << (k * 8);
+                zero |= static_cast<uint64_t>(z) << (k * 8);
+            }
+            bits->text[i / 64] = text;
+            bits->zero[i / 64] = zero;
+        }
+#endif
+        for (; i < units; ++i) {
+            uint16_t u = static_cast<uint16_t>(p[i * 2] | (p[i * 2 + 1] << 8));
+            bits->text[i / 64] |= static_cast<uint64_t>(IsTextUnit(u)) << (i % 64);
+            bits->zero[i / 64] |= static_cast<uint64_t>(u == 0) << (i % 64);
+        }
+    }
+
+    // First bit at or after `from` that is set (or clear) in `words`,
+    // or `count` if there is none before it.
+    size_t NextBit(const std::vector<uint64_t>& words, size_t from, bool set, size_t count) {
+        if (from >= count) {
+            return count;
+        }
+        size_t w = from / 64;
+        uint64_t flip = set ? 0 : ~0ull;
+        uint64_t cur = (words[w] ^ flip) & (~0ull << (from % 64));
+        while (!cur) {
+            if (++w == words.size()) {
+                return count;
+            }
+            cur = words[w] ^ flip;
+        }
+        return std::min(count, w * 64 + CountTrailingZeros(cur));
+    }
+
+    // Every run of text positions followed by a zero position, as
+    // [start, end) in positions.
+    template <typename Emit>
+    void TerminatedRuns(const ClassBits& bits, size_t count, Emit emit) {
+        size_t i = 0;
+        while ((i = NextBit(bits.text, i, true, count)) < count) {
+            size_t end = NextBit(bits.text, i, false, count);
+            if (end < count && ((bits.zero[end / 64] >> (end % 64)) & 1)) {
+                emit(i, end);
+            }
+            i = end + 1;
+        }
+    }
+}
+
+std::vector<ScannedString> ScanStrings(const PeImage& image) {
+    std::vector<ScannedString> bytes;
+    std::vector<ScannedString> units;
+    ClassBits bits;
+    for (const PeSection& section : image.sections()) {
+        size_t avail = 0;
+        const uint8_t* p = image.At(section.va, &avail);
+        if (section.IsCode() || !p) {
+            continue;
+        }
+        size_t n = section.virtualSize ? std::min<size_t>(avail, section.virtualSize) : avail;
+        uint32_t va = section.va;
+        ClassifyBytes(p, n, &bits);
+        TerminatedRuns(bits, n, [&](size_t start, size_t end) {
+            bytes.push_back({ va + static_cast<uint32_t>(start), static_cast<uint32_t>(end - start), kDbStringBytes, 0 });
+        });
+        // Sections are page aligned, so unit i is at an even address.
+        ClassifyUnits(p, n / 2, &bits);
+        TerminatedRuns(bits, n / 2, [&](size_t start, size_t end) {
+            units.push_back({ va + static_cast<uint32_t>(start * 2), static_cast<uint32_t>((end - start) * 2),
+                              kDbStringUtf16, 0 });
+        });
+    }
+    bytes.insert(bytes.end(), units.begin(), units.end());
+    return bytes;
+}
+
+bool IsPlausibleString(const PeImage& image, const ScannedString& s) {
+    size_t avail = 0;
+    const uint8_t* p = image.At(s.va, &avail);
+    if (!p || avail <= s.length) {
+        return false;
+    }
+    // Floats and pointers to the image often pass for two or three
+    // characters; a pointer is never a string.
+    uint32_t dword = 0;
+    if (image.ReadU32(s.va, &dword) && dword - image.imageBase() < image.sizeOfImage()) {
+        return false;
+    }
+    if (s.encoding == kDbStringUtf16) {
+        return s.length >= kMinUtf16Bytes && s.va % 2 == 0 && s.length % 2 == 0;
+    }
+    bool ascii = true;
+    for (uint32_t i = 0; i < s.length;) {
+        if (IsTextByte(p[i])) {
+            ++i;
+        } else if (IsTextLead(p[i]) && i + 1 < s.length && IsKsByte(p[i + 1])) {
+            ascii = false;
+            i += 2;
+        } else {
+            return false;
+        }
+    }
+    return s.length >= (ascii ? kMinAsciiBytes : kMinCp949Bytes);
+}
+
+std::vector<ScannedString> ReferencedStrings(const PeImage& image, const XrefIndex& index,
+                                             const std::vector<ScannedString>& runs) {
+    std::vector<ScannedString> found;
+    for (const ScannedString& run : runs) {
+        DbRange<DbXref> refs = index.RefsTo(run.va, run.va + run.length);
+        for (const DbXref* x = refs.begin(); x != refs.end();) {
+            // The references come sorted by target, so each address is
+            // taken once with all its references counted.
+            ScannedString s = { x->to, run.va + run.length - x->to, run.encoding, 0 };
+            for (; x != refs.end() && x->to == s.va; ++x) {
+                s.refs += x->kind == kDbXrefMemory || x->kind == kDbXrefOffset;
+            }
+            if (s.refs && IsPlausibleString(image, s)) {
+                found.push_back(s);
+            }
+        }
+    }
+    // Bytes first at each address, then keep only the first.
+    std::sort(found.begin(), found.end(), [](const ScannedString& a, const ScannedString& b) {
+        return std::tie(a.va, a.encoding) < std::tie(b.va, b.encoding);
+    });
+    found.erase(std::unique(found.begin(), found.end(),
+                            [](const ScannedString& a, const ScannedString& b) { return a.va == b.va; }),
+                found.end());
+    return found;
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2025
+//
+// Whole-image string scanner.
+//
+// extracted_strings.txt came from running a generic strings utility
+// over digi.exe and is mostly floats, pointers and packed records that
+// happen to decode as text.  ScanStrings instead classifies every byte
+// of the data sections sixteen at a time with SSE2 compares into
+// bitmaps (ASCII text, KS X 1001 bytes, zero; and per UTF-16 unit,
+// ASCII or precomposed Hangul, zero), then walks the bitmaps for runs
+// of text that end in a terminator.  The whole image takes a couple of
+// milliseconds.
+//
+// A run is only a candidate: the game's text is the part of it code
+// actually points at.  ReferencedStrings keeps, for every address a
+// code reference in the xref index lands on inside a run, the string
+// from there to the terminator, provided it passes the tests the index
+// applies to its string references (a minimum length, not a pointer)
+// and one more: double-byte characters must pair up and come from the
+// Hangul and symbol rows.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pe_image.h"
+#include "xref_index.h"
+
+struct ScannedString {
+    uint32_t va;                // first character
+    uint32_t length;            // in bytes, terminator excluded
+    uint32_t encoding;          // DbStringEncoding
+    uint32_t refs;              // code references to `va`; 0 from ScanStrings
+};
+
+// Every NUL-terminated run of text bytes and every terminated run of
+// text UTF-16 units (at even addresses) in the non-code sections of
+// `image`, by encoding and then address.  The runs are raw: a byte run
+// may hold unpaired KS X 1001 bytes, and nothing is dropped for being
+// short.
+std::vector<ScannedString> ScanStrings(const PeImage& image);
+
+// The strings the code of `index` refers to inside `runs` (as returned
+// by ScanStrings), sorted by address, each once.  Where an address
+// reads as both, CP949 wins over UTF-16: two CP949 syllables whose
+// trail bytes fall in 0xAC-0xD7 also make one UTF-16 Hangul syllable,
+// and the game keeps nearly all its text as CP949.
+std::vector<ScannedString> ReferencedStrings(const PeImage& image, const XrefIndex& index,
+                                             const std::vector<ScannedString>& runs);
+
+// Whether the string `s` is text by itself (the tests ReferencedStrings
+// applies, without the reference).
+bool IsPlausibleString(const PeImage& image, const ScannedString& s);
@@ -0,0 +1,1369 @@
+// Copyright (c) 2025
+//
+// 32-bit x86 decoder.  See x86_decode.h.
+//
+// Each opcode map is a 256-entry table of {mnemonic, operand specs,
+// flags}, filled in once by Tables' constructor.  Operand specs follow
+// the letters of the Intel opcode tables (Eb, Gv, Iz, Jb, ...), so
+// entries can be checked against the manual line by line.  Opcodes
+// whose meaning depends on ModRM.reg point at a group table; SSE
+// opcodes whose meaning depends on a 66/F3/F2 prefix point at a
+// four-way variant table; x87 and 3DNow! have their own decoders.
+
+#include "x86_decode.h"
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+    // Operand specs.
+    enum Spec : uint8_t {
+        __,
+        Eb, Ew, Ed, Ev, Ep, M, Mb, Mw, Md, Mq, Mt, Mx,
+        Gb, Gw, Gd, Gv,
+        Ib, Ibs, Iw, Iz,
+        Jb, Jz,
+        AL_, CL_, DX_, eAX, I1,
+        Zb, Zv, Zd,
+        Sw,
+        Ob, Ov,
+        Xb, Xv, Yb, Yv,         // string operands, ds:[esi] and es:[edi]
+        Ap,
+        ES_, CS_, SS_, DS_, FS_, GS_,
+        Pq, Qq, Qd, Nq,
+        Vx, Wx, Wq, Wd, Ux,
+        Cd, Dd, Rd,
+        ST0, STi,
+    };
+
+    enum Flags : uint8_t {
+        kModrm   = 0x01,
+        kPrefix  = 0x02,
+        kCond    = 0x04,    // mnemonic is a stem; append the condition
+        kSizeAlt = 0x08,    // "16-bit/32-bit" mnemonic pair
+        kGroup   = 0x10,
+        kSse     = 0x20,    // prefix-selected variant table
+        kMmx     = 0x40,    // MMX operands widen to XMM under 66
+        kValid   = 0x80,
+    };
+
+    struct Op {
+        const char* name;
+        const char* alt;            // kSizeAlt: the 16-bit form, `name` the 32-bit one
+        uint8_t     spec[3];
+        uint8_t     flags;
+        uint8_t     group;
+    };
+
+    enum Group : uint8_t {
+        kG1, kG1A, kG2, kG3b, kG3v, kG4, kG5, kG11,
+        kG6, kG7, kG8, kG9, kG12, kG13, kG14, kG15, kG16, kGPrefetch,
+        kGroupCount,
+    };
+
+    const char* const kConditions[16] = {
+        "o", "no", "b", "ae", "e", "ne", "be", "a", "s", "ns", "p", "np", "l", "ge", "le", "g",
+    };
+
+    // 3DNow! suffixes.
+    struct Now3D {
+        uint8_t     suffix;
+        const char* name;
+    };
+    const Now3D k3DNow[] = {
+        { 0x0C, "pi2fw" }, { 0x0D, "pi2fd" }, { 0x1C, "pf2iw" }, { 0x1D, "pf2id" },
+        { 0x8A, "pfnacc" }, { 0x8E, "pfpnacc" }, { 0x90, "pfcmpge" }, { 0x94, "pfmin" },
+        { 0x96, "pfrcp" }, { 0x97, "pfrsqrt" }, { 0x9A, "pfsub" }, { 0x9E, "pfadd" },
+        { 0xA0, "pfcmpgt" }, { 0xA4, "pfmax" }, { 0xA6, "pfrcpit1" }, { 0xA7, "pfrsqit1" },
+        { 0xAA, "pfsubr" }, { 0xAE, "pfacc" }, { 0xB0, "pfcmpeq" }, { 0xB4, "pfmul" },
+        { 0xB6, "pfrcpit2" }, { 0xB7, "pmulhrw" }, { 0xBB, "pswapd" }, { 0xBF, "pavgusb" },
+    };
+
+    // x87 memory forms, [opcode - 0xD8][reg], with operand sizes.
+    struct FpuMem {
+        const char* name;
+        uint8_t     size;
+    };
+    const FpuMem kFpuMem[8][8] = {
+        { {"fadd",4}, {"fmul",4}, {"fcom",4}, {"fcomp",4}, {"fsub",4}, {"fsubr",4}, {"fdiv",4}, {"fdivr",4} },
+        { {"fld",4}, {nullptr,0}, {"fst",4}, {"fstp",4}, {"fldenv",0}, {"fldcw",2}, {"fnstenv",0}, {"fnstcw",2} },
+        { {"fiadd",4}, {"fimul",4}, {"ficom",4}, {"ficomp",4}, {"fisub",4}, {"fisubr",4}, {"fidiv",4}, {"fidivr",4} },
+        { {"fild",4}, {"fisttp",4}, {"fist",4}, {"fistp",4}, {nullptr,0}, {"fld",10}, {nullptr,0}, {"fstp",10} },
+        { {"fadd",8}, {"fmul",8}, {"fcom",8}, {"fcomp",8}, {"fsub",8}, {"fsubr",8}, {"fdiv",8}, {"fdivr",8} },
+        { {"fld",8}, {"fisttp",8}, {"fst",8}, {"fstp",8}, {"frstor",0}, {nullptr,0}, {"fnsave",0}, {"fnstsw",2} },
+        { {"fiadd",2}, {"fimul",2}, {"ficom",2}, {"ficomp",2}, {"fisub",2}, {"fisubr",2}, {"fidiv",2}, {"fidivr",2} },
+        { {"fild",2}, {"fisttp",2}, {"fist",2}, {"fistp",2}, {"fbld",10}, {"fild",8}, {"fbstp",10}, {"fistp",8} },
+    };
+
+    // x87 register forms taking st(i), [opcode - 0xD8][reg]; the
+    // operand order is given by kFpuRegOrder.
+    const char* const kFpuReg[8][8] = {
+        { "fadd", "fmul", "fcom", "fcomp", "fsub", "fsubr", "fdiv", "fdivr" },
+        { "fld", "fxch", nullptr, "fstp1", nullptr, nullptr, nullptr, nullptr },
+        { "fcmovb", "fcmove", "fcmovbe", "fcmovu", nullptr, nullptr, nullptr, nullptr },
+        { "fcmovnb", "fcmovne", "fcmovnbe", "fcmovnu", nullptr, "fucomi", "fcomi", nullptr },
+        { "fadd", "fmul", "fcom2", "fcomp3", "fsubr", "fsub", "fdivr", "fdiv" },
+        { "ffree", "fxch4", "fst", "fstp", "fucom", "fucomp", nullptr, nullptr },
+        { "faddp", "fmulp", "fcomp5", nullptr, "fsubrp", "fsubp", "fdivrp", "fdivp" },
+        { "ffreep", "fxch7", "fstp8", "fstp9", nullptr, "fucomip", "fcomip", nullptr },
+    };
+    // 0: st(0), st(i)   1: st(i), st(0)   2: st(i) alone, the st(0)
+    // side implied, as digi_disasm.asm prints D8 and DE forms
+    const uint8_t kFpuRegOrder[8][8] = {
+        { 2, 2, 2, 2, 2, 2, 2, 2 },
+        { 2, 2, 0, 2, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 0, 0, 0 },
+        { 1, 1, 2, 2, 1, 1, 1, 1 },
+        { 2, 2, 2, 2, 2, 2, 0, 0 },
+        { 2, 2, 2, 2, 2, 2, 2, 2 },
+        { 2, 2, 2, 2, 0, 0, 0, 0 },
+    };
+
+    // D9 E0-FF and friends: no operands.
+    struct FpuNullary {
+        uint8_t     opcode;
+        uint8_t     modrm;
+        const char* name;
+    };
+    const FpuNullary kFpuNullary[] = {
+        { 0xD9, 0xD0, "fnop" }, { 0xD9, 0xE0, "fchs" }, { 0xD9, 0xE1, "fabs" }, { 0xD9, 0xE4, "ftst" },
+        { 0xD9, 0xE5, "fxam" }, { 0xD9, 0xE8, "fld1" }, { 0xD9, 0xE9, "fldl2t" }, { 0xD9, 0xEA, "fldl2e" },
+        { 0xD9, 0xEB, "fldpi" }, { 0xD9, 0xEC, "fldlg2" }, { 0xD9, 0xED, "fldln2" }, { 0xD9, 0xEE, "fldz" },
+        { 0xD9, 0xF0, "f2xm1" }, { 0xD9, 0xF1, "fyl2x" }, { 0xD9, 0xF2, "fptan" }, { 0xD9, 0xF3, "fpatan" },
+        { 0xD9, 0xF4, "fxtract" }, { 0xD9, 0xF5, "fprem1" }, { 0xD9, 0xF6, "fdecstp" }, { 0xD9, 0xF7, "fincstp" },
+        { 0xD9, 0xF8, "fprem" }, { 0xD9, 0xF9, "fyl2xp1" }, { 0xD9, 0xFA, "fsqrt" }, { 0xD9, 0xFB, "fsincos" },
+        { 0xD9, 0xFC, "frndint" }, { 0xD9, 0xFD, "fscale" }, { 0xD9, 0xFE, "fsin" }, { 0xD9, 0xFF, "fcos" },
+        { 0xDA, 0xE9, "fucompp" }, { 0xDB, 0xE2, "fnclex" }, { 0xDB, 0xE3, "fninit" },
+        { 0xDE, 0xD9, "fcompp" }, { 0xDF, 0xE0, "fnstsw" },
+    };
+
+    struct Tables {
+        Op one[256];
+        Op two[256];
+        Op sse[256][4];             // none, 66, F3, F2
+        Op groups[kGroupCount][8];
+        char altNames[256][16];     // storage for the split kSizeAlt names
+
+        Tables() {
+            std::memset(this, 0, sizeof(*this));
+            BuildOneByte();
+            BuildTwoByte();
+            BuildGroups();
+        }
+
+        static Op Make(const char* name, uint8_t a, uint8_t b, uint8_t c, uint8_t flags, uint8_t group = 0) {
+            Op op;
+            op.name = name;
+            op.alt = nullptr;
+            op.spec[0] = a;
+            op.spec[1] = b;
+            op.spec[2] = c;
+            op.flags = static_cast<uint8_t>(flags | kValid);
+            op.group = group;
+            return op;
+        }
+
+        void One(int code, const char* name, uint8_t a = __, uint8_t b = __, uint8_t c = __, uint8_t flags = 0) {
+            bool modrm = false;
+            for (uint8_t s : { a, b, c }) {
+                modrm |= (s >= Eb && s <= Gv) || (s >= Sw && s <= Sw) || (s >= Pq && s <= Rd);
+            }
+            one[code] = Make(name, a, b, c, static_cast<uint8_t>(flags | (modrm ? kModrm : 0)));
+            if (flags & kSizeAlt) {
+                // "16-bit/32-bit" pair, split once here so decoding
+                // only has to pick one.
+                const char* slash = std::strchr(name, '/');
+                size_t n = static_cast<size_t>(slash - name);
+                std::memcpy(altNames[code], name, n);
+                altNames[code][n] = '\0';
+                one[code].alt = altNames[code];
+                one[code].name = slash + 1;
+            }
+        }
+
+        void Two(int code, const char* name, uint8_t a = __, uint8_t b = __, uint8_t c = __, uint8_t flags = 0) {
+            bool modrm = false;
+            for (uint8_t s : { a, b, c }) {
+                modrm |= (s >= Eb && s <= Gv) || (s >= Pq && s <= Rd);
+            }
+            two[code] = Make(name, a, b, c, static_cast<uint8_t>(flags | (modrm ? kModrm : 0)));
+        }
+
+        void Grp(Op* table, int code, uint8_t group, uint8_t a = __, uint8_t b = __, uint8_t c = __) {
+            table[code] = Make(nullptr, a, b, c, kModrm | kGroup, group);
+        }
+
+        // An SSE opcode: `v` is {name, spec, spec, spec} per prefix.
+        void Sse(int code, int variant, const char* name, uint8_t a, uint8_t b, uint8_t c = __) {
+            sse[code][variant] = Make(name, a, b, c, kModrm);
+            two[code] = Make(nullptr, __, __, __, kModrm | kSse);
+        }
+
+        void Mmx(int code, const char* name, uint8_t a, uint8_t b, uint8_t c = __) {
+            two[code] = Make(name, a, b, c, kModrm | kMmx);
+        }
+
+        void Alu(int base, const char* name) {
+            One(base + 0, name, Eb, Gb);
+            One(base + 1, name, Ev, Gv);
+            One(base + 2, name, Gb, Eb);
+            One(base + 3, name, Gv, Ev);
+            One(base + 4, name, AL_, Ib);
+            One(base + 5, name, eAX, Iz);
+        }
+
+        void BuildOneByte() {
+            Alu(0x00, "add");
+            One(0x06, "push", ES_);
+            One(0x07, "pop", ES_);
+            Alu(0x08, "or");
+            One(0x0E, "push", CS_);
+            Alu(0x10, "adc");
+            One(0x16, "push", SS_);
+            One(0x17, "pop", SS_);
+            Alu(0x18, "sbb");
+            One(0x1E, "push", DS_);
+            One(0x1F, "pop", DS_);
+            Alu(0x20, "and");
+            One(0x27, "daa");
+            Alu(0x28, "sub");
+            One(0x2F, "das");
+            Alu(0x30, "xor");
+            One(0x37, "aaa");
+            Alu(0x38, "cmp");
+            One(0x3F, "aas");
+            for (int r = 0; r < 8; ++r) {
+                One(0x40 + r, "inc", Zv);
+                One(0x48 + r, "dec", Zv);
+                One(0x50 + r, "push", Zv);
+                One(0x58 + r, "pop", Zv);
+                One(0x90 + r, "xchg", Zv, eAX);
+                One(0xB0 + r, "mov", Zb, Ib);
+                One(0xB8 + r, "mov", Zv, Iz);
+            }
+            One(0x90, "nop");
+            One(0x60, "pushaw/pushal", __, __, __, kSizeAlt);
+            One(0x61, "popaw/popal", __, __, __, kSizeAlt);
+            One(0x62, "bound", Gv, Mq);
+            One(0x63, "arpl", Ew, Gw);
+            One(0x68, "push", Iz);
+            One(0x69, "imul", Gv, Ev, Iz);
+            One(0x6A, "push", Ibs);
+            One(0x6B, "imul", Gv, Ev, Ibs);
+            One(0x6C, "insb", Yb, DX_);
+            One(0x6D, "insw/insd", Yv, DX_, __, kSizeAlt);
+            One(0x6E, "outsb", DX_, Xb);
+            One(0x6F, "outsw/outsd", DX_, Xv, __, kSizeAlt);
+            for (int c = 0; c < 16; ++c) {
+                One(0x70 + c, "j", Jb, __, __, kCond);
+            }
+            Grp(one, 0x80, kG1, Eb, Ib);
+            Grp(one, 0x81, kG1, Ev, Iz);
+            Grp(one, 0x82, kG1, Eb, Ib);
+            Grp(one, 0x83, kG1, Ev, Ibs);
+            One(0x84, "test", Eb, Gb);
+            One(0x85, "test", Ev, Gv);
+            One(0x86, "xchg", Eb, Gb);
+            One(0x87, "xchg", Ev, Gv);
+            One(0x88, "mov", Eb, Gb);
+            One(0x89, "mov", Ev, Gv);
+            One(0x8A, "mov", Gb, Eb);
+            One(0x8B, "mov", Gv, Ev);
+            One(0x8C, "mov", Ew, Sw);
+            One(0x8D, "lea", Gv, M);
+            One(0x8E, "mov", Sw, Ew);
+            Grp(one, 0x8F, kG1A, Ev);
+            One(0x98, "cbw/cwde", __, __, __, kSizeAlt);
+            One(0x99, "cwd/cdq", __, __, __, kSizeAlt);
+            One(0x9A, "lcall", Ap);
+            One(0x9B, "wait");
+            One(0x9C, "pushfw/pushfd", __, __, __, kSizeAlt);
+            One(0x9D, "popfw/popfd", __, __, __, kSizeAlt);
+            One(0x9E, "sahf");
+            One(0x9F, "lahf");
+            One(0xA0, "mov", AL_, Ob);
+            One(0xA1, "mov", eAX, Ov);
+            One(0xA2, "mov", Ob, AL_);
+            One(0xA3, "mov", Ov, eAX);
+            One(0xA4, "movsb", Yb, Xb);
+            One(0xA5, "movsw/movsd", Yv, Xv, __, kSizeAlt);
+            One(0xA6, "cmpsb", Xb, Yb);
+            One(0xA7, "cmpsw/cmpsd", Xv, Yv, __, kSizeAlt);
+            One(0xA8, "test", AL_, Ib);
+            One(0xA9, "test", eAX, Iz);
+            One(0xAA, "stosb", Yb, AL_);
+            One(0xAB, "stosw/stosd", Yv, eAX, __, kSizeAlt);
+            One(0xAC, "lodsb", AL_, Xb);
+            One(0xAD, "lodsw/lodsd", eAX, Xv, __, kSizeAlt);
+            One(0xAE, "scasb", AL_, Yb);
+            One(0xAF, "scasw/scasd", eAX, Yv, __, kSizeAlt);
+            Grp(one, 0xC0, kG2, Eb, Ib);
+            Grp(one, 0xC1, kG2, Ev, Ib);
+            One(0xC2, "ret", Iw);
+            One(0xC3, "ret");
+            One(0xC4, "les", Gv, Ep);
+            One(0xC5, "lds", Gv, Ep);
+            Grp(one, 0xC6, kG11, Eb, Ib);
+            Grp(one, 0xC7, kG11, Ev, Iz);
+            One(0xC8, "enter", Iw, Ib);
+            One(0xC9, "leave");
+            One(0xCA, "retf", Iw);
+            One(0xCB, "retf");
+            One(0xCC, "int3");
+            One(0xCD, "int", Ib);
+            One(0xCE, "into");
+            One(0xCF, "iretw/iretd", __, __, __, kSizeAlt);
+            Grp(one, 0xD0, kG2, Eb, I1);
+            Grp(one, 0xD1, kG2, Ev, I1);
+            Grp(one, 0xD2, kG2, Eb, CL_);
+            Grp(one, 0xD3, kG2, Ev, CL_);
+            One(0xD4, "aam", Ib);
+            One(0xD5, "aad", Ib);
+            One(0xD6, "salc");
+            One(0xD7, "xlatb");
+            for (int x = 0xD8; x <= 0xDF; ++x) {
+                one[x] = Make("fpu", __, __, __, kModrm);
+            }
+            One(0xE0, "loopne", Jb);
+            One(0xE1, "loope", Jb);
+            One(0xE2, "loop", Jb);
+            One(0xE3, "jecxz", Jb);
+            One(0xE4, "in", AL_, Ib);
+            One(0xE5, "in", eAX, Ib);
+            One(0xE6, "out", Ib, AL_);
+            One(0xE7, "out", Ib, eAX);
+            One(0xE8, "call", Jz);
+            One(0xE9, "jmp", Jz);
+            One(0xEA, "ljmp", Ap);
+            One(0xEB, "jmp", Jb);
+            One(0xEC, "in", AL_, DX_);
+            One(0xED, "in", eAX, DX_);
+            One(0xEE, "out", DX_, AL_);
+            One(0xEF, "out", DX_, eAX);
+            One(0xF1, "int1");
+            One(0xF4, "hlt");
+            One(0xF5, "cmc");
+            Grp(one, 0xF6, kG3b, Eb);
+            Grp(one, 0xF7, kG3v, Ev);
+            One(0xF8, "clc");
+            One(0xF9, "stc");
+            One(0xFA, "cli");
+            One(0xFB, "sti");
+            One(0xFC, "cld");
+            One(0xFD, "std");
+            Grp(one, 0xFE, kG4, Eb);
+            Grp(one, 0xFF, kG5, Ev);
+            for (int p : { 0x26, 0x2E, 0x36, 0x3E, 0x64, 0x65, 0x66, 0x67, 0xF0, 0xF2, 0xF3 }) {
+                one[p] = Make(nullptr, __, __, __, kPrefix);
+            }
+            one[0x0F] = Make(nullptr, __, __, __, kPrefix);
+        }
+
+        void SsePacked(int code, const char* ps, const char* pd, const char* ss, const char* sd) {
+            Sse(code, 0, ps, Vx, Wx);
+            if (pd) {
+                Sse(code, 1, pd, Vx, Wx);
+            }
+            if (ss) {
+                Sse(code, 2, ss, Vx, Wd);
+            }
+            if (sd) {
+                Sse(code, 3, sd, Vx, Wq);
+            }
+        }
+
+        void BuildTwoByte() {
+            Grp(two, 0x00, kG6, Ew);
+            Grp(two, 0x01, kG7, M);
+            Two(0x02, "lar", Gv, Ew);
+            Two(0x03, "lsl", Gv, Ew);
+            Two(0x06, "clts");
+            Two(0x08, "invd");
+            Two(0x09, "wbinvd");
+            Two(0x0B, "ud2");
+            Grp(two, 0x0D, kGPrefetch, Mb);
+            Two(0x0E, "femms");
+            two[0x0F] = Make("3dnow", Pq, Qq, __, kModrm);
+
+            Sse(0x10, 0, "movups", Vx, Wx);
+            Sse(0x10, 1, "movupd", Vx, Wx);
+            Sse(0x10, 2, "movss", Vx, Wd);
+            Sse(0x10, 3, "movsd", Vx, Wq);
+            Sse(0x11, 0, "movups", Wx, Vx);
+            Sse(0x11, 1, "movupd", Wx, Vx);
+            Sse(0x11, 2, "movss", Wd, Vx);
+            Sse(0x11, 3, "movsd", Wq, Vx);
+            Sse(0x12, 0, "movlps", Vx, Wq);     // movhlps when the source is a register
+            Sse(0x12, 1, "movlpd", Vx, Mq);
+            Sse(0x13, 0, "movlps", Mq, Vx);
+            Sse(0x13, 1, "movlpd", Mq, Vx);
+            Sse(0x14, 0, "unpcklps", Vx, Wx);
+            Sse(0x14, 1, "unpcklpd", Vx, Wx);
+            Sse(0x15, 0, "unpckhps", Vx, Wx);
+            Sse(0x15, 1, "unpckhpd", Vx, Wx);
+            Sse(0x16, 0, "movhps", Vx, Wq);     // movlhps when the source is a register
+            Sse(0x16, 1, "movhpd", Vx, Mq);
+            Sse(0x17, 0, "movhps", Mq, Vx);
+            Sse(0x17, 1, "movhpd", Mq, Vx);
+            Grp(two, 0x18, kG16, Mb);
+            for (int x = 0x19; x <= 0x1F; ++x) {
+                Two(x, "nop", Ev);
+            }
+            Two(0x20, "mov", Rd, Cd);
+            Two(0x21, "mov", Rd, Dd);
+            Two(0x22, "mov", Cd, Rd);
+            Two(0x23, "mov", Dd, Rd);
+            Sse(0x28, 0, "movaps", Vx, Wx);
+            Sse(0x28, 1, "movapd", Vx, Wx);
+            Sse(0x29, 0, "movaps", Wx, Vx);
+            Sse(0x29, 1, "movapd", Wx, Vx);
+            Sse(0x2A, 0, "cvtpi2ps", Vx, Qq);
+            Sse(0x2A, 1, "cvtpi2pd", Vx, Qq);
+            Sse(0x2A, 2, "cvtsi2ss", Vx, Ed);
+            Sse(0x2A, 3, "cvtsi2sd", Vx, Ed);
+            Sse(0x2B, 0, "movntps", Mx, Vx);
+            Sse(0x2B, 1, "movntpd", Mx, Vx);
+            Sse(0x2C, 0, "cvttps2pi", Pq, Wq);
+            Sse(0x2C, 1, "cvttpd2pi", Pq, Wx);
+            Sse(0x2C, 2, "cvttss2si", Gd, Wd);
+            Sse(0x2C, 3, "cvttsd2si", Gd, Wq);
+            Sse(0x2D, 0, "cvtps2pi", Pq, Wq);
+            Sse(0x2D, 1, "cvtpd2pi", Pq, Wx);
+            Sse(0x2D, 2, "cvtss2si", Gd, Wd);
+            Sse(0x2D, 3, "cvtsd2si", Gd, Wq);
+            Sse(0x2E, 0, "ucomiss", Vx, Wd);
+            Sse(0x2E, 1, "ucomisd", Vx, Wq);
+            Sse(0x2F, 0, "comiss", Vx, Wd);
+            Sse(0x2F, 1, "comisd", Vx, Wq);
+            Two(0x30, "wrmsr");
+            Two(0x31, "rdtsc");
+            Two(0x32, "rdmsr");
+            Two(0x33, "rdpmc");
+            Two(0x34, "sysenter");
+            Two(0x35, "sysexit");
+            for (int c = 0; c < 16; ++c) {
+                Two(0x40 + c, "cmov", Gv, Ev, __, kCond);
+                Two(0x80 + c, "j", Jz, __, __, kCond);
+                Two(0x90 + c, "set", Eb, __, __, kCond);
+            }
+            Sse(0x50, 0, "movmskps", Gd, Ux);
+            Sse(0x50, 1, "movmskpd", Gd, Ux);
+            SsePacked(0x51, "sqrtps", "sqrtpd", "sqrtss", "sqrtsd");
+            SsePacked(0x52, "rsqrtps", nullptr, "rsqrtss", nullptr);
+            SsePacked(0x53, "rcpps", nullptr, "rcpss", nullptr);
+            SsePacked(0x54, "andps", "andpd", nullptr, nullptr);
+            SsePacked(0x55, "andnps", "andnpd", nullptr, nullptr);
+            SsePacked(0x56, "orps", "orpd", nullptr, nullptr);
+            SsePacked(0x57, "xorps", "xorpd", nullptr, nullptr);
+            SsePacked(0x58, "addps", "addpd", "addss", "addsd");
+            SsePacked(0x59, "mulps", "mulpd", "mulss", "mulsd");
+            Sse(0x5A, 0, "cvtps2pd", Vx, Wq);
+            Sse(0x5A, 1, "cvtpd2ps", Vx, Wx);
+            Sse(0x5A, 2, "cvtss2sd", Vx, Wd);
+            Sse(0x5A, 3, "cvtsd2ss", Vx, Wq);
+            Sse(0x5B, 0, "cvtdq2ps", Vx, Wx);
+            Sse(0x5B, 1, "cvtps2dq", Vx, Wx);
+            Sse(0x5B, 2, "cvttps2dq", Vx, Wx);
+            SsePacked(0x5C, "subps", "subpd", "subss", "subsd");
+            SsePacked(0x5D, "minps", "minpd", "minss", "minsd");
+            SsePacked(0x5E, "divps", "divpd", "divss", "divsd");
+            SsePacked(0x5F, "maxps", "maxpd", "maxss", "maxsd");
+
+            const char* const unpack[] = {
+                "punpcklbw", "punpcklwd", "punpckldq", "packsswb", "pcmpgtb", "pcmpgtw", "pcmpgtd", "packuswb",
+                "punpckhbw", "punpckhwd", "punpckhdq", "packssdw",
+            };
+            for (int i = 0; i < 12; ++i) {
+                Mmx(0x60 + i, unpack[i], Pq, i < 3 ? Qd : Qq);
+            }
+            Sse(0x6C, 1, "punpcklqdq", Vx, Wx);
+            Sse(0x6D, 1, "punpckhqdq", Vx, Wx);
+            Sse(0x6E, 0, "movd", Pq, Ed);
+            Sse(0x6E, 1, "movd", Vx, Ed);
+            Sse(0x6F, 0, "movq", Pq, Qq);
+            Sse(0x6F, 1, "movdqa", Vx, Wx);
+            Sse(0x6F, 2, "movdqu", Vx, Wx);
+            Sse(0x70, 0, "pshufw", Pq, Qq, Ib);
+            Sse(0x70, 1, "pshufd", Vx, Wx, Ib);
+            Sse(0x70, 2, "pshufhw", Vx, Wx, Ib);
+            Sse(0x70, 3, "pshuflw", Vx, Wx, Ib);
+            Grp(two, 0x71, kG12, Nq, Ib);
+            Grp(two, 0x72, kG13, Nq, Ib);
+            Grp(two, 0x73, kG14, Nq, Ib);
+            two[0x71].flags |= kMmx;
+            two[0x72].flags |= kMmx;
+            two[0x73].flags |= kMmx;
+            Mmx(0x74, "pcmpeqb", Pq, Qq);
+            Mmx(0x75, "pcmpeqw", Pq, Qq);
+            Mmx(0x76, "pcmpeqd", Pq, Qq);
+            Two(0x77, "emms");
+            Sse(0x7E, 0, "movd", Ed, Pq);
+            Sse(0x7E, 1, "movd", Ed, Vx);
+            Sse(0x7E, 2, "movq", Vx, Wq);
+            Sse(0x7F, 0, "movq", Qq, Pq);
+            Sse(0x7F, 1, "movdqa", Wx, Vx);
+            Sse(0x7F, 2, "movdqu", Wx, Vx);
+
+            Two(0xA0, "push", FS_);
+            Two(0xA1, "pop", FS_);
+            Two(0xA2, "cpuid");
+            Two(0xA3, "bt", Ev, Gv);
+            Two(0xA4, "shld", Ev, Gv, Ib);
+            Two(0xA5, "shld", Ev, Gv, CL_);
+            Two(0xA8, "push", GS_);
+            Two(0xA9, "pop", GS_);
+            Two(0xAA, "rsm");
+            Two(0xAB, "bts", Ev, Gv);
+            Two(0xAC, "shrd", Ev, Gv, Ib);
+            Two(0xAD, "shrd", Ev, Gv, CL_);
+            Grp(two, 0xAE, kG15, M);
+            Two(0xAF, "imul", Gv, Ev);
+            Two(0xB0, "cmpxchg", Eb, Gb);
+            Two(0xB1, "cmpxchg", Ev, Gv);
+            Two(0xB2, "lss", Gv, Ep);
+            Two(0xB3, "btr", Ev, Gv);
+            Two(0xB4, "lfs", Gv, Ep);
+            Two(0xB5, "lgs", Gv, Ep);
+            Two(0xB6, "movzx", Gv, Eb);
+            Two(0xB7, "movzx", Gv, Ew);
+            Two(0xB9, "ud1", Gv, Ev);
+            Grp(two, 0xBA, kG8, Ev, Ib);
+            Two(0xBB, "btc", Ev, Gv);
+            Two(0xBC, "bsf", Gv, Ev);
+            Two(0xBD, "bsr", Gv, Ev);
+            Two(0xBE, "movsx", Gv, Eb);
+            Two(0xBF, "movsx", Gv, Ew);
+            Two(0xC0, "xadd", Eb, Gb);
+            Two(0xC1, "xadd", Ev, Gv);
+            Sse(0xC2, 0, "cmpps", Vx, Wx, Ib);
+            Sse(0xC2, 1, "cmppd", Vx, Wx, Ib);
+            Sse(0xC2, 2, "cmpss", Vx, Wd, Ib);
+            Sse(0xC2, 3, "cmpsd", Vx, Wq, Ib);
+            Two(0xC3, "movnti", Md, Gd);
+            Sse(0xC4, 0, "pinsrw", Pq, Ed, Ib);
+            Sse(0xC4, 1, "pinsrw", Vx, Ed, Ib);
+            Sse(0xC5, 0, "pextrw", Gd, Nq, Ib);
+            Sse(0xC5, 1, "pextrw", Gd, Ux, Ib);
+            Sse(0xC6, 0, "shufps", Vx, Wx, Ib);
+            Sse(0xC6, 1, "shufpd", Vx, Wx, Ib);
+            Grp(two, 0xC7, kG9, Mq);
+            for (int r = 0; r < 8; ++r) {
+                Two(0xC8 + r, "bswap", Zd);
+            }
+
+            const char* const mmx[48] = {
+                nullptr, "psrlw", "psrld", "psrlq", "paddq", "pmullw", nullptr, nullptr,
+                "psubusb", "psubusw", "pminub", "pand", "paddusb", "paddusw", "pmaxub", "pandn",
+                "pavgb", "psraw", "psrad", "pavgw", "pmulhuw", "pmulhw", nullptr, nullptr,
+                "psubsb", "psubsw", "pminsw", "por", "paddsb", "paddsw", "pmaxsw", "pxor",
+                nullptr, "psllw", "pslld", "psllq", "pmuludq", "pmaddwd", "psadbw", nullptr,
+                "psubb", "psubw", "psubd", "psubq", "paddb", "paddw", "paddd", nullptr,
+            };
+            for (int i = 0; i < 48; ++i) {
+                if (mmx[i]) {
+                    Mmx(0xD0 + i, mmx[i], Pq, Qq);
+                }
+            }
+            Sse(0xD6, 1, "movq", Wq, Vx);
+            Sse(0xD6, 2, "movq2dq", Vx, Nq);
+            Sse(0xD6, 3, "movdq2q", Pq, Ux);
+            Sse(0xD7, 0, "pmovmskb", Gd, Nq);
+            Sse(0xD7, 1, "pmovmskb", Gd, Ux);
+            Sse(0xE6, 1, "cvttpd2dq", Vx, Wx);
+            Sse(0xE6, 2, "cvtdq2pd", Vx, Wq);
+            Sse(0xE6, 3, "cvtpd2dq", Vx, Wx);
+            Sse(0xE7, 0, "movntq", Mq, Pq);
+            Sse(0xE7, 1, "movntdq", Mx, Vx);
+            Sse(0xF7, 0, "maskmovq", Pq, Nq);
+            Sse(0xF7, 1, "maskmovdqu", Vx, Ux);
+        }
+
+        void Group(int group, const char* const names[8], uint8_t a = __, uint8_t b = __) {
+            for (int r = 0; r < 8; ++r) {
+                if (names[r]) {
+                    groups[group][r] = Make(names[r], a, b, __, kModrm);
+                }
+            }
+        }
+
+        void BuildGroups() {
+            const char* const g1[8] = { "add", "or", "adc", "sbb", "and", "sub", "xor", "cmp" };
+            const char* const g1a[8] = { "pop" };
+            const char* const g2[8] = { "rol", "ror", "rcl", "rcr", "shl", "shr", "sal", "sar" };
+            const char* const g3[8] = { "test", "test", "not", "neg", "mul", "imul", "div", "idiv" };
+            const char* const g4[8] = { "inc", "dec" };
+            const char* const g5[8] = { "inc", "dec", "call", "lcall", "jmp", "ljmp", "push" };
+            const char* const g11[8] = { "mov" };
+            const char* const g6[8] = { "sldt", "str", "lldt", "ltr", "verr", "verw" };
+            const char* const g7[8] = { "sgdt", "sidt", "lgdt", "lidt", "smsw", nullptr, "lmsw", "invlpg" };
+            const char* const g8[8] = { nullptr, nullptr, nullptr, nullptr, "bt", "bts", "btr", "btc" };
+            const char* const g9[8] = { nullptr, "cmpxchg8b" };
+            const char* const g12[8] = { nullptr, nullptr, "psrlw", nullptr, "psraw", nullptr, "psllw" };
+            const char* const g13[8] = { nullptr, nullptr, "psrld", nullptr, "psrad", nullptr, "pslld" };
+            const char* const g14[8] = { nullptr, nullptr, "psrlq", "psrldq", nullptr, nullptr, "psllq", "pslldq" };
+            const char* const g15[8] = { "fxsave", "fxrstor", "ldmxcsr", "stmxcsr", nullptr, "lfence", "mfence", "sfence" };
+            const char* const g16[8] = { "prefetchnta", "prefetcht0", "prefetcht1", "prefetcht2" };
+            const char* const gp[8] = { "prefetch", "prefetchw" };
+            Group(kG1, g1);
+            Group(kG1A, g1a);
+            Group(kG2, g2);
+            Group(kG3b, g3);
+            Group(kG3v, g3);
+            Group(kG4, g4);
+            Group(kG5, g5);
+            Group(kG11, g11);
+            Group(kG6, g6);
+            Group(kG7, g7);
+            Group(kG8, g8);
+            Group(kG9, g9);
+            Group(kG12, g12);
+            Group(kG13, g13);
+            Group(kG14, g14);
+            Group(kG15, g15);
+            Group(kG16, g16);
+            Group(kGPrefetch, gp);
+        }
+    };
+
+    const Tables& GetTables() {
+        static const Tables s_tables;
+        return s_tables;
+    }
+
+    // Decoding state for one instruction.
+    struct Cursor {
+        const uint8_t* code;
+        size_t         avail;
+        size_t         pos;
+        bool           ok;
+
+        uint8_t Byte() {
+            if (pos >= avail) {
+                ok = false;
+                return 0;
+            }
+            return code[pos++];
+        }
+
+        uint32_t Read(int size) {
+            uint32_t v = 0;
+            for (int i = 0; i < size; ++i) {
+                v |= static_cast<uint32_t>(Byte()) << (8 * i);
+            }
+            return v;
+        }
+    };
+
+    uint32_t SignExtend(uint32_t v, int size) {
+        if (size == 1) {
+            return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int8_t>(v)));
+        }
+        if (size == 2) {
+            return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(v)));
+        }
+        return v;
+    }
+
+    X86Operand RegOperand(uint8_t regClass, uint8_t reg, uint8_t size) {
+        X86Operand op = {};
+        op.type = kX86OpReg;
+        op.regClass = regClass;
+        op.reg = reg;
+        op.size = size;
+        op.base = op.index = kX86NoReg;
+        op.segment = kX86NoSegment;
+        return op;
+    }
+
+    X86Operand ImmOperand(uint32_t value, uint8_t size) {
+        X86Operand op = {};
+        op.type = kX86OpImm;
+        op.imm = value;
+        op.size = size;
+        op.base = op.index = kX86NoReg;
+        op.segment = kX86NoSegment;
+        return op;
+    }
+
+    // Read the SIB byte and displacement of a memory ModRM.
+    X86Operand MemOperand(Cursor& c, X86Insn* insn, uint8_t size) {
+        X86Operand op = {};
+        op.type = kX86OpMem;
+        op.size = size;
+        op.base = op.index = kX86NoReg;
+        op.scale = 1;
+        op.segment = insn->segment;
+        int dispSize = 0;
+        if (insn->prefixes & kX86AddrSize) {
+            static const uint8_t base16[8]  = { 3, 3, 5, 5, 6, 7, 5, 3 };    // bx bx bp bp si di bp bx
+            static const uint8_t index16[8] = { 6, 7, 6, 7, kX86NoReg, kX86NoReg, kX86NoReg, kX86NoReg };
+            op.addrSize = 2;
+            if (insn->mod == 0 && insn->rm == 6) {
+                dispSize = 2;
+            } else {
+                op.base = base16[insn->rm];
+                op.index = index16[insn->rm];
+                dispSize = insn->mod == 1 ? 1 : insn->mod == 2 ? 2 : 0;
+            }
+        } else {
+            op.addrSize = 4;
+            uint8_t rm = insn->rm;
+            if (rm == 4) {
+                uint8_t sib = c.Byte();
+                op.scale = static_cast<uint8_t>(1u << (sib >> 6));
+                uint8_t index = (sib >> 3) & 7;
+                op.index = index == 4 ? kX86NoReg : index;
+                uint8_t base = sib & 7;
+                if (base == 5 && insn->mod == 0) {
+                    dispSize = 4;
+                } else {
+                    op.base = base;
+                }
+            } else if (rm == 5 && insn->mod == 0) {
+                dispSize = 4;
+            } else {
+                op.base = rm;
+            }
+            if (insn->mod == 1) {
+                dispSize = 1;
+            } else if (insn->mod == 2) {
+                dispSize = 4;
+            }
+        }
+        if (dispSize) {
+            insn->dispOffset = static_cast<uint8_t>(c.pos);
+            insn->dispSize = static_cast<uint8_t>(dispSize);
+            op.disp = static_cast<int32_t>(SignExtend(c.Read(dispSize), dispSize));
+        }
+        return op;
+    }
+
+    // ModRM.rm as a register of `regClass` or as memory of `size`.
+    X86Operand RmOperand(Cursor& c, X86Insn* insn, uint8_t regClass, uint8_t size, bool memOnly, bool regOnly) {
+        if (insn->mod == 3) {
+            if (memOnly) {
+                c.ok = false;
+            }
+            return RegOperand(regClass, insn->rm, size);
+        }
+        if (regOnly) {
+            c.ok = false;
+        }
+        return MemOperand(c, insn, size);
+    }
+
+    bool DecodeOperand(Cursor& c, X86Insn* insn, uint8_t spec, int opSize, X86Operand* op) {
+        const uint8_t v = static_cast<uint8_t>(opSize);
+        const uint8_t z = v;
+        switch (spec) {
+        case Eb: *op = RmOperand(c, insn, kX86Gpr, 1, false, false); break;
+        case Ew: *op = RmOperand(c, insn, kX86Gpr, 2, false, false); break;
+        case Ed: *op = RmOperand(c, insn, kX86Gpr, 4, false, false); break;
+        case Ev: *op = RmOperand(c, insn, kX86Gpr, v, false, false); break;
+        case Ep: *op = RmOperand(c, insn, kX86Gpr, static_cast<uint8_t>(v + 2), true, false); break;
+        case M:  *op = RmOperand(c, insn, kX86Gpr, 0, true, false); break;
+        case Mb: *op = RmOperand(c, insn, kX86Gpr, 1, true, false); break;
+        case Mw: *op = RmOperand(c, insn, kX86Gpr, 2, true, false); break;
+        case Md: *op = RmOperand(c, insn, kX86Gpr, 4, true, false); break;
+        case Mq: *op = RmOperand(c, insn, kX86Gpr, 8, true, false); break;
+        case Mt: *op = RmOperand(c, insn, kX86Gpr, 10, true, false); break;
+        case Mx: *op = RmOperand(c, insn, kX86Gpr, 16, true, false); break;
+        case Gb: *op = RegOperand(kX86Gpr, insn->reg, 1); break;
+        case Gw: *op = RegOperand(kX86Gpr, insn->reg, 2); break;
+        case Gd: *op = RegOperand(kX86Gpr, insn->reg, 4); break;
+        case Gv: *op = RegOperand(kX86Gpr, insn->reg, v); break;
+        case Ib:
+        case Ibs:
+        case Iw:
+        case Iz: {
+            int size = spec == Iw ? 2 : spec == Iz ? z : 1;
+            if (!insn->immSize) {
+                insn->immOffset = static_cast<uint8_t>(c.pos);
+            }
+            insn->immSize = static_cast<uint8_t>(insn->immSize + size);
+            uint32_t value = c.Read(size);
+            if (spec == Ibs) {
+                value = SignExtend(value, 1);
+                if (v == 2) {
+                    value &= 0xFFFF;
+                }
+            }
+            *op = ImmOperand(value, static_cast<uint8_t>(spec == Ibs ? v : size));
+            op->signExtended = spec == Ibs;
+            break;
+        }
+        case Jb:
+        case Jz: {
+            int size = spec == Jb ? 1 : z;
+            insn->immOffset = static_cast<uint8_t>(c.pos);
+            insn->immSize = static_cast<uint8_t>(size);
+            uint32_t rel = SignExtend(c.Read(size), size);
+            *op = ImmOperand(0, 4);
+            op->type = kX86OpRel;
+            op->imm = rel;      // made absolute once the length is known
+            break;
+        }
+        case AL_: *op = RegOperand(kX86Gpr, 0, 1); break;
+        case CL_: *op = RegOperand(kX86Gpr, 1, 1); break;
+        case DX_: *op = RegOperand(kX86Gpr, 2, 2); break;
+        case eAX: *op = RegOperand(kX86Gpr, 0, v); break;
+        case I1:  *op = ImmOperand(1, 1); break;
+        case Zb:  *op = RegOperand(kX86Gpr, static_cast<uint8_t>(insn->opcode & 7), 1); break;
+        case Zv:  *op = RegOperand(kX86Gpr, static_cast<uint8_t>(insn->opcode & 7), v); break;
+        case Zd:  *op = RegOperand(kX86Gpr, static_cast<uint8_t>(insn->opcode & 7), 4); break;
+        case Sw:
+            if (insn->reg > 5) {
+                return false;
+            }
+            *op = RegOperand(kX86Seg, insn->reg, 2);
+            break;
+        case Ob:
+        case Ov: {
+            int addr = (insn->prefixes & kX86AddrSize) ? 2 : 4;
+            X86Operand m = {};
+            m.type = kX86OpMem;
+            m.size = spec == Ob ? 1 : v;
+            m.base = m.index = kX86NoReg;
+            m.scale = 1;
+            m.segment = insn->segment;
+            m.addrSize = static_cast<uint8_t>(addr);
+            insn->dispOffset = static_cast<uint8_t>(c.pos);
+            insn->dispSize = static_cast<uint8_t>(addr);
+            m.disp = static_cast<int32_t>(c.Read(addr));
+            *op = m;
+            break;
+        }
+        case Xb:
+        case Xv:
+        case Yb:
+        case Yv: {
+            // The destination of a string instruction is always es:[edi];
+            // only the source honours a segment override.
+            bool dest = spec == Yb || spec == Yv;
+            X86Operand m = {};
+            m.type = kX86OpMem;
+            m.size = spec == Xb || spec == Yb ? 1 : v;
+            m.index = kX86NoReg;
+            m.scale = 1;
+            m.addrSize = (insn->prefixes & kX86AddrSize) ? 2 : 4;
+            m.base = dest ? 7 : 6;
+            m.segment = dest ? static_cast<uint8_t>(kX86Es) : insn->segment;
+            *op = m;
+            break;
+        }
+        case Ap: {
+            X86Operand far = {};
+            far.type = kX86OpFar;
+            far.base = far.index = kX86NoReg;
+            far.segment = kX86NoSegment;
+            insn->immOffset = static_cast<uint8_t>(c.pos);
+            insn->immSize = static_cast<uint8_t>(z + 2);
+            far.imm = c.Read(z);
+            far.selector = static_cast<uint16_t>(c.Read(2));
+            *op = far;
+            break;
+        }
+        case ES_: *op = RegOperand(kX86Seg, kX86Es, 2); break;
+        case CS_: *op = RegOperand(kX86Seg, kX86Cs, 2); break;
+        case SS_: *op = RegOperand(kX86Seg, kX86Ss, 2); break;
+        case DS_: *op = RegOperand(kX86Seg, kX86Ds, 2); break;
+        case FS_: *op = RegOperand(kX86Seg, kX86Fs, 2); break;
+        case GS_: *op = RegOperand(kX86Seg, kX86Gs, 2); break;
+        case Pq:  *op = RegOperand(kX86Mmx, insn->reg, 8); break;
+        case Qq:  *op = RmOperand(c, insn, kX86Mmx, 8, false, false); break;
+        case Qd:  *op = RmOperand(c, insn, kX86Mmx, 4, false, false); break;
+        case Nq:  *op = RmOperand(c, insn, kX86Mmx, 8, false, true); break;
+        case Vx:  *op = RegOperand(kX86Xmm, insn->reg, 16); break;
+        case Wx:  *op = RmOperand(c, insn, kX86Xmm, 16, false, false); break;
+        case Wq:  *op = RmOperand(c, insn, kX86Xmm, 8, false, false); break;
+        case Wd:  *op = RmOperand(c, insn, kX86Xmm, 4, false, false); break;
+        case Ux:  *op = RmOperand(c, insn, kX86Xmm, 16, false, true); break;
+        case Cd:  *op = RegOperand(kX86Ctrl, insn->reg, 4); break;
+        case Dd:  *op = RegOperand(kX86Debug, insn->reg, 4); break;
+        case Rd:  *op = RegOperand(kX86Gpr, insn->rm, 4); break;
+        case ST0: *op = RegOperand(kX86Fpu, 0, 10); break;
+        case STi: *op = RegOperand(kX86Fpu, insn->rm, 10); break;
+        default:
+            return false;
+        }
+        if (op->type == kX86OpMem && op->size == 0 && spec != M) {
+            op->size = 0;
+        }
+        return c.ok;
+    }
+
+    // MMX operand specs widened to their XMM forms for a 66 prefix.
+    uint8_t WidenMmx(uint8_t spec) {
+        switch (spec) {
+        case Pq: return Vx;
+        case Qq:
+        case Qd: return Wx;
+        case Nq: return Ux;
+        default: return spec;
+        }
+    }
+
+    bool DecodeFpu(Cursor& c, X86Insn* insn) {
+        int x = (insn->opcode & 0xFF) - 0xD8;
+        if (insn->mod != 3) {
+            const FpuMem& m = kFpuMem[x][insn->reg];
+            if (!m.name) {
+                return false;
+            }
+            insn->mnemonic = m.name;
+            insn->operands[0] = MemOperand(c, insn, m.size);
+            insn->operandCount = 1;
+            return c.ok;
+        }
+        uint8_t modrm = static_cast<uint8_t>(0xC0 | (insn->reg << 3) | insn->rm);
+        for (const FpuNullary& n : kFpuNullary) {
+            if (n.opcode == (insn->opcode & 0xFF) && n.modrm == modrm) {
+                insn->mnemonic = n.name;
+                if (n.opcode == 0xDF) {     // fnstsw ax
+                    insn->operands[0] = RegOperand(kX86Gpr, 0, 2);
+                    insn->operandCount = 1;
+                }
+                return true;
+            }
+        }
+        const char* name = kFpuReg[x][insn->reg];
+        if (!name) {
+            return false;
+        }
+        insn->mnemonic = name;
+        switch (kFpuRegOrder[x][insn->reg]) {
+        case 0:
+            insn->operands[0] = RegOperand(kX86Fpu, 0, 10);
+            insn->operands[1] = RegOperand(kX86Fpu, insn->rm, 10);
+            insn->operandCount = 2;
+            break;
+        case 1:
+            insn->operands[0] = RegOperand(kX86Fpu, insn->rm, 10);
+            insn->operands[1] = RegOperand(kX86Fpu, 0, 10);
+            insn->operandCount = 2;
+            break;
+        default:
+            insn->operands[0] = RegOperand(kX86Fpu, insn->rm, 10);
+            insn->operandCount = 1;
+            break;
+        }
+        return true;
+    }
+
+    void Classify(X86Insn* insn) {
+        insn->flow = X86Flow::kNone;
+        uint16_t op = insn->opcode;
+        uint32_t next = insn->address + insn->length;
+        for (int i = 0; i < insn->operandCount; ++i) {
+            if (insn->operands[i].type == kX86OpRel) {
+                insn->operands[i].imm += next;
+                if (insn->prefixes & kX86OpSize) {
+                    insn->operands[i].imm = (insn->operands[i].imm & 0xFFFF);
+                }
+                insn->target = insn->operands[i].imm;
+            }
+        }
+        if ((op >= 0x70 && op <= 0x7F) || (op >= 0x0F80 && op <= 0x0F8F) || (op >= 0xE0 && op <= 0xE3)) {
+            insn->flow = X86Flow::kCondJump;
+        } else if (op == 0xEB || op == 0xE9) {
+            insn->flow = X86Flow::kJump;
+        } else if (op == 0xE8) {
+            insn->flow = X86Flow::kCall;
+        } else if (op == 0xC2 || op == 0xC3 || op == 0xCA || op == 0xCB || op == 0xCF) {
+            insn->flow = X86Flow::kReturn;
+        } else if (op == 0xEA) {
+            insn->flow = X86Flow::kIndirectJump;
+        } else if (op == 0x9A) {
+            insn->flow = X86Flow::kIndirectCall;
+        } else if (op == 0xFF && (insn->reg == 2 || insn->reg == 3)) {
+            insn->flow = X86Flow::kIndirectCall;
+        } else if (op == 0xFF && (insn->reg == 4 || insn->reg == 5)) {
+            insn->flow = X86Flow::kIndirectJump;
+        } else if (op == 0xCC || op == 0xF4 || op == 0x0F0B) {
+            insn->flow = X86Flow::kStop;
+        }
+    }
+
+    const char* const kGpr8[8]  = { "al", "cl", "dl", "bl", "ah", "ch", "dh", "bh" };
+    const char* const kGpr16[8] = { "ax", "cx", "dx", "bx", "sp", "bp", "si", "di" };
+    const char* const kGpr32[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+    const char* const kSeg[6]   = { "es", "cs", "ss", "ds", "fs", "gs" };
+
+    const char* SizeName(uint8_t size) {
+        switch (size) {
+        case 1:  return "byte ptr ";
+        case 2:  return "word ptr ";
+        case 4:  return "dword ptr ";
+        case 6:  return "fword ptr ";
+        case 8:  return "qword ptr ";
+        case 10: return "tbyte ptr ";
+        case 16: return "xmmword ptr ";
+        default: return "";
+        }
+    }
+
+    // Small values in decimal and the rest in hex, as digi_disasm.asm
+    // prints them.
+    int Number(char* buf, size_t size, uint32_t v) {
+        return v <= 9 ? std::snprintf(buf, size, "%u", v) : std::snprintf(buf, size, "0x%x", v);
+    }
+
+    struct Writer {
+        char*  buf;
+        size_t size;
+        size_t len;
+
+        void Put(const char* s) {
+            while (*s) {
+                if (len + 1 < size) {
+                    buf[len] = *s;
+                }
+                ++len;
+                ++s;
+            }
+            if (size) {
+                buf[len < size ? len : size - 1] = '\0';
+            }
+        }
+
+        void PutNumber(uint32_t v) {
+            char tmp[16];
+            Number(tmp, sizeof(tmp), v);
+            Put(tmp);
+        }
+    };
+
+    void PutRegister(Writer& w, const X86Operand& op) {
+        char tmp[16];
+        switch (op.regClass) {
+        case kX86Gpr:
+            w.Put(op.size == 1 ? kGpr8[op.reg & 7] : op.size == 2 ? kGpr16[op.reg & 7] : kGpr32[op.reg & 7]);
+            return;
+        case kX86Seg:
+            w.Put(kSeg[op.reg % 6]);
+            return;
+        case kX86Fpu:
+            std::snprintf(tmp, sizeof(tmp), "st(%u)", op.reg);
+            break;
+        case kX86Mmx:
+            std::snprintf(tmp, sizeof(tmp), "mm%u", op.reg);
+            break;
+        case kX86Xmm:
+            std::snprintf(tmp, sizeof(tmp), "xmm%u", op.reg);
+            break;
+        case kX86Ctrl:
+            std::snprintf(tmp, sizeof(tmp), "cr%u", op.reg);
+            break;
+        default:
+            std::snprintf(tmp, sizeof(tmp), "dr%u", op.reg);
+            break;
+        }
+        w.Put(tmp);
+    }
+
+    void PutMemory(Writer& w, const X86Operand& op) {
+        w.Put(SizeName(op.size));
+        if (op.segment != kX86NoSegment) {
+            w.Put(kSeg[op.segment]);
+            w.Put(":");
+        }
+        w.Put("[");
+        const char* const* regs = op.addrSize == 2 ? kGpr16 : kGpr32;
+        bool any = false;
+        if (op.base != kX86NoReg) {
+            w.Put(regs[op.base]);
+            any = true;
+        }
+        if (op.index != kX86NoReg) {
+            if (any) {
+                w.Put(" + ");
+            }
+            w.Put(regs[op.index]);
+            if (op.scale > 1) {
+                w.Put("*");
+                w.PutNumber(op.scale);
+            }
+            any = true;
+        }
+        if (!any) {
+            w.PutNumber(static_cast<uint32_t>(op.disp));
+        } else if (op.disp > 0) {
+            w.Put(" + ");
+            w.PutNumber(static_cast<uint32_t>(op.disp));
+        } else if (op.disp < 0) {
+            w.Put(" - ");
+            w.PutNumber(0u - static_cast<uint32_t>(op.disp));
+        }
+        w.Put("]");
+    }
+}
+
+bool DecodeX86(const uint8_t* code, size_t avail, uint32_t address, X86Insn* out) {
+    const Tables& t = GetTables();
+    X86Insn insn = {};
+    insn.address = address;
+    insn.segment = kX86NoSegment;
+    Cursor c = { code, avail < 15 ? avail : 15, 0, true };
+
+    // Prefixes.  The last of 66/F2/F3 selects the SSE variant.
+    int ssePrefix = 0;
+    uint8_t b;
+    for (;;) {
+        b = c.Byte();
+        if (!c.ok) {
+            return false;
+        }
+        switch (b) {
+        case 0x26: insn.segment = kX86Es; continue;
+        case 0x2E: insn.segment = kX86Cs; continue;
+        case 0x36: insn.segment = kX86Ss; continue;
+        case 0x3E: insn.segment = kX86Ds; continue;
+        case 0x64: insn.segment = kX86Fs; continue;
+        case 0x65: insn.segment = kX86Gs; continue;
+        case 0x66: insn.prefixes |= kX86OpSize; ssePrefix = 1; continue;
+        case 0x67: insn.prefixes |= kX86AddrSize; continue;
+        case 0xF0: insn.prefixes |= kX86Lock; continue;
+        case 0xF2: insn.prefixes |= kX86Repne; ssePrefix = 3; continue;
+        case 0xF3: insn.prefixes |= kX86Rep; ssePrefix = 2; continue;
+        default: break;
+        }
+        break;
+    }
+
+    Op op;
+    bool twoByte = b == 0x0F;
+    if (twoByte) {
+        b = c.Byte();
+        if (!c.ok) {
+            return false;
+        }
+        insn.opcode = static_cast<uint16_t>(0x0F00 | b);
+        op = t.two[b];
+    } else {
+        insn.opcode = b;
+        op = t.one[b];
+    }
+    if (!(op.flags & kValid)) {
+        return false;
+    }
+
+    if (op.flags & kModrm) {
+        uint8_t modrm = c.Byte();
+        insn.hasModrm = true;
+        insn.mod = modrm >> 6;
+        insn.reg = (modrm >> 3) & 7;
+        insn.rm = modrm & 7;
+    }
+
+    int opSize = (insn.prefixes & kX86OpSize) ? 2 : 4;
+    bool widen = false;
+    if (op.flags & kSse) {
+        const Op* variant = &t.sse[b][ssePrefix];
+        if (!(variant->flags & kValid)) {
+            variant = &t.sse[b][0];
+            ssePrefix = 0;
+        }
+        if (!(variant->flags & kValid)) {
+            return false;
+        }
+        op = *variant;
+        // The mandatory prefix is part of the opcode, not an operand size.
+        if (ssePrefix == 1) {
+            opSize = 4;
+        }
+    } else if ((op.flags & kMmx) && (insn.prefixes & kX86OpSize)) {
+        widen = true;
+        opSize = 4;
+    }
+
+    if (op.flags & kGroup) {
+        const Op& g = t.groups[op.group][insn.reg];
+        if (!(g.flags & kValid)) {
+            return false;
+        }
+        insn.mnemonic = g.name;
+    } else {
+        insn.mnemonic = op.name;
+    }
+
+    if (!twoByte && b >= 0xD8 && b <= 0xDF) {
+        if (!DecodeFpu(c, &insn)) {
+            return false;
+        }
+    } else if (twoByte && b == 0x0F) {
+        // 3DNow!: operands first, then the suffix that names the op.
+        if (!DecodeOperand(c, &insn, Pq, opSize, &insn.operands[0]) ||
+            !DecodeOperand(c, &insn, Qq, opSize, &insn.operands[1])) {
+            return false;
+        }
+        insn.operandCount = 2;
+        insn.suffix = c.Byte();
+        insn.mnemonic = nullptr;
+        for (const Now3D& n : k3DNow) {
+            if (n.suffix == insn.suffix) {
+                insn.mnemonic = n.name;
+            }
+        }
+        if (!insn.mnemonic) {
+            return false;
+        }
+    } else {
+        uint8_t specs[3] = { op.spec[0], op.spec[1], op.spec[2] };
+        // Group members that differ from the group's operand pattern.
+        if (op.flags & kGroup) {
+            if ((op.group == kG3b || op.group == kG3v) && insn.reg < 2) {
+                specs[1] = op.group == kG3b ? Ib : Iz;
+            }
+            if (op.group == kG5 && (insn.reg == 3 || insn.reg == 5)) {
+                specs[0] = Ep;
+            }
+            if (op.group == kG7 && insn.mod == 3) {
+                return false;
+            }
+            if (op.group == kG15 && insn.reg >= 5) {
+                specs[0] = __;          // fences; sfence with memory is clflush
+                if (insn.mod != 3) {
+                    if (insn.reg != 7) {
+                        return false;
+                    }
+                    insn.mnemonic = "clflush";
+                    specs[0] = Mb;
+                }
+            }
+            if (op.group == kG15 && insn.reg < 5 && insn.mod == 3) {
+                return false;
+            }
+            if (op.group == kG6 || op.group == kG7) {
+                specs[0] = op.group == kG7 && insn.reg < 4 ? Ep : Ew;
+                if (op.group == kG7 && insn.reg == 7) {
+                    specs[0] = Mb;
+                }
+            }
+        }
+        if ((insn.opcode == 0x0F12 || insn.opcode == 0x0F16) && ssePrefix == 0 && insn.mod == 3) {
+            insn.mnemonic = insn.opcode == 0x0F12 ? "movhlps" : "movlhps";
+            specs[1] = Ux;
+        }
+        if ((op.flags & kSizeAlt) && opSize == 2) {
+            insn.mnemonic = op.alt;
+        }
+        for (int i = 0; i < 3 && specs[i] != __; ++i) {
+            uint8_t spec = widen ? WidenMmx(specs[i]) : specs[i];
+            if (!DecodeOperand(c, &insn, spec, opSize, &insn.operands[i])) {
+                return false;
+            }
+            insn.operandCount = static_cast<uint8_t>(i + 1);
+        }
+        // Bitwise masks read better as the unsigned pattern they are.
+        if (op.group == kG1 && (op.flags & kGroup) && (insn.reg == 1 || insn.reg == 4 || insn.reg == 6)) {
+            insn.operands[1].signExtended = false;
+        }
+        if (op.flags & kCond) {
+            static const char* const s_names[3][16] = {
+                { "jo", "jno", "jb", "jae", "je", "jne", "jbe", "ja", "js", "jns", "jp", "jnp", "jl", "jge", "jle", "jg" },
+                { "seto", "setno", "setb", "setae", "sete", "setne", "setbe", "seta",
+                  "sets", "setns", "setp", "setnp", "setl", "setge", "setle", "setg" },
+                { "cmovo", "cmovno", "cmovb", "cmovae", "cmove", "cmovne", "cmovbe", "cmova",
+                  "cmovs", "cmovns", "cmovp", "cmovnp", "cmovl", "cmovge", "cmovle", "cmovg" },
+            };
+            int kind = op.name[0] == 'j' ? 0 : op.name[0] == 's' ? 1 : 2;
+            insn.mnemonic = s_names[kind][b & 15];
+        }
+    }
+
+    if (!c.ok) {
+        return false;
+    }
+    insn.length = static_cast<uint8_t>(c.pos);
+    Classify(&insn);
+    *out = insn;
+    return true;
+}
+
+size_t FormatX86(const X86Insn& insn, char* buf, size_t size) {
+    Writer w = { buf, size, 0 };
+    if (size) {
+        buf[0] = '\0';
+    }
+    if (insn.prefixes & kX86Lock) {
+        w.Put("lock ");
+    }
+    // rep/repne print only on string instructions; elsewhere they were
+    // mandatory SSE prefixes and are part of the mnemonic.
+    uint16_t op = insn.opcode;
+    bool stringOp = (op >= 0xA4 && op <= 0xA7) || (op >= 0xAA && op <= 0xAF) || (op >= 0x6C && op <= 0x6F);
+    if (stringOp && (insn.prefixes & kX86Rep)) {
+        w.Put(op == 0xA6 || op == 0xA7 || op == 0xAE || op == 0xAF ? "repe " : "rep ");
+    } else if (stringOp && (insn.prefixes & kX86Repne)) {
+        w.Put("repne ");
+    }
+    w.Put(insn.mnemonic ? insn.mnemonic : "(bad)");
+    for (int i = 0; i < insn.operandCount; ++i) {
+        const X86Operand& o = insn.operands[i];
+        w.Put(i ? ", " : " ");
+        switch (o.type) {
+        case kX86OpReg:
+            PutRegister(w, o);
+            break;
+        case kX86OpMem:
+            PutMemory(w, o);
+            break;
+        case kX86OpImm:
+            if (o.signExtended && (o.imm & (1u << (o.size * 8 - 1)))) {
+                uint32_t mask = o.size == 4 ? 0xFFFFFFFFu : (1u << (o.size * 8)) - 1;
+                w.Put("-");
+                w.PutNumber((0u - o.imm) & mask);
+            } else {
+                w.PutNumber(o.imm);
+            }
+            break;
+        case kX86OpRel:
+            w.PutNumber(o.imm);
+            break;
+        case kX86OpFar: {
+            char tmp[32];
+            std::snprintf(tmp, sizeof(tmp), "0x%x:0x%x", o.selector, o.imm);
+            w.Put(tmp);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return w.len < size ? w.len : (size ? size - 1 : 0);
+}
+
+bool X86IsFiller(const X86Insn& insn) {
+    const X86Operand& a = insn.operands[0];
+    const X86Operand& b = insn.operands[1];
+    if (insn.opcode == 0x90) {
+        return true;
+    }
+    if (insn.opcode == 0x8B && insn.mod == 3) {
+        return a.reg == b.reg;
+    }
+    return insn.opcode == 0x8D && b.type == kX86OpMem && b.disp == 0 && b.base == a.reg &&
+           (b.index == kX86NoReg || b.index == 4) && insn.segment == kX86NoSegment;
+}
+
+bool X86OperandAddress(const X86Operand& op, uint32_t* address) {
+    if (op.type == kX86OpMem && op.base == kX86NoReg && op.index == kX86NoReg && op.addrSize == 4) {
+        *address = static_cast<uint32_t>(op.disp);
+        return true;
+    }
+    if (op.type == kX86OpImm && op.size == 4) {
+        *address = op.imm;
+        return true;
+    }
+    if (op.type == kX86OpMem && op.disp && op.addrSize == 4 && (op.base == kX86NoReg || op.index == kX86NoReg)) {
+        // [reg*4 + table] and [reg + table]: the displacement is the
+        // address of the array being indexed.
+        uint32_t d = static_cast<uint32_t>(op.disp);
+        if (d >= 0x10000) {
+            *address = d;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2025
+//
+// Table-driven 32-bit x86 instruction decoder for the analysis tools.
+// It covers what digi.exe contains: the one- and two-byte integer
+// opcode maps, x87, MMX, 3DNow! and SSE/SSE2, with 16-bit operand and
+// address size prefixes.  Besides the length it reports the operands,
+// where the displacement and immediate bytes sit inside the
+// instruction (so signatures can mask them and string scans can find
+// the addresses they hold), and how the instruction affects control
+// flow.
+//
+// FormatX86 renders an instruction in the Intel syntax digi_disasm.asm
+// uses, e.g. `movsx eax, word ptr [eax*2 + 0x4b0200]`.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class X86Flow : uint8_t {
+    kNone,              // falls through
+    kJump,              // unconditional, target known
+    kCondJump,          // conditional (jcc, loop, jecxz), target known
+    kCall,              // direct call, target known
+    kReturn,
+    kIndirectJump,      // jmp through a register or memory, or far
+    kIndirectCall,
+    kStop,              // int3, hlt, ud2: execution does not continue
+};
+
+enum X86OperandType : uint8_t {
+    kX86OpNone,
+    kX86OpReg,
+    kX86OpMem,
+    kX86OpImm,
+    kX86OpRel,          // branch target, held in `imm` as an address
+    kX86OpFar,          // ptr16:32, selector and offset
+};
+
+enum X86RegClass : uint8_t {
+    kX86Gpr,            // size selects al/ax/eax
+    kX86Seg,            // es cs ss ds fs gs
+    kX86Fpu,            // st(i)
+    kX86Mmx,
+    kX86Xmm,
+    kX86Ctrl,
+    kX86Debug,
+};
+
+const uint8_t kX86NoReg = 0xFF;
+
+// Segment numbers, in the order of the Sreg encoding.
+enum X86Segment : uint8_t { kX86Es, kX86Cs, kX86Ss, kX86Ds, kX86Fs, kX86Gs, kX86NoSegment };
+
+struct X86Operand {
+    uint8_t  type;              // X86OperandType
+    uint8_t  size;              // in bytes; 0 when implied
+    uint8_t  regClass;          // X86RegClass, for kX86OpReg
+    uint8_t  reg;               // register number, for kX86OpReg
+    // kX86OpMem: [base + index*scale + disp].  Registers are 32-bit
+    // numbers unless addrSize is 2, in which case they name the 16-bit
+    // registers of the old bx/bp/si/di forms.
+    uint8_t  base;
+    uint8_t  index;
+    uint8_t  scale;
+    uint8_t  addrSize;
+    int32_t  disp;
+    uint8_t  segment;           // X86Segment override, or kX86NoSegment
+    // kX86OpImm value (sign-extended where the encoding says so),
+    // kX86OpRel target, or kX86OpFar offset.
+    uint32_t imm;
+    bool     signExtended;      // immediate widened from a signed byte
+    uint16_t selector;          // kX86OpFar
+};
+
+enum X86Prefix : uint8_t {
+    kX86Lock     = 0x01,
+    kX86Rep      = 0x02,        // F3
+    kX86Repne    = 0x04,        // F2
+    kX86OpSize   = 0x08,        // 66
+    kX86AddrSize = 0x10,        // 67
+};
+
+struct X86Insn {
+    uint32_t    address;
+    uint8_t     length;
+    uint8_t     prefixes;       // X86Prefix bits
+    uint8_t     segment;        // prefix override, or kX86NoSegment
+    // 0x00-0xFF for the one-byte map, 0x0F00 | byte for the two-byte
+    // map.  For 3DNow! (0F 0F) the suffix byte is in `imm` of no
+    // operand and in `suffix`.
+    uint16_t    opcode;
+    uint8_t     suffix;
+    bool        hasModrm;
+    uint8_t     mod, reg, rm;
+    // Offsets and sizes of the displacement and immediate fields; 0
+    // sizes when absent.  Relative branch offsets count as immediates.
+    uint8_t     dispOffset, dispSize;
+    uint8_t     immOffset, immSize;
+    const char* mnemonic;
+    uint8_t     operandCount;
+    X86Operand  operands[3];
+    X86Flow     flow;
+    uint32_t    target;         // for kJump, kCondJump and kCall
+};
+
+// Decode the instruction at `code`, which the image maps at `address`.
+// At most `avail` bytes are read.  Returns false for invalid or
+// truncated encodings.
+bool DecodeX86(const uint8_t* code, size_t avail, uint32_t address, X86Insn* out);
+
+// Write `insn` in Intel syntax into `buf`.  Returns the length written,
+// not counting the terminating NUL.
+size_t FormatX86(const X86Insn& insn, char* buf, size_t size);
+
+// Whether `insn` is one of the multi-byte no-ops MSVC pads with,
+// `mov edi, edi` and `lea reg, [reg + 0]` in its several encodings.
+bool X86IsFiller(const X86Insn& insn);
+
+// The absolute address an operand refers to, if it has one: a memory
+// operand with no base or index, or an immediate.  Used to find code
+// and data references.
+bool X86OperandAddress(const X86Operand& op, uint32_t* address);
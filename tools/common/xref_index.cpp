@@ -0,0 +1,259 @@
+// Copyright (c) 2025
+//
+// Cross-reference and call-graph index.  See xref_index.h.
+
+#include "xref_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace {
+    // Longest string looked for behind a reference.
+    const size_t kMaxStringLength = 4096;
+
+    template <typename T>
+    AnalysisDb::Chunk MakeChunk(uint32_t id, const std::vector<T>& records) {
+        AnalysisDb::Chunk chunk;
+        chunk.id = id;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(records.data());
+        chunk.data.assign(p, p + records.size() * sizeof(T));
+        return chunk;
+    }
+
+    template <typename T>
+    bool MapRange(const AnalysisDbView& db, uint32_t id, DbRange<T>* range) {
+        size_t size = 0;
+        const T* p = static_cast<const T*>(db.Chunk(id, &size));
+        if (!p) {
+            return false;
+        }
+        range->first = p;
+        range->last = p + size / sizeof(T);
+        return true;
+    }
+
+    bool IsTextByte(uint8_t c) {
+        return (c >= 0x20 && c < 0x7F) || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // Length of the NUL-terminated ASCII or CP949 string at `p`, or 0 if
+    // the bytes do not look like one.  Double-byte characters are held
+    // to the KS X 1001 rows (lead and trail both 0xA1..0xFE) the game's
+    // text uses; the wider UHC trail range lets too many floats through.
+    size_t ByteStringLength(const uint8_t* p, size_t avail) {
+        size_t n = 0;
+        while (n < avail && n < kMaxStringLength && p[n]) {
+            if (IsTextByte(p[n])) {
+                ++n;
+            } else if (p[n] >= 0xA1 && p[n] <= 0xFE && n + 1 < avail && p[n + 1] >= 0xA1 && p[n + 1] <= 0xFE) {
+                n += 2;
+            } else {
+                return 0;
+            }
+        }
+        return n < avail && !p[n] ? n : 0;
+    }
+
+    // The same for UTF-16LE, limited to ASCII and precomposed Hangul,
+    // the only text the game stores that way.
+    size_t Utf16StringLength(const uint8_t* p, size_t avail) {
+        size_t n = 0;
+        while (n + 1 < avail && n < kMaxStringLength) {
+            uint16_t unit = static_cast<uint16_t>(p[n] | (p[n + 1] << 8));
+            if (!unit) {
+                return n;
+            }
+            if (!(unit < 0x80 ? IsTextByte(static_cast<uint8_t>(unit)) : unit >= 0xAC00 && unit <= 0xD7A3)) {
+                return 0;
+            }
+            n += 2;
+        }
+        return 0;
+    }
+
+    bool StringAt(const PeImage& image, uint32_t va, uint32_t* length, uint32_t* encoding) {
+        size_t avail = 0;
+        const uint8_t* p = image.At(va, &avail);
+        if (!p || image.IsCode(va)) {
+            return false;
+        }
+        // Floats and pointers to the image often pass for two or three
+        // characters; a pointer is never a string.
+        uint32_t dword = 0;
+        if (image.ReadU32(va, &dword) && dword - image.imageBase() < image.sizeOfImage()) {
+            return false;
+        }
+        // An ASCII character followed by a zero byte reads as a
+        // one-character byte string, so try UTF-16 first.
+        size_t n = Utf16StringLength(p, avail);
+        if (n >= 4) {
+            *length = static_cast<uint32_t>(n);
+            *encoding = kDbStringUtf16;
+            return true;
+        }
+        n = ByteStringLength(p, avail);
+        bool ascii = std::all_of(p, p + n, [](uint8_t c) { return c < 0x80; });
+        if (n >= (ascii ? 2 : 6)) {
+            *length = static_cast<uint32_t>(n);
+            *encoding = kDbStringBytes;
+            return true;
+        }
+        return false;
+    }
+
+    bool ByCaller(const DbCall& a, const DbCall& b) {
+        return std::tie(a.caller, a.callee, a.site) < std::tie(b.caller, b.callee, b.site);
+    }
+
+    bool ByCallee(const DbCall& a, const DbCall& b) {
+        return std::tie(a.callee, a.caller, a.site) < std::tie(b.callee, b.caller, b.site);
+    }
+}
+
+std::vector<AnalysisDb::Chunk> BuildXrefIndex(const PeImage& image, const AnalysisDbView& db) {
+    const DbXref* xrefs = db.xrefs();
+    size_t xrefCount = db.xrefCount();
+
+    std::vector<DbXref> byTarget(xrefs, xrefs + xrefCount);
+    std::sort(byTarget.begin(), byTarget.end(), [](const DbXref& a, const DbXref& b) {
+        return std::tie(a.to, a.from, a.kind) < std::tie(b.to, b.from, b.kind);
+    });
+
+    std::vector<DbCall> calls;
+    std::vector<DbStringRef> strings;
+    for (size_t i = 0; i < xrefCount; ++i) {
+        const DbXref& x = xrefs[i];
+        if (x.kind == kDbXrefMemory || x.kind == kDbXrefOffset) {
+            DbStringRef s = { x.to, x.from, 0, 0 };
+            if (StringAt(image, x.to, &s.length, &s.encoding)) {
+                strings.push_back(s);
+            }
+            continue;
+        }
+        const DbFunction* caller = db.FunctionAt(x.from);
+        if (!caller) {
+            continue;
+        }
+        bool edge = false;
+        switch (x.kind) {
+        case kDbXrefCall:
+            edge = db.FunctionStartingAt(x.to) != nullptr;
+            break;
+        case kDbXrefJump:
+            // Only a jump into another function is a call; the rest is
+            // control flow inside this one.
+            edge = x.to != caller->start && db.FunctionStartingAt(x.to) != nullptr;
+            break;
+        case kDbXrefImport:
+            edge = true;
+            break;
+        default:
+            break;
+        }
+        if (edge) {
+            calls.push_back({ caller->start, x.to, x.from, x.kind });
+        }
+    }
+
+    std::sort(calls.begin(), calls.end(), ByCaller);
+    std::vector<DbCall> byCallee = calls;
+    std::sort(byCallee.begin(), byCallee.end(), ByCallee);
+    std::sort(strings.begin(), strings.end(), [](const DbStringRef& a, const DbStringRef& b) {
+        return std::tie(a.string, a.from) < std::tie(b.string, b.from);
+    });
+
+    return {
+        MakeChunk(kDbChunkXrefsByTarget, byTarget),
+        MakeChunk(kDbChunkCallsByCaller, calls),
+        MakeChunk(kDbChunkCallsByCallee, byCallee),
+        MakeChunk(kDbChunkStringRefs, strings),
+    };
+}
+
+bool XrefIndex::Open(const AnalysisDbView& db) {
+    m_db = &db;
+    m_xrefs.first = db.xrefs();
+    m_xrefs.last = db.xrefs() + db.xrefCount();
+    return MapRange(db, kDbChunkXrefsByTarget, &m_xrefsByTarget) &&
+           MapRange(db, kDbChunkCallsByCaller, &m_callsByCaller) &&
+           MapRange(db, kDbChunkCallsByCallee, &m_callsByCallee) && MapRange(db, kDbChunkStringRefs, &m_strings);
+}
+
+DbRange<DbCall> XrefIndex::Callers(uint32_t callee) const {
+    DbRange<DbCall> r;
+    r.first = std::lower_bound(m_callsByCallee.first, m_callsByCallee.last, callee,
+                               [](const DbCall& c, uint32_t v) { return c.callee < v; });
+    r.last = std::upper_bound(r.first, m_callsByCallee.last, callee,
+                              [](uint32_t v, const DbCall& c) { return v < c.callee; });
+    return r;
+}
+
+DbRange<DbCall> XrefIndex::Callees(uint32_t caller) const {
+    DbRange<DbCall> r;
+    r.first = std::lower_bound(m_callsByCaller.first, m_callsByCaller.last, caller,
+                               [](const DbCall& c, uint32_t v) { return c.caller < v; });
+    r.last = std::upper_bound(r.first, m_callsByCaller.last, caller,
+                              [](uint32_t v, const DbCall& c) { return v < c.caller; });
+    return r;
+}
+
+DbRange<DbXref> XrefIndex::RefsTo(uint32_t from, uint32_t to) const {
+    auto below = [](const DbXref& x, uint32_t v) { return x.to < v; };
+    DbRange<DbXref> r;
+    r.first = std::lower_bound(m_xrefsByTarget.first, m_xrefsByTarget.last, from, below);
+    r.last = std::lower_bound(r.first, m_xrefsByTarget.last, std::max(from, to), below);
+    return r;
+}
+
+DbRange<DbXref> XrefIndex::RefsFrom(uint32_t from, uint32_t to) const {
+    auto below = [](const DbXref& x, uint32_t v) { return x.from < v; };
+    DbRange<DbXref> r;
+    r.first = std::lower_bound(m_xrefs.first, m_xrefs.last, from, below);
+    r.last = std::lower_bound(r.first, m_xrefs.last, std::max(from, to), below);
+    return r;
+}
+
+bool XrefIndex::Path(uint32_t from, uint32_t to, std::vector<DbCall>* path) const {
+    path->clear();
+    const DbFunction* functions = m_db->functions();
+    const DbFunction* start = m_db->FunctionStartingAt(from);
+    if (!start) {
+        return false;
+    }
+
+    // Breadth-first over functions; each reached function remembers
+    // the edge it was first reached through.
+    const uint32_t kUnreached = ~0u;
+    const uint32_t kRoot = ~0u - 1;
+    std::vector<uint32_t> parent(m_db->functionCount(), kUnreached);
+    std::vector<uint32_t> queue;
+    queue.reserve(m_db->functionCount());
+    parent[start - functions] = kRoot;
+    queue.push_back(static_cast<uint32_t>(start - functions));
+    uint32_t found = kUnreached;
+    for (size_t head = 0; head < queue.size() && found == kUnreached; ++head) {
+        for (const DbCall& c : Callees(functions[queue[head]].start)) {
+            uint32_t edge = static_cast<uint32_t>(&c - m_callsByCaller.first);
+            if (c.callee == to) {
+                found = edge;
+                break;
+            }
+            const DbFunction* f = c.kind == kDbXrefImport ? nullptr : m_db->FunctionStartingAt(c.callee);
+            if (f && parent[f - functions] == kUnreached) {
+                parent[f - functions] = edge;
+                queue.push_back(static_cast<uint32_t>(f - functions));
+            }
+        }
+    }
+    if (found == kUnreached) {
+        return false;
+    }
+    for (uint32_t edge = found; edge != kRoot;) {
+        const DbCall& c = m_callsByCaller.first[edge];
+        path->push_back(c);
+        edge = parent[m_db->FunctionStartingAt(c.caller) - functions];
+    }
+    std::reverse(path->begin(), path->end());
+    return true;
+}
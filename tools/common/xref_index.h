@@ -0,0 +1,103 @@
+// Copyright (c) 2025
+//
+// Cross-reference and call-graph index over an analysis database.
+//
+// digi_disasm records every reference in 'XREF', sorted by the
+// referring address, which answers "what does this instruction use"
+// but not the questions asked while reconstructing a routine: who
+// calls 0x00495F5B, what reads the sine table at 0x4B0200, which
+// functions print this message.  BuildXrefIndex derives the sorted
+// arrays those need and digi_xref stores them as extra chunks of the
+// same database:
+//
+//     'XTGT'  DbXref, the 'XREF' records sorted by (to, from)
+//     'CGFR'  DbCall, call graph edges sorted by (caller, callee, site)
+//     'CGTO'  DbCall, the same edges sorted by (callee, caller, site)
+//     'SREF'  DbStringRef, references to strings sorted by (string, from)
+//
+// A call graph edge is a direct call, a jmp into another function (a
+// tail call or a thunk) or a call or jmp through an IAT slot, in which
+// case the callee is the slot.  XrefIndex maps the chunks through an
+// AnalysisDbView and answers each query with binary searches over
+// them, so nothing is parsed or built on open and a query costs a few
+// microseconds.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "analysis_db.h"
+#include "pe_image.h"
+
+const uint32_t kDbChunkXrefsByTarget = DbChunkId('X', 'T', 'G', 'T');
+const uint32_t kDbChunkCallsByCaller = DbChunkId('C', 'G', 'F', 'R');
+const uint32_t kDbChunkCallsByCallee = DbChunkId('C', 'G', 'T', 'O');
+const uint32_t kDbChunkStringRefs    = DbChunkId('S', 'R', 'E', 'F');
+
+struct DbCall {
+    uint32_t caller;            // start of the calling function
+    uint32_t callee;            // start of the called function, or the IAT slot
+    uint32_t site;              // the call or jmp instruction
+    uint32_t kind;              // kDbXrefCall, kDbXrefJump or kDbXrefImport
+};
+
+enum DbStringEncoding : uint32_t {
+    kDbStringBytes,             // NUL-terminated ASCII or CP949
+    kDbStringUtf16,             // NUL-terminated UTF-16LE
+};
+
+struct DbStringRef {
+    uint32_t string;            // VA of the first character
+    uint32_t from;              // the referring instruction
+    uint32_t length;            // in bytes, terminator excluded
+    uint32_t encoding;          // DbStringEncoding
+};
+
+// Derive the index chunks from `db`, which must have been built from
+// `image`.  The result goes to UpdateAnalysisDb.
+std::vector<AnalysisDb::Chunk> BuildXrefIndex(const PeImage& image, const AnalysisDbView& db);
+
+// [first, last) of one of the mapped arrays.
+template <typename T>
+struct DbRange {
+    const T* first = nullptr;
+    const T* last = nullptr;
+
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+class XrefIndex {
+public:
+    // Attach to the index chunks of `db`.  Returns false if digi_xref
+    // has not been run on it.  `db` must outlive the index.
+    bool Open(const AnalysisDbView& db);
+
+    // Edges into `callee` (a function start or an IAT slot).
+    DbRange<DbCall> Callers(uint32_t callee) const;
+    // Edges out of the function starting at `caller`.
+    DbRange<DbCall> Callees(uint32_t caller) const;
+    // References to any address in [from, to).
+    DbRange<DbXref> RefsTo(uint32_t from, uint32_t to) const;
+    // References made by the instructions in [from, to).
+    DbRange<DbXref> RefsFrom(uint32_t from, uint32_t to) const;
+    // Every referenced string, grouped by string.
+    DbRange<DbStringRef> Strings() const { return m_strings; }
+
+    // Shortest chain of call graph edges leading from the function
+    // starting at `from` to `to` (a function start or an IAT slot).
+    // Returns false, leaving `path` empty, if there is none.
+    bool Path(uint32_t from, uint32_t to, std::vector<DbCall>* path) const;
+
+private:
+    const AnalysisDbView* m_db = nullptr;
+    DbRange<DbXref>       m_xrefs;
+    DbRange<DbXref>       m_xrefsByTarget;
+    DbRange<DbCall>       m_callsByCaller;
+    DbRange<DbCall>       m_callsByCallee;
+    DbRange<DbStringRef>  m_strings;
+};
@@ -0,0 +1,154 @@
+// Copyright (c) 2025
+//
+// Stress test for DCStateTable (digi_analysis/dc_state_table.h).  Two
+// phases run on several threads at once:
+//
+//   * churn: each thread inserts, updates, reads back and removes its
+//     own DCs over and over, so the threads race on claiming slots,
+//     tombstones and probe chains that run through each other's keys;
+//   * contention: every thread exchanges the font of one shared DC.
+//     Each exchange returns the value it replaced, so across all
+//     threads every value written must come back exactly once, apart
+//     from the one left in the table at the end.
+//
+// Any lost update, duplicated value or torn read is reported and the
+// exit code is non-zero.  The interesting build is the one under
+// ThreadSanitizer, which MSVC lacks; posix/ provides the few Windows
+// types the table needs:
+//
+//     g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -Itools/dc_state_stress/posix tools/dc_state_stress/dc_state_stress.cpp digi_analysis/dc_state_table.cpp -o dc_state_stress
+//     dc_state_stress [threads] [iterations]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../../digi_analysis/dc_state_table.h"
+
+namespace {
+    // Per thread.  Well under the table's capacity even at eight
+    // threads, so inserts must never fail.
+    const uintptr_t kDCsPerThread = 6;
+
+    // Handles look like GDI's: a type tag in the high bits, spaced by
+    // four.  Values 0-2 are the table's own key markers.
+    HDC MakeDC(unsigned thread, uintptr_t index) {
+        return reinterpret_cast<HDC>(0x01010000u + (thread * kDCsPerThread + index) * 4);
+    }
+
+    HFONT MakeFont(uintptr_t value) {
+        return reinterpret_cast<HFONT>(value);
+    }
+
+    std::atomic<unsigned> g_failures{ 0 };
+
+    void Fail(const char* what, unsigned thread, unsigned iteration) {
+        if (g_failures.fetch_add(1) < 10) {
+            std::fprintf(stderr, "thread %u, iteration %u: %s\n", thread, iteration, what);
+        }
+    }
+
+    void Churn(DCStateTable* table, unsigned thread, unsigned iterations) {
+        for (unsigned it = 0; it < iterations; ++it) {
+            HDC dc = MakeDC(thread, it % kDCsPerThread);
+            COLORREF colour = (thread << 24) | it;
+            DCState state{ dc, MakeFont(it + 16), colour, colour ^ 0xFFFFFF, 1 };
+            if (!table->Insert(state)) {
+                Fail("insert failed", thread, it);
+                continue;
+            }
+            COLORREF prev;
+            if (!table->ExchangeTextColor(dc, colour + 1, &prev) || prev != colour) {
+                Fail("text colour exchange returned the wrong value", thread, it);
+            }
+            int mode;
+            if (!table->ExchangeBkMode(dc, 2, &mode) || mode != 1) {
+                Fail("background mode exchange returned the wrong value", thread, it);
+            }
+            DCState read;
+            if (!table->Get(dc, &read) || read.font != state.font || read.textColor != colour + 1 ||
+                read.bkColor != state.bkColor || read.bkMode != 2) {
+                Fail("read back the wrong state", thread, it);
+            }
+            if (!table->Remove(dc) || table->Contains(dc)) {
+                Fail("remove failed", thread, it);
+            }
+        }
+    }
+
+    // Fonts written by thread t are t * iterations + i + 16; the
+    // initial font is 1.
+    void Contend(DCStateTable* table, HDC shared, unsigned thread, unsigned iterations,
+                 std::vector<uintptr_t>* returned) {
+        for (unsigned it = 0; it < iterations; ++it) {
+            HFONT prev;
+            uintptr_t value = uintptr_t(thread) * iterations + it + 16;
+            if (!table->ExchangeFont(shared, MakeFont(value), &prev)) {
+                Fail("shared DC went missing", thread, it);
+                return;
+            }
+            returned->push_back(reinterpret_cast<uintptr_t>(prev));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 4;
+    unsigned iterations = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 20000;
+    if (threads == 0 || threads > 8 || iterations == 0) {
+        std::fprintf(stderr, "usage: dc_state_stress [threads (1-8)] [iterations]\n");
+        return 1;
+    }
+
+    DCStateTable table;
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(Churn, &table, t, iterations);
+    }
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    pool.clear();
+
+    const HDC shared = reinterpret_cast<HDC>(0x0101F000u);
+    table.Insert(DCState{ shared, MakeFont(1), 0, 0, 0 });
+    std::vector<std::vector<uintptr_t>> returned(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(Contend, &table, shared, t, iterations, &returned[t]);
+    }
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    HFONT last = nullptr;
+    table.GetFont(shared, &last);
+    std::vector<uint8_t> seen(size_t(threads) * iterations + 16, 0);
+    seen[reinterpret_cast<uintptr_t>(last)]++;
+    for (const std::vector<uintptr_t>& values : returned) {
+        for (uintptr_t v : values) {
+            if (v >= seen.size() || (v != 1 && v < 16)) {
+                if (g_failures.fetch_add(1) < 10) {
+                    std::fprintf(stderr, "an exchange returned font %u, which was never written\n",
+                                 static_cast<unsigned>(v));
+                }
+            } else {
+                seen[v]++;
+            }
+        }
+    }
+    for (size_t v = 0; v < seen.size(); ++v) {
+        bool written = v == 1 || v >= 16;
+        if (written && seen[v] != 1) {
+            if (g_failures.fetch_add(1) < 10) {
+                std::fprintf(stderr, "font %u %s\n", static_cast<unsigned>(v),
+                             seen[v] == 0 ? "was lost" : "came back more than once");
+            }
+        }
+    }
+
+    unsigned failures = g_failures.load();
+    std::printf("%u threads x %u iterations: %u failures\n", threads, iterations, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+// Copyright (c) 2025
+//
+// The handful of <windows.h> types dc_state_table.h needs, so the
+// stress test builds with GCC or Clang and runs under ThreadSanitizer,
+// which MSVC does not offer.  Only put on the include path for that
+// build; see dc_state_stress.cpp.
+
+#pragma once
+
+#include <cstdint>
+
+struct HDC__;
+struct HFONT__;
+typedef HDC__*        HDC;
+typedef HFONT__*      HFONT;
+typedef unsigned long COLORREF;
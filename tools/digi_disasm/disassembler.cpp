@@ -0,0 +1,1048 @@
+// Copyright (c) 2025
+//
+// Parallel recursive-descent disassembler.  See disassembler.h.
+
+#include "disassembler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common/x86_decode.h"
+
+namespace {
+    // Instructions kept for looking back from an indirect jump.
+    const size_t kHistory = 32;
+    // Upper bound for a jump table whose size could not be recovered.
+    const uint32_t kMaxUnboundedCases = 256;
+    // A worker shares part of its stack once it holds this many addresses.
+    const size_t kShareThreshold = 16;
+
+    struct FunctionSeed {
+        uint32_t address;
+        uint32_t flags;             // DbFunctionFlags
+    };
+
+    struct Worker {
+        std::vector<uint32_t>     stack;
+        std::vector<DbXref>       xrefs;
+        std::vector<FunctionSeed> functions;
+        std::vector<uint32_t>     candidates;   // immediates pointing into .text
+        X86Insn                   history[kHistory];
+        size_t                    historyCount = 0;
+        uint32_t                  invalid = 0;
+        uint32_t                  overlaps = 0;
+    };
+
+    // 64-bit FNV-1a, fed piecewise.
+    class Fnv64 {
+    public:
+        void Add(const uint8_t* p, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                m_hash = (m_hash ^ p[i]) * 1099511628211ull;
+            }
+        }
+        void Add32(uint32_t v) {
+            const uint8_t b[4] = { static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+                                   static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24) };
+            Add(b, sizeof(b));
+        }
+        uint64_t value() const { return m_hash; }
+
+    private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    // Length of the instruction starting at `va`, read off the byte
+    // flags: its code bytes run up to the next instruction start.
+    template <typename FlagsAt>
+    uint32_t InsnLength(uint32_t va, FlagsAt flagsAt) {
+        uint32_t n = 1;
+        while (n < 15 && (flagsAt(va + n) & (kDbCode | kDbInsn)) == kDbCode) {
+            ++n;
+        }
+        return n;
+    }
+
+    // DbFunctionHash::hash of the function at `start` that owns `insns`
+    // (ascending, all inside .text, whose bytes start at `code`): the
+    // address and bytes of each instruction, any relocation inside it,
+    // and the jump and index tables it uses.  `flagsAt` supplies the
+    // byte flags the lengths are read from and `tableAt` the jump table
+    // at a jmp, so the same hash can be taken with the flags of this run
+    // or of a previous database.
+    template <typename FlagsAt, typename TableAt>
+    uint64_t HashFunction(const PeImage& image, const uint8_t* code, uint32_t textStart, uint32_t start,
+                          const uint32_t* insns, size_t count, FlagsAt flagsAt, TableAt tableAt) {
+        const std::vector<uint32_t>& relocations = image.relocations();
+        Fnv64 h;
+        h.Add32(start);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t va = insns[i];
+            uint32_t length = InsnLength(va, flagsAt);
+            h.Add32(va);
+            h.Add(code + (va - textStart), length);
+            if (!relocations.empty()) {
+                for (auto r = std::lower_bound(relocations.begin(), relocations.end(), va);
+                     r != relocations.end() && *r < va + length; ++r) {
+                    h.Add32(*r - va);
+                }
+            }
+            if (const DbJumpTable* t = tableAt(va)) {
+                size_t avail = 0;
+                h.Add32(t->table);
+                h.Add32(t->indexTable);
+                const uint8_t* p = image.At(t->table, &avail);
+                h.Add(p, std::min<size_t>(t->count * 4u, p ? avail : 0));
+                p = image.At(t->indexTable, &avail);
+                h.Add(p, std::min<size_t>(t->indexCount, p ? avail : 0));
+            }
+        }
+        return h.value();
+    }
+
+    // First record at or after `x` whose `from` is not below `va`,
+    // galloping from `x` since the lookups come in ascending order.
+    const DbXref* SkipXrefs(const DbXref* x, const DbXref* end, uint32_t va) {
+        size_t step = 1;
+        const DbXref* low = x;
+        while (x != end && x->from < va) {
+            low = x + 1;
+            x = static_cast<size_t>(end - x) > step ? x + step : end;
+            step *= 2;
+        }
+        return std::lower_bound(low, x, va, [](const DbXref& a, uint32_t v) { return a.from < v; });
+    }
+
+    // A function of the previous database whose hash still matches.
+    struct ReusedFunction {
+        uint32_t              start;
+        size_t                previousIndex;
+        const uint32_t*       insns;        // its 'FINS' entries, ascending
+        uint32_t              insnCount;
+        // Its instructions and the targets of its branches: if their
+        // flags also came out as before, so does its extent walk.
+        std::vector<uint32_t> watch;
+    };
+
+    class Engine {
+    public:
+        Engine(const PeImage& image, const PeSection& text, unsigned threads)
+            : m_image(image),
+              m_textStart(text.va),
+              m_threads(threads) {
+            size_t avail = 0;
+            m_code = image.At(text.va, &avail);
+            m_textSize = static_cast<uint32_t>(std::min<size_t>(avail, text.virtualSize ? text.virtualSize : avail));
+            m_flags.reset(new std::atomic<uint8_t>[m_textSize]);
+            for (uint32_t i = 0; i < m_textSize; ++i) {
+                m_flags[i].store(0, std::memory_order_relaxed);
+            }
+            m_workers.resize(threads);
+        }
+
+        bool InText(uint32_t va) const {
+            return va - m_textStart < m_textSize;
+        }
+
+        uint8_t Flags(uint32_t va) const {
+            return m_flags[va - m_textStart].load(std::memory_order_relaxed);
+        }
+
+        void Seed(uint32_t va, uint32_t functionFlags) {
+            if (!InText(va)) {
+                return;
+            }
+            m_flags[va - m_textStart].fetch_or(kDbFunction | kDbBlock, std::memory_order_relaxed);
+            m_workers[0].functions.push_back({ va, functionFlags });
+            m_queue.push_back(va);
+        }
+
+        // Run the workers until the queue and every private stack is empty.
+        void Trace() {
+            m_idle = 0;
+            m_finished = false;
+            std::vector<std::thread> threads;
+            for (unsigned i = 1; i < m_threads; ++i) {
+                threads.emplace_back([this, i] { Run(m_workers[i]); });
+            }
+            Run(m_workers[0]);
+            for (std::thread& t : threads) {
+                t.join();
+            }
+        }
+
+        // Addresses in data sections and immediates that point at an
+        // undecoded, plausible instruction start.  Returns how many were
+        // queued.
+        size_t SeedFromPointers(std::vector<DbXref>* pointerXrefs, bool first) {
+            std::vector<uint32_t> candidates;
+            for (Worker& w : m_workers) {
+                candidates.insert(candidates.end(), w.candidates.begin(), w.candidates.end());
+                w.candidates.clear();
+            }
+            if (first) {
+                for (const PeSection& s : m_image.sections()) {
+                    if (s.IsCode()) {
+                        continue;
+                    }
+                    size_t avail = 0;
+                    const uint8_t* p = m_image.At(s.va, &avail);
+                    for (size_t off = 0; p && off + 4 <= avail; off += 4) {
+                        uint32_t v = static_cast<uint32_t>(p[off]) | (static_cast<uint32_t>(p[off + 1]) << 8) |
+                                     (static_cast<uint32_t>(p[off + 2]) << 16) |
+                                     (static_cast<uint32_t>(p[off + 3]) << 24);
+                        if (InText(v)) {
+                            pointerXrefs->push_back({ s.va + static_cast<uint32_t>(off), v, kDbXrefPointer });
+                            candidates.push_back(v);
+                        }
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            size_t queued = 0;
+            for (uint32_t va : candidates) {
+                uint8_t f = Flags(va);
+                if (f & kDbFunction) {
+                    continue;
+                }
+                if ((f & kDbInsn) || PlausibleStart(va)) {
+                    if (!(f & kDbInsn) && !(f & kDbCode)) {
+                        m_queue.push_back(va);
+                        ++queued;
+                    }
+                    // Only an entry that is not already inside a decoded
+                    // function body becomes a function of its own; a label
+                    // of a switch or an SEH scope just stays a block.
+                    if (!(f & kDbInsn) || FollowsBoundary(va)) {
+                        m_flags[va - m_textStart].fetch_or(kDbFunction | kDbBlock, std::memory_order_relaxed);
+                        m_workers[0].functions.push_back({ va, kDbFuncPointer });
+                    }
+                }
+            }
+            return queued;
+        }
+
+        // Walk .text in address order and trace from the start of each
+        // stretch nothing reached, past any padding, that decodes like
+        // code.  MSVC links whole object files, so library functions the
+        // game never calls (and the functions only they call) sit between
+        // the live ones.  Each gap is traced to completion before the next
+        // is looked for, on this thread, so a function is decoded from its
+        // first byte before anything could start in the middle of it; the
+        // effect is that of a linear sweep that still never decodes jump
+        // tables or padding.  Returns how many functions it found.
+        size_t SweepGaps() {
+            size_t found = 0;
+            Worker& w = m_workers[0];
+            uint32_t end = m_textStart + m_textSize;
+            for (uint32_t va = m_textStart; va < end; ++va) {
+                if (Flags(va) || IsPadding(va) || !PlausibleStart(va)) {
+                    continue;
+                }
+                m_flags[va - m_textStart].fetch_or(kDbFunction | kDbBlock, std::memory_order_relaxed);
+                w.functions.push_back({ va, kDbFuncUnreferenced });
+                w.stack.push_back(va);
+                while (!w.stack.empty()) {
+                    uint32_t next = w.stack.back();
+                    w.stack.pop_back();
+                    TraceFrom(w, next);
+                }
+                ++found;
+            }
+            return found;
+        }
+
+        // Look up every function of `previous` whose hash is unchanged
+        // in this image.  Nothing is claimed or seeded here: when the
+        // trace reaches the start of such a function its instructions,
+        // xrefs, jump tables and labels are replayed from `previous`
+        // instead of decoded, so functions are found, and labelled as
+        // called, pointed to or unreferenced, exactly as a full run finds
+        // them.  Returns how many can be taken over.
+        size_t Reuse(const AnalysisDbView& previous);
+
+        void ComputeExtents(std::vector<DbFunction>* out, std::vector<DbFunctionHash>* hashes,
+                            std::vector<uint32_t>* insns);
+
+        void Collect(AnalysisDb* db, DisassemblerStats* stats) {
+            db->flags.resize(m_textSize);
+            uint32_t instructions = 0, codeBytes = 0, dataBytes = 0;
+            for (uint32_t i = 0; i < m_textSize; ++i) {
+                uint8_t f = m_flags[i].load(std::memory_order_relaxed);
+                db->flags[i] = f;
+                instructions += (f & kDbInsn) != 0;
+                codeBytes += (f & kDbCode) != 0;
+                dataBytes += (f & kDbData) != 0;
+            }
+            for (Worker& w : m_workers) {
+                db->xrefs.insert(db->xrefs.end(), w.xrefs.begin(), w.xrefs.end());
+                stats->invalid += w.invalid;
+                stats->overlaps += w.overlaps;
+            }
+            std::sort(m_tables.begin(), m_tables.end(),
+                      [](const DbJumpTable& a, const DbJumpTable& b) { return a.jump < b.jump; });
+            db->jumpTables = m_tables;
+            db->info.textStart = m_textStart;
+            db->info.textSize = m_textSize;
+            db->info.instructionCount = instructions;
+            stats->instructions = instructions;
+            stats->codeBytes = codeBytes;
+            stats->dataBytes = dataBytes;
+        }
+
+    private:
+        void Run(Worker& w);
+        void TraceFrom(Worker& w, uint32_t va);
+        void NoteOperands(Worker& w, const X86Insn& insn);
+        void JumpTable(Worker& w, const X86Insn& jump);
+        void Discover(Worker& w, uint32_t va);
+        void Replay(Worker& w, const ReusedFunction& r);
+
+        bool IsPadding(uint32_t va) const {
+            uint8_t b = m_code[va - m_textStart];
+            return b == 0xCC || b == 0x90;
+        }
+
+        bool FollowsFiller(uint32_t va) const {
+            for (uint32_t back = 2; back <= 7 && va - back >= m_textStart; ++back) {
+                X86Insn insn;
+                if (DecodeX86(m_code + (va - back - m_textStart), back, va - back, &insn) && insn.length == back &&
+                    X86IsFiller(insn)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Whether `va` follows something a function cannot run on from:
+        // padding, a table, or a decoded ret or jmp.  Alignment alone is
+        // not enough; too many constants in the data sections are round
+        // numbers that land inside code.
+        bool FollowsBoundary(uint32_t va) const {
+            if (va == m_textStart) {
+                return true;
+            }
+            uint8_t prevFlags = Flags(va - 1);
+            if (prevFlags & kDbData) {
+                return true;
+            }
+            if (!(prevFlags & kDbCode)) {
+                return IsPadding(va - 1) || FollowsFiller(va);
+            }
+            for (uint32_t back = 1; back <= 15 && va - back >= m_textStart; ++back) {
+                uint32_t s = va - back;
+                X86Insn insn;
+                if ((Flags(s) & kDbInsn) && DecodeX86(m_code + (s - m_textStart), back, s, &insn) &&
+                    insn.length == back) {
+                    return insn.flow == X86Flow::kReturn || insn.flow == X86Flow::kJump ||
+                           insn.flow == X86Flow::kIndirectJump || insn.flow == X86Flow::kStop;
+                }
+            }
+            return false;
+        }
+
+        // An address nothing decoded yet: accept it when it starts after
+        // a boundary and a short straight-line decode from
+        // it stays valid, and clear of decoded bytes, until it leaves the
+        // block.
+        bool PlausibleStart(uint32_t va) const {
+            if (Flags(va) & (kDbCode | kDbData)) {
+                return false;
+            }
+            if (!FollowsBoundary(va)) {
+                return false;
+            }
+            uint32_t at = va;
+            for (int i = 0; i < 32 && InText(at); ++i) {
+                X86Insn insn;
+                if (!DecodeX86(m_code + (at - m_textStart), m_textSize - (at - m_textStart), at, &insn)) {
+                    return false;
+                }
+                for (uint32_t b = 0; b < insn.length; ++b) {
+                    if (!InText(at + b) || (Flags(at + b) & (kDbCode | kDbData))) {
+                        return false;
+                    }
+                }
+                if (insn.flow == X86Flow::kReturn || insn.flow == X86Flow::kJump ||
+                    insn.flow == X86Flow::kIndirectJump) {
+                    return true;
+                }
+                if (insn.flow == X86Flow::kStop) {
+                    return false;
+                }
+                at += insn.length;
+            }
+            return true;
+        }
+
+        const PeImage&                          m_image;
+        const uint8_t*                          m_code = nullptr;
+        uint32_t                                m_textStart;
+        uint32_t                                m_textSize = 0;
+        unsigned                                m_threads;
+        std::unique_ptr<std::atomic<uint8_t>[]> m_flags;
+        std::vector<Worker>                     m_workers;
+
+        std::mutex                              m_mutex;
+        std::condition_variable                 m_wake;
+        std::vector<uint32_t>                   m_queue;
+        unsigned                                m_idle = 0;
+        std::atomic<unsigned>                   m_waiting{ 0 };
+        bool                                    m_finished = false;
+
+        std::mutex                              m_tableMutex;
+        std::vector<DbJumpTable>                m_tables;
+
+        const AnalysisDbView*                   m_previous = nullptr;
+        std::vector<ReusedFunction>             m_reused;     // sorted by start
+        std::vector<uint32_t>                   m_reusedAt;   // per byte of .text: index in m_reused + 1, or 0
+    };
+
+    size_t Engine::Reuse(const AnalysisDbView& previous) {
+        const DbInfo& info = previous.info();
+        const DbFunctionHash* hashes = previous.functionHashes();
+        if (!hashes || info.imageBase != m_image.imageBase() || info.textStart != m_textStart ||
+            info.textSize != m_textSize) {
+            return 0;               // nothing recorded, or a different layout
+        }
+        m_previous = &previous;
+        const uint8_t* previousFlagBytes = previous.flags();
+        auto previousFlags = [this, previousFlagBytes](uint32_t va) {
+            return InText(va) ? previousFlagBytes[va - m_textStart] : static_cast<uint8_t>(0);
+        };
+        auto previousTable = [&previous](uint32_t va) { return previous.JumpTableAt(va); };
+        const DbXref* xrefs = previous.xrefs();
+        const DbXref* xrefsEnd = xrefs + previous.xrefCount();
+
+        m_reusedAt.assign(m_textSize, 0);
+        for (size_t i = 0; i < previous.functionCount(); ++i) {
+            const DbFunction& f = previous.functions()[i];
+            const DbFunctionHash& h = hashes[i];
+            const uint32_t* insns = previous.functionInsns() + h.firstInsn;
+            if (static_cast<size_t>(h.firstInsn) + h.insnCount > previous.functionInsnCount() ||
+                !std::binary_search(insns, insns + h.insnCount, f.start) ||
+                !std::all_of(insns, insns + h.insnCount, [this](uint32_t va) { return InText(va); }) ||
+                HashFunction(m_image, m_code, m_textStart, f.start, insns, h.insnCount, previousFlags, previousTable) !=
+                    h.hash) {
+                continue;           // changed: decoded again if anything still reaches it
+            }
+            ReusedFunction r = { f.start, i, insns, h.insnCount, std::vector<uint32_t>(insns, insns + h.insnCount) };
+            const DbXref* x = xrefs;
+            for (uint32_t k = 0; k < h.insnCount; ++k) {
+                for (x = SkipXrefs(x, xrefsEnd, insns[k]); x != xrefsEnd && x->from == insns[k]; ++x) {
+                    if ((x->kind == kDbXrefBranch || x->kind == kDbXrefJump || x->kind == kDbXrefCase) &&
+                        InText(x->to)) {
+                        r.watch.push_back(x->to);
+                    }
+                }
+            }
+            std::sort(r.watch.begin(), r.watch.end());
+            r.watch.erase(std::unique(r.watch.begin(), r.watch.end()), r.watch.end());
+            m_reusedAt[f.start - m_textStart] = static_cast<uint32_t>(m_reused.size() + 1);
+            m_reused.push_back(std::move(r));
+        }
+        return m_reused.size();
+    }
+
+    // Claim the instructions of `r` and leave behind exactly what
+    // TraceFrom would have: the byte flags, xrefs, jump tables, labels,
+    // function seeds and operand candidates recorded for them, and the
+    // addresses they lead to outside the function on the stack.  Any
+    // instruction another path decoded first is left to that path, as
+    // TraceFrom leaves it.
+    void Engine::Replay(Worker& w, const ReusedFunction& r) {
+        const AnalysisDbView& previous = *m_previous;
+        const uint8_t* previousFlagBytes = previous.flags();
+        auto previousFlags = [this, previousFlagBytes](uint32_t va) {
+            return InText(va) ? previousFlagBytes[va - m_textStart] : static_cast<uint8_t>(0);
+        };
+        const DbXref* xrefs = previous.xrefs();
+        const DbXref* xrefsEnd = xrefs + previous.xrefCount();
+        // Whoever claims the entry replays the function.
+        uint8_t entryFlags = m_flags[r.start - m_textStart].fetch_or(kDbInsn, std::memory_order_relaxed);
+        if (entryFlags & kDbInsn) {
+            return;
+        }
+        const DbXref* x = xrefs;
+        for (uint32_t k = 0; k < r.insnCount; ++k) {
+            uint32_t va = r.insns[k];
+            uint32_t offset = va - m_textStart;
+            uint8_t old = va == r.start ? entryFlags : m_flags[offset].fetch_or(kDbInsn, std::memory_order_relaxed);
+            if (va != r.start && (old & kDbInsn)) {
+                continue;
+            }
+            if (old & (kDbCode | kDbData)) {
+                ++w.overlaps;
+            }
+            uint32_t length = InsnLength(va, previousFlags);
+            for (uint32_t b = 0; b < length && offset + b < m_textSize; ++b) {
+                m_flags[offset + b].fetch_or(kDbCode, std::memory_order_relaxed);
+            }
+            if (const DbJumpTable* t = previous.JumpTableAt(va)) {
+                for (uint32_t b = 0; b < t->count * 4; ++b) {
+                    if (InText(t->table + b)) {
+                        m_flags[t->table + b - m_textStart].fetch_or(kDbData, std::memory_order_relaxed);
+                    }
+                }
+                for (uint32_t b = 0; b < t->indexCount; ++b) {
+                    if (InText(t->indexTable + b)) {
+                        m_flags[t->indexTable + b - m_textStart].fetch_or(kDbData, std::memory_order_relaxed);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(m_tableMutex);
+                m_tables.push_back(*t);
+            }
+
+            uint32_t next = va + length;
+            for (x = SkipXrefs(x, xrefsEnd, va); x != xrefsEnd && x->from == va; ++x) {
+                w.xrefs.push_back(*x);
+                bool inText = InText(x->to);
+                switch (x->kind) {
+                case kDbXrefCall:
+                    if (inText) {
+                        uint8_t f = m_flags[x->to - m_textStart].fetch_or(kDbFunction | kDbBlock,
+                                                                         std::memory_order_relaxed);
+                        if (!(f & kDbFunction)) {
+                            w.functions.push_back({ x->to, kDbFuncCalled });
+                        }
+                        Discover(w, x->to);
+                    }
+                    break;
+                case kDbXrefBranch:
+                    if (InText(next)) {
+                        m_flags[next - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                    }
+                    if (inText) {
+                        m_flags[x->to - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                        Discover(w, x->to);
+                    }
+                    break;
+                case kDbXrefJump:
+                case kDbXrefCase:
+                    if (inText) {
+                        m_flags[x->to - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                        Discover(w, x->to);
+                    }
+                    break;
+                case kDbXrefOffset:
+                    if (inText) {
+                        w.candidates.push_back(x->to);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // The walk that listed the instructions stops at function
+            // entries, so one that runs on into the next function has to
+            // hand it to the trace.  Only those few are decoded.
+            if (k + 1 < r.insnCount && r.insns[k + 1] == next) {
+                continue;
+            }
+            X86Insn insn;
+            if (InText(next) && DecodeX86(m_code + offset, m_textSize - offset, va, &insn) &&
+                (insn.flow == X86Flow::kNone || insn.flow == X86Flow::kCall ||
+                 insn.flow == X86Flow::kIndirectCall || insn.flow == X86Flow::kCondJump)) {
+                Discover(w, next);
+            }
+        }
+    }
+
+    void Engine::Run(Worker& w) {
+        for (;;) {
+            if (w.stack.empty()) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (m_queue.empty()) {
+                    if (++m_idle == m_threads) {
+                        m_finished = true;
+                        m_wake.notify_all();
+                        return;
+                    }
+                    m_waiting.fetch_add(1, std::memory_order_relaxed);
+                    m_wake.wait(lock, [this] { return !m_queue.empty() || m_finished; });
+                    m_waiting.fetch_sub(1, std::memory_order_relaxed);
+                    if (m_finished) {
+                        return;
+                    }
+                    --m_idle;
+                }
+                size_t take = std::min<size_t>(m_queue.size(), 64);
+                w.stack.assign(m_queue.end() - static_cast<std::ptrdiff_t>(take), m_queue.end());
+                m_queue.resize(m_queue.size() - take);
+            }
+            uint32_t va = w.stack.back();
+            w.stack.pop_back();
+            TraceFrom(w, va);
+
+            if (w.stack.size() >= kShareThreshold && m_waiting.load(std::memory_order_relaxed) > 0) {
+                size_t half = w.stack.size() / 2;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_queue.insert(m_queue.end(), w.stack.begin(), w.stack.begin() + static_cast<std::ptrdiff_t>(half));
+                w.stack.erase(w.stack.begin(), w.stack.begin() + static_cast<std::ptrdiff_t>(half));
+                m_wake.notify_all();
+            }
+        }
+    }
+
+    void Engine::Discover(Worker& w, uint32_t va) {
+        if (InText(va) && !(Flags(va) & kDbInsn)) {
+            w.stack.push_back(va);
+        }
+    }
+
+    void Engine::NoteOperands(Worker& w, const X86Insn& insn) {
+        uint32_t image = m_image.imageBase();
+        for (int i = 0; i < insn.operandCount; ++i) {
+            const X86Operand& op = insn.operands[i];
+            uint32_t address;
+            if (op.type == kX86OpRel || !X86OperandAddress(op, &address) ||
+                address - image >= m_image.sizeOfImage()) {
+                continue;
+            }
+            if (op.type == kX86OpMem) {
+                bool viaIat = (insn.flow == X86Flow::kIndirectCall || insn.flow == X86Flow::kIndirectJump) &&
+                              op.base == kX86NoReg && op.index == kX86NoReg && !InText(address);
+                w.xrefs.push_back({ insn.address, address, viaIat ? kDbXrefImport : kDbXrefMemory });
+            } else {
+                w.xrefs.push_back({ insn.address, address, kDbXrefOffset });
+                if (InText(address)) {
+                    w.candidates.push_back(address);
+                }
+            }
+        }
+    }
+
+    void Engine::TraceFrom(Worker& w, uint32_t va) {
+        w.historyCount = 0;
+        while (InText(va)) {
+            uint32_t offset = va - m_textStart;
+            if (!m_reusedAt.empty() && m_reusedAt[offset]) {
+                Replay(w, m_reused[m_reusedAt[offset] - 1]);
+                return;
+            }
+            uint8_t old = m_flags[offset].fetch_or(kDbInsn, std::memory_order_relaxed);
+            if (old & kDbInsn) {
+                return;
+            }
+            if (old & (kDbCode | kDbData)) {
+                ++w.overlaps;
+            }
+            X86Insn insn;
+            if (!DecodeX86(m_code + offset, m_textSize - offset, va, &insn)) {
+                m_flags[offset].fetch_and(static_cast<uint8_t>(~kDbInsn), std::memory_order_relaxed);
+                ++w.invalid;
+                return;
+            }
+            for (uint32_t i = 0; i < insn.length && offset + i < m_textSize; ++i) {
+                m_flags[offset + i].fetch_or(kDbCode, std::memory_order_relaxed);
+            }
+            NoteOperands(w, insn);
+            w.history[w.historyCount % kHistory] = insn;
+            ++w.historyCount;
+
+            uint32_t next = va + insn.length;
+            switch (insn.flow) {
+            case X86Flow::kNone:
+            case X86Flow::kIndirectCall:
+                va = next;
+                continue;
+            case X86Flow::kCall:
+                w.xrefs.push_back({ va, insn.target, kDbXrefCall });
+                if (InText(insn.target)) {
+                    uint8_t f = m_flags[insn.target - m_textStart].fetch_or(kDbFunction | kDbBlock,
+                                                                             std::memory_order_relaxed);
+                    if (!(f & kDbFunction)) {
+                        w.functions.push_back({ insn.target, kDbFuncCalled });
+                    }
+                    Discover(w, insn.target);
+                }
+                va = next;
+                continue;
+            case X86Flow::kCondJump:
+                w.xrefs.push_back({ va, insn.target, kDbXrefBranch });
+                if (InText(insn.target)) {
+                    m_flags[insn.target - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                    Discover(w, insn.target);
+                }
+                if (InText(next)) {
+                    m_flags[next - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                }
+                va = next;
+                continue;
+            case X86Flow::kJump:
+                w.xrefs.push_back({ va, insn.target, kDbXrefJump });
+                if (InText(insn.target)) {
+                    m_flags[insn.target - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+                    Discover(w, insn.target);
+                }
+                return;
+            case X86Flow::kIndirectJump:
+                JumpTable(w, insn);
+                return;
+            default:
+                return;
+            }
+        }
+    }
+
+    // Whether `op` is the 32-bit register `reg32` or its low byte, as
+    // the index loads in front of a byte-indexed switch write it.
+    bool IsRegister(const X86Operand& op, uint8_t reg32) {
+        if (op.type != kX86OpReg || op.regClass != kX86Gpr) {
+            return false;
+        }
+        return op.size == 1 ? reg32 < 4 && op.reg == reg32 : op.reg == reg32;
+    }
+
+    // Instructions that never write EFLAGS, among those compilers put
+    // between a compare and its branch.
+    bool KeepsFlags(const X86Insn& insn) {
+        uint16_t op = insn.opcode;
+        return (op >= 0x88 && op <= 0x8B) || op == 0x8D || op == 0xC6 || op == 0xC7 || (op >= 0x50 && op <= 0x5F) ||
+               op == 0x68 || op == 0x6A || op == 0x90 || op == 0xA1 || op == 0xA3 || (op >= 0xB0 && op <= 0xBF) ||
+               op == 0x0FB6 || op == 0x0FB7 || op == 0x0FBE || op == 0x0FBF ||
+               (op >= 0xD8 && op <= 0xDF && insn.mnemonic && insn.mnemonic[1] != 'u' && insn.mnemonic[1] != 'c');
+    }
+
+    void Engine::JumpTable(Worker& w, const X86Insn& jump) {
+        const X86Operand& m = jump.operands[0];
+        if (jump.opcode != 0xFF || m.type != kX86OpMem || m.base != kX86NoReg || m.index == kX86NoReg ||
+            m.scale != 4 || m.addrSize != 4) {
+            return;
+        }
+        uint32_t table = static_cast<uint32_t>(m.disp);
+
+        // Walk back for `movzx/mov idx8, byte ptr [reg + index]` and
+        // `cmp reg, n; ja`.  A miss leaves the bound open.
+        uint32_t bound = 0;
+        uint32_t indexTable = 0;
+        uint8_t guarded = m.index;
+        size_t have = std::min(w.historyCount, kHistory);
+        for (size_t back = 2; back <= have; ++back) {
+            const X86Insn& h = w.history[(w.historyCount - back) % kHistory];
+            if (h.operandCount == 2 && h.operands[1].type == kX86OpMem && h.operands[1].size == 1 &&
+                (h.opcode == 0x8A || h.opcode == 0x0FB6) && IsRegister(h.operands[0], guarded) &&
+                h.operands[1].base != kX86NoReg && h.operands[1].index == kX86NoReg && !indexTable) {
+                indexTable = static_cast<uint32_t>(h.operands[1].disp);
+                guarded = h.operands[1].base;
+                continue;
+            }
+            if (h.opcode == 0x77 || h.opcode == 0x0F87) {
+                // The compiler is free to schedule moves between the cmp
+                // and the ja, so skip whatever leaves the flags alone.
+                for (size_t more = back + 1; more <= have; ++more) {
+                    const X86Insn& c = w.history[(w.historyCount - more) % kHistory];
+                    if (KeepsFlags(c)) {
+                        continue;
+                    }
+                    bool isCmp = (c.opcode == 0x83 || c.opcode == 0x81 || c.opcode == 0x3D) &&
+                                 (c.opcode == 0x3D || c.reg == 7);
+                    if (isCmp && c.operands[1].type == kX86OpImm && IsRegister(c.operands[0], guarded)) {
+                        bound = c.operands[1].imm + 1;
+                    }
+                    break;
+                }
+                break;
+            }
+        }
+
+        uint32_t count = 0;
+        uint32_t indexCount = 0;
+        size_t avail = 0;
+        if (indexTable && bound) {
+            const uint8_t* idx = m_image.At(indexTable, &avail);
+            if (!idx || avail < bound) {
+                return;
+            }
+            indexCount = bound;
+            for (uint32_t i = 0; i < bound; ++i) {
+                count = std::max<uint32_t>(count, idx[i] + 1u);
+            }
+        } else if (!indexTable) {
+            count = bound;
+        }
+        const uint8_t* entries = m_image.At(table, &avail);
+        if (!entries) {
+            return;
+        }
+        uint32_t limit = count ? count : kMaxUnboundedCases;
+        uint32_t n = 0;
+        for (; n < limit && (n + 1) * 4 <= avail; ++n) {
+            uint32_t target = 0;
+            m_image.ReadU32(table + n * 4, &target);
+            if (!InText(target)) {
+                break;
+            }
+            // An unbounded table stops where the code after it begins.
+            if (!count && n && InText(table + n * 4) && (Flags(table + n * 4) & kDbInsn)) {
+                break;
+            }
+        }
+        if (count && n < count) {
+            return;                 // not the table the guard described
+        }
+        count = n;
+        if (!count) {
+            return;
+        }
+        if (indexTable && !indexCount) {
+            // Compared against a register: MSVC puts the index table
+            // straight after the targets, and every index is below their
+            // count, which padding and code bytes rarely are.
+            const uint8_t* idx = m_image.At(indexTable, &avail);
+            while (idx && indexCount < avail && indexCount < kMaxUnboundedCases && idx[indexCount] < count &&
+                   !(InText(indexTable + indexCount) && (Flags(indexTable + indexCount) & kDbInsn))) {
+                ++indexCount;
+            }
+        }
+
+        for (uint32_t i = 0; i < count * 4; ++i) {
+            if (InText(table + i)) {
+                m_flags[table + i - m_textStart].fetch_or(kDbData, std::memory_order_relaxed);
+            }
+        }
+        for (uint32_t i = 0; i < indexCount; ++i) {
+            if (InText(indexTable + i)) {
+                m_flags[indexTable + i - m_textStart].fetch_or(kDbData, std::memory_order_relaxed);
+            }
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t target = 0;
+            m_image.ReadU32(table + i * 4, &target);
+            w.xrefs.push_back({ jump.address, target, kDbXrefCase });
+            m_flags[target - m_textStart].fetch_or(kDbBlock, std::memory_order_relaxed);
+            Discover(w, target);
+        }
+        std::lock_guard<std::mutex> lock(m_tableMutex);
+        m_tables.push_back({ jump.address, table, count, indexTable, indexCount, 0 });
+    }
+
+    void Engine::ComputeExtents(std::vector<DbFunction>* out, std::vector<DbFunctionHash>* hashes,
+                                std::vector<uint32_t>* insns) {
+        std::vector<FunctionSeed> seeds;
+        for (Worker& w : m_workers) {
+            seeds.insert(seeds.end(), w.functions.begin(), w.functions.end());
+        }
+        std::sort(seeds.begin(), seeds.end(),
+                  [](const FunctionSeed& a, const FunctionSeed& b) { return a.address < b.address; });
+        std::vector<DbFunction>& functions = *out;
+        functions.clear();
+        for (const FunctionSeed& s : seeds) {
+            if (!(Flags(s.address) & kDbInsn)) {
+                continue;           // never decoded: a bad pointer
+            }
+            if (!functions.empty() && functions.back().start == s.address) {
+                functions.back().flags |= s.flags;
+            } else {
+                functions.push_back({ s.address, s.address, 0, 0, s.flags, 0 });
+            }
+        }
+
+        std::vector<std::vector<uint32_t>> owned(functions.size());
+        hashes->assign(functions.size(), DbFunctionHash());
+        auto flagsAt = [this](uint32_t va) { return InText(va) ? Flags(va) : static_cast<uint8_t>(0); };
+        auto tableAt = [this](uint32_t va) -> const DbJumpTable* {
+            auto it = std::lower_bound(m_tables.begin(), m_tables.end(), va,
+                                       [](const DbJumpTable& t, uint32_t a) { return t.jump < a; });
+            return it != m_tables.end() && it->jump == va ? &*it : nullptr;
+        };
+
+        // A function taken over from the previous database keeps its
+        // extent when every flag its walk would look at came out the
+        // same; otherwise it is walked like any other.
+        auto reuse = [&](DbFunction& f, size_t index) {
+            auto it = std::lower_bound(m_reused.begin(), m_reused.end(), f.start,
+                                       [](const ReusedFunction& r, uint32_t a) { return r.start < a; });
+            if (it == m_reused.end() || it->start != f.start) {
+                return false;
+            }
+            for (uint32_t va : it->watch) {
+                if (Flags(va) != m_previous->FlagsAt(va)) {
+                    return false;
+                }
+            }
+            const DbFunction& p = m_previous->functions()[it->previousIndex];
+            const DbFunctionHash& h = m_previous->functionHashes()[it->previousIndex];
+            const uint32_t* previousInsns = m_previous->functionInsns() + h.firstInsn;
+            f.end = p.end;
+            f.instructionCount = p.instructionCount;
+            f.blockCount = p.blockCount;
+            f.flags |= p.flags & (kDbFuncSwitch | kDbFuncThunk);
+            owned[index].assign(previousInsns, previousInsns + h.insnCount);
+            (*hashes)[index].hash = h.hash;
+            return true;
+        };
+
+        std::atomic<size_t> nextFunction{ 0 };
+        auto work = [&] {
+            // Visit marks are the function index + 1, so the array never
+            // needs clearing between functions.
+            std::vector<uint32_t> mark(m_textSize, 0);
+            std::vector<uint32_t> pending;
+            for (;;) {
+                size_t index = nextFunction.fetch_add(1, std::memory_order_relaxed);
+                if (index >= functions.size()) {
+                    return;
+                }
+                DbFunction& f = functions[index];
+                if (m_previous && reuse(f, index)) {
+                    continue;
+                }
+                std::vector<uint32_t>& mine = owned[index];
+                uint32_t stamp = static_cast<uint32_t>(index + 1);
+                pending.assign(1, f.start);
+                mark[f.start - m_textStart] = stamp;
+                while (!pending.empty()) {
+                    uint32_t va = pending.back();
+                    pending.pop_back();
+                    X86Insn insn;
+                    uint32_t offset = va - m_textStart;
+                    if (!(Flags(va) & kDbInsn) || !DecodeX86(m_code + offset, m_textSize - offset, va, &insn)) {
+                        continue;
+                    }
+                    ++f.instructionCount;
+                    mine.push_back(va);
+                    f.blockCount += (va == f.start || (Flags(va) & kDbBlock)) ? 1 : 0;
+                    f.end = std::max(f.end, va + insn.length);
+                    if (insn.flow == X86Flow::kJump && va == f.start) {
+                        f.flags |= kDbFuncThunk;
+                    }
+                    auto follow = [&](uint32_t to) {
+                        if (InText(to) && mark[to - m_textStart] != stamp && !(Flags(to) & kDbFunction)) {
+                            mark[to - m_textStart] = stamp;
+                            pending.push_back(to);
+                        }
+                    };
+                    switch (insn.flow) {
+                    case X86Flow::kNone:
+                    case X86Flow::kCall:
+                    case X86Flow::kIndirectCall:
+                        follow(va + insn.length);
+                        break;
+                    case X86Flow::kCondJump:
+                        follow(va + insn.length);
+                        follow(insn.target);
+                        break;
+                    case X86Flow::kJump:
+                        follow(insn.target);
+                        break;
+                    case X86Flow::kIndirectJump: {
+                        auto it = std::lower_bound(m_tables.begin(), m_tables.end(), va,
+                                                   [](const DbJumpTable& t, uint32_t a) { return t.jump < a; });
+                        if (it != m_tables.end() && it->jump == va) {
+                            f.flags |= kDbFuncSwitch;
+                            for (uint32_t i = 0; i < it->count; ++i) {
+                                uint32_t target = 0;
+                                m_image.ReadU32(it->table + i * 4, &target);
+                                follow(target);
+                            }
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                    }
+                }
+                if (f.flags & kDbFuncThunk && f.instructionCount != 1) {
+                    f.flags &= ~static_cast<uint32_t>(kDbFuncThunk);
+                }
+                std::sort(mine.begin(), mine.end());
+                (*hashes)[index].hash =
+                    HashFunction(m_image, m_code, m_textStart, f.start, mine.data(), mine.size(), flagsAt, tableAt);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < m_threads; ++i) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        insns->clear();
+        for (size_t i = 0; i < functions.size(); ++i) {
+            (*hashes)[i].firstInsn = static_cast<uint32_t>(insns->size());
+            (*hashes)[i].insnCount = static_cast<uint32_t>(owned[i].size());
+            insns->insert(insns->end(), owned[i].begin(), owned[i].end());
+        }
+    }
+
+    double Since(std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+    }
+}
+
+bool Disassemble(const PeImage& image, const DisassemblerOptions& options, AnalysisDb* db,
+                 DisassemblerStats* stats) {
+    const PeSection* text = nullptr;
+    for (const PeSection& s : image.sections()) {
+        if (s.IsCode()) {
+            text = &s;
+            break;
+        }
+    }
+    if (!text) {
+        return false;
+    }
+    *stats = DisassemblerStats();
+    unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, threads);
+    stats->threads = threads;
+
+    Engine engine(image, *text, threads);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (options.previous) {
+        stats->reused = static_cast<uint32_t>(engine.Reuse(*options.previous));
+    }
+    engine.Seed(image.entryPoint(), kDbFuncEntry);
+    for (const PeExport& e : image.exports()) {
+        engine.Seed(e.va, kDbFuncExport);
+    }
+    engine.Trace();
+    std::vector<DbXref> pointerXrefs;
+    stats->rounds = 1;
+    // Pointers first, so functions reached through them are labelled
+    // as such; gaps only once nothing else is left.
+    bool first = true;
+    for (;;) {
+        if (options.pointerSeeds && engine.SeedFromPointers(&pointerXrefs, first)) {
+            first = false;
+            engine.Trace();
+        } else if (!options.gapSeeds || !engine.SweepGaps()) {
+            break;
+        }
+        first = false;
+        ++stats->rounds;
+    }
+    stats->traceSeconds = Since(start);
+
+    start = std::chrono::steady_clock::now();
+    engine.Collect(db, stats);
+    engine.ComputeExtents(&db->functions, &db->functionHashes, &db->functionInsns);
+    stats->extentSeconds = Since(start);
+
+    db->xrefs.insert(db->xrefs.end(), pointerXrefs.begin(), pointerXrefs.end());
+    std::sort(db->xrefs.begin(), db->xrefs.end(), [](const DbXref& a, const DbXref& b) {
+        return a.from != b.from ? a.from < b.from : a.to != b.to ? a.to < b.to : a.kind < b.kind;
+    });
+    db->xrefs.erase(std::unique(db->xrefs.begin(), db->xrefs.end(),
+                                [](const DbXref& a, const DbXref& b) {
+                                    return a.from == b.from && a.to == b.to && a.kind == b.kind;
+                                }),
+                    db->xrefs.end());
+
+    db->info.imageBase = image.imageBase();
+    db->info.entryPoint = image.entryPoint();
+    db->info.imageSize = static_cast<uint32_t>(image.fileSize());
+    db->info.imageChecksum = ImageChecksum(image.fileData(), image.fileSize());
+    return true;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025
+//
+// Parallel recursive-descent disassembler for digi.exe.
+//
+// Decoding starts at the entry point and the exports and follows
+// control flow: fall-through, direct jumps and calls, and the
+// `jmp [reg*4 + table]` switches MSVC emits, whose tables (and the
+// byte index tables in front of sparse ones) are bounded by the
+// `cmp reg, n; ja default` guarding them and marked as data so no
+// sweep ever decodes them.  When the flow runs dry, dwords in the data
+// sections and immediates that point into .text at a plausible
+// instruction boundary seed another round; this picks up the window
+// procedures, vtables and callbacks nothing calls directly.  What is
+// still left over after that are the library functions the linker
+// pulled in and nothing uses; the start of each such gap seeds a last
+// set of rounds if it decodes like code.
+//
+// The work is spread over a pool of threads sharing one queue of
+// addresses.  Each byte of .text has an atomic flag byte, and an
+// address is claimed by setting its instruction bit, so every
+// instruction is decoded exactly once no matter how many paths reach
+// it.  A worker keeps the addresses it discovers on a private stack
+// and hands half of them to the shared queue only when another worker
+// is idle, so the lock is touched rarely.  Function extents are then
+// computed in parallel, one function per task: everything reachable
+// from its entry without crossing into another entry.
+//
+// Each function's hash (see DbFunctionHash) is stored with it, so a
+// database doubles as the cache for the next run.  Given the database
+// of an earlier run, a function whose hash comes out the same over the
+// new image is replayed from it when the trace reaches its entry, in
+// place of being decoded, and its extent is taken over when everything
+// its walk looks at is unchanged.  Functions are still found, and
+// labelled by how they were found, in the order a full run finds them,
+// so the result is the database a full run writes;
+// tools/disasm_reuse_check compares the two over a patched image.
+
+#pragma once
+
+#include <cstdint>
+
+#include "../common/analysis_db.h"
+#include "../common/pe_image.h"
+
+struct DisassemblerOptions {
+    unsigned threads = 0;           // 0: one per hardware thread
+    bool     pointerSeeds = true;   // seed from code pointers in data and immediates
+    bool     gapSeeds = true;       // seed from the stretches nothing reached
+    // Database of an earlier run over the same layout; functions whose
+    // hash is unchanged are replayed from it instead of re-analysed.
+    const AnalysisDbView* previous = nullptr;
+};
+
+struct DisassemblerStats {
+    double   traceSeconds = 0;      // recursive descent, all rounds
+    double   extentSeconds = 0;     // function extents
+    unsigned threads = 0;
+    unsigned rounds = 0;            // including pointer and gap seeding rounds
+    uint32_t instructions = 0;
+    uint32_t codeBytes = 0;
+    uint32_t dataBytes = 0;         // jump and index tables inside .text
+    uint32_t invalid = 0;           // paths that ran into an undecodable byte
+    uint32_t overlaps = 0;          // instructions starting inside another
+    uint32_t reused = 0;            // functions taken over from `previous`
+};
+
+// Disassemble `image` into `db`.  Returns false if the image has no
+// code section.
+bool Disassemble(const PeImage& image, const DisassemblerOptions& options, AnalysisDb* db,
+                 DisassemblerStats* stats);
@@ -0,0 +1,125 @@
+// Copyright (c) 2025
+//
+// Text listing.  See listing.h.
+
+#include "listing.h"
+
+#include <algorithm>
+
+#include "../common/x86_decode.h"
+
+namespace {
+    // Bytes per `db` line for unreached bytes.
+    const uint32_t kBytesPerLine = 8;
+
+    void WriteLine(std::FILE* out, uint32_t va, const uint8_t* bytes, uint32_t count, const char* text) {
+        char hex[3 * 16 + 1];
+        size_t len = 0;
+        for (uint32_t i = 0; i < count && i < 16; ++i) {
+            len += static_cast<size_t>(std::snprintf(hex + len, sizeof(hex) - len, i ? " %02X" : "%02X", bytes[i]));
+        }
+        std::fprintf(out, "%08X: %-20s %s\n", va, hex, text);
+    }
+
+    void WriteFunctionHeader(std::FILE* out, const DbFunction& f) {
+        std::fprintf(out, "\n; ---- sub_%08X  %u bytes, %u instructions, %u blocks", f.start, f.end - f.start,
+                     f.instructionCount, f.blockCount);
+        static const struct {
+            uint32_t    flag;
+            const char* name;
+        } s_flags[] = {
+            { kDbFuncEntry, "entry" }, { kDbFuncExport, "export" }, { kDbFuncPointer, "address taken" },
+            { kDbFuncSwitch, "switch" }, { kDbFuncThunk, "thunk" },
+            { kDbFuncUnreferenced, "unreferenced" },
+        };
+        for (const auto& s : s_flags) {
+            if (f.flags & s.flag) {
+                std::fprintf(out, ", %s", s.name);
+            }
+        }
+        std::fprintf(out, "\n");
+    }
+}
+
+void WriteListing(std::FILE* out, const PeImage& image, const AnalysisDbView& db, uint32_t from, uint32_t to) {
+    const DbInfo& info = db.info();
+    uint32_t textEnd = info.textStart + info.textSize;
+    from = std::max(from, info.textStart);
+    to = std::min(to, textEnd);
+    size_t avail = 0;
+    const uint8_t* text = image.At(info.textStart, &avail);
+    if (!text || from >= to) {
+        return;
+    }
+
+    uint32_t va = from;
+    while (va < to) {
+        uint8_t flags = db.FlagsAt(va);
+        const uint8_t* p = text + (va - info.textStart);
+        if (flags & kDbFunction) {
+            if (const DbFunction* f = db.FunctionStartingAt(va)) {
+                WriteFunctionHeader(out, *f);
+            }
+        } else if (flags & kDbBlock) {
+            std::fprintf(out, "loc_%08X:\n", va);
+        }
+
+        if (flags & kDbInsn) {
+            X86Insn insn;
+            if (DecodeX86(p, textEnd - va, va, &insn)) {
+                char buf[128];
+                FormatX86(insn, buf, sizeof(buf));
+                WriteLine(out, va, p, insn.length, buf);
+                if (const DbJumpTable* t = db.JumpTableAt(va)) {
+                    std::fprintf(out, "          ; switch: %u cases at 0x%x", t->count, t->table);
+                    if (t->indexTable) {
+                        std::fprintf(out, ", %u indices at 0x%x", t->indexCount, t->indexTable);
+                    }
+                    std::fprintf(out, "\n");
+                }
+                va += insn.length;
+                continue;
+            }
+        }
+
+        if (flags & kDbData) {
+            // Jump table entries are dwords; index tables are bytes.
+            uint32_t target = 0;
+            bool dword = va + 4 <= textEnd && (db.FlagsAt(va + 3) & kDbData) && image.ReadU32(va, &target) &&
+                         target - info.textStart < info.textSize && (db.FlagsAt(target) & kDbInsn);
+            char buf[64];
+            if (dword) {
+                std::snprintf(buf, sizeof(buf), "dd 0x%x", target);
+                WriteLine(out, va, p, 4, buf);
+                va += 4;
+                continue;
+            }
+            uint32_t n = 0;
+            while (n < kBytesPerLine && va + n < to && (db.FlagsAt(va + n) & kDbData) &&
+                   !(n && (db.FlagsAt(va + n) & (kDbInsn | kDbBlock)))) {
+                ++n;
+            }
+            WriteLine(out, va, p, n, "db (index table)");
+            va += n;
+            continue;
+        }
+
+        // Unreached: padding, dead code or data the analysis never saw used.
+        X86Insn filler;
+        if (DecodeX86(p, textEnd - va, va, &filler) && X86IsFiller(filler) && va + filler.length <= to) {
+            WriteLine(out, va, p, filler.length, "db (padding)");
+            va += filler.length;
+            continue;
+        }
+        uint32_t n = 0;
+        while (n < kBytesPerLine && va + n < to && !(db.FlagsAt(va + n) & (kDbInsn | kDbData | kDbFunction))) {
+            ++n;
+        }
+        n = std::max<uint32_t>(n, 1);
+        char buf[64];
+        bool padding = std::all_of(p, p + n, [p](uint8_t b) { return b == p[0] && (b == 0xCC || b == 0x90); });
+        std::snprintf(buf, sizeof(buf), padding ? "db (padding)" : "db");
+        WriteLine(out, va, p, n, buf);
+        va += n;
+    }
+}
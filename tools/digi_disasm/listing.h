@@ -0,0 +1,20 @@
+// Copyright (c) 2025
+//
+// Text listing rendered on demand from an analysis database.  Lines use
+// the layout of digi_analysis/digi_disasm.asm, address, bytes and
+// Intel syntax, with a header in front of each function, a label in
+// front of each other branch target, jump tables as `dd` case lists and
+// anything never reached as `db`.  Only the requested range is decoded,
+// so listing one function out of the whole image is instant.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include "../common/analysis_db.h"
+#include "../common/pe_image.h"
+
+// Write the listing of [from, to) to `out`.  The range is clipped to
+// .text.
+void WriteListing(std::FILE* out, const PeImage& image, const AnalysisDbView& db, uint32_t from, uint32_t to);
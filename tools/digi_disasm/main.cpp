@@ -0,0 +1,187 @@
+// Copyright (c) 2025
+//
+// digi_disasm: disassemble digi.exe into an analysis database, or
+// render part of a database back into a text listing.
+//
+//     digi_disasm [--threads N] [--no-pointers] [--no-gaps] [--previous old.adb] <digi.exe> <out.adb>
+//     digi_disasm --list <digi.exe> <db.adb> [address [end]]
+//
+// The first form runs the parallel disassembler over the whole image
+// and reports how long it took; with --previous it re-analyses only
+// the functions whose bytes differ from those the earlier database
+// recorded (`old.adb` may be `out.adb` itself).  The rewritten file
+// starts without the chunks other tools added, so the digi_xref index
+// is rebuilt if the earlier database had one; labels from digi_sig
+// have to be matched again.  The second lists the function holding
+// `address` (or [address, end), or all of .text) in the layout of
+// digi_disasm.asm.  Portable C++ apart from the file mapping, so it
+// builds on Linux as well:
+//
+//     g++ -O2 -pthread tools/digi_disasm/*.cpp tools/common/*.cpp -o digi_disasm
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../common/xref_index.h"
+#include "disassembler.h"
+#include "listing.h"
+
+namespace {
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_disasm [--threads N] [--no-pointers] [--no-gaps] [--previous old.adb]\n"
+                     "                   <digi.exe> <out.adb>\n"
+                     "       digi_disasm --list <digi.exe> <db.adb> [address [end]]\n");
+        return 1;
+    }
+
+    bool ParseAddress(const char* s, uint32_t* out) {
+        char* end = nullptr;
+        unsigned long v = std::strtoul(s, &end, 16);
+        if (!*s || *end) {
+            return false;
+        }
+        *out = static_cast<uint32_t>(v);
+        return true;
+    }
+
+    bool LoadImage(const char* path, MappedFile* file, PeImage* image) {
+        if (!file->Open(path)) {
+            std::fprintf(stderr, "digi_disasm: cannot open %s\n", path);
+            return false;
+        }
+        if (!image->Load(file->data(), file->size())) {
+            std::fprintf(stderr, "digi_disasm: %s is not a 32-bit PE image\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    int List(int argc, char** argv) {
+        if (argc < 2 || argc > 4) {
+            return Usage();
+        }
+        MappedFile file;
+        PeImage image;
+        AnalysisDbView db;
+        if (!LoadImage(argv[0], &file, &image)) {
+            return 1;
+        }
+        if (!db.Open(argv[1])) {
+            std::fprintf(stderr, "digi_disasm: %s is not an analysis database\n", argv[1]);
+            return 1;
+        }
+        if (db.info().imageChecksum != ImageChecksum(file.data(), file.size())) {
+            std::fprintf(stderr, "digi_disasm: %s was built from a different image\n", argv[1]);
+            return 1;
+        }
+        uint32_t from = db.info().textStart;
+        uint32_t to = from + db.info().textSize;
+        if (argc >= 3 && !ParseAddress(argv[2], &from)) {
+            return Usage();
+        }
+        if (argc == 4) {
+            if (!ParseAddress(argv[3], &to)) {
+                return Usage();
+            }
+        } else if (argc == 3) {
+            if (const DbFunction* f = db.FunctionAt(from)) {
+                from = f->start;
+                to = f->end;
+            } else {
+                to = from + 64;
+            }
+        }
+        WriteListing(stdout, image, db, from, to);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--list") == 0) {
+        return List(argc - 2, argv + 2);
+    }
+
+    DisassemblerOptions options;
+    const char* previousPath = nullptr;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-' && argv[arg][1] == '-'; ++arg) {
+        if (std::strcmp(argv[arg], "--threads") == 0 && arg + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::atoi(argv[++arg]));
+        } else if (std::strcmp(argv[arg], "--no-pointers") == 0) {
+            options.pointerSeeds = false;
+        } else if (std::strcmp(argv[arg], "--no-gaps") == 0) {
+            options.gapSeeds = false;
+        } else if (std::strcmp(argv[arg], "--previous") == 0 && arg + 1 < argc) {
+            previousPath = argv[++arg];
+        } else {
+            return Usage();
+        }
+    }
+    if (argc - arg != 2) {
+        return Usage();
+    }
+
+    MappedFile file;
+    PeImage image;
+    if (!LoadImage(argv[arg], &file, &image)) {
+        return 1;
+    }
+    AnalysisDb db;
+    DisassemblerStats stats;
+    bool hadXrefIndex = false;
+    {
+        // Closed again before the output is written, which may replace it.
+        AnalysisDbView previous;
+        if (previousPath) {
+            if (!previous.Open(previousPath)) {
+                std::fprintf(stderr, "digi_disasm: %s is not an analysis database\n", previousPath);
+                return 1;
+            }
+            options.previous = &previous;
+            size_t size = 0;
+            hadXrefIndex = previous.Chunk(kDbChunkXrefsByTarget, &size) != nullptr;
+        }
+        if (!Disassemble(image, options, &db, &stats)) {
+            std::fprintf(stderr, "digi_disasm: %s has no code section\n", argv[arg]);
+            return 1;
+        }
+    }
+    if (!WriteAnalysisDb(argv[arg + 1], db)) {
+        std::fprintf(stderr, "digi_disasm: cannot write %s\n", argv[arg + 1]);
+        return 1;
+    }
+    if (hadXrefIndex) {
+        std::vector<AnalysisDb::Chunk> chunks;
+        {
+            AnalysisDbView written;
+            if (!written.Open(argv[arg + 1])) {
+                std::fprintf(stderr, "digi_disasm: cannot read back %s\n", argv[arg + 1]);
+                return 1;
+            }
+            chunks = BuildXrefIndex(image, written);
+        }
+        if (!UpdateAnalysisDb(argv[arg + 1], chunks)) {
+            std::fprintf(stderr, "digi_disasm: cannot add the xref index to %s\n", argv[arg + 1]);
+            return 1;
+        }
+    }
+
+    size_t switches = db.jumpTables.size();
+    std::printf("%u instructions, %zu functions, %zu switches, %zu xrefs\n", stats.instructions,
+                db.functions.size(), switches, db.xrefs.size());
+    std::printf(".text: %u of %u bytes code, %u bytes tables, %u unreached\n", stats.codeBytes, db.info.textSize,
+                stats.dataBytes, db.info.textSize - stats.codeBytes - stats.dataBytes);
+    std::printf("%u invalid paths, %u overlapping starts\n", stats.invalid, stats.overlaps);
+    if (previousPath) {
+        std::printf("%u of %zu functions taken over from %s\n", stats.reused, db.functions.size(), previousPath);
+    }
+    std::printf("trace %.3f s (%u rounds), extents %.3f s, %u threads\n", stats.traceSeconds, stats.rounds,
+                stats.extentSeconds, stats.threads);
+    return 0;
+}
@@ -0,0 +1,1840 @@
+// Copyright (c) 2025
+//
+// x86-32 interpreter.  See emulator.h.
+
+#include "emulator.h"
+
+#include <algorithm>
+#include <cfenv>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // Addresses outside the flat memory: the import thunks, one per
+    // IAT slot, and the return address Call() pushes.
+    const uint32_t kThunkBase   = 0xFFFF0000;
+    const uint32_t kExitAddress = 0xFFFE0000;
+
+    const uint32_t kPageSize  = 0x1000;
+    const uint32_t kHeapSize  = 16 << 20;
+    const uint32_t kStackSize = 1 << 20;
+
+    // Instructions per cached block, so a long straight run of code
+    // does not have to be decoded in one go.
+    const uint32_t kMaxBlockInsns = 64;
+
+    const uint32_t kCF = 0x001;
+    const uint32_t kPF = 0x004;
+    const uint32_t kAF = 0x010;
+    const uint32_t kZF = 0x040;
+    const uint32_t kSF = 0x080;
+    const uint32_t kIF = 0x200;
+    const uint32_t kDF = 0x400;
+    const uint32_t kOF = 0x800;
+    const uint32_t kArithFlags = kCF | kPF | kAF | kZF | kSF | kOF;
+
+    // x87 status word condition bits.
+    const uint16_t kC0 = 0x0100;
+    const uint16_t kC1 = 0x0200;
+    const uint16_t kC2 = 0x0400;
+    const uint16_t kC3 = 0x4000;
+
+    uint32_t Mask(uint8_t size) {
+        return size == 1 ? 0xFFu : size == 2 ? 0xFFFFu : 0xFFFFFFFFu;
+    }
+
+    uint32_t SignBit(uint8_t size) {
+        return size == 1 ? 0x80u : size == 2 ? 0x8000u : 0x80000000u;
+    }
+
+    int32_t SignExtend(uint32_t v, uint8_t size) {
+        return size == 1 ? static_cast<int8_t>(v) : size == 2 ? static_cast<int16_t>(v) : static_cast<int32_t>(v);
+    }
+
+    // PF is set when the low byte of the result has an even number of
+    // set bits.
+    uint32_t Parity(uint32_t v) {
+        v = (v ^ (v >> 4)) & 0xF;
+        return ((0x6996 >> v) & 1) ? 0 : kPF;
+    }
+
+    uint32_t ZeroSignParity(uint32_t r, uint8_t size) {
+        return ((r & Mask(size)) ? 0 : kZF) | ((r & SignBit(size)) ? kSF : 0) | Parity(r & 0xFF);
+    }
+
+    uint32_t Align(uint32_t v, uint32_t to) {
+        return (v + to - 1) & ~(to - 1);
+    }
+
+    bool SameText(const std::string& a, const char* b) {
+        size_t n = std::strlen(b);
+        if (a.size() != n) {
+            return false;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] + 32) : a[i];
+            char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] + 32) : b[i];
+            if (x != y) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The host rounding mode set to an x87 rounding control for the
+    // lifetime of the object.
+    class HostRounding {
+    public:
+        explicit HostRounding(int rc) : m_saved(std::fegetround()) {
+            static const int kModes[4] = { FE_TONEAREST, FE_DOWNWARD, FE_UPWARD, FE_TOWARDZERO };
+            std::fesetround(kModes[rc & 3]);
+        }
+        ~HostRounding() { std::fesetround(m_saved); }
+
+    private:
+        int m_saved;
+    };
+
+    enum FpuOp { kFpuAdd, kFpuMul, kFpuSub, kFpuDiv, kFpuSqrt, kFpuScale };
+
+    double Compute(int op, double x, double y) {
+        switch (op) {
+        case kFpuAdd: return x + y;
+        case kFpuMul: return x * y;
+        case kFpuSub: return x - y;
+        case kFpuDiv: return x / y;
+        case kFpuScale: return std::ldexp(x, static_cast<int>(y));
+        default:      return std::sqrt(x);
+        }
+    }
+
+    bool UsesSimd(const X86Insn& insn) {
+        for (int i = 0; i < insn.operandCount; ++i) {
+            const X86Operand& op = insn.operands[i];
+            if (op.type == kX86OpReg && (op.regClass == kX86Mmx || op.regClass == kX86Xmm)) {
+                return true;
+            }
+        }
+        return insn.opcode == 0x0F0E || insn.opcode == 0x0F77 || (insn.opcode >= 0x0F10 && insn.opcode <= 0x0F17);
+    }
+}
+
+Emulator::Emulator() {
+    std::memset(m_reg, 0, sizeof(m_reg));
+    std::memset(m_fpu, 0, sizeof(m_fpu));
+}
+
+bool Emulator::Load(const PeImage& image) {
+    const PeSection* text = nullptr;
+    for (const PeSection& s : image.sections()) {
+        if (s.IsCode() && !text) {
+            text = &s;
+        }
+    }
+    if (!text) {
+        return false;
+    }
+
+    // image | heap | stack | thread information block
+    m_base = image.imageBase();
+    m_heapBase = m_heapTop = m_base + Align(image.sizeOfImage(), 0x10000);
+    m_heapEnd = m_heapBase + kHeapSize;
+    m_stackTop = m_heapEnd + kStackSize;
+    m_fsBase = m_stackTop;
+    m_size = m_fsBase + kPageSize - m_base;
+    if (m_base + m_size < m_base || m_base + m_size > kExitAddress) {
+        return false;
+    }
+    m_memory.assign(m_size, 0);
+    m_mem = m_memory.data();
+
+    // The headers, which the CRT reads, and the sections.
+    uint32_t headers = static_cast<uint32_t>(image.fileSize());
+    for (const PeSection& s : image.sections()) {
+        headers = std::min(headers, s.rawOffset);
+    }
+    std::memcpy(m_mem, image.fileData(), std::min(headers, kPageSize));
+    for (const PeSection& s : image.sections()) {
+        uint32_t size = s.virtualSize ? std::min(s.rawSize, s.virtualSize) : s.rawSize;
+        if (s.rawOffset > image.fileSize() || size > image.fileSize() - s.rawOffset || s.va - m_base > m_size ||
+            size > m_size - (s.va - m_base)) {
+            return false;
+        }
+        std::memcpy(m_mem + (s.va - m_base), image.fileData() + s.rawOffset, size);
+    }
+    m_textStart = text->va;
+    m_textSize = text->virtualSize ? text->virtualSize : text->rawSize;
+
+    // The end of the SEH chain, the stack limits and the self pointer
+    // MSVC code reads through fs.
+    Write32(m_fsBase + 0x00, 0xFFFFFFFF);
+    Write32(m_fsBase + 0x04, m_stackTop);
+    Write32(m_fsBase + 0x08, m_heapEnd);
+    Write32(m_fsBase + 0x18, m_fsBase);
+
+    m_imports.clear();
+    for (const PeImport& import : image.imports()) {
+        ImportSlot slot = { import.dll, import.name, import.ordinal, nullptr, nullptr, 0 };
+        Write32(import.iatVa, kThunkBase + static_cast<uint32_t>(m_imports.size()));
+        m_imports.push_back(slot);
+    }
+
+    FlushBlocks();
+    std::memset(m_reg, 0, sizeof(m_reg));
+    m_reg[kEsp] = m_stackTop;
+    m_eflags = kIF | 2;
+    m_flagOp = kFlagsEager;
+    m_fpuEmpty = 0xFF;
+    m_top = 0;
+    m_fsw = 0;
+    m_fcw = 0x027F;
+    m_fault = false;
+    m_error.clear();
+    return true;
+}
+
+size_t Emulator::RegisterImports(const ImportStub* stubs, size_t count, void* context) {
+    size_t bound = 0;
+    for (ImportSlot& slot : m_imports) {
+        for (size_t i = 0; i < count; ++i) {
+            const ImportStub& s = stubs[i];
+            bool match = s.name ? slot.name == s.name : slot.name.empty() && slot.ordinal == s.ordinal;
+            if (match && SameText(slot.dll, s.dll)) {
+                slot.handler = s.handler;
+                slot.context = context;
+                slot.argBytes = s.argBytes;
+                ++bound;
+                break;
+            }
+        }
+    }
+    return bound;
+}
+
+bool Emulator::Call(uint32_t address, const uint32_t* args, size_t count, uint32_t* result) {
+    // A handler may call back into the image (a qsort comparator, a
+    // window procedure); the nested call runs below the current frame
+    // and returns to the handler.
+    bool nested = m_depth > 0;
+    uint32_t savedEsp = m_reg[kEsp];
+    uint32_t savedEip = m_eip;
+    if (!nested) {
+        m_reg[kEsp] = m_stackTop;
+        m_stopAt = m_instructions + m_limit;
+        m_fault = false;
+        m_error.clear();
+    }
+    for (size_t i = count; i-- > 0;) {
+        Push(args[i]);
+    }
+    Push(kExitAddress);
+    m_eip = address;
+    ++m_depth;
+    bool ok = Run();
+    --m_depth;
+    if (ok) {
+        *result = m_reg[kEax];
+    }
+    m_reg[kEsp] = savedEsp;
+    m_eip = savedEip;
+    return ok;
+}
+
+void Emulator::Abort(const char* why) {
+    Fail(why);
+}
+
+bool Emulator::PopFloat(double* out) {
+    if ((m_fpuEmpty >> m_top) & 1) {
+        return false;
+    }
+    *out = FpuPop();
+    return true;
+}
+
+int Emulator::fpuDepth() const {
+    int n = 0;
+    for (int i = 0; i < 8; ++i) {
+        n += (m_fpuEmpty >> i) & 1 ? 0 : 1;
+    }
+    return n;
+}
+
+uint32_t Emulator::Arg(int i) {
+    return Read32(m_reg[kEsp] + 4 + 4 * static_cast<uint32_t>(i));
+}
+
+// ---------------------------------------------------------------------
+// Memory
+
+void Emulator::MemoryFault(uint32_t address, uint32_t size, const char* access) {
+    if (!m_fault) {
+        char buf[80];
+        std::snprintf(buf, sizeof(buf), "%s of %u bytes at 0x%08X outside memory", access, size, address);
+        m_fault = true;
+        m_error = buf;
+    }
+}
+
+uint8_t* Emulator::Host(uint32_t address, size_t size) {
+    uint32_t offset = address - m_base;
+    return offset < m_size && size <= m_size - offset ? m_mem + offset : nullptr;
+}
+
+uint8_t Emulator::Read8(uint32_t address) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size) {
+        return m_mem[offset];
+    }
+    MemoryFault(address, 1, "read");
+    return 0;
+}
+
+uint16_t Emulator::Read16(uint32_t address) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size - 1) {
+        uint16_t v;
+        std::memcpy(&v, m_mem + offset, 2);
+        return v;
+    }
+    MemoryFault(address, 2, "read");
+    return 0;
+}
+
+uint32_t Emulator::Read32(uint32_t address) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size - 3) {
+        uint32_t v;
+        std::memcpy(&v, m_mem + offset, 4);
+        return v;
+    }
+    MemoryFault(address, 4, "read");
+    return 0;
+}
+
+// Stores into .text mark the decoded blocks stale; Run() drops them
+// once the storing instruction has finished.
+void Emulator::Write8(uint32_t address, uint8_t value) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size) {
+        m_mem[offset] = value;
+        m_codeWritten |= address - m_textStart < m_textSize;
+        return;
+    }
+    MemoryFault(address, 1, "write");
+}
+
+void Emulator::Write16(uint32_t address, uint16_t value) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size - 1) {
+        std::memcpy(m_mem + offset, &value, 2);
+        m_codeWritten |= address + 1 - m_textStart < m_textSize + 1;
+        return;
+    }
+    MemoryFault(address, 2, "write");
+}
+
+void Emulator::Write32(uint32_t address, uint32_t value) {
+    uint32_t offset = address - m_base;
+    if (offset < m_size - 3) {
+        std::memcpy(m_mem + offset, &value, 4);
+        m_codeWritten |= address + 3 - m_textStart < m_textSize + 3;
+        return;
+    }
+    MemoryFault(address, 4, "write");
+}
+
+bool Emulator::ReadBytes(uint32_t address, void* out, size_t size) {
+    const uint8_t* p = Host(address, size);
+    if (!p) {
+        MemoryFault(address, static_cast<uint32_t>(size), "read");
+        return false;
+    }
+    std::memcpy(out, p, size);
+    return true;
+}
+
+bool Emulator::WriteBytes(uint32_t address, const void* data, size_t size) {
+    uint8_t* p = Host(address, size);
+    if (!p) {
+        MemoryFault(address, static_cast<uint32_t>(size), "write");
+        return false;
+    }
+    std::memcpy(p, data, size);
+    m_codeWritten |= address < m_textStart + m_textSize && address + size > m_textStart;
+    return true;
+}
+
+uint32_t Emulator::Alloc(uint32_t size) {
+    uint32_t address = m_heapTop;
+    if (size > m_heapEnd - address) {
+        return 0;
+    }
+    m_heapTop = Align(address + size, 16);
+    std::memset(m_mem + (address - m_base), 0, size);
+    return address;
+}
+
+// ---------------------------------------------------------------------
+// Registers, operands and flags
+
+uint32_t Emulator::GetReg(uint8_t reg, uint8_t size) const {
+    if (size == 4) {
+        return m_reg[reg];
+    }
+    if (size == 2) {
+        return m_reg[reg] & 0xFFFF;
+    }
+    return reg < 4 ? m_reg[reg] & 0xFF : (m_reg[reg - 4] >> 8) & 0xFF;
+}
+
+void Emulator::SetReg(uint8_t reg, uint8_t size, uint32_t value) {
+    if (size == 4) {
+        m_reg[reg] = value;
+    } else if (size == 2) {
+        m_reg[reg] = (m_reg[reg] & 0xFFFF0000u) | (value & 0xFFFF);
+    } else if (reg < 4) {
+        m_reg[reg] = (m_reg[reg] & ~0xFFu) | (value & 0xFF);
+    } else {
+        m_reg[reg - 4] = (m_reg[reg - 4] & ~0xFF00u) | ((value & 0xFF) << 8);
+    }
+}
+
+uint32_t Emulator::Address(const X86Operand& op) {
+    uint32_t a = static_cast<uint32_t>(op.disp);
+    if (op.base != kX86NoReg) {
+        a += m_reg[op.base];
+    }
+    if (op.index != kX86NoReg) {
+        a += m_reg[op.index] * op.scale;
+    }
+    if (op.addrSize == 2) {
+        a &= 0xFFFF;
+    }
+    if (op.segment == kX86Fs) {
+        a += m_fsBase;
+    }
+    return a;
+}
+
+uint32_t Emulator::Get(const X86Operand& op) {
+    if (op.type == kX86OpReg) {
+        return GetReg(op.reg, op.size);
+    }
+    if (op.type == kX86OpMem) {
+        uint32_t a = Address(op);
+        return op.size == 1 ? Read8(a) : op.size == 2 ? Read16(a) : Read32(a);
+    }
+    return op.imm;
+}
+
+void Emulator::Set(const X86Operand& op, uint32_t value) {
+    if (op.type == kX86OpReg) {
+        SetReg(op.reg, op.size, value);
+        return;
+    }
+    uint32_t a = Address(op);
+    if (op.size == 1) {
+        Write8(a, static_cast<uint8_t>(value));
+    } else if (op.size == 2) {
+        Write16(a, static_cast<uint16_t>(value));
+    } else {
+        Write32(a, value);
+    }
+}
+
+void Emulator::Push(uint32_t value) {
+    m_reg[kEsp] -= 4;
+    Write32(m_reg[kEsp], value);
+}
+
+uint32_t Emulator::Pop() {
+    uint32_t v = Read32(m_reg[kEsp]);
+    m_reg[kEsp] += 4;
+    return v;
+}
+
+void Emulator::SetLazy(FlagOp op, uint32_t dst, uint32_t src, uint32_t result, uint8_t size) {
+    m_flagOp = op;
+    m_flagDst = dst;
+    m_flagSrc = src;
+    m_flagResult = result & Mask(size);
+    m_flagSize = size;
+}
+
+uint32_t Emulator::Flags() {
+    if (m_flagOp == kFlagsEager) {
+        return m_eflags;
+    }
+    uint32_t d = m_flagDst;
+    uint32_t s = m_flagSrc;
+    uint32_t r = m_flagResult;
+    uint32_t sign = SignBit(m_flagSize);
+    uint32_t f = (m_eflags & ~kArithFlags) | ZeroSignParity(r, m_flagSize);
+    switch (m_flagOp) {
+    case kFlagsAdd:
+        f |= (r < d ? kCF : 0) | ((d ^ r) & (s ^ r) & sign ? kOF : 0) | ((d ^ s ^ r) & 0x10);
+        break;
+    case kFlagsSub:
+        f |= (d < s ? kCF : 0) | ((d ^ s) & (d ^ r) & sign ? kOF : 0) | ((d ^ s ^ r) & 0x10);
+        break;
+    case kFlagsInc:
+        f |= (m_eflags & kCF) | (r == sign ? kOF : 0) | ((r & 0xF) == 0 ? kAF : 0);
+        break;
+    case kFlagsDec:
+        f |= (m_eflags & kCF) | (d == sign ? kOF : 0) | ((r & 0xF) == 0xF ? kAF : 0);
+        break;
+    default:
+        break;
+    }
+    m_eflags = f;
+    m_flagOp = kFlagsEager;
+    return f;
+}
+
+void Emulator::SetFlags(uint32_t eflags) {
+    m_eflags = eflags;
+    m_flagOp = kFlagsEager;
+}
+
+bool Emulator::Cond(int cc) {
+    // Straight from the operands after the usual cmp or sub.
+    if (m_flagOp == kFlagsSub) {
+        uint32_t d = m_flagDst;
+        uint32_t s = m_flagSrc;
+        int32_t sd = SignExtend(d, m_flagSize);
+        int32_t ss = SignExtend(s, m_flagSize);
+        switch (cc) {
+        case 0x2: return d < s;
+        case 0x3: return d >= s;
+        case 0x4: return d == s;
+        case 0x5: return d != s;
+        case 0x6: return d <= s;
+        case 0x7: return d > s;
+        case 0xC: return sd < ss;
+        case 0xD: return sd >= ss;
+        case 0xE: return sd <= ss;
+        case 0xF: return sd > ss;
+        default:  break;
+        }
+    }
+    uint32_t f = Flags();
+    bool r = false;
+    switch (cc >> 1) {
+    case 0: r = (f & kOF) != 0; break;
+    case 1: r = (f & kCF) != 0; break;
+    case 2: r = (f & kZF) != 0; break;
+    case 3: r = (f & (kCF | kZF)) != 0; break;
+    case 4: r = (f & kSF) != 0; break;
+    case 5: r = (f & kPF) != 0; break;
+    case 6: r = !(f & kSF) != !(f & kOF); break;
+    default: r = (f & kZF) || !(f & kSF) != !(f & kOF); break;
+    }
+    return r != ((cc & 1) != 0);
+}
+
+// add or adc sbb and sub xor cmp, in the order of the ModRM reg field.
+uint32_t Emulator::Alu(int op, uint32_t dst, uint32_t src, uint8_t size) {
+    uint32_t mask = Mask(size);
+    uint32_t r = 0;
+    switch (op) {
+    case 0:
+        r = (dst + src) & mask;
+        SetLazy(kFlagsAdd, dst, src, r, size);
+        break;
+    case 1:
+        r = dst | src;
+        SetLazy(kFlagsLogic, dst, src, r, size);
+        break;
+    case 2:
+    case 3: {
+        uint32_t cf = Flags() & kCF;
+        uint32_t sign = SignBit(size);
+        uint32_t carry = 0;
+        uint32_t of = 0;
+        if (op == 2) {
+            uint64_t wide = static_cast<uint64_t>(dst) + src + cf;
+            r = static_cast<uint32_t>(wide) & mask;
+            carry = wide > mask ? kCF : 0;
+            of = (dst ^ r) & (src ^ r) & sign ? kOF : 0;
+        } else {
+            r = (dst - src - cf) & mask;
+            carry = static_cast<uint64_t>(dst) < static_cast<uint64_t>(src) + cf ? kCF : 0;
+            of = (dst ^ src) & (dst ^ r) & sign ? kOF : 0;
+        }
+        SetFlags((m_eflags & ~kArithFlags) | ZeroSignParity(r, size) | carry | of | ((dst ^ src ^ r) & kAF));
+        break;
+    }
+    case 4:
+        r = dst & src;
+        SetLazy(kFlagsLogic, dst, src, r, size);
+        break;
+    case 6:
+        r = dst ^ src;
+        SetLazy(kFlagsLogic, dst, src, r, size);
+        break;
+    default:
+        r = (dst - src) & mask;
+        SetLazy(kFlagsSub, dst, src, r, size);
+        break;
+    }
+    return r;
+}
+
+// rol ror rcl rcr shl shr sal sar, in the order of the ModRM reg field.
+// A zero count changes nothing, flags included.
+uint32_t Emulator::Shift(int op, uint32_t v, uint32_t count, uint8_t size) {
+    count &= 0x1F;
+    if (!count) {
+        return v;
+    }
+    uint32_t bits = size * 8u;
+    uint32_t mask = Mask(size);
+    uint32_t sign = SignBit(size);
+    uint32_t f = Flags();
+    uint32_t cf = f & kCF;
+    uint32_t r = v;
+    switch (op) {
+    case 0:
+    case 1: {
+        uint32_t n = count % bits;
+        if (op == 0) {
+            r = n ? ((v << n) | (v >> (bits - n))) & mask : v;
+            cf = r & 1;
+            f = (f & ~(kCF | kOF)) | cf | (((r & sign) != 0) != (cf != 0) ? kOF : 0);
+        } else {
+            r = n ? ((v >> n) | (v << (bits - n))) & mask : v;
+            cf = (r & sign) ? kCF : 0;
+            f = (f & ~(kCF | kOF)) | cf | (((r ^ (r << 1)) & sign) ? kOF : 0);
+        }
+        SetFlags(f);
+        return r;
+    }
+    case 2:
+    case 3: {
+        uint32_t n = count % (bits + 1);
+        uint32_t of = 0;
+        if (op == 3) {
+            of = ((r & sign) != 0) != (cf != 0) ? kOF : 0;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            uint32_t out = 0;
+            if (op == 2) {
+                out = (r & sign) ? kCF : 0;
+                r = ((r << 1) | cf) & mask;
+            } else {
+                out = r & 1;
+                r = (r >> 1) | (cf ? sign : 0);
+            }
+            cf = out;
+        }
+        if (op == 2) {
+            of = ((r & sign) != 0) != (cf != 0) ? kOF : 0;
+        }
+        SetFlags((f & ~(kCF | kOF)) | cf | of);
+        return r;
+    }
+    case 4:
+    case 6:
+        r = static_cast<uint32_t>(static_cast<uint64_t>(v) << count) & mask;
+        cf = count <= bits ? (v >> (bits - count)) & 1 : 0;
+        SetFlags((f & ~kArithFlags) | ZeroSignParity(r, size) | cf | (((r & sign) != 0) != (cf != 0) ? kOF : 0));
+        return r;
+    case 5:
+        r = v >> count;
+        cf = (v >> (count - 1)) & 1;
+        SetFlags((f & ~kArithFlags) | ZeroSignParity(r, size) | cf | ((v & sign) ? kOF : 0));
+        return r;
+    default: {
+        int32_t s = SignExtend(v, size);
+        r = static_cast<uint32_t>(s >> count) & mask;
+        cf = static_cast<uint32_t>(s >> (count - 1)) & 1;
+        SetFlags((f & ~kArithFlags) | ZeroSignParity(r, size) | cf);
+        return r;
+    }
+    }
+}
+
+// F6/F7 with reg 4-7: mul, imul, div and idiv of the accumulator.
+bool Emulator::MulDiv(const X86Insn& insn, int op) {
+    const X86Operand& src = insn.operands[0];
+    uint8_t size = src.size;
+    uint32_t mask = Mask(size);
+    uint64_t s = Get(src);
+    uint32_t f = Flags() & ~kArithFlags;
+    if (op <= 5) {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        bool overflow = false;
+        if (op == 4) {
+            uint64_t p = static_cast<uint64_t>(GetReg(kEax, size)) * s;
+            lo = p & mask;
+            hi = (p >> (size * 8)) & mask;
+            overflow = hi != 0;
+        } else {
+            int64_t p = static_cast<int64_t>(SignExtend(GetReg(kEax, size), size)) *
+                        SignExtend(static_cast<uint32_t>(s), size);
+            lo = static_cast<uint64_t>(p) & mask;
+            hi = (static_cast<uint64_t>(p) >> (size * 8)) & mask;
+            overflow = p != SignExtend(static_cast<uint32_t>(lo), size);
+        }
+        if (size == 1) {
+            SetReg(kEax, 2, static_cast<uint32_t>(lo | (hi << 8)));
+        } else {
+            SetReg(kEax, size, static_cast<uint32_t>(lo));
+            SetReg(kEdx, size, static_cast<uint32_t>(hi));
+        }
+        SetFlags(f | ZeroSignParity(static_cast<uint32_t>(lo), size) | (overflow ? kCF | kOF : 0));
+        return true;
+    }
+
+    uint64_t dividend = size == 1 ? GetReg(kEax, 2)
+                                  : (static_cast<uint64_t>(GetReg(kEdx, size)) << (size * 8)) | GetReg(kEax, size);
+    if (!s) {
+        return Fail("divide by zero");
+    }
+    uint64_t q = 0;
+    uint64_t r = 0;
+    if (op == 6) {
+        q = dividend / s;
+        r = dividend % s;
+        if (q > mask) {
+            return Fail("divide overflow");
+        }
+    } else {
+        int shift = 64 - size * 16;
+        int64_t sd = static_cast<int64_t>(dividend << shift) >> shift;
+        int64_t sv = SignExtend(static_cast<uint32_t>(s), size);
+        if (sd == INT64_MIN && sv == -1) {
+            return Fail("divide overflow");
+        }
+        int64_t sq = sd / sv;
+        int64_t limit = static_cast<int64_t>(SignBit(size));
+        if (sq >= limit || sq < -limit) {
+            return Fail("divide overflow");
+        }
+        q = static_cast<uint64_t>(sq) & mask;
+        r = static_cast<uint64_t>(sd % sv) & mask;
+    }
+    if (size == 1) {
+        SetReg(kEax, 2, static_cast<uint32_t>(q | (r << 8)));
+    } else {
+        SetReg(kEax, size, static_cast<uint32_t>(q));
+        SetReg(kEdx, size, static_cast<uint32_t>(r));
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------
+// Execution
+
+void Emulator::FlushBlocks() {
+    m_insns.clear();
+    m_blocks.clear();
+    m_blockAt.assign(m_textSize, 0);
+    m_codeWritten = false;
+}
+
+uint32_t Emulator::DecodeBlock(uint32_t address) {
+    Block block = { address, static_cast<uint32_t>(m_insns.size()), 0 };
+    uint32_t va = address;
+    while (block.count < kMaxBlockInsns && va - m_textStart < m_textSize) {
+        X86Insn insn;
+        uint32_t avail = m_textStart + m_textSize - va;
+        if (!DecodeX86(m_mem + (va - m_base), avail, va, &insn)) {
+            break;
+        }
+        m_insns.push_back(insn);
+        ++block.count;
+        va += insn.length;
+        if (insn.flow != X86Flow::kNone) {
+            break;
+        }
+    }
+    if (!block.count) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "0x%08X: invalid instruction", address);
+        m_error = buf;
+        return 0;
+    }
+    m_blocks.push_back(block);
+    m_blockAt[address - m_textStart] = static_cast<uint32_t>(m_blocks.size());
+    return static_cast<uint32_t>(m_blocks.size());
+}
+
+bool Emulator::Fail(const char* what) {
+    if (!m_fault) {
+        m_fault = true;
+        m_error = what;
+    }
+    return false;
+}
+
+// Prefix the error with the instruction that stopped the run.
+bool Emulator::Located(const X86Insn& insn) {
+    char text[128];
+    FormatX86(insn, text, sizeof(text));
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "0x%08X %s: ", insn.address, text);
+    m_error.insert(0, buf);
+    m_fault = true;
+    return false;
+}
+
+bool Emulator::RunImport(uint32_t index) {
+    const ImportSlot& slot = m_imports[index];
+    if (!slot.handler) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "#%u", slot.ordinal);
+        m_error = "call to unregistered import " + slot.dll + "!" + (slot.name.empty() ? buf : slot.name);
+        m_fault = true;
+        return false;
+    }
+    uint32_t result = slot.handler(*this, slot.context);
+    if (m_fault) {
+        return false;
+    }
+    m_reg[kEax] = result;
+    m_eip = Pop();
+    m_reg[kEsp] += slot.argBytes;
+    return !m_fault;
+}
+
+bool Emulator::Run() {
+    for (;;) {
+        uint32_t eip = m_eip;
+        if (eip == kExitAddress) {
+            return true;
+        }
+        if (eip - kThunkBase < m_imports.size()) {
+            if (!RunImport(eip - kThunkBase)) {
+                return false;
+            }
+            continue;
+        }
+        if (m_instructions >= m_stopAt) {
+            char buf[80];
+            std::snprintf(buf, sizeof(buf), "0x%08X: instruction limit reached", eip);
+            m_error = buf;
+            m_fault = true;
+            return false;
+        }
+
+        if (eip - m_textStart >= m_textSize) {
+            // Code outside .text (a thunk built on the heap, say) is
+            // decoded every time rather than cached.
+            X86Insn insn;
+            const uint8_t* p = Host(eip, 1);
+            if (!p || !DecodeX86(p, m_size - (eip - m_base), eip, &insn)) {
+                char buf[64];
+                std::snprintf(buf, sizeof(buf), "0x%08X: no code here", eip);
+                m_error = buf;
+                m_fault = true;
+                return false;
+            }
+            m_eip = eip + insn.length;
+            ++m_instructions;
+            if (!Step(insn) || m_fault) {
+                return Located(insn);
+            }
+            continue;
+        }
+
+        uint32_t index = m_blockAt[eip - m_textStart];
+        if (!index && !(index = DecodeBlock(eip))) {
+            m_fault = true;
+            return false;
+        }
+        const Block& block = m_blocks[index - 1];
+        const X86Insn* insn = &m_insns[block.first];
+        const X86Insn* end = insn + block.count;
+        for (; insn != end; ++insn) {
+            m_eip = insn->address + insn->length;
+            if (!Step(*insn) || m_fault) {
+                m_instructions += static_cast<uint64_t>(insn - &m_insns[block.first]) + 1;
+                return Located(*insn);
+            }
+            if (m_codeWritten) {
+                // The block may have just been overwritten; carry on
+                // from the next instruction with a fresh decode.
+                m_instructions += static_cast<uint64_t>(insn - &m_insns[block.first]) + 1;
+                FlushBlocks();
+                break;
+            }
+        }
+        if (insn == end) {
+            m_instructions += block.count;
+        }
+    }
+}
+
+bool Emulator::Step(const X86Insn& insn) {
+    const X86Operand& a = insn.operands[0];
+    const X86Operand& b = insn.operands[1];
+    uint16_t op = insn.opcode;
+    uint8_t opSize = (insn.prefixes & kX86OpSize) ? 2 : 4;
+
+    if (op < 0x40 && (op & 7) < 6) {
+        uint32_t r = Alu(op >> 3, Get(a), Get(b), a.size);
+        if ((op >> 3) != 7) {
+            Set(a, r);
+        }
+        return true;
+    }
+    if (op >= 0x0F00) {
+        return TwoByte(insn);
+    }
+
+    switch (op) {
+    case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+    case 0x48: case 0x49: case 0x4A: case 0x4B: case 0x4C: case 0x4D: case 0x4E: case 0x4F: {
+        Flags();
+        uint32_t v = Get(a);
+        uint32_t r = op < 0x48 ? v + 1 : v - 1;
+        SetLazy(op < 0x48 ? kFlagsInc : kFlagsDec, v, 1, r, a.size);
+        Set(a, r);
+        return true;
+    }
+    case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+    case 0x68: case 0x6A:
+        if (opSize == 2) {
+            return Fail("16-bit push not emulated");
+        }
+        Push(Get(a));
+        return true;
+    case 0x58: case 0x59: case 0x5A: case 0x5B: case 0x5C: case 0x5D: case 0x5E: case 0x5F:
+    case 0x8F:
+        if (opSize == 2) {
+            return Fail("16-bit pop not emulated");
+        }
+        // A memory destination is addressed with esp already
+        // incremented.
+        Set(a, Pop());
+        return true;
+    case 0x60: {
+        uint32_t esp = m_reg[kEsp];
+        for (int r = 0; r < 8; ++r) {
+            Push(r == kEsp ? esp : m_reg[r]);
+        }
+        return true;
+    }
+    case 0x61:
+        for (int r = 7; r >= 0; --r) {
+            uint32_t v = Pop();
+            if (r != kEsp) {
+                m_reg[r] = v;
+            }
+        }
+        return true;
+    case 0x69:
+    case 0x6B: {
+        const X86Operand& c = insn.operands[2];
+        int64_t p = static_cast<int64_t>(SignExtend(Get(b), b.size)) * SignExtend(Get(c), b.size);
+        uint32_t r = static_cast<uint32_t>(p) & Mask(a.size);
+        Set(a, r);
+        SetFlags((Flags() & ~kArithFlags) | ZeroSignParity(r, a.size) |
+                 (p != SignExtend(r, a.size) ? kCF | kOF : 0));
+        return true;
+    }
+    case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+    case 0x78: case 0x79: case 0x7A: case 0x7B: case 0x7C: case 0x7D: case 0x7E: case 0x7F:
+        if (Cond(op & 0xF)) {
+            m_eip = insn.target;
+        }
+        return true;
+    case 0x80: case 0x81: case 0x82: case 0x83: {
+        uint32_t r = Alu(insn.reg, Get(a), Get(b) & Mask(a.size), a.size);
+        if (insn.reg != 7) {
+            Set(a, r);
+        }
+        return true;
+    }
+    case 0x84: case 0x85: case 0xA8: case 0xA9:
+        Alu(4, Get(a), Get(b), a.size);
+        return true;
+    case 0x86: case 0x87:
+    case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97: {
+        uint32_t x = Get(a);
+        uint32_t y = Get(b);
+        Set(a, y);
+        Set(b, x);
+        return true;
+    }
+    case 0x88: case 0x89: case 0x8A: case 0x8B: case 0xA0: case 0xA1: case 0xA2: case 0xA3:
+    case 0xB0: case 0xB1: case 0xB2: case 0xB3: case 0xB4: case 0xB5: case 0xB6: case 0xB7:
+    case 0xB8: case 0xB9: case 0xBA: case 0xBB: case 0xBC: case 0xBD: case 0xBE: case 0xBF:
+    case 0xC6: case 0xC7:
+        Set(a, Get(b));
+        return true;
+    case 0x8D: {
+        X86Operand m = b;
+        m.segment = kX86NoSegment;
+        Set(a, Address(m));
+        return true;
+    }
+    case 0x90:
+    case 0x9B:
+        return true;
+    case 0x98:
+        if (opSize == 2) {
+            SetReg(kEax, 2, static_cast<uint32_t>(static_cast<int8_t>(m_reg[kEax])));
+        } else {
+            m_reg[kEax] = static_cast<uint32_t>(static_cast<int16_t>(m_reg[kEax]));
+        }
+        return true;
+    case 0x99:
+        if (opSize == 2) {
+            SetReg(kEdx, 2, (m_reg[kEax] & 0x8000) ? 0xFFFF : 0);
+        } else {
+            m_reg[kEdx] = (m_reg[kEax] & 0x80000000u) ? 0xFFFFFFFFu : 0;
+        }
+        return true;
+    case 0x9C:
+        Push(Flags() | 2);
+        return true;
+    case 0x9D:
+        SetFlags((Pop() & (kArithFlags | kDF)) | kIF | 2);
+        return true;
+    case 0x9E:
+        SetFlags((Flags() & ~(kArithFlags & ~kOF)) | (GetReg(4, 1) & (kCF | kPF | kAF | kZF | kSF)));
+        return true;
+    case 0x9F:
+        SetReg(4, 1, (Flags() & 0xFF) | 2);
+        return true;
+    case 0xA4: case 0xA5: case 0xA6: case 0xA7: case 0xAA: case 0xAB:
+    case 0xAC: case 0xAD: case 0xAE: case 0xAF:
+        return StringOp(insn);
+    case 0xC0: case 0xC1: case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+        Set(a, Shift(insn.reg, Get(a), Get(b), a.size));
+        return true;
+    case 0xC2:
+    case 0xC3:
+        m_eip = Pop();
+        if (op == 0xC2) {
+            m_reg[kEsp] += a.imm;
+        }
+        return true;
+    case 0xC8: {
+        uint32_t size = a.imm;
+        uint32_t level = b.imm & 0x1F;
+        Push(m_reg[kEbp]);
+        uint32_t frame = m_reg[kEsp];
+        for (uint32_t i = 1; i < level; ++i) {
+            m_reg[kEbp] -= 4;
+            Push(Read32(m_reg[kEbp]));
+        }
+        if (level) {
+            Push(frame);
+        }
+        m_reg[kEbp] = frame;
+        m_reg[kEsp] -= size;
+        return true;
+    }
+    case 0xC9:
+        m_reg[kEsp] = m_reg[kEbp];
+        m_reg[kEbp] = Pop();
+        return true;
+    case 0xCC:
+        return Fail("breakpoint");
+    case 0xD7: {
+        X86Operand m = {};
+        m.type = kX86OpMem;
+        m.base = kEbx;
+        m.index = kX86NoReg;
+        m.segment = insn.segment;
+        m.addrSize = 4;
+        SetReg(kEax, 1, Read8(Address(m) + (m_reg[kEax] & 0xFF)));
+        return true;
+    }
+    case 0xD8: case 0xD9: case 0xDA: case 0xDB: case 0xDC: case 0xDD: case 0xDE: case 0xDF:
+        return Fpu(insn);
+    case 0xE0:
+    case 0xE1:
+    case 0xE2: {
+        uint32_t ecx = --m_reg[kEcx];
+        bool zf = op == 0xE2 || ((Flags() & kZF) != 0) == (op == 0xE1);
+        if (ecx && zf) {
+            m_eip = insn.target;
+        }
+        return true;
+    }
+    case 0xE3:
+        if (!m_reg[kEcx]) {
+            m_eip = insn.target;
+        }
+        return true;
+    case 0xE8:
+        Push(m_eip);
+        m_eip = insn.target;
+        return true;
+    case 0xE9:
+    case 0xEB:
+        m_eip = insn.target;
+        return true;
+    case 0xF5:
+        SetFlags(Flags() ^ kCF);
+        return true;
+    case 0xF6:
+    case 0xF7:
+        switch (insn.reg) {
+        case 0:
+        case 1:
+            Alu(4, Get(a), Get(b), a.size);
+            return true;
+        case 2:
+            Set(a, ~Get(a));
+            return true;
+        case 3: {
+            uint32_t v = Get(a);
+            uint32_t r = Alu(5, 0, v, a.size);
+            Set(a, r);
+            return true;
+        }
+        default:
+            return MulDiv(insn, insn.reg);
+        }
+    case 0xF8:
+        SetFlags(Flags() & ~kCF);
+        return true;
+    case 0xF9:
+        SetFlags(Flags() | kCF);
+        return true;
+    case 0xFC:
+        m_eflags &= ~kDF;
+        return true;
+    case 0xFD:
+        m_eflags |= kDF;
+        return true;
+    case 0xFE:
+    case 0xFF:
+        switch (insn.reg) {
+        case 0:
+        case 1: {
+            Flags();
+            uint32_t v = Get(a);
+            uint32_t r = insn.reg == 0 ? v + 1 : v - 1;
+            SetLazy(insn.reg == 0 ? kFlagsInc : kFlagsDec, v, 1, r, a.size);
+            Set(a, r);
+            return true;
+        }
+        case 2: {
+            uint32_t target = Get(a);
+            Push(m_eip);
+            m_eip = target;
+            return true;
+        }
+        case 4:
+            m_eip = Get(a);
+            return true;
+        case 6:
+            Push(Get(a));
+            return true;
+        default:
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+    return Fail("instruction not emulated");
+}
+
+bool Emulator::StringOp(const X86Insn& insn) {
+    uint16_t op = insn.opcode;
+    uint8_t size = (op & 1) ? ((insn.prefixes & kX86OpSize) ? 2 : 4) : 1;
+    bool rep = (insn.prefixes & (kX86Rep | kX86Repne)) != 0;
+    bool compare = op == 0xA6 || op == 0xA7 || op == 0xAE || op == 0xAF;
+    int32_t step = (m_eflags & kDF) ? -static_cast<int32_t>(size) : static_cast<int32_t>(size);
+    // Operand 0 or 1 is ds:[esi] (honouring an override) for movs,
+    // cmps and lods; es:[edi] is always flat.
+    const X86Operand& src = op == 0xA6 || op == 0xA7 ? insn.operands[0] : insn.operands[1];
+
+    if (rep && !m_reg[kEcx]) {
+        return true;
+    }
+
+    // rep movs and rep stos forwards over memory that does not overlap
+    // are the bulk of the game's copies and clears.
+    if (rep && step > 0 && (op == 0xA4 || op == 0xA5 || op == 0xAA || op == 0xAB)) {
+        uint64_t bytes = static_cast<uint64_t>(m_reg[kEcx]) * size;
+        uint32_t edi = m_reg[kEdi];
+        uint8_t* dst = bytes <= m_size ? Host(edi, static_cast<size_t>(bytes)) : nullptr;
+        if (dst && op >= 0xAA) {
+            uint32_t v = GetReg(kEax, size);
+            for (uint64_t i = 0; i < bytes; i += size) {
+                std::memcpy(dst + i, &v, size);
+            }
+            m_codeWritten |= edi < m_textStart + m_textSize && edi + bytes > m_textStart;
+            m_reg[kEdi] += static_cast<uint32_t>(bytes);
+            m_reg[kEcx] = 0;
+            return true;
+        }
+        uint32_t esi = Address(src);
+        const uint8_t* from = dst ? Host(esi, static_cast<size_t>(bytes)) : nullptr;
+        if (from && (from + bytes <= dst || dst + bytes <= from)) {
+            std::memcpy(dst, from, static_cast<size_t>(bytes));
+            m_codeWritten |= edi < m_textStart + m_textSize && edi + bytes > m_textStart;
+            m_reg[kEsi] += static_cast<uint32_t>(bytes);
+            m_reg[kEdi] += static_cast<uint32_t>(bytes);
+            m_reg[kEcx] = 0;
+            return true;
+        }
+    }
+
+    X86Operand s = src;
+    s.size = size;
+    X86Operand d = {};
+    d.type = kX86OpMem;
+    d.size = size;
+    d.base = kEdi;
+    d.index = kX86NoReg;
+    d.scale = 1;
+    d.addrSize = 4;
+    d.segment = kX86NoSegment;
+    X86Operand acc = {};
+    acc.type = kX86OpReg;
+    acc.regClass = kX86Gpr;
+    acc.reg = kEax;
+    acc.size = size;
+    for (;;) {
+        switch (op) {
+        case 0xA4:
+        case 0xA5:
+            Set(d, Get(s));
+            break;
+        case 0xA6:
+        case 0xA7:
+            Alu(7, Get(s), Get(d), size);
+            break;
+        case 0xAA:
+        case 0xAB:
+            Set(d, Get(acc));
+            break;
+        case 0xAC:
+        case 0xAD:
+            Set(acc, Get(s));
+            break;
+        default:
+            Alu(7, Get(acc), Get(d), size);
+            break;
+        }
+        if (m_fault) {
+            return false;
+        }
+        if (op != 0xAA && op != 0xAB && op != 0xAE && op != 0xAF) {
+            m_reg[kEsi] += static_cast<uint32_t>(step);
+        }
+        if (op != 0xAC && op != 0xAD) {
+            m_reg[kEdi] += static_cast<uint32_t>(step);
+        }
+        if (!rep) {
+            return true;
+        }
+        if (!--m_reg[kEcx]) {
+            return true;
+        }
+        if (compare && Cond(4) != ((insn.prefixes & kX86Rep) != 0)) {
+            return true;
+        }
+    }
+}
+
+bool Emulator::TwoByte(const X86Insn& insn) {
+    const X86Operand& a = insn.operands[0];
+    const X86Operand& b = insn.operands[1];
+    uint16_t op = insn.opcode & 0xFF;
+
+    if (op >= 0x80 && op <= 0x8F) {
+        if (Cond(op & 0xF)) {
+            m_eip = insn.target;
+        }
+        return true;
+    }
+    if (op >= 0x90 && op <= 0x9F) {
+        Set(a, Cond(op & 0xF) ? 1 : 0);
+        return true;
+    }
+    if (op >= 0x40 && op <= 0x4F) {
+        // The source is read, and can fault, whether or not it moves.
+        uint32_t v = Get(b);
+        if (Cond(op & 0xF)) {
+            Set(a, v);
+        }
+        return true;
+    }
+    if (op >= 0xC8 && op <= 0xCF) {
+        uint32_t v = m_reg[op & 7];
+        m_reg[op & 7] = (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+        return true;
+    }
+
+    switch (op) {
+    case 0x19: case 0x1A: case 0x1B: case 0x1C: case 0x1D: case 0x1E: case 0x1F:
+        return true;
+    case 0x31:
+        // The instruction count stands in for the time stamp counter.
+        m_reg[kEax] = static_cast<uint32_t>(m_instructions);
+        m_reg[kEdx] = static_cast<uint32_t>(m_instructions >> 32);
+        return true;
+    case 0xA2:
+        // A family 6 processor with the FPU, TSC, CMPXCHG8B and CMOV,
+        // and no MMX, SSE or extended leaves (so no 3DNow!).
+        if (m_reg[kEax] == 0) {
+            m_reg[kEax] = 1;
+            m_reg[kEbx] = 0x756E6547;       // "Genu"
+            m_reg[kEdx] = 0x49656E69;       // "ineI"
+            m_reg[kEcx] = 0x6C65746E;       // "ntel"
+        } else if (m_reg[kEax] == 1) {
+            m_reg[kEax] = 0x00000633;
+            m_reg[kEbx] = 0;
+            m_reg[kEcx] = 0;
+            m_reg[kEdx] = 0x00008111;
+        } else {
+            m_reg[kEax] = m_reg[kEbx] = m_reg[kEcx] = m_reg[kEdx] = 0;
+        }
+        return true;
+    case 0xA3: case 0xAB: case 0xB3: case 0xBB: case 0xBA: {
+        int kind = op == 0xBA ? insn.reg - 4 : (op >> 3) & 3;
+        uint32_t bits = a.size * 8u;
+        X86Operand m = a;
+        uint32_t bit = Get(b);
+        if (op != 0xBA && a.type == kX86OpMem) {
+            // A register bit offset reaches past the operand.
+            int32_t offset = SignExtend(bit, a.size);
+            int32_t unit = offset >= 0 ? offset / static_cast<int32_t>(bits)
+                                       : -((-offset + static_cast<int32_t>(bits) - 1) / static_cast<int32_t>(bits));
+            m.disp += unit * static_cast<int32_t>(a.size);
+        }
+        bit &= bits - 1;
+        uint32_t v = Get(m);
+        SetFlags((Flags() & ~kCF) | ((v >> bit) & 1));
+        if (kind == 1) {
+            Set(m, v | (1u << bit));
+        } else if (kind == 2) {
+            Set(m, v & ~(1u << bit));
+        } else if (kind == 3) {
+            Set(m, v ^ (1u << bit));
+        }
+        return true;
+    }
+    case 0xA4: case 0xA5: case 0xAC: case 0xAD: {
+        uint32_t n = Get(insn.operands[2]) & 0x1F;
+        if (!n) {
+            return true;
+        }
+        uint32_t bits = a.size * 8u;
+        uint32_t mask = Mask(a.size);
+        uint32_t sign = SignBit(a.size);
+        uint64_t d = Get(a);
+        uint64_t s = Get(b);
+        uint32_t r = 0;
+        uint32_t cf = 0;
+        if (op <= 0xA5) {
+            r = static_cast<uint32_t>((((d << bits) | s) << n) >> bits) & mask;
+            cf = static_cast<uint32_t>(d >> (bits - n)) & 1;
+        } else {
+            r = static_cast<uint32_t>(((s << bits) | d) >> n) & mask;
+            cf = static_cast<uint32_t>(d >> (n - 1)) & 1;
+        }
+        Set(a, r);
+        SetFlags((Flags() & ~kArithFlags) | ZeroSignParity(r, a.size) | cf |
+                 ((r ^ static_cast<uint32_t>(d)) & sign ? kOF : 0));
+        return true;
+    }
+    case 0xAF: {
+        int64_t p = static_cast<int64_t>(SignExtend(Get(a), a.size)) * SignExtend(Get(b), a.size);
+        uint32_t r = static_cast<uint32_t>(p) & Mask(a.size);
+        Set(a, r);
+        SetFlags((Flags() & ~kArithFlags) | ZeroSignParity(r, a.size) |
+                 (p != SignExtend(r, a.size) ? kCF | kOF : 0));
+        return true;
+    }
+    case 0xB0:
+    case 0xB1: {
+        uint32_t v = Get(a);
+        Alu(7, GetReg(kEax, a.size), v, a.size);
+        if (Cond(4)) {
+            Set(a, Get(b));
+        } else {
+            SetReg(kEax, a.size, v);
+        }
+        return true;
+    }
+    case 0xB6: case 0xB7:
+        Set(a, Get(b));
+        return true;
+    case 0xBE: case 0xBF:
+        Set(a, static_cast<uint32_t>(SignExtend(Get(b), b.size)));
+        return true;
+    case 0xBC:
+    case 0xBD: {
+        uint32_t v = Get(b);
+        uint32_t f = Flags() & ~kZF;
+        if (!v) {
+            SetFlags(f | kZF);
+            return true;
+        }
+        uint32_t i = 0;
+        if (op == 0xBC) {
+            while (!((v >> i) & 1)) {
+                ++i;
+            }
+        } else {
+            i = a.size * 8u - 1;
+            while (!((v >> i) & 1)) {
+                --i;
+            }
+        }
+        Set(a, i);
+        SetFlags(f);
+        return true;
+    }
+    case 0xC0:
+    case 0xC1: {
+        uint32_t x = Get(a);
+        uint32_t y = Get(b);
+        uint32_t r = Alu(0, x, y, a.size);
+        Set(b, x);
+        Set(a, r);
+        return true;
+    }
+    default:
+        break;
+    }
+    return Fail(UsesSimd(insn) ? "MMX, 3DNow! and SSE are not emulated" : "instruction not emulated");
+}
+
+// ---------------------------------------------------------------------
+// x87
+
+void Emulator::FpuPush(double v) {
+    m_top = (m_top - 1) & 7;
+    // Pushing onto a full register is a masked stack overflow: the
+    // result is the indefinite NaN.
+    m_fpu[m_top] = (m_fpuEmpty >> m_top) & 1 ? v : -std::nan("");
+    m_fpuEmpty = static_cast<uint8_t>(m_fpuEmpty & ~(1u << m_top));
+}
+
+double Emulator::FpuPop() {
+    double v = m_fpu[m_top];
+    m_fpuEmpty = static_cast<uint8_t>(m_fpuEmpty | (1u << m_top));
+    m_top = (m_top + 1) & 7;
+    return v;
+}
+
+// Arithmetic results rounded to the precision control of the control
+// word: 24 bits is what Direct3D leaves the FPU at unless told to
+// preserve it.  Only the significand is narrowed; the exponent keeps
+// its full range, as it does in the x87 registers.
+double Emulator::FpuRound(double v) const {
+    if ((m_fcw & 0x300) != 0) {
+        return v;
+    }
+    if (v == 0.0 || !std::isfinite(v)) {
+        return v;
+    }
+    // Scaled into [0.5, 1) first, which is exact, so the float cast
+    // only narrows the significand and honours the host rounding mode
+    // whatever the exponent.
+    int exponent = 0;
+    double m = std::frexp(v, &exponent);
+    return std::ldexp(static_cast<double>(static_cast<float>(m)), exponent);
+}
+
+// x `op` y under the rounding and precision controls.  The host
+// rounding mode is only touched when the control word asks for
+// something other than round to nearest.
+double Emulator::FpuCompute(int op, double x, double y) const {
+    int rc = (m_fcw >> 10) & 3;
+    if (!rc) {
+        return FpuRound(Compute(op, x, y));
+    }
+    HostRounding rounding(rc);
+    return FpuRound(Compute(op, x, y));
+}
+
+// Rounding by the control word, for fist and frndint.
+double Emulator::FpuInteger(double v) const {
+    switch ((m_fcw >> 10) & 3) {
+    case 0:  return std::nearbyint(v);
+    case 1:  return std::floor(v);
+    case 2:  return std::ceil(v);
+    default: return std::trunc(v);
+    }
+}
+
+double Emulator::FpuLoad(uint32_t address, uint8_t size, bool integer) {
+    if (integer) {
+        if (size == 2) {
+            return static_cast<int16_t>(Read16(address));
+        }
+        if (size == 4) {
+            return static_cast<int32_t>(Read32(address));
+        }
+        uint64_t v = Read32(address) | (static_cast<uint64_t>(Read32(address + 4)) << 32);
+        return static_cast<double>(static_cast<int64_t>(v));
+    }
+    if (size == 4) {
+        uint32_t bits = Read32(address);
+        float f;
+        std::memcpy(&f, &bits, 4);
+        return f;
+    }
+    uint64_t bits = Read32(address) | (static_cast<uint64_t>(Read32(address + 4)) << 32);
+    if (size == 8) {
+        double d;
+        std::memcpy(&d, &bits, 8);
+        return d;
+    }
+    // 80-bit extended: explicit integer bit, 15-bit exponent.
+    uint16_t se = Read16(address + 8);
+    int exponent = se & 0x7FFF;
+    double sign = (se & 0x8000) ? -1.0 : 1.0;
+    if (exponent == 0x7FFF) {
+        return (bits << 1) ? std::nan("") : sign * HUGE_VAL;
+    }
+    if (!exponent && !bits) {
+        return sign * 0.0;
+    }
+    return sign * std::ldexp(static_cast<double>(bits), exponent - 16383 - 63);
+}
+
+void Emulator::FpuStore(uint32_t address, uint8_t size, bool integer, double v) {
+    if (integer) {
+        double r = FpuInteger(v);
+        // Out of range or NaN: the integer indefinite value.
+        if (size == 2) {
+            Write16(address, r >= -32768.0 && r <= 32767.0 ? static_cast<uint16_t>(static_cast<int16_t>(r)) : 0x8000);
+        } else if (size == 4) {
+            Write32(address, r >= -2147483648.0 && r <= 2147483647.0
+                                 ? static_cast<uint32_t>(static_cast<int32_t>(r)) : 0x80000000u);
+        } else {
+            uint64_t q = r >= -9223372036854775808.0 && r < 9223372036854775808.0
+                             ? static_cast<uint64_t>(static_cast<int64_t>(r)) : 0x8000000000000000ull;
+            Write32(address, static_cast<uint32_t>(q));
+            Write32(address + 4, static_cast<uint32_t>(q >> 32));
+        }
+        return;
+    }
+    if (size == 4) {
+        float f = static_cast<float>(v);
+        uint32_t bits;
+        std::memcpy(&bits, &f, 4);
+        Write32(address, bits);
+        return;
+    }
+    uint64_t bits = 0;
+    if (size == 8) {
+        std::memcpy(&bits, &v, 8);
+        Write32(address, static_cast<uint32_t>(bits));
+        Write32(address + 4, static_cast<uint32_t>(bits >> 32));
+        return;
+    }
+    uint16_t se = std::signbit(v) ? 0x8000 : 0;
+    if (std::isnan(v)) {
+        se |= 0x7FFF;
+        bits = 0xC000000000000000ull;
+    } else if (std::isinf(v)) {
+        se |= 0x7FFF;
+        bits = 0x8000000000000000ull;
+    } else if (v != 0.0) {
+        int e = 0;
+        double m = std::frexp(std::fabs(v), &e);
+        bits = static_cast<uint64_t>(std::ldexp(m, 64));
+        se = static_cast<uint16_t>(se | (e - 1 + 16383));
+    }
+    Write32(address, static_cast<uint32_t>(bits));
+    Write32(address + 4, static_cast<uint32_t>(bits >> 32));
+    Write16(address + 8, se);
+}
+
+// fprem and fprem1, reduced completely in one step (C2 clear) where
+// the hardware may take several; a loop on C2 ends after one pass
+// with the same result.  C0 C3 C1 receive the low three bits of the
+// quotient, which sine and cosine routines use to pick the octant.
+double Emulator::FpuRemainder(double x, double y, bool nearest) {
+    double r = nearest ? std::remainder(x, y) : std::fmod(x, y);
+    uint32_t q = 0;
+    if (std::isfinite(r) && y != 0.0 && std::fabs(y) < DBL_MAX / 8) {
+        double q8 = nearest ? std::remainder(x, 8 * y) : std::fmod(x, 8 * y);
+        q = static_cast<uint32_t>(std::llround((q8 - r) / y)) & 7;
+    }
+    m_fsw = static_cast<uint16_t>((m_fsw & ~(kC0 | kC1 | kC2 | kC3)) | ((q & 4) ? kC0 : 0) | ((q & 2) ? kC3 : 0) |
+                                  ((q & 1) ? kC1 : 0));
+    return r;
+}
+
+// fcom sets C3 C2 C0 in the status word; fcomi sets ZF PF CF the same
+// way.
+void Emulator::FpuCompare(double a, double b, bool eflags) {
+    uint32_t bits = 0;
+    if (std::isnan(a) || std::isnan(b)) {
+        bits = 7;
+    } else if (a < b) {
+        bits = 1;
+    } else if (a == b) {
+        bits = 4;
+    }
+    if (eflags) {
+        SetFlags((Flags() & ~kArithFlags) | ((bits & 4) ? kZF : 0) | ((bits & 2) ? kPF : 0) | ((bits & 1) ? kCF : 0));
+    } else {
+        m_fsw = static_cast<uint16_t>((m_fsw & ~(kC0 | kC1 | kC2 | kC3)) | ((bits & 4) ? kC3 : 0) |
+                                      ((bits & 2) ? kC2 : 0) | ((bits & 1) ? kC0 : 0));
+    }
+}
+
+// fadd fmul fcom fcomp fsub fsubr fdiv fdivr as `st0 op= v`; the
+// comparisons leave st0 alone.
+bool Emulator::FpuArith(int op, double v) {
+    double& st = St(0);
+    switch (op) {
+    case 0: st = FpuCompute(kFpuAdd, st, v); break;
+    case 1: st = FpuCompute(kFpuMul, st, v); break;
+    case 2: FpuCompare(st, v, false); break;
+    case 3: FpuCompare(st, v, false); FpuPop(); break;
+    case 4: st = FpuCompute(kFpuSub, st, v); break;
+    case 5: st = FpuCompute(kFpuSub, v, st); break;
+    case 6: st = FpuCompute(kFpuDiv, st, v); break;
+    default: st = FpuCompute(kFpuDiv, v, st); break;
+    }
+    return true;
+}
+
+bool Emulator::Fpu(const X86Insn& insn) {
+    int x = (insn.opcode & 0xFF) - 0xD8;
+    int reg = insn.reg;
+    int rm = insn.rm;
+
+    if (insn.mod != 3) {
+        const X86Operand& m = insn.operands[0];
+        uint32_t address = Address(m);
+        switch (x) {
+        case 0:
+        case 2:
+        case 4:
+        case 6:
+            return FpuArith(reg, FpuLoad(address, m.size, x == 2 || x == 6));
+        case 1:
+            switch (reg) {
+            case 0: FpuPush(FpuLoad(address, 4, false)); return true;
+            case 2: FpuStore(address, 4, false, St(0)); return true;
+            case 3: FpuStore(address, 4, false, FpuPop()); return true;
+            case 5: m_fcw = Read16(address); return true;
+            case 7: Write16(address, m_fcw); return true;
+            default: break;
+            }
+            break;
+        case 3:
+        case 5:
+        case 7: {
+            // fild, fisttp, fist, fistp and the 64- and 80-bit forms.
+            bool integer = x != 5 && !(x == 3 && (reg == 5 || reg == 7));
+            if (x == 5 && reg == 7) {
+                Write16(address, static_cast<uint16_t>((m_fsw & ~0x3800) | (m_top << 11)));
+                return true;
+            }
+            if (reg == 4 || reg == 6 || (x == 5 && reg >= 4)) {
+                break;      // fbld, fbstp, fldenv-style state
+            }
+            if (reg == 0 || reg == 5) {
+                FpuPush(FpuLoad(address, m.size, integer));
+            } else if (reg == 1) {
+                uint16_t fcw = m_fcw;
+                m_fcw |= 0x0C00;
+                FpuStore(address, m.size, integer || x == 5, FpuPop());
+                m_fcw = fcw;
+            } else {
+                FpuStore(address, m.size, integer, reg == 2 ? St(0) : FpuPop());
+            }
+            return true;
+        }
+        default:
+            break;
+        }
+        return Fail("x87 environment instructions not emulated");
+    }
+
+    double& st0 = St(0);
+    switch (x) {
+    case 0:
+        return FpuArith(reg, St(rm));
+    case 1:
+        switch (reg) {
+        case 0: FpuPush(St(rm)); return true;
+        case 1: std::swap(st0, St(rm)); return true;
+        case 2: return true;                            // fnop
+        case 3: St(rm) = st0; FpuPop(); return true;    // fstp1
+        case 4:
+            switch (rm) {
+            case 0: st0 = -st0; return true;
+            case 1: st0 = std::fabs(st0); return true;
+            case 4: FpuCompare(st0, 0.0, false); return true;
+            case 5: {
+                uint16_t c = 0;
+                if ((m_fpuEmpty >> m_top) & 1) {
+                    c = kC3 | kC0;
+                } else if (std::isnan(st0)) {
+                    c = kC0;
+                } else if (std::isinf(st0)) {
+                    c = kC2 | kC0;
+                } else if (st0 == 0.0) {
+                    c = kC3;
+                } else if (std::fpclassify(st0) == FP_SUBNORMAL) {
+                    c = kC3 | kC2;
+                } else {
+                    c = kC2;
+                }
+                c = static_cast<uint16_t>(c | (std::signbit(st0) ? kC1 : 0));
+                m_fsw = static_cast<uint16_t>((m_fsw & ~(kC0 | kC1 | kC2 | kC3)) | c);
+                return true;
+            }
+            default: break;
+            }
+            break;
+        case 5: {
+            static const double kConstants[7] = {
+                1.0, 3.321928094887362347870, 1.442695040888963407360, 3.141592653589793238463,
+                0.301029995663981195214, 0.693147180559945309417, 0.0,
+            };
+            if (rm < 7) {
+                FpuPush(kConstants[rm]);
+                return true;
+            }
+            break;
+        }
+        case 6:
+            switch (rm) {
+            case 0: st0 = FpuRound(std::exp2(st0) - 1.0); return true;
+            case 1: { double y = St(1); FpuPop(); St(0) = FpuRound(y * std::log2(st0)); return true; }
+            case 2: st0 = FpuRound(std::tan(st0)); FpuPush(1.0); m_fsw &= ~kC2; return true;
+            case 3: { double y = St(1); double v = st0; FpuPop(); St(0) = FpuRound(std::atan2(y, v)); return true; }
+            case 4: {
+                double v = st0;
+                double e = v == 0.0 ? -HUGE_VAL : std::logb(v);
+                st0 = e;
+                FpuPush(v == 0.0 ? v : std::ldexp(v, -static_cast<int>(e)));
+                return true;
+            }
+            case 5: st0 = FpuRemainder(st0, St(1), true); return true;
+            case 6: m_top = (m_top - 1) & 7; return true;
+            case 7: m_top = (m_top + 1) & 7; return true;
+            default: break;
+            }
+            break;
+        default:
+            switch (rm) {
+            case 0: st0 = FpuRemainder(st0, St(1), false); return true;
+            case 1: { double y = St(1); double v = st0; FpuPop(); St(0) = FpuRound(y * std::log2(v + 1.0)); return true; }
+            case 2: st0 = FpuCompute(kFpuSqrt, st0, 0.0); return true;
+            case 3: { double v = st0; st0 = FpuRound(std::sin(v)); FpuPush(FpuRound(std::cos(v))); m_fsw &= ~kC2; return true; }
+            case 4: st0 = FpuInteger(st0); return true;
+            case 5: {
+                // Scales past the double range saturate anyway.
+                double n = std::max(-100000.0, std::min(100000.0, std::trunc(St(1))));
+                st0 = std::isnan(n) ? n : FpuCompute(kFpuScale, st0, n);
+                return true;
+            }
+            case 6: st0 = FpuRound(std::sin(st0)); m_fsw &= ~kC2; return true;
+            default: st0 = FpuRound(std::cos(st0)); m_fsw &= ~kC2; return true;
+            }
+        }
+        break;
+    case 2:
+        if (reg < 4) {
+            static const int kCc[4] = { 0x2, 0x4, 0x6, 0xA };     // b e be u
+            if (Cond(kCc[reg])) {
+                st0 = St(rm);
+            }
+            return true;
+        }
+        if (reg == 5 && rm == 1) {                      // fucompp
+            FpuCompare(st0, St(1), false);
+            FpuPop();
+            FpuPop();
+            return true;
+        }
+        break;
+    case 3:
+        if (reg < 4) {
+            static const int kCc[4] = { 0x3, 0x5, 0x7, 0xB };     // nb ne nbe nu
+            if (Cond(kCc[reg])) {
+                st0 = St(rm);
+            }
+            return true;
+        }
+        if (reg == 4 && rm == 2) {                      // fnclex
+            m_fsw &= 0x7F00;
+            return true;
+        }
+        if (reg == 4 && rm == 3) {                      // fninit
+            m_fcw = 0x037F;
+            m_fsw = 0;
+            m_top = 0;
+            m_fpuEmpty = 0xFF;
+            return true;
+        }
+        if (reg == 5 || reg == 6) {                     // fucomi, fcomi
+            FpuCompare(st0, St(rm), true);
+            return true;
+        }
+        break;
+    case 4:
+    case 6: {
+        // st(i) op= st0, popping for DE.  The reg 4-7 forms are the
+        // reverse of D8's: E0+i is fsubr, st(i) = st0 - st(i).
+        double& sti = St(rm);
+        switch (reg) {
+        case 0: sti = FpuCompute(kFpuAdd, sti, st0); break;
+        case 1: sti = FpuCompute(kFpuMul, sti, st0); break;
+        case 2: FpuCompare(st0, sti, false); break;
+        case 3:
+            FpuCompare(st0, sti, false);
+            if (x == 6) {
+                if (rm != 1) {
+                    return Fail("x87 instruction not emulated");
+                }
+                FpuPop();                               // fcompp
+            }
+            break;
+        case 4: sti = FpuCompute(kFpuSub, st0, sti); break;
+        case 5: sti = FpuCompute(kFpuSub, sti, st0); break;
+        case 6: sti = FpuCompute(kFpuDiv, st0, sti); break;
+        default: sti = FpuCompute(kFpuDiv, sti, st0); break;
+        }
+        if (x == 6 || reg == 3) {
+            FpuPop();
+        }
+        return true;
+    }
+    case 5:
+        switch (reg) {
+        case 0: m_fpuEmpty = static_cast<uint8_t>(m_fpuEmpty | (1u << ((m_top + rm) & 7))); return true;
+        case 1: std::swap(st0, St(rm)); return true;
+        case 2: St(rm) = st0; return true;
+        case 3: St(rm) = st0; FpuPop(); return true;
+        case 4: FpuCompare(st0, St(rm), false); return true;
+        case 5: FpuCompare(st0, St(rm), false); FpuPop(); return true;
+        default: break;
+        }
+        break;
+    default:
+        if (reg == 4 && rm == 0) {                      // fnstsw ax
+            SetReg(kEax, 2, static_cast<uint32_t>((m_fsw & ~0x3800) | (m_top << 11)));
+            return true;
+        }
+        if (reg == 0) {                                 // ffreep
+            m_fpuEmpty = static_cast<uint8_t>(m_fpuEmpty | (1u << ((m_top + rm) & 7)));
+            FpuPop();
+            return true;
+        }
+        if (reg == 5 || reg == 6) {                     // fucomip, fcomip
+            FpuCompare(st0, St(rm), true);
+            FpuPop();
+            return true;
+        }
+        break;
+    }
+    return Fail("x87 instruction not emulated");
+}
@@ -0,0 +1,232 @@
+// Copyright (c) 2025
+//
+// User-mode x86-32 interpreter for running digi.exe routines outside
+// Windows.  The reconstructions in digi_analysis can otherwise only be
+// checked by injecting the DLL into the running game; with this they
+// can be called side by side with the original code on any machine.
+//
+// The image is copied section by section into one flat block of
+// memory at its preferred base, followed by a heap, a stack and the
+// thread information block fs points at.  Every IAT slot is filled
+// with the address of a thunk outside that memory; jumping to one runs
+// the handler registered for the import through RegisterImports, or
+// stops with an error naming it.  Call() pushes the arguments and a
+// return address no code can reach, and runs until the routine
+// returns to it.
+//
+// Instructions are decoded once per basic block with DecodeX86 and
+// kept in a cache indexed by address, so a routine called millions of
+// times is decoded once.  A store into the code section throws the
+// cache away.  Arithmetic flags are computed lazily from the last
+// flag-setting operation, since most of them are overwritten before
+// anything reads them.
+//
+// What is covered is what the game's own code uses: the integer
+// instruction set without the system instructions, and x87, whose
+// registers are held as doubles.  Results are rounded to the precision
+// control of the control word (53 bits as Windows starts a thread, 24
+// once Direct3D has set it), so they match the hardware except where
+// a 64-bit intermediate would have been rounded differently or left
+// the double range, and for the transcendental instructions, which use
+// the C library.  The exception flags are not kept, and fprem reduces
+// completely in one go rather than in the hardware's partial steps,
+// which only changes how often a loop around it goes round.  cpuid
+// reports a processor with neither MMX, 3DNow! nor SSE, which steers
+// the D3DX routines onto their x87 paths; executing one of those
+// instructions anyway stops with an error, as do port I/O, segment
+// register loads and privileged instructions.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/pe_image.h"
+#include "../common/x86_decode.h"
+
+class Emulator;
+
+// Called with esp pointing at the return address, so Arg(0) is the
+// first argument.  The result goes to eax; `argBytes` of the stub say
+// how much the import pops (the arguments of a __stdcall import, 0 for
+// __cdecl ones).
+typedef uint32_t (*ImportHandler)(Emulator& emu, void* context);
+
+struct ImportStub {
+    const char*   dll;          // matched case-insensitively
+    const char*   name;         // nullptr to match `ordinal` instead
+    uint16_t      ordinal;
+    uint32_t      argBytes;
+    ImportHandler handler;
+};
+
+enum EmuReg : uint8_t { kEax, kEcx, kEdx, kEbx, kEsp, kEbp, kEsi, kEdi };
+
+class Emulator {
+public:
+    Emulator();
+
+    // Map `image` and point its IAT at the import thunks.  `image` is
+    // not referenced afterwards.
+    bool Load(const PeImage& image);
+
+    // Bind every import matching an entry of `stubs`.  May be called
+    // more than once; later tables override earlier ones.  Returns the
+    // number of imports bound.
+    size_t RegisterImports(const ImportStub* stubs, size_t count, void* context);
+
+    // Run the __cdecl or __stdcall routine at `address` on `args` and
+    // return its eax in `result`.  Registers other than esp keep the
+    // values they had, so a routine using another convention can be
+    // called by setting them first.  Returns false, with error() set,
+    // if the routine faulted or ran into something unsupported.
+    bool Call(uint32_t address, const uint32_t* args, size_t count, uint32_t* result);
+
+    // Stop a runaway routine after this many instructions (default
+    // 100 million per Call).
+    void setInstructionLimit(uint64_t limit) { m_limit = limit; }
+
+    const std::string& error() const { return m_error; }
+    uint64_t instructions() const { return m_instructions; }
+    size_t cachedBlocks() const { return m_blocks.size(); }
+
+    uint32_t reg(EmuReg r) const { return m_reg[r]; }
+    void setReg(EmuReg r, uint32_t value) { m_reg[r] = value; }
+    // Take st(0) off the x87 stack, where routines return floating
+    // point results.  Returns false if the stack is empty.
+    bool PopFloat(double* out);
+    // Push `v`, for handlers standing in for routines that return a
+    // float.
+    void PushFloat(double v) { FpuPush(v); }
+    int fpuDepth() const;
+
+    // For handlers: stop the run with `why` as the error.
+    void Abort(const char* why);
+
+    // The `i`th dword argument of the routine an import handler is
+    // running for.
+    uint32_t Arg(int i);
+
+    // Memory access for handlers and harnesses.  Out-of-range reads
+    // return 0 and writes are dropped, both setting error().
+    uint8_t  Read8(uint32_t address);
+    uint16_t Read16(uint32_t address);
+    uint32_t Read32(uint32_t address);
+    void Write8(uint32_t address, uint8_t value);
+    void Write16(uint32_t address, uint16_t value);
+    void Write32(uint32_t address, uint32_t value);
+    bool ReadBytes(uint32_t address, void* out, size_t size);
+    bool WriteBytes(uint32_t address, const void* data, size_t size);
+    // Host pointer to `size` bytes at `address`, or nullptr.
+    uint8_t* Host(uint32_t address, size_t size);
+
+    // `size` bytes of zeroed, 16-byte aligned memory from the heap
+    // region, or 0 when it is exhausted.  Never freed; ResetHeap()
+    // empties the heap again.
+    uint32_t Alloc(uint32_t size);
+    void ResetHeap() { m_heapTop = m_heapBase; }
+
+private:
+    struct Block {
+        uint32_t start;
+        uint32_t first;         // index into m_insns
+        uint32_t count;
+    };
+
+    // How the arithmetic flags are derived from m_flagDst/Src/Result.
+    enum FlagOp : uint8_t { kFlagsEager, kFlagsAdd, kFlagsSub, kFlagsLogic, kFlagsInc, kFlagsDec };
+
+    uint32_t DecodeBlock(uint32_t address);
+    void FlushBlocks();
+    bool Run();
+    bool Step(const X86Insn& insn);
+    bool Fail(const char* what);
+    bool Located(const X86Insn& insn);
+    bool RunImport(uint32_t index);
+    void MemoryFault(uint32_t address, uint32_t size, const char* access);
+
+    uint32_t Address(const X86Operand& op);
+    uint32_t Get(const X86Operand& op);
+    void Set(const X86Operand& op, uint32_t value);
+    uint32_t GetReg(uint8_t reg, uint8_t size) const;
+    void SetReg(uint8_t reg, uint8_t size, uint32_t value);
+    void Push(uint32_t value);
+    uint32_t Pop();
+
+    uint32_t Flags();
+    void SetFlags(uint32_t eflags);
+    void SetLazy(FlagOp op, uint32_t dst, uint32_t src, uint32_t result, uint8_t size);
+    bool Cond(int cc);
+
+    uint32_t Alu(int op, uint32_t dst, uint32_t src, uint8_t size);
+    uint32_t Shift(int op, uint32_t value, uint32_t count, uint8_t size);
+    bool MulDiv(const X86Insn& insn, int op);
+    bool StringOp(const X86Insn& insn);
+    bool TwoByte(const X86Insn& insn);
+    bool Fpu(const X86Insn& insn);
+
+    double& St(int i) { return m_fpu[(m_top + i) & 7]; }
+    void FpuPush(double v);
+    double FpuPop();
+    double FpuLoad(uint32_t address, uint8_t size, bool integer);
+    void FpuStore(uint32_t address, uint8_t size, bool integer, double v);
+    void FpuCompare(double a, double b, bool eflags);
+    bool FpuArith(int op, double v);
+    double FpuRound(double v) const;
+    double FpuCompute(int op, double x, double y) const;
+    double FpuRemainder(double x, double y, bool nearest);
+    double FpuInteger(double v) const;
+
+    // Flat memory from m_base; the image comes first.
+    std::vector<uint8_t> m_memory;
+    uint8_t*  m_mem = nullptr;
+    uint32_t  m_base = 0;
+    uint32_t  m_size = 0;
+    uint32_t  m_textStart = 0;
+    uint32_t  m_textSize = 0;
+    uint32_t  m_heapBase = 0;
+    uint32_t  m_heapTop = 0;
+    uint32_t  m_heapEnd = 0;
+    uint32_t  m_stackTop = 0;
+    uint32_t  m_fsBase = 0;
+    bool      m_codeWritten = false;
+    bool      m_fault = false;
+
+    struct ImportSlot {
+        std::string   dll;
+        std::string   name;
+        uint16_t      ordinal;
+        ImportHandler handler;
+        void*         context;
+        uint32_t      argBytes;
+    };
+    std::vector<ImportSlot> m_imports;
+
+    // Decoded blocks; m_blockAt holds index + 1 per code byte.
+    std::vector<X86Insn>  m_insns;
+    std::vector<Block>    m_blocks;
+    std::vector<uint32_t> m_blockAt;
+
+    uint32_t m_reg[8];
+    uint32_t m_eip = 0;
+    uint32_t m_eflags = 0;
+    FlagOp   m_flagOp = kFlagsEager;
+    uint8_t  m_flagSize = 4;
+    uint32_t m_flagDst = 0;
+    uint32_t m_flagSrc = 0;
+    uint32_t m_flagResult = 0;
+
+    double   m_fpu[8];
+    uint8_t  m_fpuEmpty = 0xFF;     // bit per physical register
+    int      m_top = 0;
+    uint16_t m_fsw = 0;
+    uint16_t m_fcw = 0x027F;
+
+    uint64_t m_instructions = 0;
+    uint64_t m_limit = 100000000;
+    uint64_t m_stopAt = 0;
+    int      m_depth = 0;          // nested Call()s
+    std::string m_error;
+};
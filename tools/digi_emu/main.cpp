@@ -0,0 +1,256 @@
+// Copyright (c) 2025
+//
+// digi_emu: run digi.exe routines in the x86-32 interpreter (see
+// emulator.h), either to check the reconstructions in digi_analysis
+// against them or to try one out by hand.
+//
+//     digi_emu <digi.exe> verify [calls]
+//     digi_emu <digi.exe> call <address> [arg ...]
+//
+// `verify` calls every original in kCases and its reconstruction on
+// the same arguments (the edge cases of the routine, then `calls`
+// random ones, a million by default), reports each mismatch and how
+// many calls a second the interpreter managed.  It exits non-zero on
+// any mismatch, so it can gate a build.  `call` runs the routine at
+// `address` on the given arguments (decimal, or hex with 0x) and
+// prints eax, st(0) if the routine left a float there, and the number
+// of instructions it took.
+//
+// The runtime imports the game's arithmetic leans on (_ftol, floor,
+// rand, timeGetTime, ...) are stubbed in kRuntimeStubs; calling any
+// other import stops the routine with its name.  Builds on Linux:
+//
+//     g++ -O2 tools/digi_emu/*.cpp tools/common/*.cpp digi_analysis/functions.cpp digi_analysis/digi_table.cpp -o digi_emu
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../../digi_analysis/functions.h"
+#include "emulator.h"
+
+namespace {
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_emu <digi.exe> verify [calls]\n"
+                     "       digi_emu <digi.exe> call <address> [arg ...]\n");
+        return 1;
+    }
+
+    // ---- import stubs ------------------------------------------------
+
+    struct RuntimeState {
+        uint32_t randSeed = 1;
+    };
+
+    double ArgDouble(Emulator& emu, int i) {
+        uint32_t words[2] = { emu.Arg(i), emu.Arg(i + 1) };
+        double v;
+        std::memcpy(&v, words, sizeof(v));
+        return v;
+    }
+
+    double PopArgument(Emulator& emu) {
+        double v = 0.0;
+        if (!emu.PopFloat(&v)) {
+            emu.Abort("float argument expected on an empty x87 stack");
+        }
+        return v;
+    }
+
+    // st(0) truncated to a 64-bit integer in edx:eax, popped.
+    uint32_t Ftol(Emulator& emu, void*) {
+        double v = std::trunc(PopArgument(emu));
+        int64_t q = v >= -9223372036854775808.0 && v < 9223372036854775808.0 ? static_cast<int64_t>(v) : INT64_MIN;
+        emu.setReg(kEdx, static_cast<uint32_t>(static_cast<uint64_t>(q) >> 32));
+        return static_cast<uint32_t>(q);
+    }
+
+    uint32_t Floor(Emulator& emu, void*) {
+        emu.PushFloat(std::floor(ArgDouble(emu, 0)));
+        return 0;
+    }
+
+    uint32_t CiAsin(Emulator& emu, void*) {
+        emu.PushFloat(std::asin(PopArgument(emu)));
+        return 0;
+    }
+
+    uint32_t CiAcos(Emulator& emu, void*) {
+        emu.PushFloat(std::acos(PopArgument(emu)));
+        return 0;
+    }
+
+    uint32_t Finite(Emulator& emu, void*) {
+        return std::isfinite(ArgDouble(emu, 0)) ? 1 : 0;
+    }
+
+    // The MSVCRT generator, so a routine sees the sequence it sees in
+    // the game.
+    uint32_t Rand(Emulator&, void* context) {
+        RuntimeState* state = static_cast<RuntimeState*>(context);
+        state->randSeed = state->randSeed * 214013 + 2531011;
+        return (state->randSeed >> 16) & 0x7FFF;
+    }
+
+    // A clock that advances with the work done, so timing loops end
+    // and runs repeat exactly.
+    uint32_t TimeGetTime(Emulator& emu, void*) {
+        return static_cast<uint32_t>(emu.instructions() / 1000);
+    }
+
+    uint32_t ReturnZero(Emulator&, void*) {
+        return 0;
+    }
+
+    const ImportStub kRuntimeStubs[] = {
+        { "MSVCRT.dll", "_ftol", 0, 0, Ftol },
+        { "MSVCRT.dll", "floor", 0, 0, Floor },
+        { "MSVCRT.dll", "_CIasin", 0, 0, CiAsin },
+        { "MSVCRT.dll", "_CIacos", 0, 0, CiAcos },
+        { "MSVCRT.dll", "_finite", 0, 0, Finite },
+        { "MSVCRT.dll", "rand", 0, 0, Rand },
+        { "WINMM.dll", "timeGetTime", 0, 0, TimeGetTime },
+        { "KERNEL32.dll", "IsProcessorFeaturePresent", 0, 4, ReturnZero },
+        { "KERNEL32.dll", "Sleep", 0, 4, ReturnZero },
+    };
+
+    // ---- reconstructions ----------------------------------------------
+
+    // A reconstruction is called with one dword and its result
+    // widened to a dword the way the original leaves it in eax.
+    struct DiffCase {
+        const char* name;
+        uint32_t    address;
+        uint32_t  (*reconstruction)(uint32_t);
+    };
+
+    uint32_t Widen(int16_t v) {
+        return static_cast<uint32_t>(static_cast<int32_t>(v));
+    }
+
+    uint32_t Call401000(uint32_t v) { return Widen(func_401000(static_cast<int32_t>(v))); }
+    uint32_t Call401020(uint32_t v) { return Widen(func_401020(static_cast<int32_t>(v))); }
+    uint32_t Call401040(uint32_t v) { return Widen(func_401040(static_cast<int32_t>(v))); }
+    uint32_t Call401050(uint32_t v) { return Widen(func_401050(static_cast<int32_t>(v))); }
+
+    const DiffCase kCases[] = {
+        { "func_401000", 0x401000, Call401000 },
+        { "func_401020", 0x401020, Call401020 },
+        { "func_401040", 0x401040, Call401040 },
+        { "func_401050", 0x401050, Call401050 },
+    };
+
+    // Table wrap-around and the ends of the int32 range.
+    const uint32_t kEdgeArgs[] = {
+        0, 1, 0x3FF, 0x400, 0x401, 0x7FF, 0x800, 0xBFF, 0xC00, 0xFFF, 0x1000, 0x1001,
+        0xFFFFFFFF, 0xFFFFFC00, 0xFFFFF000, 0x7FFFFFFF, 0x80000000, 0x7FFFFC00, 0x7FFFFBFF,
+    };
+
+    uint32_t XorShift(uint32_t* state) {
+        uint32_t x = *state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return *state = x;
+    }
+
+    double Seconds(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    }
+
+    int Verify(Emulator& emu, uint32_t calls) {
+        const size_t kMaxShown = 8;
+        int failed = 0;
+        for (const DiffCase& c : kCases) {
+            size_t total = sizeof(kEdgeArgs) / sizeof(kEdgeArgs[0]) + calls;
+            size_t mismatches = 0;
+            uint32_t seed = 0x2545F491;
+            uint64_t before = emu.instructions();
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < total; ++i) {
+                uint32_t arg = i < sizeof(kEdgeArgs) / sizeof(kEdgeArgs[0]) ? kEdgeArgs[i] : XorShift(&seed);
+                uint32_t original = 0;
+                if (!emu.Call(c.address, &arg, 1, &original)) {
+                    std::printf("%-12s 0x%08X  arg 0x%08X: %s\n", c.name, c.address, arg, emu.error().c_str());
+                    return 1;
+                }
+                uint32_t mine = c.reconstruction(arg);
+                if (mine != original && ++mismatches <= kMaxShown) {
+                    std::printf("%-12s arg 0x%08X: original 0x%08X, reconstruction 0x%08X\n", c.name, arg, original,
+                                mine);
+                }
+            }
+            double seconds = Seconds(start, std::chrono::steady_clock::now());
+            std::printf("%-12s 0x%08X  %zu calls, %zu mismatches, %.1f M calls/s, %.1f instructions/call\n", c.name,
+                        c.address, total, mismatches, total / seconds / 1e6,
+                        static_cast<double>(emu.instructions() - before) / total);
+            failed |= mismatches != 0;
+        }
+        return failed;
+    }
+
+    int CallOne(Emulator& emu, int argc, char** argv) {
+        char* end = nullptr;
+        uint32_t address = static_cast<uint32_t>(std::strtoul(argv[0], &end, 16));
+        if (!*argv[0] || *end) {
+            return Usage();
+        }
+        std::vector<uint32_t> args;
+        for (int i = 1; i < argc; ++i) {
+            long long v = std::strtoll(argv[i], &end, 0);
+            if (!*argv[i] || *end) {
+                return Usage();
+            }
+            args.push_back(static_cast<uint32_t>(v));
+        }
+        uint32_t eax = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = emu.Call(address, args.data(), args.size(), &eax);
+        double seconds = Seconds(start, std::chrono::steady_clock::now());
+        if (!ok) {
+            std::printf("error: %s\n", emu.error().c_str());
+        } else {
+            std::printf("eax = 0x%08X (%d)\n", eax, static_cast<int32_t>(eax));
+            double st0 = 0.0;
+            if (emu.PopFloat(&st0)) {
+                std::printf("st0 = %.17g\n", st0);
+            }
+        }
+        std::printf("%llu instructions, %zu blocks decoded, %.1f us\n",
+                    static_cast<unsigned long long>(emu.instructions()), emu.cachedBlocks(), seconds * 1e6);
+        return ok ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return Usage();
+    }
+    MappedFile file;
+    PeImage image;
+    if (!file.Open(argv[1]) || !image.Load(file.data(), file.size())) {
+        std::fprintf(stderr, "digi_emu: %s is not a 32-bit PE image\n", argv[1]);
+        return 1;
+    }
+    Emulator emu;
+    if (!emu.Load(image)) {
+        std::fprintf(stderr, "digi_emu: cannot map %s\n", argv[1]);
+        return 1;
+    }
+    RuntimeState runtime;
+    emu.RegisterImports(kRuntimeStubs, sizeof(kRuntimeStubs) / sizeof(kRuntimeStubs[0]), &runtime);
+
+    if (std::strcmp(argv[2], "verify") == 0 && argc <= 4) {
+        uint32_t calls = argc == 4 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 0)) : 1000000;
+        return Verify(emu, calls);
+    }
+    if (std::strcmp(argv[2], "call") == 0 && argc >= 4) {
+        return CallOne(emu, argc - 3, argv + 3);
+    }
+    return Usage();
+}
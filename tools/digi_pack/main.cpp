@@ -0,0 +1,445 @@
+// Copyright (c) 2025
+//
+// digi_pack: pack the game's loose asset files into one archive (see
+// digi_analysis/asset_archive.h) for the file hooks to serve from a
+// single mapping.
+//
+//     digi_pack build [--lz4] [--block-size KB] <game dir> <out.pak> [dir ...]
+//     digi_pack list <archive.pak>
+//     digi_pack verify <archive.pak> <game dir> [dir ...]
+//
+// `build` packs every file under the given directories of the game
+// directory (ETCDAT, CARD, SOUND, ...), or under all of its
+// subdirectories if none are given; the files next to digi.exe are left
+// out.  With --lz4 each file is compressed in blocks (64 KB unless
+// --block-size says otherwise) and kept compressed if that saves at
+// least an eighth.  Put the archive next to digi.exe as digi.pak, or
+// point DIGI_ARCHIVE at it.  `list` prints the entries.  `verify` reads
+// every file back through the archive in uneven chunks, compares it
+// with the loose file and times both ways of reading.
+//
+//     g++ -O2 tools/digi_pack/*.cpp tools/common/mapped_file.cpp digi_analysis/asset_archive.cpp digi_analysis/lz4_block.cpp -o digi_pack
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include "../common/mapped_file.h"
+#include "../../digi_analysis/asset_archive.h"
+#include "../../digi_analysis/lz4_block.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const uint32_t kDefaultBlockSize = 64 * 1024;
+
+    // Compressed entries must come to at most 7/8 of their size; below
+    // that saving the decompression costs more than the smaller map.
+    const uint32_t kMinSavingShift = 3;
+
+#if defined(_WIN32)
+    const char kSeparator = '\\';
+#else
+    const char kSeparator = '/';
+#endif
+
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_pack build [--lz4] [--block-size KB] <game dir> <out.pak> [dir ...]\n"
+                     "       digi_pack list <archive.pak>\n"
+                     "       digi_pack verify <archive.pak> <game dir> [dir ...]\n");
+        return 1;
+    }
+
+    double Seconds(Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    }
+
+    struct LooseFile {
+        std::string path;               // on disk
+        std::string name;               // normalised, relative to the game directory
+    };
+
+    std::string Normalise(const std::string& relative) {
+        std::string out(relative.size(), '\0');
+        out.resize(NormaliseAssetPath(relative.data(), relative.size(), &out[0]));
+        return out;
+    }
+
+    // Append the files under `dir` (`relative` to the game directory)
+    // to `files`.  `dir` may also name a single file.
+    void ListFiles(const std::string& dir, const std::string& relative, bool topLevel,
+                   std::vector<LooseFile>* files) {
+#if defined(_WIN32)
+        DWORD attributes = GetFileAttributesA(dir.c_str());
+        if (attributes == INVALID_FILE_ATTRIBUTES) {
+            return;
+        }
+        if (!(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            files->push_back({ dir, Normalise(relative) });
+            return;
+        }
+        WIN32_FIND_DATAA entry;
+        HANDLE find = FindFirstFileA((dir + "\\*").c_str(), &entry);
+        if (find == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            std::string name = entry.cFileName;
+            bool isDir = (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            if (name == "." || name == ".." || (topLevel && !isDir)) {
+                continue;
+            }
+            ListFiles(dir + "\\" + name, relative.empty() ? name : relative + "\\" + name, false, files);
+        } while (FindNextFileA(find, &entry));
+        FindClose(find);
+#else
+        struct stat st;
+        if (stat(dir.c_str(), &st) != 0) {
+            return;
+        }
+        if (!S_ISDIR(st.st_mode)) {
+            files->push_back({ dir, Normalise(relative) });
+            return;
+        }
+        DIR* d = opendir(dir.c_str());
+        if (!d) {
+            return;
+        }
+        while (dirent* entry = readdir(d)) {
+            std::string name = entry->d_name;
+            std::string path = dir + "/" + name;
+            if (name == "." || name == ".." || stat(path.c_str(), &st) != 0 || (topLevel && !S_ISDIR(st.st_mode))) {
+                continue;
+            }
+            ListFiles(path, relative.empty() ? name : relative + "\\" + name, false, files);
+        }
+        closedir(d);
+#endif
+    }
+
+    // The files `args` pick out of `root`, sorted by normalised name.
+    // Returns false if two of them normalise to the same name.
+    bool CollectFiles(const std::string& root, int argc, char** argv, std::vector<LooseFile>* files) {
+        if (argc == 0) {
+            ListFiles(root, "", true, files);
+        }
+        for (int i = 0; i < argc; ++i) {
+            std::string relative = argv[i];
+            std::replace(relative.begin(), relative.end(), '\\', kSeparator);
+            ListFiles(root + kSeparator + relative, relative, false, files);
+        }
+        std::sort(files->begin(), files->end(),
+                  [](const LooseFile& a, const LooseFile& b) { return a.name < b.name; });
+        for (size_t i = 1; i < files->size(); ++i) {
+            if ((*files)[i].name == (*files)[i - 1].name) {
+                std::fprintf(stderr, "digi_pack: %s and %s are the same asset\n", (*files)[i - 1].path.c_str(),
+                             (*files)[i].path.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // MappedFile refuses empty files; they are packed as empty entries.
+    bool IsEmptyFile(const std::string& path) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        bool empty = f && std::fgetc(f) == EOF;
+        if (f) {
+            std::fclose(f);
+        }
+        return empty;
+    }
+
+    // One entry while the archive is laid out.
+    struct Packed {
+        AssetEntry              entry;
+        std::vector<uint32_t>   blockSizes;     // compressed entries
+        std::vector<uint8_t>    blocks;         // their stored bytes, back to back
+    };
+
+    uint32_t Align(uint64_t offset) {
+        return static_cast<uint32_t>((offset + kAssetDataAlignment - 1) & ~uint64_t(kAssetDataAlignment - 1));
+    }
+
+    // Compress `data` in blocks into `p`.  Returns false, leaving the
+    // entry stored, unless that saves enough.
+    bool CompressEntry(const uint8_t* data, uint32_t size, uint32_t blockSize, Packed* p) {
+        std::vector<uint8_t> scratch(Lz4CompressBound(blockSize));
+        for (uint32_t at = 0; at < size; at += blockSize) {
+            uint32_t length = std::min(blockSize, size - at);
+            size_t n = Lz4Compress(data + at, length, scratch.data());
+            if (n >= length) {
+                // Kept raw; a stored size equal to the length says so.
+                p->blocks.insert(p->blocks.end(), data + at, data + at + length);
+                p->blockSizes.push_back(length);
+            } else {
+                p->blocks.insert(p->blocks.end(), scratch.begin(), scratch.begin() + n);
+                p->blockSizes.push_back(static_cast<uint32_t>(n));
+            }
+        }
+        if (p->blocks.size() > size - (size >> kMinSavingShift)) {
+            p->blocks.clear();
+            p->blockSizes.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool WritePadding(std::FILE* f, uint64_t* at, uint64_t to) {
+        static const uint8_t kZeros[kAssetDataAlignment] = {};
+        size_t n = static_cast<size_t>(to - *at);
+        *at = to;
+        return std::fwrite(kZeros, 1, n, f) == n;
+    }
+
+    int Build(int argc, char** argv) {
+        bool lz4 = false;
+        uint32_t blockSize = kDefaultBlockSize;
+        int arg = 0;
+        for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+            if (std::strcmp(argv[arg], "--lz4") == 0) {
+                lz4 = true;
+            } else if (std::strcmp(argv[arg], "--block-size") == 0 && arg + 1 < argc) {
+                blockSize = static_cast<uint32_t>(std::atoi(argv[++arg])) * 1024;
+            } else {
+                return Usage();
+            }
+        }
+        if (argc - arg < 2 || blockSize == 0) {
+            return Usage();
+        }
+        std::string root = argv[arg];
+        const char* outPath = argv[arg + 1];
+        std::vector<LooseFile> files;
+        if (!CollectFiles(root, argc - arg - 2, argv + arg + 2, &files)) {
+            return 1;
+        }
+        if (files.empty()) {
+            std::fprintf(stderr, "digi_pack: no files under %s\n", root.c_str());
+            return 1;
+        }
+
+        // Lay out the tables, compressing as we go.
+        Clock::time_point t0 = Clock::now();
+        std::vector<Packed> packed(files.size());
+        std::string names;
+        uint32_t blockCount = 0;
+        uint64_t rawBytes = 0;
+        uint32_t compressed = 0;
+        for (size_t i = 0; i < files.size(); ++i) {
+            MappedFile file;
+            if (!file.Open(files[i].path.c_str()) && !IsEmptyFile(files[i].path)) {
+                std::fprintf(stderr, "digi_pack: cannot read %s\n", files[i].path.c_str());
+                return 1;
+            }
+            if (file.size() > 0xFFFFFFFFu) {
+                std::fprintf(stderr, "digi_pack: %s is too large\n", files[i].path.c_str());
+                return 1;
+            }
+            Packed& p = packed[i];
+            p.entry = {};
+            p.entry.nameOffset = static_cast<uint32_t>(names.size());
+            p.entry.nameLength = static_cast<uint32_t>(files[i].name.size());
+            p.entry.size       = static_cast<uint32_t>(file.size());
+            p.entry.firstBlock = kAssetNoBlock;
+            names += files[i].name;
+            rawBytes += file.size();
+            if (lz4 && file.size() > 0 && CompressEntry(file.data(), p.entry.size, blockSize, &p)) {
+                p.entry.flags      = kAssetCompressed;
+                p.entry.firstBlock = blockCount;
+                blockCount += static_cast<uint32_t>(p.blockSizes.size());
+                ++compressed;
+            }
+        }
+        Clock::time_point t1 = Clock::now();
+
+        AssetArchiveHeader header = {};
+        std::memcpy(header.magic, kAssetArchiveMagic, sizeof(header.magic));
+        header.version     = kAssetArchiveVersion;
+        header.entryCount  = static_cast<uint32_t>(files.size());
+        header.blockCount  = blockCount;
+        header.blockSize   = blockSize;
+        header.namesOffset = static_cast<uint32_t>(sizeof(AssetArchiveHeader) + files.size() * sizeof(AssetEntry) +
+                                                   uint64_t(blockCount) * sizeof(AssetBlock));
+        header.namesSize   = static_cast<uint32_t>(names.size());
+
+        std::vector<AssetBlock> blocks;
+        uint64_t at = Align(uint64_t(header.namesOffset) + header.namesSize);
+        for (Packed& p : packed) {
+            at = Align(at);
+            if (p.entry.flags & kAssetCompressed) {
+                for (uint32_t size : p.blockSizes) {
+                    blocks.push_back({ static_cast<uint32_t>(at), size });
+                    at += size;
+                }
+            } else {
+                p.entry.dataOffset = static_cast<uint32_t>(at);
+                at += p.entry.size;
+            }
+            if (at > 0xFFFFFFFFu) {
+                std::fprintf(stderr, "digi_pack: the archive would pass 4 GB\n");
+                return 1;
+            }
+        }
+
+        std::FILE* f = std::fopen(outPath, "wb");
+        if (!f) {
+            std::fprintf(stderr, "digi_pack: cannot write %s\n", outPath);
+            return 1;
+        }
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+        for (const Packed& p : packed) {
+            ok = ok && std::fwrite(&p.entry, sizeof(p.entry), 1, f) == 1;
+        }
+        ok = ok && (blocks.empty() || std::fwrite(blocks.data(), sizeof(AssetBlock), blocks.size(), f) == blocks.size());
+        ok = ok && std::fwrite(names.data(), 1, names.size(), f) == names.size();
+        uint64_t written = uint64_t(header.namesOffset) + header.namesSize;
+        for (size_t i = 0; ok && i < packed.size(); ++i) {
+            const Packed& p = packed[i];
+            ok = WritePadding(f, &written, Align(written));
+            if (p.entry.flags & kAssetCompressed) {
+                ok = ok && std::fwrite(p.blocks.data(), 1, p.blocks.size(), f) == p.blocks.size();
+                written += p.blocks.size();
+            } else if (p.entry.size > 0) {
+                MappedFile file;
+                ok = ok && file.Open(files[i].path.c_str()) && file.size() == p.entry.size &&
+                     std::fwrite(file.data(), 1, file.size(), f) == file.size();
+                written += p.entry.size;
+            }
+        }
+        if (std::fclose(f) != 0 || !ok) {
+            std::fprintf(stderr, "digi_pack: cannot write %s\n", outPath);
+            return 1;
+        }
+        std::printf("%zu files, %llu bytes packed into %llu (%u compressed, %u blocks), %.3f s\n", files.size(),
+                    static_cast<unsigned long long>(rawBytes), static_cast<unsigned long long>(written), compressed,
+                    blockCount, Seconds(t0, t1));
+        return 0;
+    }
+
+    bool OpenArchive(const char* path, MappedFile* file, AssetArchive* archive) {
+        if (!file->Open(path) || !archive->Open(file->data(), file->size())) {
+            std::fprintf(stderr, "digi_pack: %s is not an asset archive\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    int List(int argc, char** argv) {
+        if (argc != 1) {
+            return Usage();
+        }
+        MappedFile file;
+        AssetArchive archive;
+        if (!OpenArchive(argv[0], &file, &archive)) {
+            return 1;
+        }
+        for (uint32_t i = 0; i < archive.EntryCount(); ++i) {
+            const AssetEntry& e = archive.Entry(i);
+            std::printf("%10u  %s  %.*s\n", e.size, (e.flags & kAssetCompressed) ? "lz4   " : "stored",
+                        static_cast<int>(e.nameLength), archive.Name(e));
+        }
+        return 0;
+    }
+
+    int Verify(int argc, char** argv) {
+        if (argc < 2) {
+            return Usage();
+        }
+        MappedFile file;
+        AssetArchive archive;
+        if (!OpenArchive(argv[0], &file, &archive)) {
+            return 1;
+        }
+        std::vector<LooseFile> files;
+        if (!CollectFiles(argv[1], argc - 2, argv + 2, &files)) {
+            return 1;
+        }
+
+        // Read each asset back through the archive in chunks of uneven
+        // sizes, as the CRT's buffered reads and the game's fread calls
+        // would, then the loose file the same way.
+        const size_t kChunks[] = { 4096, 1000, 65536, 17, 200000 };
+        std::vector<uint8_t> fromArchive, fromDisk;
+        size_t missing = 0;
+        size_t mismatches = 0;
+        uint64_t bytes = 0;
+        double archiveSeconds = 0.0;
+        double diskSeconds = 0.0;
+        for (const LooseFile& loose : files) {
+            const AssetEntry* entry = archive.Find(loose.name.data(), loose.name.size());
+            if (!entry) {
+                std::fprintf(stderr, "missing: %s\n", loose.name.c_str());
+                ++missing;
+                continue;
+            }
+            fromArchive.assign(entry->size, 0);
+            AssetReadCache cache;
+            Clock::time_point t0 = Clock::now();
+            size_t done = 0;
+            for (size_t k = 0; done < entry->size; ++k) {
+                size_t n = archive.Read(*entry, done, fromArchive.data() + done,
+                                        std::min(kChunks[k % 5], fromArchive.size() - done), &cache);
+                if (n == 0) {
+                    break;
+                }
+                done += n;
+            }
+            Clock::time_point t1 = Clock::now();
+            fromDisk.assign(entry->size, 0);
+            std::FILE* f = std::fopen(loose.path.c_str(), "rb");
+            size_t read = 0;
+            if (f) {
+                for (size_t k = 0; read < fromDisk.size(); ++k) {
+                    size_t n = std::fread(fromDisk.data() + read, 1, std::min(kChunks[k % 5], fromDisk.size() - read), f);
+                    if (n == 0) {
+                        break;
+                    }
+                    read += n;
+                }
+                std::fclose(f);
+            }
+            Clock::time_point t2 = Clock::now();
+            archiveSeconds += Seconds(t0, t1);
+            diskSeconds += Seconds(t1, t2);
+            bytes += entry->size;
+            if (done != entry->size || read != entry->size || fromArchive != fromDisk) {
+                std::fprintf(stderr, "mismatch: %s\n", loose.name.c_str());
+                ++mismatches;
+            }
+        }
+        std::printf("%zu files, %zu missing, %zu mismatches\n", files.size(), missing, mismatches);
+        std::printf("archive %.3f s (%.1f MB/s), loose files %.3f s (%.1f MB/s)\n", archiveSeconds,
+                    bytes / 1e6 / (archiveSeconds > 0 ? archiveSeconds : 1), diskSeconds,
+                    bytes / 1e6 / (diskSeconds > 0 ? diskSeconds : 1));
+        return missing == 0 && mismatches == 0 ? 0 : 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return Usage();
+    }
+    if (std::strcmp(argv[1], "build") == 0) {
+        return Build(argc - 2, argv + 2);
+    }
+    if (std::strcmp(argv[1], "list") == 0) {
+        return List(argc - 2, argv + 2);
+    }
+    if (std::strcmp(argv[1], "verify") == 0) {
+        return Verify(argc - 2, argv + 2);
+    }
+    return Usage();
+}
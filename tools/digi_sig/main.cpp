@@ -0,0 +1,158 @@
+// Copyright (c) 2025
+//
+// digi_sig: build signature libraries from the MSVC runtime and MFC
+// libraries and label the functions of an analysis database that match
+// them (see tools/common/signatures.h).
+//
+//     digi_sig build <out.sig> <file.lib | file.obj> ...
+//     digi_sig match [--threads N] <digi.exe> <db.adb> <lib.sig> ...
+//     digi_sig labels <db.adb>
+//
+// `build` reads every function of the given objects and libraries into
+// one signature library; feed it the LIBC.LIB and NAFXCW.LIB of the
+// Visual C++ the game was built with.  `match` looks each function of
+// the database up in the libraries, earlier ones first, and stores the
+// labels in the database, replacing any from an earlier run.  `labels`
+// lists them.
+//
+//     g++ -O2 -pthread tools/digi_sig/*.cpp tools/common/*.cpp -o digi_sig
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../common/signatures.h"
+
+namespace {
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_sig build <out.sig> <file.lib | file.obj> ...\n"
+                     "       digi_sig match [--threads N] <digi.exe> <db.adb> <lib.sig> ...\n"
+                     "       digi_sig labels <db.adb>\n");
+        return 1;
+    }
+
+    int Build(int argc, char** argv) {
+        if (argc < 2) {
+            return Usage();
+        }
+        std::vector<SigFunction> functions;
+        for (int i = 1; i < argc; ++i) {
+            MappedFile file;
+            std::string error;
+            if (!file.Open(argv[i])) {
+                std::fprintf(stderr, "digi_sig: cannot open %s\n", argv[i]);
+                return 1;
+            }
+            if (!ReadObjectFunctions(file.data(), file.size(), &functions, &error)) {
+                std::fprintf(stderr, "digi_sig: %s: %s\n", argv[i], error.c_str());
+                return 1;
+            }
+        }
+        SigBuildStats stats;
+        if (!WriteSignatureLibrary(argv[0], functions, &stats)) {
+            std::fprintf(stderr, "digi_sig: cannot write %s\n", argv[0]);
+            return 1;
+        }
+        std::printf("%u functions, %u signatures, %u duplicates, %u too short\n", stats.functions,
+                    stats.signatures, stats.duplicates, stats.tooShort);
+        return 0;
+    }
+
+    int Match(int argc, char** argv) {
+        unsigned threads = 0;
+        int arg = 0;
+        if (arg + 1 < argc && std::strcmp(argv[arg], "--threads") == 0) {
+            threads = static_cast<unsigned>(std::atoi(argv[arg + 1]));
+            arg += 2;
+        }
+        if (argc - arg < 3) {
+            return Usage();
+        }
+        const char* exePath = argv[arg];
+        const char* dbPath = argv[arg + 1];
+
+        MappedFile file;
+        PeImage image;
+        if (!file.Open(exePath) || !image.Load(file.data(), file.size())) {
+            std::fprintf(stderr, "digi_sig: %s is not a 32-bit PE image\n", exePath);
+            return 1;
+        }
+        std::vector<std::unique_ptr<SignatureLibrary>> libraries;
+        std::vector<const SignatureLibrary*> order;
+        for (int i = arg + 2; i < argc; ++i) {
+            libraries.emplace_back(new SignatureLibrary);
+            if (!libraries.back()->Open(argv[i])) {
+                std::fprintf(stderr, "digi_sig: %s is not a signature library\n", argv[i]);
+                return 1;
+            }
+            order.push_back(libraries.back().get());
+        }
+
+        std::vector<AnalysisDb::Chunk> chunks;
+        SigMatchStats stats;
+        {
+            // Closed again before UpdateAnalysisDb rewrites the file.
+            AnalysisDbView db;
+            if (!db.Open(dbPath)) {
+                std::fprintf(stderr, "digi_sig: %s is not an analysis database\n", dbPath);
+                return 1;
+            }
+            if (db.info().imageChecksum != ImageChecksum(file.data(), file.size())) {
+                std::fprintf(stderr, "digi_sig: %s was built from a different image\n", dbPath);
+                return 1;
+            }
+            chunks = MatchSignatures(image, db, order, threads, &stats);
+        }
+        if (!UpdateAnalysisDb(dbPath, chunks)) {
+            std::fprintf(stderr, "digi_sig: cannot update %s\n", dbPath);
+            return 1;
+        }
+        std::printf("%u of %u functions labelled (%u bytes), %u ambiguous\n", stats.matched, stats.functions,
+                    stats.bytes, stats.ambiguous);
+        std::printf("match %.3f s, %u threads\n", stats.seconds, stats.threads);
+        return 0;
+    }
+
+    int Labels(int argc, char** argv) {
+        if (argc != 1) {
+            return Usage();
+        }
+        AnalysisDbView db;
+        LabelIndex labels;
+        if (!db.Open(argv[0])) {
+            std::fprintf(stderr, "digi_sig: %s is not an analysis database\n", argv[0]);
+            return 1;
+        }
+        if (!labels.Open(db)) {
+            std::fprintf(stderr, "digi_sig: %s has no labels; run digi_sig match first\n", argv[0]);
+            return 1;
+        }
+        for (const DbLabel& l : labels) {
+            std::printf("0x%08X  %5u  %s\n", l.address, l.length, labels.Name(l));
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return Usage();
+    }
+    if (std::strcmp(argv[1], "build") == 0) {
+        return Build(argc - 2, argv + 2);
+    }
+    if (std::strcmp(argv[1], "match") == 0) {
+        return Match(argc - 2, argv + 2);
+    }
+    if (std::strcmp(argv[1], "labels") == 0) {
+        return Labels(argc - 2, argv + 2);
+    }
+    return Usage();
+}
@@ -0,0 +1,477 @@
+// Copyright (c) 2025
+//
+// digi_strings: find the strings digi.exe's code refers to (see
+// tools/common/string_scan.h) and regenerate digi_analysis/strings.cpp
+// and strings.h from them.
+//
+//     digi_strings scan <digi.exe>
+//     digi_strings list <digi.exe> <db.adb>
+//     digi_strings generate <digi.exe> <db.adb> <dir>
+//
+// `scan` runs the scanner over the data sections and reports what it
+// found and how long it took.  `list` prints the referenced strings,
+// Hangul included, as UTF-8.  `generate` writes them to `dir`/strings.cpp
+// and `dir`/strings.h as the interned blob and perfect hash tables
+// digi_analysis/string_table.cpp looks them up in.  The database must
+// carry the xref index, so run digi_disasm and then `digi_xref build` on
+// it first.
+//
+//     g++ -O2 tools/digi_strings/*.cpp tools/common/*.cpp digi_analysis/cp949_table.cpp -o digi_strings
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../common/string_scan.h"
+#include "../common/xref_index.h"
+#include "../../digi_analysis/cp949.h"
+#include "../../digi_analysis/string_table.h"
+
+namespace {
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_strings scan <digi.exe>\n"
+                     "       digi_strings list <digi.exe> <db.adb>\n"
+                     "       digi_strings generate <digi.exe> <db.adb> <dir>\n");
+        return 1;
+    }
+
+    bool LoadImage(const char* path, MappedFile* file, PeImage* image) {
+        if (!file->Open(path) || !image->Load(file->data(), file->size())) {
+            std::fprintf(stderr, "digi_strings: %s is not a 32-bit PE image\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    double Milliseconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // `s` decoded to UTF-16.  The scanner only passes KS X 1001 pairs,
+    // all of which the CP949 table defines.
+    std::vector<uint16_t> Decode(const PeImage& image, const ScannedString& s) {
+        const uint8_t* p = image.At(s.va);
+        std::vector<uint16_t> out;
+        if (s.encoding == kDbStringUtf16) {
+            for (uint32_t i = 0; i < s.length; i += 2) {
+                out.push_back(static_cast<uint16_t>(p[i] | (p[i + 1] << 8)));
+            }
+            return out;
+        }
+        for (uint32_t i = 0; i < s.length; ++i) {
+            if (p[i] < 0x80) {
+                out.push_back(p[i]);
+                continue;
+            }
+            uint16_t c = g_cp949Table[(p[i] - kCp949LeadFirst) * kCp949TrailCount + (p[i + 1] - kCp949TrailFirst)];
+            out.push_back(c ? c : '?');
+            ++i;
+        }
+        return out;
+    }
+
+    std::string Utf8(const std::vector<uint16_t>& text) {
+        std::string out;
+        for (uint16_t c : text) {
+            if (c < 0x80) {
+                out += static_cast<char>(c);
+            } else if (c < 0x800) {
+                out += static_cast<char>(0xC0 | (c >> 6));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            } else {
+                out += static_cast<char>(0xE0 | (c >> 12));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        return out;
+    }
+
+    // A wide string literal that compiles to `text` whatever the source
+    // encoding the compiler assumes: everything outside printable ASCII
+    // is escaped, Hangul as universal character names.
+    std::string WideLiteral(const std::vector<uint16_t>& text) {
+        std::string out = "L\"";
+        for (uint16_t c : text) {
+            char buf[8];
+            switch (c) {
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '?':  out += "\\?"; break;     // no trigraphs
+            default:
+                if (c < 0x80) {
+                    out += static_cast<char>(c);
+                } else {
+                    std::snprintf(buf, sizeof(buf), "\\u%04X", c);
+                    out += buf;
+                }
+                break;
+            }
+        }
+        return out + "\"";
+    }
+
+    const char* EncodingName(const PeImage& image, const ScannedString& s) {
+        if (s.encoding == kDbStringUtf16) {
+            return "utf16";
+        }
+        const uint8_t* p = image.At(s.va);
+        return std::any_of(p, p + s.length, [](uint8_t c) { return c >= 0x80; }) ? "cp949" : "ascii";
+    }
+
+    const char kHeader[] =
+        "// Copyright (c) 2025\n"
+        "//\n"
+        "// The strings digi.exe's code refers to, decoded to UTF-16.  Generated\n"
+        "// by tools/digi_strings from the data sections and the xref index of\n"
+        "// an analysis database; do not edit, regenerate with\n"
+        "//\n"
+        "//     digi_strings generate <digi.exe> <db.adb> digi_analysis\n"
+        "//\n"
+        "// The game's ANSI strings are CP949 and a few are UTF-16; both come\n"
+        "// out as UTF-16 here.  Use the functions in string_table.h rather\n"
+        "// than these tables.\n"
+        "\n"
+        "#pragma once\n"
+        "\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "\n";
+
+    const char kDeclarations[] =
+        "// Each distinct text once, as its length, the text and a zero.\n"
+        "extern const wchar_t g_string_blob[kStringBlobUnits];\n"
+        "\n"
+        "// Per string, in address order: where its text starts in the blob\n"
+        "// and its address in digi.exe.\n"
+        "extern const uint32_t g_string_offsets[kStringCount];\n"
+        "extern const uint32_t g_string_addresses[kStringCount];\n"
+        "\n"
+        "// Minimal perfect hash of the distinct texts: displacement per\n"
+        "// bucket, then the first string with that text per slot.\n"
+        "extern const int32_t  g_string_text_displacements[kStringTextCount];\n"
+        "extern const uint32_t g_string_text_slots[kStringTextCount];\n"
+        "\n"
+        "// Minimal perfect hash of the addresses, laid out the same way.\n"
+        "extern const int32_t  g_string_address_displacements[kStringCount];\n"
+        "extern const uint32_t g_string_address_slots[kStringCount];\n";
+
+    // The bucket search gives up after this many displacements.  A
+    // random hash finds one for every bucket in a few hundred at most.
+    const uint32_t kMaxDisplacement = 1u << 24;
+
+    const uint32_t kFreeSlot = 0xFFFFFFFFu;
+
+    // Hash-and-displace construction of a minimal perfect hash of `count`
+    // keys, which `hash` hashes by number.  Every key goes to the bucket
+    // its seed-0 hash picks.  The buckets are then placed largest first:
+    // a bucket of several keys gets the first displacement (seed) under
+    // which all of its keys land on free slots, and each single key takes
+    // the next free slot directly, recorded as a negative displacement.
+    // `slots` receives the key placed in each slot.
+    template <typename Hash>
+    bool BuildPerfectHash(size_t count, Hash hash, std::vector<int32_t>* displacements,
+                          std::vector<uint32_t>* slots) {
+        std::vector<std::vector<uint32_t>> buckets(count);
+        for (uint32_t key = 0; key < count; ++key) {
+            buckets[hash(key, 0) % count].push_back(key);
+        }
+        std::vector<uint32_t> order(count);
+        for (uint32_t b = 0; b < count; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        displacements->assign(count, 0);
+        slots->assign(count, kFreeSlot);
+        std::vector<size_t> taken;
+        for (uint32_t b : order) {
+            const std::vector<uint32_t>& bucket = buckets[b];
+            if (bucket.size() < 2) {
+                break;
+            }
+            for (uint32_t d = 1;; ++d) {
+                if (d == kMaxDisplacement) {
+                    return false;
+                }
+                taken.clear();
+                for (uint32_t key : bucket) {
+                    size_t slot = hash(key, d) % count;
+                    if ((*slots)[slot] != kFreeSlot || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                        break;
+                    }
+                    taken.push_back(slot);
+                }
+                if (taken.size() == bucket.size()) {
+                    for (size_t i = 0; i < taken.size(); ++i) {
+                        (*slots)[taken[i]] = bucket[i];
+                    }
+                    (*displacements)[b] = static_cast<int32_t>(d);
+                    break;
+                }
+            }
+        }
+        size_t next = 0;
+        for (uint32_t b : order) {
+            if (buckets[b].size() != 1) {
+                continue;
+            }
+            while ((*slots)[next] != kFreeSlot) {
+                ++next;
+            }
+            (*slots)[next] = buckets[b][0];
+            (*displacements)[b] = -static_cast<int32_t>(next) - 1;
+        }
+        return true;
+    }
+
+    // The string tables, as strings.cpp lays them out.
+    struct StringTables {
+        std::vector<uint16_t> blob;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> addresses;
+        std::vector<uint32_t> texts;            // string index of each distinct text
+        std::vector<int32_t>  textDisplacements;
+        std::vector<uint32_t> textSlots;
+        std::vector<int32_t>  addressDisplacements;
+        std::vector<uint32_t> addressSlots;
+    };
+
+    bool BuildTables(const PeImage& image, const std::vector<ScannedString>& strings, StringTables* t) {
+        std::map<std::vector<uint16_t>, uint32_t> interned;
+        for (const ScannedString& s : strings) {
+            std::vector<uint16_t> text = Decode(image, s);
+            if (text.size() > 0xFFFF) {
+                std::fprintf(stderr, "digi_strings: the string at 0x%08X is too long\n", s.va);
+                return false;
+            }
+            auto found = interned.find(text);
+            if (found == interned.end()) {
+                uint32_t offset = static_cast<uint32_t>(t->blob.size() + 1);
+                t->blob.push_back(static_cast<uint16_t>(text.size()));
+                t->blob.insert(t->blob.end(), text.begin(), text.end());
+                t->blob.push_back(0);
+                t->texts.push_back(static_cast<uint32_t>(t->offsets.size()));
+                found = interned.emplace(std::move(text), offset).first;
+            }
+            t->offsets.push_back(found->second);
+            t->addresses.push_back(s.va);
+        }
+
+        auto textHash = [&](uint32_t key, uint32_t seed) {
+            uint32_t offset = t->offsets[t->texts[key]];
+            return StringTextHash(&t->blob[offset], t->blob[offset - 1], seed);
+        };
+        auto addressHash = [&](uint32_t key, uint32_t seed) { return StringAddressHash(t->addresses[key], seed); };
+        if (!BuildPerfectHash(t->texts.size(), textHash, &t->textDisplacements, &t->textSlots) ||
+            !BuildPerfectHash(t->addresses.size(), addressHash, &t->addressDisplacements, &t->addressSlots)) {
+            std::fprintf(stderr, "digi_strings: no perfect hash found\n");
+            return false;
+        }
+        for (uint32_t& slot : t->textSlots) {
+            slot = t->texts[slot];
+        }
+
+        // Look every string up the way string_table.cpp will.
+        for (uint32_t i = 0; i < t->offsets.size(); ++i) {
+            const uint16_t* text = &t->blob[t->offsets[i]];
+            uint16_t length = t->blob[t->offsets[i] - 1];
+            size_t textSlot = PerfectHashSlot(t->textDisplacements.data(), t->textDisplacements.size(),
+                                              StringTextHash(text, length, 0),
+                                              [&](uint32_t d) { return StringTextHash(text, length, d); });
+            uint32_t va = t->addresses[i];
+            size_t addressSlot = PerfectHashSlot(t->addressDisplacements.data(), t->addressDisplacements.size(),
+                                                 StringAddressHash(va, 0),
+                                                 [&](uint32_t d) { return StringAddressHash(va, d); });
+            if (t->offsets[t->textSlots[textSlot]] != t->offsets[i] || t->addressSlots[addressSlot] != i) {
+                std::fprintf(stderr, "digi_strings: the perfect hash misses 0x%08X\n", va);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // `values` as the body of an array initialiser, eight to a line.
+    template <typename T>
+    std::string ArrayBody(const std::vector<T>& values, const char* format) {
+        std::string out;
+        char buf[32];
+        for (size_t i = 0; i < values.size(); ++i) {
+            out += i % 8 ? " " : "\n    ";
+            std::snprintf(buf, sizeof(buf), format, values[i]);
+            out += buf;
+            out += ",";
+        }
+        return out + "\n";
+    }
+
+    bool WriteSources(const PeImage& image, const std::vector<ScannedString>& strings, const std::string& dir) {
+        if (strings.empty()) {
+            std::fprintf(stderr, "digi_strings: no strings to write\n");
+            return false;
+        }
+        StringTables t;
+        if (!BuildTables(image, strings, &t)) {
+            return false;
+        }
+        char buf[96];
+        std::string header = kHeader;
+        header += "// Strings, distinct texts, and UTF-16 units in the blob.\n";
+        std::snprintf(buf, sizeof(buf), "const std::size_t kStringCount      = %zu;\n", t.offsets.size());
+        header += buf;
+        std::snprintf(buf, sizeof(buf), "const std::size_t kStringTextCount  = %zu;\n", t.texts.size());
+        header += buf;
+        std::snprintf(buf, sizeof(buf), "const std::size_t kStringBlobUnits  = %zu;\n\n", t.blob.size());
+        header += buf;
+        header += kDeclarations;
+
+        // One distinct text per line, wrapped at twelve units, with its
+        // first address and the text as a literal in a comment.
+        std::string source =
+            "// Copyright (c) 2025\n"
+            "//\n"
+            "// Generated by tools/digi_strings; do not edit.  See strings.h.\n"
+            "\n"
+            "#include \"strings.h\"\n"
+            "\n"
+            "const wchar_t g_string_blob[kStringBlobUnits] = {\n";
+        for (uint32_t index : t.texts) {
+            uint32_t offset = t.offsets[index];
+            uint32_t end = offset + t.blob[offset - 1] + 1;
+            std::vector<uint16_t> text(&t.blob[offset], &t.blob[end - 1]);
+            std::snprintf(buf, sizeof(buf), "    // 0x%08X ", t.addresses[index]);
+            source += buf + WideLiteral(text) + "\n   ";
+            for (uint32_t i = offset - 1; i < end; ++i) {
+                uint32_t k = i - (offset - 1);
+                std::snprintf(buf, sizeof(buf), "%s0x%04X,", k && k % 12 == 0 ? "\n    " : " ", t.blob[i]);
+                source += buf;
+            }
+            source += "\n";
+        }
+        source += "};\n\nconst uint32_t g_string_offsets[kStringCount] = {" + ArrayBody(t.offsets, "%6u") +
+                  "};\n\nconst uint32_t g_string_addresses[kStringCount] = {" + ArrayBody(t.addresses, "0x%08X") +
+                  "};\n\nconst int32_t g_string_text_displacements[kStringTextCount] = {" +
+                  ArrayBody(t.textDisplacements, "%6d") +
+                  "};\n\nconst uint32_t g_string_text_slots[kStringTextCount] = {" + ArrayBody(t.textSlots, "%6u") +
+                  "};\n\nconst int32_t g_string_address_displacements[kStringCount] = {" +
+                  ArrayBody(t.addressDisplacements, "%6d") +
+                  "};\n\nconst uint32_t g_string_address_slots[kStringCount] = {" + ArrayBody(t.addressSlots, "%6u") +
+                  "};\n";
+
+        const struct {
+            const char*        name;
+            const std::string& text;
+        } files[] = {
+            { "strings.h", header },
+            { "strings.cpp", source },
+        };
+        for (const auto& file : files) {
+            std::string path = dir + "/" + file.name;
+            std::FILE* f = std::fopen(path.c_str(), "wb");
+            bool ok = f && std::fwrite(file.text.data(), 1, file.text.size(), f) == file.text.size();
+            if (!f || std::fclose(f) != 0 || !ok) {
+                std::fprintf(stderr, "digi_strings: cannot write %s\n", path.c_str());
+                return false;
+            }
+        }
+        std::fprintf(stderr, "%zu strings, %zu distinct, %zu blob units\n", t.offsets.size(), t.texts.size(),
+                     t.blob.size());
+        return true;
+    }
+
+    int Scan(const char* exePath) {
+        MappedFile file;
+        PeImage image;
+        if (!LoadImage(exePath, &file, &image)) {
+            return 1;
+        }
+        // Best of several runs, so the figure is the scan and not the
+        // page faults of the first touch.
+        const int kRuns = 10;
+        double best = 0.0;
+        std::vector<ScannedString> runs;
+        for (int i = 0; i < kRuns; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            runs = ScanStrings(image);
+            double ms = Milliseconds(start);
+            best = i ? std::min(best, ms) : ms;
+        }
+        size_t bytes = 0;
+        size_t units = 0;
+        size_t plausible = 0;
+        for (const ScannedString& s : runs) {
+            ++(s.encoding == kDbStringUtf16 ? units : bytes);
+            plausible += IsPlausibleString(image, s);
+        }
+        size_t scanned = 0;
+        for (const PeSection& section : image.sections()) {
+            scanned += section.IsCode() ? 0 : section.rawSize;
+        }
+        std::printf("%zu byte runs, %zu UTF-16 runs, %zu of them plausible on their own\n", bytes, units, plausible);
+        std::printf("%zu bytes scanned in %.3f ms\n", scanned, best);
+        return 0;
+    }
+
+    int Referenced(const char* exePath, const char* dbPath, const char* dir) {
+        MappedFile file;
+        PeImage image;
+        AnalysisDbView db;
+        XrefIndex index;
+        if (!LoadImage(exePath, &file, &image)) {
+            return 1;
+        }
+        if (!db.Open(dbPath)) {
+            std::fprintf(stderr, "digi_strings: %s is not an analysis database\n", dbPath);
+            return 1;
+        }
+        if (db.info().imageChecksum != ImageChecksum(file.data(), file.size())) {
+            std::fprintf(stderr, "digi_strings: %s was built from a different image\n", dbPath);
+            return 1;
+        }
+        if (!index.Open(db)) {
+            std::fprintf(stderr, "digi_strings: %s has no xref index; run digi_xref build first\n", dbPath);
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ScannedString> strings = ReferencedStrings(image, index, ScanStrings(image));
+        double ms = Milliseconds(start);
+
+        if (dir) {
+            if (!WriteSources(image, strings, dir)) {
+                return 1;
+            }
+        } else {
+            for (const ScannedString& s : strings) {
+                std::printf("%08X  %-5s %3u  %s\n", s.va, EncodingName(image, s), s.refs,
+                            Utf8(Decode(image, s)).c_str());
+            }
+        }
+        std::fprintf(stderr, "%zu referenced strings, %.3f ms\n", strings.size(), ms);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "scan") == 0) {
+        return Scan(argv[2]);
+    }
+    if (argc == 4 && std::strcmp(argv[1], "list") == 0) {
+        return Referenced(argv[2], argv[3], nullptr);
+    }
+    if (argc == 5 && std::strcmp(argv[1], "generate") == 0) {
+        return Referenced(argv[2], argv[3], argv[4]);
+    }
+    return Usage();
+}
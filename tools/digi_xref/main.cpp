@@ -0,0 +1,288 @@
+// Copyright (c) 2025
+//
+// digi_xref: build and query the cross-reference and call-graph index
+// of an analysis database (see tools/common/xref_index.h).
+//
+//     digi_xref build <digi.exe> <db.adb>
+//     digi_xref <digi.exe> <db.adb> callers <address | import>
+//     digi_xref <digi.exe> <db.adb> callees <address>
+//     digi_xref <digi.exe> <db.adb> refs-to <address> [end]
+//     digi_xref <digi.exe> <db.adb> refs-from <address> [end]
+//     digi_xref <digi.exe> <db.adb> strings [text]
+//     digi_xref <digi.exe> <db.adb> path <from> <to | import>
+//
+// `build` adds the index chunks to a database digi_disasm wrote; run it
+// again after re-running digi_disasm.  An address inside a function
+// stands for the function where a function is expected, and an import
+// is given by name (`callers GetTickCount`).  Each query reports how
+// long the lookup took, not counting the output.
+//
+//     g++ -O2 tools/digi_xref/*.cpp tools/common/*.cpp -o digi_xref
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../common/xref_index.h"
+
+namespace {
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: digi_xref build <digi.exe> <db.adb>\n"
+                     "       digi_xref <digi.exe> <db.adb> callers <address | import>\n"
+                     "       digi_xref <digi.exe> <db.adb> callees <address>\n"
+                     "       digi_xref <digi.exe> <db.adb> refs-to <address> [end]\n"
+                     "       digi_xref <digi.exe> <db.adb> refs-from <address> [end]\n"
+                     "       digi_xref <digi.exe> <db.adb> strings [text]\n"
+                     "       digi_xref <digi.exe> <db.adb> path <from> <to | import>\n");
+        return 1;
+    }
+
+    const char* const kKindNames[] = { "call", "jump", "branch", "case", "memory", "offset", "pointer", "import" };
+
+    const char* KindName(uint32_t kind) {
+        return kind < sizeof(kKindNames) / sizeof(kKindNames[0]) ? kKindNames[kind] : "?";
+    }
+
+    class Session {
+    public:
+        bool Open(const char* exePath, const char* dbPath) {
+            if (!m_file.Open(exePath) || !m_image.Load(m_file.data(), m_file.size())) {
+                std::fprintf(stderr, "digi_xref: %s is not a 32-bit PE image\n", exePath);
+                return false;
+            }
+            if (!m_db.Open(dbPath)) {
+                std::fprintf(stderr, "digi_xref: %s is not an analysis database\n", dbPath);
+                return false;
+            }
+            if (m_db.info().imageChecksum != ImageChecksum(m_file.data(), m_file.size())) {
+                std::fprintf(stderr, "digi_xref: %s was built from a different image\n", dbPath);
+                return false;
+            }
+            return true;
+        }
+
+        const PeImage& image() const { return m_image; }
+        const AnalysisDbView& db() const { return m_db; }
+
+        // A hex address or the name of an import, which stands for its
+        // IAT slot.
+        bool Resolve(const char* s, uint32_t* out) const {
+            char* end = nullptr;
+            unsigned long v = std::strtoul(s, &end, 16);
+            if (*s && !*end) {
+                *out = static_cast<uint32_t>(v);
+                return true;
+            }
+            for (const PeImport& import : m_image.imports()) {
+                if (import.name == s) {
+                    *out = import.iatVa;
+                    return true;
+                }
+            }
+            std::fprintf(stderr, "digi_xref: %s is neither an address nor an import\n", s);
+            return false;
+        }
+
+        // `va` widened to the start of the function holding it.
+        uint32_t FunctionStart(uint32_t va) const {
+            const DbFunction* f = m_db.FunctionAt(va);
+            return f ? f->start : va;
+        }
+
+        // "sub_00495F5B", "sub_00495F00+0x5b", "KERNEL32.dll!GetTickCount"
+        // or the bare address.
+        std::string Name(uint32_t va) const {
+            char buf[96];
+            if (const DbFunction* f = m_db.FunctionAt(va)) {
+                if (f->start == va) {
+                    std::snprintf(buf, sizeof(buf), "sub_%08X", va);
+                } else {
+                    std::snprintf(buf, sizeof(buf), "sub_%08X+0x%x", f->start, va - f->start);
+                }
+                return buf;
+            }
+            for (const PeImport& import : m_image.imports()) {
+                if (import.iatVa == va) {
+                    if (import.name.empty()) {
+                        std::snprintf(buf, sizeof(buf), "%s!#%u", import.dll.c_str(), import.ordinal);
+                        return buf;
+                    }
+                    return import.dll + "!" + import.name;
+                }
+            }
+            std::snprintf(buf, sizeof(buf), "0x%08X", va);
+            return buf;
+        }
+
+        // The string a DbStringRef points at, quoted and shortened.
+        std::string Text(const DbStringRef& s) const {
+            const size_t kMaxShown = 72;
+            const uint8_t* p = m_image.At(s.string);
+            std::string out = s.encoding == kDbStringUtf16 ? "L\"" : "\"";
+            uint32_t step = s.encoding == kDbStringUtf16 ? 2 : 1;
+            for (uint32_t i = 0; p && i < s.length && out.size() < kMaxShown; i += step) {
+                uint32_t c = step == 2 ? static_cast<uint32_t>(p[i] | (p[i + 1] << 8)) : p[i];
+                char buf[8];
+                if (c == '\n') {
+                    out += "\\n";
+                } else if (c == '\r') {
+                    out += "\\r";
+                } else if (c == '\t') {
+                    out += "\\t";
+                } else if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += static_cast<char>(c);
+                } else if (c >= 0x20 && c < 0x7F) {
+                    out += static_cast<char>(c);
+                } else {
+                    // CP949 bytes or Hangul; escaped so the output stays
+                    // readable on any console.
+                    std::snprintf(buf, sizeof(buf), c > 0xFF ? "\\u%04x" : "\\x%02x", c);
+                    out += buf;
+                }
+            }
+            out += out.size() >= kMaxShown ? "\"..." : "\"";
+            return out;
+        }
+
+    private:
+        MappedFile     m_file;
+        PeImage        m_image;
+        AnalysisDbView m_db;
+    };
+
+    class Timer {
+    public:
+        Timer() : m_start(std::chrono::steady_clock::now()) {}
+
+        void Report(size_t results) const {
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+            std::fprintf(stderr, "%zu results, %.1f us\n", results, us);
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    int Build(const char* exePath, const char* dbPath) {
+        std::vector<AnalysisDb::Chunk> chunks;
+        {
+            Session session;
+            if (!session.Open(exePath, dbPath)) {
+                return 1;
+            }
+            chunks = BuildXrefIndex(session.image(), session.db());
+        }
+        if (!UpdateAnalysisDb(dbPath, chunks)) {
+            std::fprintf(stderr, "digi_xref: cannot write %s\n", dbPath);
+            return 1;
+        }
+        std::printf("%zu xrefs, %zu call graph edges, %zu string references\n",
+                    chunks[0].data.size() / sizeof(DbXref), chunks[1].data.size() / sizeof(DbCall),
+                    chunks[3].data.size() / sizeof(DbStringRef));
+        return 0;
+    }
+
+    int Query(const Session& session, const XrefIndex& index, int argc, char** argv) {
+        const char* command = argv[0];
+        uint32_t a = 0;
+        uint32_t b = 0;
+        if (std::strcmp(command, "callers") == 0 && argc == 2) {
+            if (!session.Resolve(argv[1], &a)) {
+                return 1;
+            }
+            Timer timer;
+            DbRange<DbCall> calls = index.Callers(session.FunctionStart(a));
+            timer.Report(calls.size());
+            for (const DbCall& c : calls) {
+                std::printf("%08X  %-28s %s\n", c.site, session.Name(c.site).c_str(), KindName(c.kind));
+            }
+        } else if (std::strcmp(command, "callees") == 0 && argc == 2) {
+            if (!session.Resolve(argv[1], &a)) {
+                return 1;
+            }
+            Timer timer;
+            DbRange<DbCall> calls = index.Callees(session.FunctionStart(a));
+            timer.Report(calls.size());
+            for (const DbCall& c : calls) {
+                std::printf("%08X  %-28s %s\n", c.site, session.Name(c.callee).c_str(), KindName(c.kind));
+            }
+        } else if ((std::strcmp(command, "refs-to") == 0 || std::strcmp(command, "refs-from") == 0) &&
+                   (argc == 2 || argc == 3)) {
+            if (!session.Resolve(argv[1], &a) || (argc == 3 && !session.Resolve(argv[2], &b))) {
+                return 1;
+            }
+            b = argc == 3 ? b : a + 1;
+            bool to = command[5] == 't';
+            Timer timer;
+            DbRange<DbXref> refs = to ? index.RefsTo(a, b) : index.RefsFrom(a, b);
+            timer.Report(refs.size());
+            for (const DbXref& x : refs) {
+                std::printf("%08X  %-28s -> %08X  %s\n", x.from, session.Name(x.from).c_str(), x.to,
+                            KindName(x.kind));
+            }
+        } else if (std::strcmp(command, "strings") == 0 && argc <= 2) {
+            Timer timer;
+            DbRange<DbStringRef> strings = index.Strings();
+            timer.Report(strings.size());
+            for (const DbStringRef* s = strings.begin(); s != strings.end();) {
+                const DbStringRef* next = s;
+                while (next != strings.end() && next->string == s->string) {
+                    ++next;
+                }
+                std::string text = session.Text(*s);
+                if (argc == 1 || text.find(argv[1]) != std::string::npos) {
+                    std::printf("%08X  %s\n", s->string, text.c_str());
+                    for (; s != next; ++s) {
+                        std::printf("    %08X  %s\n", s->from, session.Name(s->from).c_str());
+                    }
+                }
+                s = next;
+            }
+        } else if (std::strcmp(command, "path") == 0 && argc == 3) {
+            if (!session.Resolve(argv[1], &a) || !session.Resolve(argv[2], &b)) {
+                return 1;
+            }
+            std::vector<DbCall> path;
+            Timer timer;
+            bool found = index.Path(session.FunctionStart(a), session.FunctionStart(b), &path);
+            timer.Report(path.size());
+            if (!found) {
+                std::printf("no call path from %s to %s\n", session.Name(a).c_str(), session.Name(b).c_str());
+                return 1;
+            }
+            std::printf("%s\n", session.Name(path.front().caller).c_str());
+            for (const DbCall& c : path) {
+                std::printf("  %08X %-6s %s\n", c.site, KindName(c.kind), session.Name(c.callee).c_str());
+            }
+        } else {
+            return Usage();
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 4 && std::strcmp(argv[1], "build") == 0) {
+        return Build(argv[2], argv[3]);
+    }
+    if (argc < 4) {
+        return Usage();
+    }
+    Session session;
+    if (!session.Open(argv[1], argv[2])) {
+        return 1;
+    }
+    XrefIndex index;
+    if (!index.Open(session.db())) {
+        std::fprintf(stderr, "digi_xref: %s has no index; run digi_xref build first\n", argv[2]);
+        return 1;
+    }
+    return Query(session, index, argc - 3, argv + 3);
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2025
+//
+// Check that digi_disasm's incremental mode (--previous) gives the
+// database a full run gives.  The image is disassembled once as it is,
+// then patched in memory and disassembled again twice, from scratch
+// and with the first database as the previous one, at one thread and
+// at one per hardware thread.  The written files must match byte for
+// byte; the first difference is reported and the exit code is
+// non-zero.
+//
+// Each patch is a file offset and the hex bytes to put there.  Without
+// any, the only call to sub_00401000 (file offset 0x1055) is nopped,
+// which leaves that function reachable only through the gap sweep:
+//
+//     g++ -O2 -pthread tools/disasm_reuse_check/*.cpp tools/digi_disasm/disassembler.cpp tools/common/*.cpp -o disasm_reuse_check
+//     disasm_reuse_check <digi.exe> [offset=bytes ...]
+//
+// The databases go to the current directory and are removed again
+// when they match.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../digi_disasm/disassembler.h"
+
+namespace {
+    const char* kDefaultPatch = "1055=9090909090";
+    const char* kPreviousPath = "disasm_reuse_check_previous.adb";
+    const char* kFullPath = "disasm_reuse_check_full.adb";
+    const char* kIncrementalPath = "disasm_reuse_check_incremental.adb";
+
+    int HexDigit(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    // Apply "offset=bytes" to `image`.  Returns false if it is malformed
+    // or runs past the end.
+    bool ApplyPatch(const char* patch, std::vector<uint8_t>* image) {
+        char* end = nullptr;
+        unsigned long offset = std::strtoul(patch, &end, 16);
+        if (end == patch || *end != '=') {
+            return false;
+        }
+        const char* hex = end + 1;
+        size_t length = std::strlen(hex);
+        if (!length || length % 2 || offset + length / 2 > image->size()) {
+            return false;
+        }
+        for (size_t i = 0; i < length; i += 2) {
+            int hi = HexDigit(hex[i]);
+            int lo = HexDigit(hex[i + 1]);
+            if (hi < 0 || lo < 0) {
+                return false;
+            }
+            (*image)[offset + i / 2] = static_cast<uint8_t>(hi << 4 | lo);
+        }
+        return true;
+    }
+
+    bool Run(const PeImage& image, unsigned threads, const AnalysisDbView* previous, const char* path,
+             DisassemblerStats* stats) {
+        DisassemblerOptions options;
+        options.threads = threads;
+        options.previous = previous;
+        AnalysisDb db;
+        if (!Disassemble(image, options, &db, stats)) {
+            std::fprintf(stderr, "disasm_reuse_check: the image has no code section\n");
+            return false;
+        }
+        if (!WriteAnalysisDb(path, db)) {
+            std::fprintf(stderr, "disasm_reuse_check: cannot write %s\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    // Whether the two files are identical; reports where they are not.
+    bool SameFile(const char* a, const char* b) {
+        MappedFile fa;
+        MappedFile fb;
+        if (!fa.Open(a) || !fb.Open(b)) {
+            std::fprintf(stderr, "disasm_reuse_check: cannot read back %s or %s\n", a, b);
+            return false;
+        }
+        size_t common = fa.size() < fb.size() ? fa.size() : fb.size();
+        for (size_t i = 0; i < common; ++i) {
+            if (fa.data()[i] != fb.data()[i]) {
+                std::printf("  differ at byte %zu\n", i);
+                return false;
+            }
+        }
+        if (fa.size() != fb.size()) {
+            std::printf("  differ in size: %zu and %zu bytes\n", fa.size(), fb.size());
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: disasm_reuse_check <digi.exe> [offset=bytes ...]\n");
+        return 1;
+    }
+    MappedFile file;
+    if (!file.Open(argv[1])) {
+        std::fprintf(stderr, "disasm_reuse_check: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<const char*> patches(argv + 2, argv + argc);
+    if (patches.empty()) {
+        patches.push_back(kDefaultPatch);
+    }
+    std::vector<uint8_t> patched(file.data(), file.data() + file.size());
+    for (const char* patch : patches) {
+        if (!ApplyPatch(patch, &patched)) {
+            std::fprintf(stderr, "disasm_reuse_check: bad patch %s\n", patch);
+            return 1;
+        }
+    }
+
+    PeImage original;
+    PeImage image;
+    if (!original.Load(file.data(), file.size()) || !image.Load(patched.data(), patched.size())) {
+        std::fprintf(stderr, "disasm_reuse_check: %s is not a 32-bit PE image\n", argv[1]);
+        return 1;
+    }
+    DisassemblerStats stats;
+    if (!Run(original, 0, nullptr, kPreviousPath, &stats)) {
+        return 1;
+    }
+    int failures = 0;
+    {
+        // Closed before the files are removed, which Windows would refuse.
+        AnalysisDbView previous;
+        if (!previous.Open(kPreviousPath)) {
+            std::fprintf(stderr, "disasm_reuse_check: cannot read back %s\n", kPreviousPath);
+            return 1;
+        }
+        unsigned counts[] = { 1, std::thread::hardware_concurrency() };
+        for (unsigned threads : counts) {
+            threads = threads ? threads : 1;
+            DisassemblerStats full;
+            DisassemblerStats incremental;
+            if (!Run(image, threads, nullptr, kFullPath, &full) ||
+                !Run(image, threads, &previous, kIncrementalPath, &incremental)) {
+                return 1;
+            }
+            bool same = SameFile(kFullPath, kIncrementalPath);
+            std::printf("%u threads: %u functions taken over, full %.3f s, incremental %.3f s: %s\n", threads,
+                        incremental.reused, full.traceSeconds + full.extentSeconds,
+                        incremental.traceSeconds + incremental.extentSeconds, same ? "identical" : "DIFFERENT");
+            failures += same ? 0 : 1;
+        }
+    }
+    if (failures) {
+        std::printf("databases kept for inspection: %s, %s\n", kFullPath, kIncrementalPath);
+        return 1;
+    }
+    std::remove(kPreviousPath);
+    std::remove(kFullPath);
+    std::remove(kIncrementalPath);
+    return 0;
+}
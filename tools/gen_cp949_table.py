@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025
+#
+# Generate digi_analysis/cp949_table.cpp, the double-byte half of the
+# CP949 (Unified Hangul Code) to UTF-16 table used by cp949.cpp.
+#
+# The table covers lead bytes 0x81-0xFE and trail bytes 0x41-0xFE;
+# pairs that CP949 does not define are stored as 0.  Usage:
+#
+#     python3 tools/gen_cp949_table.py > digi_analysis/cp949_table.cpp
+
+LEAD_FIRST, LEAD_LAST = 0x81, 0xFE
+TRAIL_FIRST, TRAIL_LAST = 0x41, 0xFE
+
+
+def main():
+    print("// Copyright (c) 2025")
+    print("//")
+    print("// CP949 double-byte to UTF-16 table.  Generated by")
+    print("// tools/gen_cp949_table.py; do not edit by hand.")
+    print()
+    print('#include "cp949.h"')
+    print()
+    print("const uint16_t g_cp949Table[kCp949LeadCount * kCp949TrailCount] = {")
+    for lead in range(LEAD_FIRST, LEAD_LAST + 1):
+        row = []
+        for trail in range(TRAIL_FIRST, TRAIL_LAST + 1):
+            try:
+                ch = bytes([lead, trail]).decode("cp949")
+                row.append(ord(ch) if len(ch) == 1 else 0)
+            except UnicodeDecodeError:
+                row.append(0)
+        print("    // lead 0x%02X" % lead)
+        for i in range(0, len(row), 12):
+            print("    " + " ".join("0x%04X," % v for v in row[i:i + 12]))
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
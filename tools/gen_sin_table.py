@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025
+#
+# Generate digi_analysis/digi_table.inc, the 4096-entry sine table the
+# routines at 0x401000 and 0x401020 index, from the game executable.
+#
+# The table lives in .data at virtual address 0x4B0200 (file offset
+# 0xB0200 in the Korean release).  The address is translated through
+# the section headers rather than assumed, and the result is checked
+# against 4096 * sin(2 * pi * i / 4096) so a different build of the
+# executable fails loudly instead of producing garbage.  Usage:
+#
+#     python3 tools/gen_sin_table.py "original exe/digi.exe" > digi_analysis/digi_table.inc
+
+import math
+import struct
+import sys
+
+TABLE_VA = 0x4B0200
+ENTRIES = 4096
+SCALE = 4096
+TOLERANCE = 2
+
+
+def va_to_offset(image, va):
+    pe = struct.unpack_from("<I", image, 0x3C)[0]
+    if image[pe:pe + 4] != b"PE\0\0":
+        sys.exit("not a PE image")
+    sections, = struct.unpack_from("<H", image, pe + 6)
+    opt_size, = struct.unpack_from("<H", image, pe + 20)
+    base, = struct.unpack_from("<I", image, pe + 24 + 28)
+    rva = va - base
+    table = pe + 24 + opt_size
+    for i in range(sections):
+        vsize, vaddr, rsize, roff = struct.unpack_from("<IIII", image, table + i * 40 + 8)
+        if vaddr <= rva < vaddr + max(vsize, rsize):
+            return roff + (rva - vaddr)
+    sys.exit("0x%08X is not in any section" % va)
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else "original exe/digi.exe"
+    with open(path, "rb") as f:
+        image = f.read()
+    offset = va_to_offset(image, TABLE_VA)
+    values = struct.unpack_from("<%dh" % ENTRIES, image, offset)
+    for i, v in enumerate(values):
+        expected = round(SCALE * math.sin(2 * math.pi * i / ENTRIES))
+        if abs(v - expected) > TOLERANCE:
+            sys.exit("entry %d is %d, expected about %d: not the sine table" % (i, v, expected))
+
+    print("// Copyright (c) 2025")
+    print("//")
+    print("// Sine table from digi.exe (0x%08X, file offset 0x%X): entry i is" % (TABLE_VA, offset))
+    print("// 4096 * sin(2 * pi * i / 4096) as the game rounded it.  Generated")
+    print("// by tools/gen_sin_table.py; do not edit by hand.  Included inside")
+    print("// an initialiser list by digi_table.h and digi_table.cpp.")
+    print()
+    for i in range(0, ENTRIES, 16):
+        print("    " + " ".join("%d," % v for v in values[i:i + 16]))
+
+
+if __name__ == "__main__":
+    main()
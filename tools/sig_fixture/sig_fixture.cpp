@@ -0,0 +1,365 @@
+// Copyright (c) 2025
+//
+// Test fixture for digi_sig, which needs reference libraries that are
+// not in the repository (and do not run on Linux).  `build` writes
+// copies of digi.exe's own functions as a COFF object, or as a .lib
+// archive of two objects, in the form the compiler would have left
+// them before linking:
+//
+//   * every call or jump that leaves the function carries a REL32
+//     relocation, and every 32-bit displacement or immediate that
+//     points into the image a DIR32 one, with the field zeroed;
+//   * each function has its own section, as under /Gy, with an
+//     external symbol `_ref_XXXXXXXX` naming its address;
+//   * a switch's jump table follows the code in the same section, its
+//     entries DIR32 relocations, as MSVC places them.
+//
+// Functions i with i % step equal to 0 or step / 2 are taken (the
+// first group into the archive's first object, the second into its
+// other).  `check` then sorts the labels `digi_sig match` wrote:
+//
+//   * at the address they name: correct;
+//   * on a function outside the fixture: a copy of a fixture function
+//     the game has elsewhere, which the matcher rightly labels too;
+//   * on a fixture function under another name: a false match, which
+//     makes the exit code non-zero.
+//
+// Fixture functions left unlabelled are mostly ones whose bodies
+// differ from others only in call targets: they match several names
+// and are left as ambiguous, which is the matcher working as intended.
+//
+//     g++ -O2 -pthread tools/sig_fixture/*.cpp tools/common/*.cpp -o sig_fixture
+//     digi_disasm digi.exe digi.adb
+//     sig_fixture build digi.exe digi.adb ref.lib [step]
+//     digi_sig build ref.sig ref.lib
+//     digi_sig match digi.exe digi.adb ref.sig
+//     sig_fixture check ref.lib digi.adb
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../common/analysis_db.h"
+#include "../common/mapped_file.h"
+#include "../common/pe_image.h"
+#include "../common/signatures.h"
+#include "../common/x86_decode.h"
+
+namespace {
+    const uint16_t kMachineI386 = 0x14C;
+    const uint16_t kRelDir32 = 0x0006;
+    const uint16_t kRelRel32 = 0x0014;
+    const uint32_t kCodeSection = 0x60000020;   // code, execute, read
+    const uint16_t kTypeFunction = 0x20;
+    const uint8_t  kClassExternal = 2;
+    const char* const kNamePrefix = "_ref_";
+
+    struct Reloc {
+        uint32_t offset;
+        uint16_t type;
+    };
+
+    struct Section {
+        std::string          name;
+        std::vector<uint8_t> data;
+        std::vector<Reloc>   relocs;
+    };
+
+    void Put16(std::vector<uint8_t>* out, uint32_t value) {
+        out->push_back(static_cast<uint8_t>(value));
+        out->push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void Put32(std::vector<uint8_t>* out, uint32_t value) {
+        Put16(out, value & 0xFFFF);
+        Put16(out, value >> 16);
+    }
+
+    void Set32(std::vector<uint8_t>* out, size_t at, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            (*out)[at + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    // Turn the field at `offset` back into a relocation.
+    void Unlink(Section* s, uint32_t offset, uint16_t type) {
+        s->relocs.push_back({ offset, type });
+        std::memset(&s->data[offset], 0, 4);
+    }
+
+    // The unlinked copy of `fn`, or false if its bytes are not in the
+    // image.
+    bool MakeSection(const PeImage& image, const AnalysisDbView& db, const DbFunction& fn, Section* s) {
+        size_t avail = 0;
+        const uint8_t* code = image.At(fn.start, &avail);
+        if (!code || avail < fn.end - fn.start) {
+            return false;
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "%s%08X", kNamePrefix, fn.start);
+        s->name = name;
+        s->data.assign(code, code + (fn.end - fn.start));
+
+        uint32_t length = static_cast<uint32_t>(s->data.size());
+        for (uint32_t offset = 0; offset < length;) {
+            X86Insn insn;
+            if (!DecodeX86(code + offset, length - offset, fn.start + offset, &insn)) {
+                ++offset;
+                continue;
+            }
+            bool relative = insn.flow == X86Flow::kJump || insn.flow == X86Flow::kCondJump || insn.flow == X86Flow::kCall;
+            if (relative && insn.immSize == 4) {
+                if (insn.target < fn.start || insn.target >= fn.end) {
+                    Unlink(s, offset + insn.immOffset, kRelRel32);
+                }
+            } else {
+                uint32_t value;
+                if (insn.dispSize == 4) {
+                    std::memcpy(&value, code + offset + insn.dispOffset, 4);
+                    if (value - image.imageBase() < image.sizeOfImage()) {
+                        Unlink(s, offset + insn.dispOffset, kRelDir32);
+                    }
+                }
+                if (insn.immSize == 4) {
+                    std::memcpy(&value, code + offset + insn.immOffset, 4);
+                    if (value - image.imageBase() < image.sizeOfImage()) {
+                        Unlink(s, offset + insn.immOffset, kRelDir32);
+                    }
+                }
+            }
+            offset += insn.length;
+        }
+
+        for (size_t i = 0; i < db.jumpTableCount(); ++i) {
+            const DbJumpTable& table = db.jumpTables()[i];
+            if (table.jump < fn.start || table.jump >= fn.end) {
+                continue;
+            }
+            while (s->data.size() % 4) {
+                s->data.push_back(0x90);
+            }
+            for (uint32_t k = 0; k < table.count; ++k) {
+                s->relocs.push_back({ static_cast<uint32_t>(s->data.size()), kRelDir32 });
+                Put32(&s->data, 0);
+            }
+        }
+        return true;
+    }
+
+    // A COFF object with one code section and one external function
+    // symbol per entry of `sections`.
+    std::vector<uint8_t> WriteObject(const std::vector<Section>& sections) {
+        std::vector<uint8_t> out;
+        uint32_t count = static_cast<uint32_t>(sections.size());
+        Put16(&out, kMachineI386);
+        Put16(&out, count);
+        Put32(&out, 0);                 // time stamp
+        size_t symbolTableAt = out.size();
+        Put32(&out, 0);                 // symbol table, patched below
+        Put32(&out, count);
+        Put16(&out, 0);                 // optional header size
+        Put16(&out, 0);                 // characteristics
+
+        size_t headers = out.size();
+        out.resize(headers + 40 * static_cast<size_t>(count));
+        for (uint32_t i = 0; i < count; ++i) {
+            const Section& s = sections[i];
+            uint32_t raw = static_cast<uint32_t>(out.size());
+            out.insert(out.end(), s.data.begin(), s.data.end());
+            uint32_t relocs = static_cast<uint32_t>(out.size());
+            for (const Reloc& r : s.relocs) {
+                Put32(&out, r.offset);
+                Put32(&out, 0);         // symbol index; the matcher ignores it
+                Put16(&out, r.type);
+            }
+            size_t h = headers + 40 * static_cast<size_t>(i);
+            std::memcpy(&out[h], ".text$x", 7);
+            Set32(&out, h + 16, static_cast<uint32_t>(s.data.size()));
+            Set32(&out, h + 20, raw);
+            Set32(&out, h + 24, relocs);
+            out[h + 32] = static_cast<uint8_t>(s.relocs.size());
+            out[h + 33] = static_cast<uint8_t>(s.relocs.size() >> 8);
+            Set32(&out, h + 36, kCodeSection);
+        }
+
+        Set32(&out, symbolTableAt, static_cast<uint32_t>(out.size()));
+        std::string strings;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint8_t symbol[18] = {};
+            uint32_t name = static_cast<uint32_t>(4 + strings.size());
+            strings += sections[i].name;
+            strings += '\0';
+            std::memcpy(symbol + 4, &name, 4);          // long name: zeroes, then the offset
+            symbol[12] = static_cast<uint8_t>(i + 1);   // section number
+            symbol[13] = static_cast<uint8_t>((i + 1) >> 8);
+            symbol[14] = kTypeFunction;
+            symbol[16] = kClassExternal;
+            out.insert(out.end(), symbol, symbol + sizeof(symbol));
+        }
+        Put32(&out, static_cast<uint32_t>(4 + strings.size()));
+        out.insert(out.end(), strings.begin(), strings.end());
+        return out;
+    }
+
+    // An ar archive of `members`, without the linker members a real
+    // .lib starts with; ReadObjectFunctions skips those anyway.
+    std::vector<uint8_t> WriteArchive(const std::vector<std::vector<uint8_t>>& members) {
+        const char kArchive[] = "!<arch>\n";
+        std::vector<uint8_t> out(kArchive, kArchive + 8);
+        for (size_t i = 0; i < members.size(); ++i) {
+            char header[61];
+            std::snprintf(header, sizeof(header), "%-16s%-12s%-6s%-6s%-8s%-10zu`\n",
+                          ("fixture" + std::to_string(i + 1) + ".obj/").c_str(), "0", "0", "0", "644",
+                          members[i].size());
+            out.insert(out.end(), header, header + 60);
+            out.insert(out.end(), members[i].begin(), members[i].end());
+            if (members[i].size() & 1) {
+                out.push_back('\n');
+            }
+        }
+        return out;
+    }
+
+    bool EndsWith(const std::string& s, const char* suffix) {
+        size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+
+    int Usage() {
+        std::fprintf(stderr,
+                     "usage: sig_fixture build <digi.exe> <db.adb> <out.obj | out.lib> [step]\n"
+                     "       sig_fixture check <ref.obj | ref.lib> <db.adb>\n");
+        return 1;
+    }
+
+    int Build(int argc, char** argv) {
+        if (argc < 3 || argc > 4) {
+            return Usage();
+        }
+        size_t step = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 7;
+        if (step < 2) {
+            std::fprintf(stderr, "sig_fixture: step must be at least 2\n");
+            return 1;
+        }
+        MappedFile file;
+        PeImage image;
+        if (!file.Open(argv[0]) || !image.Load(file.data(), file.size())) {
+            std::fprintf(stderr, "sig_fixture: %s is not a 32-bit PE image\n", argv[0]);
+            return 1;
+        }
+        AnalysisDbView db;
+        if (!db.Open(argv[1])) {
+            std::fprintf(stderr, "sig_fixture: %s is not an analysis database\n", argv[1]);
+            return 1;
+        }
+        if (db.info().imageChecksum != ImageChecksum(file.data(), file.size())) {
+            std::fprintf(stderr, "sig_fixture: %s was built from a different image\n", argv[1]);
+            return 1;
+        }
+
+        std::vector<Section> groups[2];
+        for (size_t i = 0; i < db.functionCount(); ++i) {
+            size_t group = i % step == 0 ? 0 : i % step == step / 2 ? 1 : 2;
+            Section s;
+            if (group < 2 && MakeSection(image, db, db.functions()[i], &s)) {
+                groups[group].push_back(std::move(s));
+            }
+        }
+
+        std::string path = argv[2];
+        std::vector<uint8_t> out;
+        if (EndsWith(path, ".lib")) {
+            out = WriteArchive({ WriteObject(groups[0]), WriteObject(groups[1]) });
+        } else {
+            groups[0].insert(groups[0].end(), groups[1].begin(), groups[1].end());
+            out = WriteObject(groups[0]);
+        }
+        FILE* f = std::fopen(path.c_str(), "wb");
+        bool ok = f && std::fwrite(out.data(), 1, out.size(), f) == out.size();
+        ok = f && std::fclose(f) == 0 && ok;
+        if (!ok) {
+            std::fprintf(stderr, "sig_fixture: cannot write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("%zu functions written to %s\n", groups[0].size() + groups[1].size(), path.c_str());
+        return 0;
+    }
+
+    // The address a fixture name stands for, or 0.
+    uint32_t NamedAddress(const char* name) {
+        size_t prefix = std::strlen(kNamePrefix);
+        if (std::strncmp(name, kNamePrefix, prefix) != 0) {
+            return 0;
+        }
+        return static_cast<uint32_t>(std::strtoul(name + prefix, nullptr, 16));
+    }
+
+    int Check(int argc, char** argv) {
+        if (argc != 2) {
+            return Usage();
+        }
+        MappedFile fixture;
+        std::vector<SigFunction> functions;
+        std::string error;
+        if (!fixture.Open(argv[0])) {
+            std::fprintf(stderr, "sig_fixture: cannot open %s\n", argv[0]);
+            return 1;
+        }
+        if (!ReadObjectFunctions(fixture.data(), fixture.size(), &functions, &error)) {
+            std::fprintf(stderr, "sig_fixture: %s: %s\n", argv[0], error.c_str());
+            return 1;
+        }
+        std::vector<uint32_t> members;
+        for (const SigFunction& f : functions) {
+            if (uint32_t address = NamedAddress(f.name.c_str())) {
+                members.push_back(address);
+            }
+        }
+        std::sort(members.begin(), members.end());
+
+        AnalysisDbView db;
+        LabelIndex labels;
+        if (!db.Open(argv[1])) {
+            std::fprintf(stderr, "sig_fixture: %s is not an analysis database\n", argv[1]);
+            return 1;
+        }
+        if (!labels.Open(db)) {
+            std::fprintf(stderr, "sig_fixture: %s has no labels; run digi_sig match first\n", argv[1]);
+            return 1;
+        }
+        size_t own = 0;
+        size_t copies = 0;
+        size_t wrong = 0;
+        for (const DbLabel& l : labels) {
+            const char* name = labels.Name(l);
+            if (NamedAddress(name) == l.address) {
+                ++own;
+            } else if (!std::binary_search(members.begin(), members.end(), l.address)) {
+                ++copies;
+            } else {
+                std::printf("  0x%08X labelled %s\n", l.address, name);
+                ++wrong;
+            }
+        }
+        std::printf("%zu fixture functions: %zu labelled at their own address, %zu not labelled\n",
+                    members.size(), own, members.size() - own);
+        std::printf("%zu copies elsewhere labelled, %zu false matches\n", copies, wrong);
+        return wrong ? 2 : 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return Usage();
+    }
+    if (std::strcmp(argv[1], "build") == 0) {
+        return Build(argc - 2, argv + 2);
+    }
+    if (std::strcmp(argv[1], "check") == 0) {
+        return Check(argc - 2, argv + 2);
+    }
+    return Usage();
+}
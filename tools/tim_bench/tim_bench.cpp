@@ -0,0 +1,181 @@
+// Copyright (c) 2025
+//
+// Decode benchmark for the TIM decoder over a directory of game assets
+// (point it at the install directory: CHDAT, ETCDAT, STDDAT, ETCNA and
+// the rest are searched recursively).  Every .tim and .bin file is
+// mapped and scanned for TIMs; files without any are skipped.  Each TIM
+// is decoded with its first CLUT by DecodeTim and by the per-pixel
+// reference, the outputs are compared, and then both are timed over
+// the whole set.  Portable C++, so it builds with the Linux toolchains
+// as well:
+//
+//     g++ -O2 tools/tim_bench/tim_bench.cpp digi_analysis/tim_image.cpp tools/common/mapped_file.cpp
+//     tim_bench <asset dir> [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include "../../digi_analysis/tim_image.h"
+#include "../common/mapped_file.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double Seconds(Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    }
+
+    bool IsTimFile(const std::string& name) {
+        if (name.size() < 4) {
+            return false;
+        }
+        std::string ext = name.substr(name.size() - 4);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) {
+            return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        });
+        return ext == ".tim" || ext == ".bin";
+    }
+
+    // Append the .tim and .bin files under `dir` to `files`.
+    void ListFiles(const std::string& dir, std::vector<std::string>* files) {
+#if defined(_WIN32)
+        WIN32_FIND_DATAA entry;
+        HANDLE find = FindFirstFileA((dir + "\\*").c_str(), &entry);
+        if (find == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            std::string name = entry.cFileName;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = dir + "\\" + name;
+            if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                ListFiles(path, files);
+            } else if (IsTimFile(name)) {
+                files->push_back(path);
+            }
+        } while (FindNextFileA(find, &entry));
+        FindClose(find);
+#else
+        DIR* d = opendir(dir.c_str());
+        if (!d) {
+            return;
+        }
+        while (dirent* entry = readdir(d)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = dir + "/" + name;
+            struct stat st;
+            if (stat(path.c_str(), &st) != 0) {
+                continue;
+            }
+            if (S_ISDIR(st.st_mode)) {
+                ListFiles(path, files);
+            } else if (IsTimFile(name)) {
+                files->push_back(path);
+            }
+        }
+        closedir(d);
+#endif
+    }
+
+    void Report(const char* name, double seconds, double pixels, double baseline) {
+        std::printf("%-20s %8.1f M pixels/s  %6.2f ns/pixel  %5.2fx\n", name, pixels / seconds / 1e6,
+                    seconds * 1e9 / pixels, baseline / seconds);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (argc < 2 || iterations <= 0) {
+        std::fprintf(stderr, "usage: tim_bench <asset dir> [iterations]\n");
+        return 1;
+    }
+    std::vector<std::string> paths;
+    ListFiles(argv[1], &paths);
+    std::sort(paths.begin(), paths.end());
+
+    // Map and parse; the files stay mapped for the decodes below.
+    Clock::time_point t0 = Clock::now();
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<TimImage> images;
+    for (const std::string& path : paths) {
+        std::unique_ptr<MappedFile> file(new MappedFile);
+        if (file->Open(path.c_str()) && ParseTimBundle(file->data(), file->size(), &images) > 0) {
+            files.push_back(std::move(file));
+        }
+    }
+    Clock::time_point t1 = Clock::now();
+    if (images.empty()) {
+        std::fprintf(stderr, "tim_bench: no TIM images under %s\n", argv[1]);
+        return 1;
+    }
+
+    size_t byMode[4] = {};
+    size_t pixels = 0;
+    size_t largest = 0;
+    for (const TimImage& image : images) {
+        ++byMode[image.mode];
+        pixels += static_cast<size_t>(image.width) * image.height;
+        largest = std::max(largest, static_cast<size_t>(image.width) * image.height);
+    }
+    std::printf("%zu files, %zu TIMs (%zu 4-bit, %zu 8-bit, %zu 15-bit, %zu 24-bit), %.2f M pixels\n", files.size(),
+                images.size(), byMode[kTim4Bit], byMode[kTim8Bit], byMode[kTim15Bit], byMode[kTim24Bit],
+                pixels / 1e6);
+    std::printf("map and parse: %.3f ms, decode path: %s, iterations: %d\n", Seconds(t0, t1) * 1e3, TimDecodePath(),
+                iterations);
+
+    // Verify before timing.
+    std::vector<uint32_t> fast(largest), reference(largest);
+    size_t mismatches = 0;
+    for (const TimImage& image : images) {
+        size_t n = static_cast<size_t>(image.width) * image.height;
+        size_t pitch = image.width * sizeof(uint32_t);
+        DecodeTim(image, 0, fast.data(), pitch);
+        DecodeTimReference(image, 0, reference.data(), pitch);
+        if (std::memcmp(fast.data(), reference.data(), n * sizeof(uint32_t)) != 0) {
+            std::fprintf(stderr, "mismatch: TIM at 0x%X, mode %u, %ux%u\n", image.offset, image.mode, image.width,
+                         image.height);
+            ++mismatches;
+        }
+    }
+
+    volatile uint32_t sink = 0;
+    Clock::time_point t2 = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (const TimImage& image : images) {
+            DecodeTimReference(image, 0, reference.data(), image.width * sizeof(uint32_t));
+            sink += reference[0];
+        }
+    }
+    Clock::time_point t3 = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (const TimImage& image : images) {
+            DecodeTim(image, 0, fast.data(), image.width * sizeof(uint32_t));
+            sink += fast[0];
+        }
+    }
+    Clock::time_point t4 = Clock::now();
+
+    double total = static_cast<double>(pixels) * iterations;
+    std::printf("mismatches: %zu\n", mismatches);
+    Report("reference", Seconds(t2, t3), total, Seconds(t2, t3));
+    Report("DecodeTim", Seconds(t3, t4), total, Seconds(t2, t3));
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2025
+//
+// Synthetic TIM images for tim_bench, since the repository ships no
+// game assets.  Writes into an existing directory:
+//
+//     tim_4bit.tim, tim_8bit.tim, tim_15bit.tim, tim_24bit.tim
+//         one TIM each, of a size that is not a multiple of any SIMD
+//         step, so every path runs its tail code;
+//     bundle_4bit.bin ... bundle_24bit.bin
+//         every width from kWidths for the mode, one and five rows
+//         high, laid end to end with padding words and a small offset
+//         table between some of them, as in ETCDAT\ETCTIM.BIN;
+//     bundle_mixed.bin
+//         all four modes interleaved.
+//
+// Pixels and CLUT entries are random from a fixed seed, with 0x0000
+// and STP-set colours mixed in on purpose so all three alpha cases
+// appear, and the CLUTs have several rows and sometimes fewer colours
+// than the indices reach.  Portable C++:
+//
+//     g++ -O2 tools/tim_gen/tim_gen.cpp -o tim_gen
+//     tim_gen <out dir> [seed]
+//     tim_bench <out dir>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+    const uint32_t kTimTag     = 0x10;
+    const uint32_t kTimHasClut = 0x8;
+    const char* const kModeNames[] = { "4bit", "8bit", "15bit", "24bit" };
+
+    // Pixel widths tried for each mode.  A TIM's width is stored in
+    // 16-bit units, so 4-bit images step by four pixels and 8-bit by
+    // two; the rest straddle the 8-, 16- and 32-pixel SIMD steps.
+    const uint32_t kWidths4[]  = { 4, 8, 12, 16, 20, 28, 32, 36, 60, 100 };
+    const uint32_t kWidths8[]  = { 2, 6, 8, 10, 14, 16, 18, 30, 34, 66 };
+    const uint32_t kWidthsRgb[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 17, 31, 33, 65 };
+
+    struct Random {
+        uint32_t state;
+
+        uint32_t Next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    };
+
+    void Put16(std::vector<uint8_t>* out, uint32_t value) {
+        out->push_back(static_cast<uint8_t>(value));
+        out->push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void Put32(std::vector<uint8_t>* out, uint32_t value) {
+        Put16(out, value & 0xFFFF);
+        Put16(out, value >> 16);
+    }
+
+    // A 15-bit colour: one in eight is 0x0000, one in four has STP set.
+    uint16_t RandomColour(Random* rng) {
+        uint32_t r = rng->Next();
+        if ((r & 7) == 0) {
+            return 0;
+        }
+        uint16_t colour = static_cast<uint16_t>((r >> 8) & 0x7FFF);
+        if ((r & 0x30) == 0) {
+            colour |= 0x8000;
+        }
+        return colour;
+    }
+
+    // Block length, VRAM rectangle in 16-bit units, then the data.
+    void PutBlock(std::vector<uint8_t>* out, uint32_t x, uint32_t y, uint32_t units, uint32_t rows,
+                  const std::vector<uint8_t>& data) {
+        Put32(out, static_cast<uint32_t>(12 + data.size()));
+        Put16(out, x);
+        Put16(out, y);
+        Put16(out, units);
+        Put16(out, rows);
+        out->insert(out->end(), data.begin(), data.end());
+    }
+
+    // Append a TIM of `width` x `height` pixels in `mode` to `out`.
+    void PutTim(std::vector<uint8_t>* out, uint32_t mode, uint32_t width, uint32_t height, Random* rng) {
+        bool indexed = mode <= 1;
+        Put32(out, kTimTag);
+        Put32(out, mode | (indexed ? kTimHasClut : 0));
+        if (indexed) {
+            // Up to four rows, sometimes short of the index range so
+            // out-of-range indices are exercised as well.
+            uint32_t full = mode == 0 ? 16 : 256;
+            uint32_t colours = rng->Next() % 3 == 0 ? full - 1 - rng->Next() % (full / 2) : full;
+            uint32_t rows = 1 + rng->Next() % 4;
+            std::vector<uint8_t> clut;
+            for (uint32_t i = 0; i < colours * rows; ++i) {
+                Put16(&clut, RandomColour(rng));
+            }
+            PutBlock(out, 0, 480 + rng->Next() % 16, colours, rows, clut);
+        }
+        uint32_t units;
+        switch (mode) {
+        case 0:  units = width / 4; break;
+        case 1:  units = width / 2; break;
+        case 2:  units = width; break;
+        default: units = (width * 3 + 1) / 2; break;
+        }
+        std::vector<uint8_t> pixels;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t u = 0; u < units; ++u) {
+                Put16(&pixels, mode == 2 ? RandomColour(rng) : rng->Next() & 0xFFFF);
+            }
+        }
+        PutBlock(out, 320 + rng->Next() % 64, rng->Next() % 256, units, height, pixels);
+    }
+
+    // Filler between TIMs in a bundle: nothing, a run of padding words,
+    // or a short table of offsets.  None of it can be read as a TIM
+    // tag followed by valid flags.
+    void PutFiller(std::vector<uint8_t>* out, Random* rng) {
+        switch (rng->Next() % 3) {
+        case 0:
+            break;
+        case 1:
+            for (uint32_t i = 1 + rng->Next() % 4; i > 0; --i) {
+                Put32(out, 0xFFFFFFFF);
+            }
+            break;
+        default:
+            for (uint32_t i = 1 + rng->Next() % 6; i > 0; --i) {
+                Put32(out, 0x100 + (rng->Next() & 0xFFFF) * 4);
+            }
+            break;
+        }
+    }
+
+    void Widths(uint32_t mode, const uint32_t** widths, size_t* count) {
+        switch (mode) {
+        case 0:
+            *widths = kWidths4;
+            *count = sizeof(kWidths4) / sizeof(kWidths4[0]);
+            break;
+        case 1:
+            *widths = kWidths8;
+            *count = sizeof(kWidths8) / sizeof(kWidths8[0]);
+            break;
+        default:
+            *widths = kWidthsRgb;
+            *count = sizeof(kWidthsRgb) / sizeof(kWidthsRgb[0]);
+            break;
+        }
+    }
+
+    bool Write(const std::string& path, const std::vector<uint8_t>& data) {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            std::fprintf(stderr, "tim_gen: cannot write %s\n", path.c_str());
+            return false;
+        }
+        bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size();
+        ok = std::fclose(f) == 0 && ok;
+        if (!ok) {
+            std::fprintf(stderr, "tim_gen: cannot write %s\n", path.c_str());
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: tim_gen <out dir> [seed]\n");
+        return 1;
+    }
+    std::string dir = argv[1];
+    Random rng = { argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 0)) : 0x2545F491u };
+    if (rng.state == 0) {
+        rng.state = 1;
+    }
+    const uint32_t heights[] = { 1, 5 };
+    size_t tims = 0;
+    std::vector<uint8_t> mixed;
+    for (uint32_t mode = 0; mode < 4; ++mode) {
+        std::vector<uint8_t> single;
+        PutTim(&single, mode, mode == 0 ? 92 : mode == 1 ? 78 : 77, 41, &rng);
+        if (!Write(dir + "/tim_" + kModeNames[mode] + ".tim", single)) {
+            return 1;
+        }
+        ++tims;
+
+        const uint32_t* widths;
+        size_t count;
+        Widths(mode, &widths, &count);
+        std::vector<uint8_t> bundle;
+        for (size_t i = 0; i < count; ++i) {
+            for (uint32_t height : heights) {
+                PutTim(&bundle, mode, widths[i], height, &rng);
+                PutFiller(&bundle, &rng);
+                ++tims;
+            }
+        }
+        if (!Write(dir + "/bundle_" + kModeNames[mode] + ".bin", bundle)) {
+            return 1;
+        }
+    }
+    for (uint32_t i = 0; i < 32; ++i) {
+        uint32_t mode = rng.Next() % 4;
+        const uint32_t* widths;
+        size_t count;
+        Widths(mode, &widths, &count);
+        PutTim(&mixed, mode, widths[rng.Next() % count], 1 + rng.Next() % 9, &rng);
+        PutFiller(&mixed, &rng);
+        ++tims;
+    }
+    if (!Write(dir + "/bundle_mixed.bin", mixed)) {
+        return 1;
+    }
+    std::printf("%zu TIMs written to %s\n", tims, dir.c_str());
+    return 0;
+}